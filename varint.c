@@ -0,0 +1,11871 @@
+/*****************************************************************************
+*       Copyright (C) 2009-2014, FS Consulting Inc. All rights reserved		 *
+*																			 *
+*  This notice is intended as a precaution against inadvertent publication	 *
+*  and does not constitute an admission or acknowledgement that publication	 *
+*  has occurred or constitute a waiver of confidentiality.					 *
+*																			 *
+*  This software is the proprietary and confidential property				 *
+*  of FS Consulting, Inc.													 *
+*****************************************************************************/
+
+
+/*{
+
+	Module:	varint.c
+
+	Author:	Francois Schiettecatte (fschiettecatte@gmail.com)
+
+	Creation Date:	January 7th, 2009
+
+	Purpose:	Integer encoding schemes, see varint.h.
+
+}*/
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** C includes (POSIX)
+*/
+
+/* Enable gnu source */
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif	/* !defined(_GNU_SOURCE) */
+
+/* Enable reentrant functions */
+#if !defined(_REENTRANT)
+#define _REENTRANT
+#endif	/* !defined(_REENTRANT) */
+
+/* Enable large file functions */
+#if !defined(_LARGEFILE_SOURCE)
+#define _LARGEFILE_SOURCE
+#endif	/* !defined(_LARGEFILE_SOURCE) */
+
+/* Set large file bits */
+#if !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS		(64)
+#endif	/* !defined(_FILE_OFFSET_BITS) */
+
+/* #include <assert.h> */
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/times.h>
+#include <sys/time.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sys/uio.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif	/* defined(__linux__) */
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif	/* defined(__x86_64__) || defined(__i386__) */
+#include <semaphore.h>
+#include <sched.h>
+#include <pthread.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <float.h>
+#include <grp.h>
+#include <limits.h>
+#include <math.h>
+#include <pwd.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+#include <locale.h>
+#include <iconv.h>
+#include <wchar.h>
+#include <wctype.h>
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** Library includes
+*/
+
+#include "varint.h"
+#include "varintPrivate.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =========================================
+** === Number storage tables (generator) ===
+** =========================================
+*/
+
+
+/* The quad tables are generated at compile time from a description of the
+** format, a macro giving the number of bytes for each 2 bit size code and
+** the header size. A quad header holds the code of the first integer in its
+** top bits. The tables have one row per header and are cache line aligned
+** so a table spans as few cache lines as it can.
+*/
+
+
+/* Size code and byte size of integer uiMacroIndex (0 to 3) of a quad header */
+#define NUM_TABLE_QUAD_CODE(uiMacroHeader, uiMacroIndex) \
+	(((uiMacroHeader) >> (2 * (3 - (uiMacroIndex)))) & 0x3)
+
+#define NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, uiMacroIndex) \
+	tMacroCodeSize(NUM_TABLE_QUAD_CODE(uiMacroHeader, uiMacroIndex))
+
+/* Offset of integer uiMacroIndex of a quad from the end of the header */
+#define NUM_TABLE_QUAD_OFFSET(tMacroCodeSize, uiMacroHeader, uiMacroIndex) \
+	((((uiMacroIndex) > 0) ? NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 0) : 0) +	\
+			(((uiMacroIndex) > 1) ? NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 1) : 0) +	\
+			(((uiMacroIndex) > 2) ? NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 2) : 0) +	\
+			(((uiMacroIndex) > 3) ? NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 3) : 0))
+
+
+/* Row of a quad sizes table, the sizes, the offsets from the header of the
+** integers after the first, and the length of the quad
+*/
+#define NUM_TABLE_QUAD_SIZES(tMacroCodeSize, uiMacroHeaderSize, uiMacroHeader) \
+	{NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 0), NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 1),	\
+			NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 2), NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, 3),	\
+			(uiMacroHeaderSize) + NUM_TABLE_QUAD_OFFSET(tMacroCodeSize, uiMacroHeader, 1),	\
+			(uiMacroHeaderSize) + NUM_TABLE_QUAD_OFFSET(tMacroCodeSize, uiMacroHeader, 2),	\
+			(uiMacroHeaderSize) + NUM_TABLE_QUAD_OFFSET(tMacroCodeSize, uiMacroHeader, 3),	\
+			(uiMacroHeaderSize) + NUM_TABLE_QUAD_OFFSET(tMacroCodeSize, uiMacroHeader, 4)}
+
+
+/* Row of a quad shuffle mask table, the pshufb mask which moves each integer
+** from its offset after the header into its own 32 bit lane, 0x80 clears the
+** bytes past the size of the integer
+*/
+#define NUM_TABLE_QUAD_SHUFFLE_BYTE(tMacroCodeSize, uiMacroHeader, uiMacroIndex, uiMacroByte) \
+	(((uiMacroByte) < NUM_TABLE_QUAD_SIZE(tMacroCodeSize, uiMacroHeader, uiMacroIndex)) ?	\
+			(NUM_TABLE_QUAD_OFFSET(tMacroCodeSize, uiMacroHeader, uiMacroIndex) + (uiMacroByte)) : 0x80)
+
+#define NUM_TABLE_QUAD_SHUFFLE_INTEGER(tMacroCodeSize, uiMacroHeader, uiMacroIndex) \
+	NUM_TABLE_QUAD_SHUFFLE_BYTE(tMacroCodeSize, uiMacroHeader, uiMacroIndex, 0), NUM_TABLE_QUAD_SHUFFLE_BYTE(tMacroCodeSize, uiMacroHeader, uiMacroIndex, 1),	\
+			NUM_TABLE_QUAD_SHUFFLE_BYTE(tMacroCodeSize, uiMacroHeader, uiMacroIndex, 2), NUM_TABLE_QUAD_SHUFFLE_BYTE(tMacroCodeSize, uiMacroHeader, uiMacroIndex, 3)
+
+#define NUM_TABLE_QUAD_SHUFFLE_MASK(tMacroCodeSize, uiMacroHeaderSize, uiMacroHeader) \
+	{NUM_TABLE_QUAD_SHUFFLE_INTEGER(tMacroCodeSize, uiMacroHeader, 0), NUM_TABLE_QUAD_SHUFFLE_INTEGER(tMacroCodeSize, uiMacroHeader, 1),	\
+			NUM_TABLE_QUAD_SHUFFLE_INTEGER(tMacroCodeSize, uiMacroHeader, 2), NUM_TABLE_QUAD_SHUFFLE_INTEGER(tMacroCodeSize, uiMacroHeader, 3)}
+
+
+/* Rows for all 256 quad headers, tMacroRow is one of the row macros above */
+#define NUM_TABLE_QUAD_HEADERS_4(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, uiMacroHeader) \
+	tMacroRow(tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader)), tMacroRow(tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 1),	\
+			tMacroRow(tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 2), tMacroRow(tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 3)
+
+#define NUM_TABLE_QUAD_HEADERS_16(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, uiMacroHeader) \
+	NUM_TABLE_QUAD_HEADERS_4(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader)),	\
+			NUM_TABLE_QUAD_HEADERS_4(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 4),	\
+			NUM_TABLE_QUAD_HEADERS_4(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 8),	\
+			NUM_TABLE_QUAD_HEADERS_4(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 12)
+
+#define NUM_TABLE_QUAD_HEADERS_64(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, uiMacroHeader) \
+	NUM_TABLE_QUAD_HEADERS_16(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader)),	\
+			NUM_TABLE_QUAD_HEADERS_16(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 16),	\
+			NUM_TABLE_QUAD_HEADERS_16(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 32),	\
+			NUM_TABLE_QUAD_HEADERS_16(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, (uiMacroHeader) + 48)
+
+#define NUM_TABLE_QUAD_HEADERS(tMacroRow, tMacroCodeSize, uiMacroHeaderSize) \
+	NUM_TABLE_QUAD_HEADERS_64(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, 0), NUM_TABLE_QUAD_HEADERS_64(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, 64),	\
+			NUM_TABLE_QUAD_HEADERS_64(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, 128), NUM_TABLE_QUAD_HEADERS_64(tMacroRow, tMacroCodeSize, uiMacroHeaderSize, 192)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ======================================
+** === Number storage tables (varint) ===
+** ======================================
+*/
+
+
+/* Masks used to mask out a varint in memory */
+const unsigned int		uiVarintMaskGlobal[] = {0x0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+
+/* Structure which tells us the byte size of each varint based on the header,
+** the offset of the varints after the first and the length of the quad
+*/
+const struct varintSize pvsVarintSizesGlobal[256] __attribute__ ((aligned (NUM_CACHE_LINE_SIZE))) =
+{
+	NUM_TABLE_QUAD_HEADERS(NUM_TABLE_QUAD_SIZES, NUM_VARINT_CODE_SIZE, NUM_VARINT_HEADER_SIZE)
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage tables (compact varint) ===
+** ==============================================
+*/
+
+
+/* Masks used to mask out a compact varint in memory */
+const unsigned int		uiCompactVarintMaskGlobal[] = {0x0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+
+/* Structure which tells us the byte size of each compact varint based on the
+** header, the offset of the compact varints after the first and the length
+** of the quad
+*/
+const struct compactVarintSize pvsCompactVarintSizesGlobal[256] __attribute__ ((aligned (NUM_CACHE_LINE_SIZE))) =
+{
+	NUM_TABLE_QUAD_HEADERS(NUM_TABLE_QUAD_SIZES, NUM_COMPACT_VARINT_CODE_SIZE, NUM_COMPACT_VARINT_HEADER_SIZE)
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ========================================
+** === Number storage functions (arena) ===
+** ========================================
+*/
+
+
+/* The arena hands out cache line aligned buffers for encoded and decoded
+** data from large mappings, buffers are handed back into per size class
+** free lists and reused, so the hot path neither calls malloc() nor takes
+** page faults on memory it has used before. An arena is not thread safe,
+** each thread uses its own, see iNumArenaGetThread().
+*/
+
+
+/* Huge page length, regions are rounded up to it */
+#define NUM_ARENA_HUGE_PAGE_LENGTH					(2 * 1024 * 1024)
+
+/* Size classes, powers of two from the smallest */
+#define NUM_ARENA_SIZE_CLASS_MIN_SHIFT				(6)
+#define NUM_ARENA_SIZE_CLASS_COUNT					(32)
+
+/* Buffer header length, the header keeps the data cache line aligned */
+#define NUM_ARENA_HEADER_LENGTH						(NUM_CACHE_LINE_SIZE)
+
+
+/* Arena buffer header, lives in front of the data */
+struct numArenaHeader {
+	unsigned int			uiSizeClass;
+	struct numArenaHeader	*pnahNext;				/* Next free buffer in the class */
+};
+
+
+/* Arena region, one mapping */
+struct numArenaRegion {
+	void					*pvData;
+	size_t					zLength;
+	struct numArenaRegion	*pnarNext;
+};
+
+
+/* Arena structure */
+struct numArena {
+	unsigned int			uiFlags;
+	size_t					zRegionLength;
+
+	struct numArenaRegion	*pnarRegions;			/* Most recent first */
+	unsigned char			*pucBump;				/* Free space in the most recent shared region */
+	unsigned char			*pucBumpEnd;
+
+	struct numArenaHeader	*pnahFree[NUM_ARENA_SIZE_CLASS_COUNT];
+
+	unsigned long long		ullMappedLength;
+	unsigned long long		ullAllocations;
+	unsigned long long		ullReuses;
+};
+
+
+/* Per thread arena */
+static pthread_once_t	tpoNumArenaThreadOnceGlobal = PTHREAD_ONCE_INIT;
+static pthread_key_t	tkNumArenaThreadKeyGlobal;
+
+
+/*
+
+	Function:	iNumArenaMapRegion()
+
+	Purpose:	Maps a new region for an arena.
+
+	Parameters:	pnaNumArena		arena
+				zLength			length needed
+				ppnarRegion		return pointer for the region
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumArenaMapRegion
+(
+	struct numArena *pnaNumArena,
+	size_t zLength,
+	struct numArenaRegion **ppnarRegion
+)
+{
+
+	struct numArenaRegion	*pnarRegion = NULL;
+	int						iMapFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+	void					*pvData = MAP_FAILED;
+
+
+	ASSERT(pnaNumArena != NULL);
+	ASSERT(ppnarRegion != NULL);
+
+
+	if ( (pnarRegion = (struct numArenaRegion *)malloc(sizeof(struct numArenaRegion))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	if ( (pnaNumArena->uiFlags & NUM_ARENA_FLAG_PREFAULT) != 0 ) {
+		iMapFlags |= MAP_POPULATE;
+	}
+
+
+	/* Try explicit huge pages first, they need to be reserved by the administrator */
+	if ( (pnaNumArena->uiFlags & NUM_ARENA_FLAG_HUGE_PAGES) != 0 ) {
+
+		zLength = (zLength + NUM_ARENA_HUGE_PAGE_LENGTH - 1) & ~((size_t)NUM_ARENA_HUGE_PAGE_LENGTH - 1);
+
+#if defined(MAP_HUGETLB)
+		pvData = mmap(NULL, zLength, PROT_READ | PROT_WRITE, iMapFlags | MAP_HUGETLB, -1, 0);
+#endif	/* defined(MAP_HUGETLB) */
+	}
+
+	if ( pvData == MAP_FAILED ) {
+
+		if ( (pvData = mmap(NULL, zLength, PROT_READ | PROT_WRITE, iMapFlags, -1, 0)) == MAP_FAILED ) {
+			free(pnarRegion);
+			return (NUM_MemError);
+		}
+
+#if defined(MADV_HUGEPAGE)
+		/* Ask for transparent huge pages instead, this is only advice */
+		if ( (pnaNumArena->uiFlags & NUM_ARENA_FLAG_HUGE_PAGES) != 0 ) {
+			madvise(pvData, zLength, MADV_HUGEPAGE);
+		}
+#endif	/* defined(MADV_HUGEPAGE) */
+	}
+
+
+	pnarRegion->pvData = pvData;
+	pnarRegion->zLength = zLength;
+	pnarRegion->pnarNext = pnaNumArena->pnarRegions;
+	pnaNumArena->pnarRegions = pnarRegion;
+
+	pnaNumArena->ullMappedLength += zLength;
+
+	*ppnarRegion = pnarRegion;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumArenaCreate()
+
+	Purpose:	Creates an arena.
+
+	Parameters:	ullRegionLength		length to map at a time, 0 for the default
+				uiFlags				arena flags
+				ppvNumArena			return pointer for the arena
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumArenaCreate
+(
+	unsigned long long ullRegionLength,
+	unsigned int uiFlags,
+	void **ppvNumArena
+)
+{
+
+	struct numArena		*pnaNumArena = NULL;
+
+
+	/* Check the parameters */
+	if ( (uiFlags & ~(NUM_ARENA_FLAG_HUGE_PAGES | NUM_ARENA_FLAG_PREFAULT)) != 0 ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumArena == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Set the defaults */
+	if ( ullRegionLength == 0 ) {
+		ullRegionLength = NUM_ARENA_REGION_LENGTH_DEFAULT;
+	}
+
+
+	if ( (pnaNumArena = (struct numArena *)calloc(1, sizeof(struct numArena))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnaNumArena->uiFlags = uiFlags;
+	pnaNumArena->zRegionLength = ullRegionLength;
+
+	*ppvNumArena = (void *)pnaNumArena;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumArenaAllocate()
+
+	Purpose:	Allocates a cache line aligned buffer from an arena, reusing a
+				buffer of the same size class if one was released. Buffers
+				larger than the region length get a mapping of their own.
+
+	Parameters:	pvNumArena		arena
+				ullLength		length needed
+				ppvData			return pointer for the buffer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumArenaAllocate
+(
+	void *pvNumArena,
+	unsigned long long ullLength,
+	void **ppvData
+)
+{
+
+	struct numArena			*pnaNumArena = (struct numArena *)pvNumArena;
+	struct numArenaHeader	*pnahNumArenaHeader = NULL;
+	struct numArenaRegion	*pnarRegion = NULL;
+	unsigned int			uiSizeClass = 0;
+	size_t					zBlockLength = 0;
+	int						iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnaNumArena == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvData == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Get the size class */
+	while ( (uiSizeClass < NUM_ARENA_SIZE_CLASS_COUNT) && (((unsigned long long)1 << (uiSizeClass + NUM_ARENA_SIZE_CLASS_MIN_SHIFT)) < ullLength) ) {
+		uiSizeClass++;
+	}
+
+	if ( uiSizeClass == NUM_ARENA_SIZE_CLASS_COUNT ) {
+		return (NUM_InvalidParameter);
+	}
+
+	pnaNumArena->ullAllocations++;
+
+
+	/* Reuse a released buffer */
+	if ( pnaNumArena->pnahFree[uiSizeClass] != NULL ) {
+
+		pnahNumArenaHeader = pnaNumArena->pnahFree[uiSizeClass];
+		pnaNumArena->pnahFree[uiSizeClass] = pnahNumArenaHeader->pnahNext;
+		pnaNumArena->ullReuses++;
+
+		*ppvData = (unsigned char *)pnahNumArenaHeader + NUM_ARENA_HEADER_LENGTH;
+
+		return (NUM_NoError);
+	}
+
+
+	zBlockLength = NUM_ARENA_HEADER_LENGTH + ((size_t)1 << (uiSizeClass + NUM_ARENA_SIZE_CLASS_MIN_SHIFT));
+
+	/* Large buffers get their own region */
+	if ( zBlockLength > pnaNumArena->zRegionLength ) {
+
+		if ( (iError = iNumArenaMapRegion(pnaNumArena, zBlockLength, &pnarRegion)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		pnahNumArenaHeader = (struct numArenaHeader *)pnarRegion->pvData;
+	}
+
+	/* Otherwise carve them from the shared region, mapping a new one when it runs out */
+	else {
+
+		if ( (pnaNumArena->pucBump == NULL) || ((size_t)(pnaNumArena->pucBumpEnd - pnaNumArena->pucBump) < zBlockLength) ) {
+
+			if ( (iError = iNumArenaMapRegion(pnaNumArena, pnaNumArena->zRegionLength, &pnarRegion)) != NUM_NoError ) {
+				return (iError);
+			}
+
+			pnaNumArena->pucBump = (unsigned char *)pnarRegion->pvData;
+			pnaNumArena->pucBumpEnd = pnaNumArena->pucBump + pnarRegion->zLength;
+		}
+
+		pnahNumArenaHeader = (struct numArenaHeader *)pnaNumArena->pucBump;
+		pnaNumArena->pucBump += zBlockLength;
+	}
+
+	pnahNumArenaHeader->uiSizeClass = uiSizeClass;
+	pnahNumArenaHeader->pnahNext = NULL;
+
+	*ppvData = (unsigned char *)pnahNumArenaHeader + NUM_ARENA_HEADER_LENGTH;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumArenaRelease()
+
+	Purpose:	Hands a buffer back to the arena it was allocated from.
+
+	Parameters:	pvNumArena		arena
+				pvData			buffer, may be NULL
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumArenaRelease
+(
+	void *pvNumArena,
+	void *pvData
+)
+{
+
+	struct numArena			*pnaNumArena = (struct numArena *)pvNumArena;
+	struct numArenaHeader	*pnahNumArenaHeader = NULL;
+
+
+	/* Check the parameters */
+	if ( pnaNumArena == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pvData == NULL ) {
+		return (NUM_NoError);
+	}
+
+
+	pnahNumArenaHeader = (struct numArenaHeader *)((unsigned char *)pvData - NUM_ARENA_HEADER_LENGTH);
+
+	if ( pnahNumArenaHeader->uiSizeClass >= NUM_ARENA_SIZE_CLASS_COUNT ) {
+		return (NUM_InvalidParameter);
+	}
+
+	pnahNumArenaHeader->pnahNext = pnaNumArena->pnahFree[pnahNumArenaHeader->uiSizeClass];
+	pnaNumArena->pnahFree[pnahNumArenaHeader->uiSizeClass] = pnahNumArenaHeader;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumArenaGetCounts()
+
+	Purpose:	Gets the counts for an arena.
+
+	Parameters:	pvNumArena			arena
+				pullMappedLength	return pointer for the length mapped
+				pullAllocations		return pointer for the number of allocations
+				pullReuses			return pointer for the number of allocations
+									which reused a released buffer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumArenaGetCounts
+(
+	void *pvNumArena,
+	unsigned long long *pullMappedLength,
+	unsigned long long *pullAllocations,
+	unsigned long long *pullReuses
+)
+{
+
+	struct numArena		*pnaNumArena = (struct numArena *)pvNumArena;
+
+
+	/* Check the parameters */
+	if ( pnaNumArena == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pullMappedLength == NULL) || (pullAllocations == NULL) || (pullReuses == NULL) ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	*pullMappedLength = pnaNumArena->ullMappedLength;
+	*pullAllocations = pnaNumArena->ullAllocations;
+	*pullReuses = pnaNumArena->ullReuses;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumArenaFree()
+
+	Purpose:	Frees an arena and every buffer allocated from it.
+
+	Parameters:	pvNumArena		arena
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumArenaFree
+(
+	void *pvNumArena
+)
+{
+
+	struct numArena			*pnaNumArena = (struct numArena *)pvNumArena;
+	struct numArenaRegion	*pnarRegion = NULL;
+
+
+	/* Check the parameters */
+	if ( pnaNumArena == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	while ( pnaNumArena->pnarRegions != NULL ) {
+		pnarRegion = pnaNumArena->pnarRegions;
+		pnaNumArena->pnarRegions = pnarRegion->pnarNext;
+		munmap(pnarRegion->pvData, pnarRegion->zLength);
+		free(pnarRegion);
+	}
+
+	free(pnaNumArena);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	vNumArenaThreadFree()
+
+	Purpose:	Frees the arena of a thread when the thread exits.
+
+	Parameters:	pvNumArena		arena
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumArenaThreadFree
+(
+	void *pvNumArena
+)
+{
+
+	iNumArenaFree(pvNumArena);
+
+	return;
+
+}
+
+
+/*
+
+	Function:	vNumArenaThreadKeyCreate()
+
+	Purpose:	Creates the key for the per thread arenas, once.
+
+	Parameters:	none
+
+	Global Variables:	tkNumArenaThreadKeyGlobal
+
+	Returns:	void
+
+*/
+static void vNumArenaThreadKeyCreate
+(
+	void
+)
+{
+
+	pthread_key_create(&tkNumArenaThreadKeyGlobal, vNumArenaThreadFree);
+
+	return;
+
+}
+
+
+/*
+
+	Function:	iNumArenaGetThread()
+
+	Purpose:	Gets the arena of the calling thread, creating it the first
+				time. The arena backs onto transparent huge pages and is freed
+				when the thread exits.
+
+	Parameters:	ppvNumArena		return pointer for the arena
+
+	Global Variables:	tpoNumArenaThreadOnceGlobal, tkNumArenaThreadKeyGlobal
+
+	Returns:	NUM error code
+
+*/
+int iNumArenaGetThread
+(
+	void **ppvNumArena
+)
+{
+
+	void	*pvNumArena = NULL;
+	int		iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( ppvNumArena == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	pthread_once(&tpoNumArenaThreadOnceGlobal, vNumArenaThreadKeyCreate);
+
+	if ( (pvNumArena = pthread_getspecific(tkNumArenaThreadKeyGlobal)) == NULL ) {
+
+		if ( (iError = iNumArenaCreate(0, NUM_ARENA_FLAG_HUGE_PAGES, &pvNumArena)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( pthread_setspecific(tkNumArenaThreadKeyGlobal, pvNumArena) != 0 ) {
+			iNumArenaFree(pvNumArena);
+			return (NUM_MemError);
+		}
+	}
+
+	*ppvNumArena = pvNumArena;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ============================================
+** === Number storage functions (histogram) ===
+** ============================================
+*/
+
+
+/* A histogram has a single writer, values are recorded with relaxed atomic
+** stores rather than locked increments, so other threads can merge it at any
+** time and see a close to current view of it. Each thread records into its
+** own histogram, see iNumHistogramGetThread(), these are kept in a list and
+** merged on report, the histogram of a thread is folded into a retired
+** histogram when the thread exits so nothing recorded is lost.
+**
+** Building varint.c with NUM_DECODE_LATENCY defined records the latency of
+** every block decode, in ticks, in the histogram of the calling thread.
+*/
+
+
+/* Histogram structure */
+struct numHistogram {
+	unsigned long long		pullCounts[NUM_HISTOGRAM_BUCKET_COUNT];
+	unsigned long long		ullCount;
+	unsigned long long		ullMinValue;
+	unsigned long long		ullMaxValue;
+	unsigned long long		ullSum;
+
+	struct numHistogram		*pnhNumHistogramNext;	/* Thread histogram list */
+};
+
+
+/* Per thread histograms, the list of live thread histograms and the
+** histogram the thread histograms are folded into when their thread exits
+*/
+static pthread_once_t			tpoNumHistogramThreadOnceGlobal = PTHREAD_ONCE_INIT;
+static pthread_key_t			tkNumHistogramThreadKeyGlobal;
+static pthread_mutex_t			tmNumHistogramThreadMutexGlobal = PTHREAD_MUTEX_INITIALIZER;
+static struct numHistogram		*pnhNumHistogramThreadsGlobal = NULL;
+static struct numHistogram		nhNumHistogramRetiredGlobal;
+
+
+/* Tick length, calibrated once */
+static pthread_once_t			tpoNumTickOnceGlobal = PTHREAD_ONCE_INIT;
+static double					dNumTickNanosecondsGlobal = 1;
+
+
+/* Macros to read and write histogram fields, they only have one writer */
+#define NUM_HISTOGRAM_LOAD(ullMacroField)					__atomic_load_n(&(ullMacroField), __ATOMIC_RELAXED)
+#define NUM_HISTOGRAM_STORE(ullMacroField, ullMacroValue)	__atomic_store_n(&(ullMacroField), (ullMacroValue), __ATOMIC_RELAXED)
+
+
+/*
+
+	Function:	uiNumHistogramGetBucket()
+
+	Purpose:	Gets the bucket for a value.
+
+	Parameters:	ullValue		value
+
+	Global Variables:	none
+
+	Returns:	the bucket
+
+*/
+static unsigned int uiNumHistogramGetBucket
+(
+	unsigned long long ullValue
+)
+{
+
+	unsigned int	uiExponent = 0;
+
+
+	if ( ullValue < (1ULL << NUM_HISTOGRAM_SUB_BUCKET_BITS) ) {
+		return ((unsigned int)ullValue);
+	}
+
+	uiExponent = 63 - __builtin_clzll(ullValue);
+
+	return (((uiExponent - NUM_HISTOGRAM_SUB_BUCKET_BITS + 1) << NUM_HISTOGRAM_SUB_BUCKET_BITS) +
+			(unsigned int)((ullValue >> (uiExponent - NUM_HISTOGRAM_SUB_BUCKET_BITS)) & ((1ULL << NUM_HISTOGRAM_SUB_BUCKET_BITS) - 1)));
+
+}
+
+
+/*
+
+	Function:	ullNumHistogramGetBucketMaxValue()
+
+	Purpose:	Gets the highest value which falls in a bucket.
+
+	Parameters:	uiBucket		bucket
+
+	Global Variables:	none
+
+	Returns:	the highest value
+
+*/
+static unsigned long long ullNumHistogramGetBucketMaxValue
+(
+	unsigned int uiBucket
+)
+{
+
+	unsigned int	uiShift = 0;
+
+
+	if ( uiBucket < (1U << NUM_HISTOGRAM_SUB_BUCKET_BITS) ) {
+		return (uiBucket);
+	}
+
+	uiShift = (uiBucket >> NUM_HISTOGRAM_SUB_BUCKET_BITS) - 1;
+
+	return ((((unsigned long long)((1U << NUM_HISTOGRAM_SUB_BUCKET_BITS) | (uiBucket & ((1U << NUM_HISTOGRAM_SUB_BUCKET_BITS) - 1)))) << uiShift) +
+			((1ULL << uiShift) - 1));
+
+}
+
+
+/*
+
+	Function:	iNumHistogramCreate()
+
+	Purpose:	Creates a histogram.
+
+	Parameters:	ppvNumHistogram		return pointer for the histogram
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramCreate
+(
+	void **ppvNumHistogram
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = NULL;
+
+
+	/* Check the parameters */
+	if ( ppvNumHistogram == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( (pnhNumHistogram = (struct numHistogram *)calloc(1, sizeof(struct numHistogram))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnhNumHistogram->ullMinValue = ~0ULL;
+
+	*ppvNumHistogram = (void *)pnhNumHistogram;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramRecord()
+
+	Purpose:	Records a value in a histogram, only one thread may record
+				in a histogram.
+
+	Parameters:	pvNumHistogram		histogram
+				ullValue			value
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramRecord
+(
+	void *pvNumHistogram,
+	unsigned long long ullValue
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = (struct numHistogram *)pvNumHistogram;
+	unsigned int			uiBucket = 0;
+
+
+	/* Check the parameters */
+	if ( pnhNumHistogram == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	uiBucket = uiNumHistogramGetBucket(ullValue);
+
+	NUM_HISTOGRAM_STORE(pnhNumHistogram->pullCounts[uiBucket], pnhNumHistogram->pullCounts[uiBucket] + 1);
+	NUM_HISTOGRAM_STORE(pnhNumHistogram->ullCount, pnhNumHistogram->ullCount + 1);
+	NUM_HISTOGRAM_STORE(pnhNumHistogram->ullSum, pnhNumHistogram->ullSum + ullValue);
+
+	if ( ullValue < pnhNumHistogram->ullMinValue ) {
+		NUM_HISTOGRAM_STORE(pnhNumHistogram->ullMinValue, ullValue);
+	}
+
+	if ( ullValue > pnhNumHistogram->ullMaxValue ) {
+		NUM_HISTOGRAM_STORE(pnhNumHistogram->ullMaxValue, ullValue);
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramMerge()
+
+	Purpose:	Adds the values of a histogram to another one, the source
+				histogram can be being recorded in. The histogram merged
+				into must only be used by the calling thread.
+
+	Parameters:	pvNumHistogram			histogram to merge into
+				pvNumHistogramSource	histogram to merge
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramMerge
+(
+	void *pvNumHistogram,
+	void *pvNumHistogramSource
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = (struct numHistogram *)pvNumHistogram;
+	struct numHistogram		*pnhNumHistogramSource = (struct numHistogram *)pvNumHistogramSource;
+	unsigned long long		ullValue = 0;
+	unsigned int			uiI = 0;
+
+
+	/* Check the parameters */
+	if ( (pnhNumHistogram == NULL) || (pnhNumHistogramSource == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	for ( uiI = 0; uiI < NUM_HISTOGRAM_BUCKET_COUNT; uiI++ ) {
+		if ( (ullValue = NUM_HISTOGRAM_LOAD(pnhNumHistogramSource->pullCounts[uiI])) > 0 ) {
+			NUM_HISTOGRAM_STORE(pnhNumHistogram->pullCounts[uiI], pnhNumHistogram->pullCounts[uiI] + ullValue);
+		}
+	}
+
+	NUM_HISTOGRAM_STORE(pnhNumHistogram->ullCount, pnhNumHistogram->ullCount + NUM_HISTOGRAM_LOAD(pnhNumHistogramSource->ullCount));
+	NUM_HISTOGRAM_STORE(pnhNumHistogram->ullSum, pnhNumHistogram->ullSum + NUM_HISTOGRAM_LOAD(pnhNumHistogramSource->ullSum));
+
+	if ( (ullValue = NUM_HISTOGRAM_LOAD(pnhNumHistogramSource->ullMinValue)) < pnhNumHistogram->ullMinValue ) {
+		NUM_HISTOGRAM_STORE(pnhNumHistogram->ullMinValue, ullValue);
+	}
+
+	if ( (ullValue = NUM_HISTOGRAM_LOAD(pnhNumHistogramSource->ullMaxValue)) > pnhNumHistogram->ullMaxValue ) {
+		NUM_HISTOGRAM_STORE(pnhNumHistogram->ullMaxValue, ullValue);
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramReset()
+
+	Purpose:	Clears a histogram, nothing may be recording in it.
+
+	Parameters:	pvNumHistogram		histogram
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramReset
+(
+	void *pvNumHistogram
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = (struct numHistogram *)pvNumHistogram;
+
+
+	/* Check the parameters */
+	if ( pnhNumHistogram == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	memset(pnhNumHistogram->pullCounts, 0, sizeof(pnhNumHistogram->pullCounts));
+	pnhNumHistogram->ullCount = 0;
+	pnhNumHistogram->ullMinValue = ~0ULL;
+	pnhNumHistogram->ullMaxValue = 0;
+	pnhNumHistogram->ullSum = 0;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramGetCounts()
+
+	Purpose:	Gets the number of values in a histogram, the smallest,
+				the largest and the mean.
+
+	Parameters:	pvNumHistogram		histogram
+				pullCount			return pointer for the number of values (optional)
+				pullMinValue		return pointer for the smallest value, 0 if there are none (optional)
+				pullMaxValue		return pointer for the largest value (optional)
+				pdMeanValue			return pointer for the mean value (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramGetCounts
+(
+	void *pvNumHistogram,
+	unsigned long long *pullCount,
+	unsigned long long *pullMinValue,
+	unsigned long long *pullMaxValue,
+	double *pdMeanValue
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = (struct numHistogram *)pvNumHistogram;
+	unsigned long long		ullCount = 0;
+
+
+	/* Check the parameters */
+	if ( pnhNumHistogram == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	ullCount = NUM_HISTOGRAM_LOAD(pnhNumHistogram->ullCount);
+
+	if ( pullCount != NULL ) {
+		*pullCount = ullCount;
+	}
+
+	if ( pullMinValue != NULL ) {
+		*pullMinValue = (ullCount > 0) ? NUM_HISTOGRAM_LOAD(pnhNumHistogram->ullMinValue) : 0;
+	}
+
+	if ( pullMaxValue != NULL ) {
+		*pullMaxValue = NUM_HISTOGRAM_LOAD(pnhNumHistogram->ullMaxValue);
+	}
+
+	if ( pdMeanValue != NULL ) {
+		*pdMeanValue = (ullCount > 0) ? ((double)NUM_HISTOGRAM_LOAD(pnhNumHistogram->ullSum) / ullCount) : 0;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramGetPercentile()
+
+	Purpose:	Gets the value at a percentile of a histogram, this is the
+				highest value in the bucket the percentile falls in, capped
+				at the largest value recorded.
+
+	Parameters:	pvNumHistogram		histogram
+				dPercentile			percentile, 0 to 100
+				pullValue			return pointer for the value, 0 if there are no values
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramGetPercentile
+(
+	void *pvNumHistogram,
+	double dPercentile,
+	unsigned long long *pullValue
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = (struct numHistogram *)pvNumHistogram;
+	unsigned long long		ullCount = 0;
+	unsigned long long		ullTarget = 0;
+	unsigned long long		ullCumulativeCount = 0;
+	unsigned long long		ullMaxValue = 0;
+	unsigned long long		ullValue = 0;
+	unsigned int			uiI = 0;
+
+
+	/* Check the parameters */
+	if ( pnhNumHistogram == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (dPercentile < 0) || (dPercentile > 100) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pullValue == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	*pullValue = 0;
+
+	if ( (ullCount = NUM_HISTOGRAM_LOAD(pnhNumHistogram->ullCount)) == 0 ) {
+		return (NUM_NoError);
+	}
+
+	/* The number of values at or below the percentile, at least one */
+	ullTarget = (unsigned long long)ceil((dPercentile / 100) * ullCount);
+	if ( ullTarget == 0 ) {
+		ullTarget = 1;
+	}
+
+	ullMaxValue = NUM_HISTOGRAM_LOAD(pnhNumHistogram->ullMaxValue);
+
+	for ( uiI = 0; uiI < NUM_HISTOGRAM_BUCKET_COUNT; uiI++ ) {
+		if ( (ullCumulativeCount += NUM_HISTOGRAM_LOAD(pnhNumHistogram->pullCounts[uiI])) >= ullTarget ) {
+			break;
+		}
+	}
+
+	/* The counts can trail the count if the histogram is being recorded in */
+	ullValue = (uiI < NUM_HISTOGRAM_BUCKET_COUNT) ? ullNumHistogramGetBucketMaxValue(uiI) : ullMaxValue;
+	*pullValue = (ullValue < ullMaxValue) ? ullValue : ullMaxValue;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramFree()
+
+	Purpose:	Frees a histogram.
+
+	Parameters:	pvNumHistogram		histogram
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramFree
+(
+	void *pvNumHistogram
+)
+{
+
+	/* Check the parameters */
+	if ( pvNumHistogram == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	free(pvNumHistogram);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	vNumHistogramThreadFree()
+
+	Purpose:	Folds the histogram of a thread into the retired histogram
+				and frees it when the thread exits.
+
+	Parameters:	pvNumHistogram		histogram
+
+	Global Variables:	tmNumHistogramThreadMutexGlobal, pnhNumHistogramThreadsGlobal,
+						nhNumHistogramRetiredGlobal
+
+	Returns:	void
+
+*/
+static void vNumHistogramThreadFree
+(
+	void *pvNumHistogram
+)
+{
+
+	struct numHistogram		**ppnhNumHistogram = NULL;
+
+
+	pthread_mutex_lock(&tmNumHistogramThreadMutexGlobal);
+
+	for ( ppnhNumHistogram = &pnhNumHistogramThreadsGlobal; *ppnhNumHistogram != NULL; ppnhNumHistogram = &(*ppnhNumHistogram)->pnhNumHistogramNext ) {
+		if ( *ppnhNumHistogram == (struct numHistogram *)pvNumHistogram ) {
+			*ppnhNumHistogram = (*ppnhNumHistogram)->pnhNumHistogramNext;
+			break;
+		}
+	}
+
+	iNumHistogramMerge(&nhNumHistogramRetiredGlobal, pvNumHistogram);
+
+	pthread_mutex_unlock(&tmNumHistogramThreadMutexGlobal);
+
+	iNumHistogramFree(pvNumHistogram);
+
+	return;
+
+}
+
+
+/*
+
+	Function:	vNumHistogramThreadKeyCreate()
+
+	Purpose:	Creates the key for the per thread histograms, once.
+
+	Parameters:	none
+
+	Global Variables:	tkNumHistogramThreadKeyGlobal, nhNumHistogramRetiredGlobal
+
+	Returns:	void
+
+*/
+static void vNumHistogramThreadKeyCreate
+(
+	void
+)
+{
+
+	pthread_key_create(&tkNumHistogramThreadKeyGlobal, vNumHistogramThreadFree);
+
+	iNumHistogramReset(&nhNumHistogramRetiredGlobal);
+
+	return;
+
+}
+
+
+/*
+
+	Function:	iNumHistogramGetThread()
+
+	Purpose:	Gets the histogram of the calling thread, creating it the
+				first time.
+
+	Parameters:	ppvNumHistogram		return pointer for the histogram
+
+	Global Variables:	tpoNumHistogramThreadOnceGlobal, tkNumHistogramThreadKeyGlobal,
+						tmNumHistogramThreadMutexGlobal, pnhNumHistogramThreadsGlobal
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramGetThread
+(
+	void **ppvNumHistogram
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = NULL;
+	int						iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( ppvNumHistogram == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	pthread_once(&tpoNumHistogramThreadOnceGlobal, vNumHistogramThreadKeyCreate);
+
+	if ( (pnhNumHistogram = (struct numHistogram *)pthread_getspecific(tkNumHistogramThreadKeyGlobal)) == NULL ) {
+
+		if ( (iError = iNumHistogramCreate((void **)&pnhNumHistogram)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( pthread_setspecific(tkNumHistogramThreadKeyGlobal, pnhNumHistogram) != 0 ) {
+			iNumHistogramFree(pnhNumHistogram);
+			return (NUM_MemError);
+		}
+
+		pthread_mutex_lock(&tmNumHistogramThreadMutexGlobal);
+		pnhNumHistogram->pnhNumHistogramNext = pnhNumHistogramThreadsGlobal;
+		pnhNumHistogramThreadsGlobal = pnhNumHistogram;
+		pthread_mutex_unlock(&tmNumHistogramThreadMutexGlobal);
+	}
+
+	*ppvNumHistogram = (void *)pnhNumHistogram;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramMergeThreads()
+
+	Purpose:	Adds the values of all the thread histograms, including
+				those of threads which have exited, to a histogram.
+
+	Parameters:	pvNumHistogram		histogram to merge into
+
+	Global Variables:	tpoNumHistogramThreadOnceGlobal, tmNumHistogramThreadMutexGlobal,
+						pnhNumHistogramThreadsGlobal, nhNumHistogramRetiredGlobal
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramMergeThreads
+(
+	void *pvNumHistogram
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = NULL;
+	int						iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pvNumHistogram == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	pthread_once(&tpoNumHistogramThreadOnceGlobal, vNumHistogramThreadKeyCreate);
+
+	pthread_mutex_lock(&tmNumHistogramThreadMutexGlobal);
+
+	iError = iNumHistogramMerge(pvNumHistogram, &nhNumHistogramRetiredGlobal);
+
+	for ( pnhNumHistogram = pnhNumHistogramThreadsGlobal; (pnhNumHistogram != NULL) && (iError == NUM_NoError); pnhNumHistogram = pnhNumHistogram->pnhNumHistogramNext ) {
+		iError = iNumHistogramMerge(pvNumHistogram, pnhNumHistogram);
+	}
+
+	pthread_mutex_unlock(&tmNumHistogramThreadMutexGlobal);
+
+
+	return (iError);
+
+}
+
+
+/*
+
+	Function:	iNumHistogramResetThreads()
+
+	Purpose:	Clears all the thread histograms, no thread may be recording
+				in its histogram.
+
+	Parameters:	none
+
+	Global Variables:	tpoNumHistogramThreadOnceGlobal, tmNumHistogramThreadMutexGlobal,
+						pnhNumHistogramThreadsGlobal, nhNumHistogramRetiredGlobal
+
+	Returns:	NUM error code
+
+*/
+int iNumHistogramResetThreads
+(
+	void
+)
+{
+
+	struct numHistogram		*pnhNumHistogram = NULL;
+
+
+	pthread_once(&tpoNumHistogramThreadOnceGlobal, vNumHistogramThreadKeyCreate);
+
+	pthread_mutex_lock(&tmNumHistogramThreadMutexGlobal);
+
+	iNumHistogramReset(&nhNumHistogramRetiredGlobal);
+
+	for ( pnhNumHistogram = pnhNumHistogramThreadsGlobal; pnhNumHistogram != NULL; pnhNumHistogram = pnhNumHistogram->pnhNumHistogramNext ) {
+		iNumHistogramReset(pnhNumHistogram);
+	}
+
+	pthread_mutex_unlock(&tmNumHistogramThreadMutexGlobal);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	vNumTickCalibrate()
+
+	Purpose:	Measures the length of a tick against the monotonic clock,
+				once.
+
+	Parameters:	none
+
+	Global Variables:	dNumTickNanosecondsGlobal
+
+	Returns:	void
+
+*/
+static void vNumTickCalibrate
+(
+	void
+)
+{
+
+#if defined(__x86_64__) || defined(__i386__)
+	struct timespec		tsStartTimeSpec;
+	struct timespec		tsEndTimeSpec;
+	struct timespec		tsSleepTimeSpec = {0, 10000000};
+	unsigned long long	ullStartTicks = 0;
+	unsigned long long	ullEndTicks = 0;
+	double				dNanoseconds = 0;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &tsStartTimeSpec);
+	ullStartTicks = ullNumGetTicks();
+
+	nanosleep(&tsSleepTimeSpec, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &tsEndTimeSpec);
+	ullEndTicks = ullNumGetTicks();
+
+	dNanoseconds = ((double)(tsEndTimeSpec.tv_sec - tsStartTimeSpec.tv_sec) * 1000000000) + (double)(tsEndTimeSpec.tv_nsec - tsStartTimeSpec.tv_nsec);
+
+	if ( ullEndTicks > ullStartTicks ) {
+		dNumTickNanosecondsGlobal = dNanoseconds / (double)(ullEndTicks - ullStartTicks);
+	}
+#endif	/* defined(__x86_64__) || defined(__i386__) */
+
+	return;
+
+}
+
+
+/*
+
+	Function:	iNumGetTickNanoseconds()
+
+	Purpose:	Gets the length of a tick from ullNumGetTicks() in
+				nanoseconds, the first call takes about 10ms.
+
+	Parameters:	pdNanoseconds		return pointer for the tick length
+
+	Global Variables:	tpoNumTickOnceGlobal, dNumTickNanosecondsGlobal
+
+	Returns:	NUM error code
+
+*/
+int iNumGetTickNanoseconds
+(
+	double *pdNanoseconds
+)
+{
+
+	/* Check the parameters */
+	if ( pdNanoseconds == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	pthread_once(&tpoNumTickOnceGlobal, vNumTickCalibrate);
+
+	*pdNanoseconds = dNumTickNanosecondsGlobal;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage functions (quad decode) ===
+** ==============================================
+*/
+
+
+/* Bulk quad decoders, 1 to NUM_QUAD_DECODE_UNROLL_MAX quads are decoded per
+** iteration. The headers of the quads in an iteration are walked first, each
+** is one table lookup from the one before it, so the value loads of all the
+** quads can issue together rather than each quad waiting on the one before.
+*/
+
+
+/* Macro to check that a quad starts and ends before the end of the data, the
+** value loads past the end of the quad stay in the padding after the data
+*/
+#define NUM_QUAD_PAST_END(pvsMacroSizes, pucMacroQuad, pucMacroDataEnd) \
+	(((pucMacroQuad) >= (pucMacroDataEnd)) || ((pvsMacroSizes)[(pucMacroQuad)[0]].ucLength > ((pucMacroDataEnd) - (pucMacroQuad))))
+
+
+/* Macro to define a bulk quad decoder for a format and an unroll factor,
+** the inner loops have a constant trip count and are unrolled by the compiler.
+** A bounded decoder checks each quad against the end of the data before
+** reading it and returns NULL if one runs past it, an unbounded decoder
+** trusts the data and ignores pucDataEnd
+*/
+#define NUM_DEFINE_QUAD_DECODER(pucMacroFunction, tMacroSize, pvsMacroSizes, puiMacroMasks, uiMacroHeaderSize, uiMacroUnroll, bMacroBounded) \
+	static unsigned char *pucMacroFunction(unsigned char *pucData, unsigned char *pucDataEnd, unsigned int uiQuadCount, unsigned int *puiValues)	\
+	{	\
+		const tMacroSize	*ppvsMacroSizes[uiMacroUnroll];	\
+		unsigned char		*ppucMacroQuads[uiMacroUnroll];	\
+		unsigned int		uiMacroValue = 0;	\
+		unsigned int		uiMacroI = 0;	\
+\
+		for ( ; uiQuadCount >= (uiMacroUnroll); uiQuadCount -= (uiMacroUnroll), puiValues += (4 * (uiMacroUnroll)) ) {	\
+\
+			/* Walk the headers, the next iteration can start as soon as the last one is known */	\
+			ppucMacroQuads[0] = pucData;	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, ppucMacroQuads[0], pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			ppvsMacroSizes[0] = pvsMacroSizes + pucData[0];	\
+			for ( uiMacroI = 1; uiMacroI < (uiMacroUnroll); uiMacroI++ ) {	\
+				ppucMacroQuads[uiMacroI] = ppucMacroQuads[uiMacroI - 1] + ppvsMacroSizes[uiMacroI - 1]->ucLength;	\
+				if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, ppucMacroQuads[uiMacroI], pucDataEnd) ) {	\
+					return (NULL);	\
+				}	\
+				ppvsMacroSizes[uiMacroI] = pvsMacroSizes + ppucMacroQuads[uiMacroI][0];	\
+			}	\
+			pucData = ppucMacroQuads[(uiMacroUnroll) - 1] + ppvsMacroSizes[(uiMacroUnroll) - 1]->ucLength;	\
+\
+			/* Load the values */	\
+			for ( uiMacroI = 0; uiMacroI < (uiMacroUnroll); uiMacroI++ ) {	\
+				memcpy(&uiMacroValue, ppucMacroQuads[uiMacroI] + (uiMacroHeaderSize), sizeof(unsigned int));	\
+				puiValues[(uiMacroI * 4)] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[uiMacroI]->ucSize1];	\
+				memcpy(&uiMacroValue, ppucMacroQuads[uiMacroI] + ppvsMacroSizes[uiMacroI]->ucOffset2, sizeof(unsigned int));	\
+				puiValues[(uiMacroI * 4) + 1] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[uiMacroI]->ucSize2];	\
+				memcpy(&uiMacroValue, ppucMacroQuads[uiMacroI] + ppvsMacroSizes[uiMacroI]->ucOffset3, sizeof(unsigned int));	\
+				puiValues[(uiMacroI * 4) + 2] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[uiMacroI]->ucSize3];	\
+				memcpy(&uiMacroValue, ppucMacroQuads[uiMacroI] + ppvsMacroSizes[uiMacroI]->ucOffset4, sizeof(unsigned int));	\
+				puiValues[(uiMacroI * 4) + 3] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[uiMacroI]->ucSize4];	\
+			}	\
+		}	\
+\
+		/* Decode the remaining quads one at a time */	\
+		for ( ; uiQuadCount > 0; uiQuadCount--, puiValues += 4 ) {	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucData, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			ppvsMacroSizes[0] = pvsMacroSizes + pucData[0];	\
+			memcpy(&uiMacroValue, pucData + (uiMacroHeaderSize), sizeof(unsigned int));	\
+			puiValues[0] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[0]->ucSize1];	\
+			memcpy(&uiMacroValue, pucData + ppvsMacroSizes[0]->ucOffset2, sizeof(unsigned int));	\
+			puiValues[1] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[0]->ucSize2];	\
+			memcpy(&uiMacroValue, pucData + ppvsMacroSizes[0]->ucOffset3, sizeof(unsigned int));	\
+			puiValues[2] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[0]->ucSize3];	\
+			memcpy(&uiMacroValue, pucData + ppvsMacroSizes[0]->ucOffset4, sizeof(unsigned int));	\
+			puiValues[3] = uiMacroValue & puiMacroMasks[ppvsMacroSizes[0]->ucSize4];	\
+			pucData += ppvsMacroSizes[0]->ucLength;	\
+		}	\
+\
+		return (pucData);	\
+	}
+
+
+/* Bulk quad decoders */
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeVarintQuads1, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, 1, false)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeVarintQuads2, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, 2, false)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeVarintQuads3, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, 3, false)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeVarintQuads4, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, 4, false)
+
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeCompactVarintQuads1, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, 1, false)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeCompactVarintQuads2, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, 2, false)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeCompactVarintQuads3, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, 3, false)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeCompactVarintQuads4, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, 4, false)
+
+
+/* Bounded bulk quad decoders for blocks, which can come from untrusted data */
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeVarintQuadsBounded, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, NUM_QUAD_DECODE_UNROLL_DEFAULT, true)
+NUM_DEFINE_QUAD_DECODER(pucNumDecodeCompactVarintQuadsBounded, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, NUM_QUAD_DECODE_UNROLL_DEFAULT, true)
+
+
+/* Bulk quad decoder type */
+typedef unsigned char *(*pucNumDecodeQuadsFunction)(unsigned char *pucData, unsigned char *pucDataEnd, unsigned int uiQuadCount, unsigned int *puiValues);
+
+
+/* Bulk quad decoders by unroll factor, varint then compact varint */
+static const pucNumDecodeQuadsFunction	ppucNumDecodeVarintQuadsGlobal[NUM_QUAD_DECODE_UNROLL_MAX] =
+		{pucNumDecodeVarintQuads1, pucNumDecodeVarintQuads2, pucNumDecodeVarintQuads3, pucNumDecodeVarintQuads4};
+
+static const pucNumDecodeQuadsFunction	ppucNumDecodeCompactVarintQuadsGlobal[NUM_QUAD_DECODE_UNROLL_MAX] =
+		{pucNumDecodeCompactVarintQuads1, pucNumDecodeCompactVarintQuads2, pucNumDecodeCompactVarintQuads3, pucNumDecodeCompactVarintQuads4};
+
+
+/*
+
+	Function:	pucNumDecodeCompactVarintEscapeQuads()
+
+	Purpose:	Decodes a run of compact varint escape quads. Escapes are
+				rare so the quads are decoded one at a time, only checking
+				for escapes in quads with a 3 byte size.
+
+	Parameters:	pucData				data to decode
+				uiQuadCount			number of quads to decode
+				puiValues			where to decode the integers, holds uiQuadCount * 4 integers
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data decoded
+
+*/
+static unsigned char *pucNumDecodeCompactVarintEscapeQuads
+(
+	unsigned char *pucData,
+	unsigned int uiQuadCount,
+	unsigned int *puiValues
+)
+{
+
+	for ( ; uiQuadCount > 0; uiQuadCount--, puiValues += 4 ) {
+		NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucData);
+	}
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	pucNumReadCompactVarintEscapeQuadBounded()
+
+	Purpose:	Reads a compact varint escape quad that must end before the
+				end of the data. A quad close to the end is read from a zero
+				padded copy so the escapes cannot be read past the end.
+
+	Parameters:	puiValues			where to read the integers, holds 4 integers
+				pucData				data to read
+				pucDataEnd			end of the data
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the quad, NULL if the quad runs past the end of the data
+
+*/
+static unsigned char *pucNumReadCompactVarintEscapeQuadBounded
+(
+	unsigned int *puiValues,
+	unsigned char *pucData,
+	unsigned char *pucDataEnd
+)
+{
+
+	unsigned char	pucQuad[NUM_COMPACT_VARINT_ESCAPE_QUAD_MAX_SIZE + NUM_READ_PADDING_SIZE];
+	unsigned char	*pucQuadPtr = pucQuad;
+
+
+	ASSERT(puiValues != NULL);
+	ASSERT(pucData != NULL);
+	ASSERT(pucDataEnd != NULL);
+
+
+	/* Far enough from the end for the longest quad */
+	if ( (pucDataEnd - pucData) >= NUM_COMPACT_VARINT_ESCAPE_QUAD_MAX_SIZE ) {
+		NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucData);
+		return (pucData);
+	}
+
+	if ( pucData >= pucDataEnd ) {
+		return (NULL);
+	}
+
+	/* Read the copy and check that the quad fits in what was copied */
+	memset(pucQuad, 0, sizeof(pucQuad));
+	memcpy(pucQuad, pucData, pucDataEnd - pucData);
+
+	NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucQuadPtr);
+
+	if ( (pucQuadPtr - pucQuad) > (pucDataEnd - pucData) ) {
+		return (NULL);
+	}
+
+	return (pucData + (pucQuadPtr - pucQuad));
+
+}
+
+
+/*
+
+	Function:	iNumDecodeQuads()
+
+	Purpose:	Decodes a run of varint or compact varint quads, uiUnroll
+				quads at a time, or compact varint escape quads. The data
+				must be followed by at least NUM_READ_PADDING_SIZE readable
+				bytes.
+
+	Parameters:	uiFormat			format, a quad format
+				uiUnroll			quads decoded per iteration, 0 for the default
+				pucData				data to decode
+				uiQuadCount			number of quads to decode
+				puiValues			where to decode the integers, holds uiQuadCount * 4 integers
+				ppucDataEnd			return pointer for the end of the data decoded (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumDecodeQuads
+(
+	unsigned int uiFormat,
+	unsigned int uiUnroll,
+	unsigned char *pucData,
+	unsigned int uiQuadCount,
+	unsigned int *puiValues,
+	unsigned char **ppucDataEnd
+)
+{
+
+	unsigned char	*pucDataEnd = NULL;
+
+
+	/* Check the parameters */
+	if ( (uiFormat != NUM_FORMAT_VARINT_QUAD) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiUnroll > NUM_QUAD_DECODE_UNROLL_MAX ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ((pucData == NULL) || (puiValues == NULL)) && (uiQuadCount > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Set the defaults */
+	if ( uiUnroll == 0 ) {
+		uiUnroll = NUM_QUAD_DECODE_UNROLL_DEFAULT;
+	}
+
+
+	/* Decode the quads */
+	if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		pucDataEnd = ppucNumDecodeVarintQuadsGlobal[uiUnroll - 1](pucData, NULL, uiQuadCount, puiValues);
+	}
+	else if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		pucDataEnd = ppucNumDecodeCompactVarintQuadsGlobal[uiUnroll - 1](pucData, NULL, uiQuadCount, puiValues);
+	}
+	else {
+		pucDataEnd = pucNumDecodeCompactVarintEscapeQuads(pucData, uiQuadCount, puiValues);
+	}
+
+	if ( ppucDataEnd != NULL ) {
+		*ppucDataEnd = pucDataEnd;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===============================================
+** === Number storage functions (varint octet) ===
+** ===============================================
+*/
+
+
+/* A run of varint octets holds the integers eight at a time, the tail of
+** fewer than eight integers is stored as a varint quad followed by a varint
+** trio or pair, the last pair is padded with a zero if there is one integer
+** left over.
+*/
+
+
+/* Use AVX2 to decode varint octets when the processor has it, it is checked
+** for at run time. Each half of the octet is loaded into a lane and shuffled
+** into four integers with the shuffle mask for its quad header
+*/
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NUM_VARINT_OCTET_AVX2
+#endif
+
+
+#if defined(NUM_VARINT_OCTET_AVX2)
+
+/* Shuffle masks for each varint quad header */
+static const unsigned char	pucNumVarintShuffleMasksGlobal[256][16] __attribute__ ((aligned (NUM_CACHE_LINE_SIZE))) =
+{
+	NUM_TABLE_QUAD_HEADERS(NUM_TABLE_QUAD_SHUFFLE_MASK, NUM_VARINT_CODE_SIZE, NUM_VARINT_HEADER_SIZE)
+};
+
+#endif	/* defined(NUM_VARINT_OCTET_AVX2) */
+
+
+/*
+
+	Function:	pucNumDecodeVarintOctetsScalar()
+
+	Purpose:	Decodes a run of varint octets.
+
+	Parameters:	pucData				data to decode
+				uiOctetCount		number of octets to decode
+				puiValues			where to decode the integers, holds uiOctetCount * 8 integers
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data decoded
+
+*/
+static unsigned char *pucNumDecodeVarintOctetsScalar
+(
+	unsigned char *pucData,
+	unsigned int uiOctetCount,
+	unsigned int *puiValues
+)
+{
+
+	for ( ; uiOctetCount > 0; uiOctetCount--, puiValues += 8 ) {
+		NUM_READ_VARINT_OCTET(puiValues, pucData);
+	}
+
+	return (pucData);
+
+}
+
+
+#if defined(NUM_VARINT_OCTET_AVX2)
+/*
+
+	Function:	pucNumDecodeVarintOctetsAvx2()
+
+	Purpose:	Decodes a run of varint octets with AVX2, 16 bytes are
+				loaded from the start of each half of an octet so the last
+				octet is left to the scalar decoder to stay within the data
+				and its padding.
+
+	Parameters:	pucData				data to decode
+				uiOctetCount		number of octets to decode
+				puiValues			where to decode the integers, holds uiOctetCount * 8 integers
+
+	Global Variables:	pucNumVarintShuffleMasksGlobal
+
+	Returns:	a pointer to the end of the data decoded
+
+*/
+__attribute__ ((target ("avx2")))
+static unsigned char *pucNumDecodeVarintOctetsAvx2
+(
+	unsigned char *pucData,
+	unsigned int uiOctetCount,
+	unsigned int *puiValues
+)
+{
+
+	const struct varintSize		*pvsVarintSizesLowPtr = NULL;
+	const struct varintSize		*pvsVarintSizesHighPtr = NULL;
+	__m256i						ymmData;
+	__m256i						ymmMask;
+
+
+	for ( ; uiOctetCount > 1; uiOctetCount--, puiValues += 8 ) {
+
+		pvsVarintSizesLowPtr = pvsVarintSizesGlobal + pucData[0];
+		pvsVarintSizesHighPtr = pvsVarintSizesGlobal + pucData[1];
+
+		/* The low half starts after the header, the high half after the low half */
+		ymmData = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(pucData + NUM_VARINT_OCTET_HEADER_SIZE))),
+				_mm_loadu_si128((__m128i *)(pucData + NUM_VARINT_OCTET_HEADER_SIZE + pvsVarintSizesLowPtr->ucLength - NUM_VARINT_HEADER_SIZE)), 1);
+
+		ymmMask = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_load_si128((__m128i *)pucNumVarintShuffleMasksGlobal[pucData[0]])),
+				_mm_load_si128((__m128i *)pucNumVarintShuffleMasksGlobal[pucData[1]]), 1);
+
+		_mm256_storeu_si256((__m256i *)puiValues, _mm256_shuffle_epi8(ymmData, ymmMask));
+
+		pucData += pvsVarintSizesLowPtr->ucLength + pvsVarintSizesHighPtr->ucLength;
+	}
+
+	return (pucNumDecodeVarintOctetsScalar(pucData, uiOctetCount, puiValues));
+
+}
+#endif	/* defined(NUM_VARINT_OCTET_AVX2) */
+
+
+/*
+
+	Function:	pucNumDecodeVarintOctets()
+
+	Purpose:	Decodes a run of varint octets, using the AVX2 decoder if
+				the processor has it.
+
+	Parameters:	pucData				data to decode
+				uiOctetCount		number of octets to decode
+				puiValues			where to decode the integers, holds uiOctetCount * 8 integers
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data decoded
+
+*/
+static unsigned char *pucNumDecodeVarintOctets
+(
+	unsigned char *pucData,
+	unsigned int uiOctetCount,
+	unsigned int *puiValues
+)
+{
+
+#if defined(NUM_VARINT_OCTET_AVX2)
+	if ( __builtin_cpu_supports("avx2") ) {
+		return (pucNumDecodeVarintOctetsAvx2(pucData, uiOctetCount, puiValues));
+	}
+#endif	/* defined(NUM_VARINT_OCTET_AVX2) */
+
+	return (pucNumDecodeVarintOctetsScalar(pucData, uiOctetCount, puiValues));
+
+}
+
+
+/*
+
+	Function:	iNumEncodeVarintOctets()
+
+	Purpose:	Encodes integers as a run of varint octets. The data must
+				be at least NUM_GET_VARINT_OCTETS_MAX_SIZE() bytes long.
+
+	Parameters:	puiValues			integers to encode
+				uiValuesLength		number of integers to encode
+				pucData				where to encode the integers
+				ppucDataEnd			return pointer for the end of the data encoded
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumEncodeVarintOctets
+(
+	unsigned int *puiValues,
+	unsigned int uiValuesLength,
+	unsigned char *pucData,
+	unsigned char **ppucDataEnd
+)
+{
+
+	unsigned int	uiI = 0;
+
+
+	/* Check the parameters */
+	if ( ((puiValues == NULL) || (pucData == NULL)) && (uiValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppucDataEnd == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Encode the octets */
+	for ( uiI = 0; (uiI + 8) <= uiValuesLength; uiI += 8 ) {
+		NUM_WRITE_VARINT_OCTET(puiValues + uiI, pucData);
+	}
+
+	/* Encode the tail */
+	if ( (uiI + 4) <= uiValuesLength ) {
+		NUM_WRITE_VARINT_QUAD(puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], puiValues[uiI + 3], pucData);
+		uiI += 4;
+	}
+
+	if ( (uiI + 3) == uiValuesLength ) {
+		NUM_WRITE_VARINT_TRIO(puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], pucData);
+	}
+	else if ( (uiI + 2) == uiValuesLength ) {
+		NUM_WRITE_VARINT_PAIR(puiValues[uiI], puiValues[uiI + 1], pucData);
+	}
+	else if ( (uiI + 1) == uiValuesLength ) {
+		NUM_WRITE_VARINT_PAIR(puiValues[uiI], 0, pucData);
+	}
+
+	*ppucDataEnd = pucData;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumDecodeVarintOctets()
+
+	Purpose:	Decodes a run of varint octets. The data must be followed by
+				at least NUM_READ_PADDING_SIZE readable bytes.
+
+	Parameters:	pucData				data to decode
+				uiValuesLength		number of integers to decode
+				puiValues			where to decode the integers, holds uiValuesLength integers
+				ppucDataEnd			return pointer for the end of the data decoded (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumDecodeVarintOctets
+(
+	unsigned char *pucData,
+	unsigned int uiValuesLength,
+	unsigned int *puiValues,
+	unsigned char **ppucDataEnd
+)
+{
+
+	unsigned int	uiI = 0;
+	unsigned int	uiPadding = 0;
+
+
+	/* Check the parameters */
+	if ( ((pucData == NULL) || (puiValues == NULL)) && (uiValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Decode the octets */
+	pucData = pucNumDecodeVarintOctets(pucData, uiValuesLength / 8, puiValues);
+	uiI = uiValuesLength & ~7U;
+
+	/* Decode the tail */
+	if ( (uiI + 4) <= uiValuesLength ) {
+		NUM_READ_VARINT_QUAD(puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], puiValues[uiI + 3], pucData);
+		uiI += 4;
+	}
+
+	if ( (uiI + 3) == uiValuesLength ) {
+		NUM_READ_VARINT_TRIO(puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], pucData);
+	}
+	else if ( (uiI + 2) == uiValuesLength ) {
+		NUM_READ_VARINT_PAIR(puiValues[uiI], puiValues[uiI + 1], pucData);
+	}
+	else if ( (uiI + 1) == uiValuesLength ) {
+		NUM_READ_VARINT_PAIR(puiValues[uiI], uiPadding, pucData);
+	}
+
+	if ( ppucDataEnd != NULL ) {
+		*ppucDataEnd = pucData;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ========================================
+** === Number storage functions (block) ===
+** ========================================
+*/
+
+
+/* A block is a run of integers in a single format, prefixed by the number
+** of integers in the block and the length of the encoded data, both stored
+** as compressed uints. Quad formats pad the last quad with zeros, the
+** padding is not counted in the number of integers.
+**
+** The low bits of the number of integers hold the block width. Fixed width
+** blocks store each integer as 1 or 2 little endian bytes, without padding.
+*/
+
+
+/* Use the SSE4.1 widening loads (pmovzxbd, pmovzxwd) to decode fixed width
+** blocks when the processor has them, they are checked for at run time
+*/
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NUM_BLOCK_FIXED_WIDTH_SSE41
+#endif
+
+
+/* Macro to define a decoder specialized for a fixed width, the width is
+** the size of the type so the loop has no table lookups or branches
+*/
+#define NUM_DEFINE_FIXED_WIDTH_DECODER(vMacroFunction, tMacroType) \
+	static void vMacroFunction(unsigned char *pucData, unsigned int *puiValues, unsigned int uiValuesLength)	\
+	{	\
+		tMacroType		tMacroValue;	\
+		unsigned int	uiMacroI = 0;	\
+\
+		for ( uiMacroI = 0; uiMacroI < uiValuesLength; uiMacroI++, pucData += sizeof(tMacroType) ) {	\
+			memcpy(&tMacroValue, pucData, sizeof(tMacroType));	\
+			puiValues[uiMacroI] = tMacroValue;	\
+		}	\
+	}
+
+
+/* Macro to define an SSE4.1 decoder specialized for a fixed width, 16 bytes
+** are loaded at a time and widened 4 integers at a time, the remainder is
+** left to the scalar decoder
+*/
+#define NUM_DEFINE_FIXED_WIDTH_DECODER_SSE41(vMacroFunction, tMacroType, xmmMacroWiden, vMacroScalarFunction) \
+	__attribute__ ((target ("sse4.1")))	\
+	static void vMacroFunction(unsigned char *pucData, unsigned int *puiValues, unsigned int uiValuesLength)	\
+	{	\
+		__m128i			xmmMacroData;	\
+		unsigned int	uiMacroI = 0;	\
+\
+		for ( uiMacroI = 0; (uiMacroI + (16 / sizeof(tMacroType))) <= uiValuesLength; uiMacroI += (16 / sizeof(tMacroType)), pucData += 16 ) {	\
+			xmmMacroData = _mm_loadu_si128((__m128i *)pucData);	\
+			_mm_storeu_si128((__m128i *)(puiValues + uiMacroI), xmmMacroWiden(xmmMacroData));	\
+			_mm_storeu_si128((__m128i *)(puiValues + uiMacroI + 4), xmmMacroWiden(_mm_srli_si128(xmmMacroData, 4 * sizeof(tMacroType))));	\
+			if ( sizeof(tMacroType) == 1 ) {	\
+				_mm_storeu_si128((__m128i *)(puiValues + uiMacroI + 8), xmmMacroWiden(_mm_srli_si128(xmmMacroData, 8)));	\
+				_mm_storeu_si128((__m128i *)(puiValues + uiMacroI + 12), xmmMacroWiden(_mm_srli_si128(xmmMacroData, 12)));	\
+			}	\
+		}	\
+\
+		vMacroScalarFunction(pucData, puiValues + uiMacroI, uiValuesLength - uiMacroI);	\
+	}
+
+
+/* Fixed width decoders */
+NUM_DEFINE_FIXED_WIDTH_DECODER(vNumBlockDecodeWidth1, unsigned char)
+NUM_DEFINE_FIXED_WIDTH_DECODER(vNumBlockDecodeWidth2, unsigned short)
+
+#if defined(NUM_BLOCK_FIXED_WIDTH_SSE41)
+NUM_DEFINE_FIXED_WIDTH_DECODER_SSE41(vNumBlockDecodeWidth1Sse41, unsigned char, _mm_cvtepu8_epi32, vNumBlockDecodeWidth1)
+NUM_DEFINE_FIXED_WIDTH_DECODER_SSE41(vNumBlockDecodeWidth2Sse41, unsigned short, _mm_cvtepu16_epi32, vNumBlockDecodeWidth2)
+#endif	/* defined(NUM_BLOCK_FIXED_WIDTH_SSE41) */
+
+
+/*
+
+	Function:	iNumReadCompressedUIntBounded()
+
+	Purpose:	Reads a compressed uint without reading past the end of the data,
+				unlike NUM_READ_COMPRESSED_UINT which trusts the data.
+
+	Parameters:	pucData				data to read from
+				uiDataLength		length of the data
+				puiValue			return pointer for the value
+				puiSize				return pointer for the number of bytes read
+
+	Global Variables:	none
+
+	Returns:	NUM_NoError on success, NUM_CorruptDataError if the data is truncated
+
+*/
+static int iNumReadCompressedUIntBounded
+(
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiValue,
+	unsigned int *puiSize
+)
+{
+
+	unsigned int	uiValue = 0;
+	unsigned int	uiSize = 0;
+
+
+	ASSERT(pucData != NULL);
+	ASSERT(puiValue != NULL);
+	ASSERT(puiSize != NULL);
+
+
+	/* Loop over the bytes, bailing if we run out of data or the integer is too long */
+	for ( uiSize = 0; uiSize < uiDataLength; uiSize++ ) {
+
+		if ( uiSize == NUM_COMPRESSED_UINT_MAX_SIZE ) {
+			return (NUM_CorruptDataError);
+		}
+
+		uiValue = (uiValue << NUM_COMPRESSED_DATA_BITS) + (pucData[uiSize] & NUM_COMPRESSED_DATA_MASK);
+
+		if ( (pucData[uiSize] & NUM_COMPRESSED_CONTINUE_BIT) == 0 ) {
+			*puiValue = uiValue;
+			*puiSize = uiSize + 1;
+			return (NUM_NoError);
+		}
+	}
+
+
+	return (NUM_CorruptDataError);
+
+}
+
+
+/*
+
+	Function:	uiNumBlockGetWidth()
+
+	Purpose:	Gets the width to store a block with, a fixed width is used
+				if every integer fits in it and the data is no longer than
+				it would be in the format.
+
+	Parameters:	uiValuesOr			all the integers or'ed together
+				uiIntegerCount		number of integers
+				uiBlockDataLength	length of the data in the format
+
+	Global Variables:	none
+
+	Returns:	the block width
+
+*/
+static unsigned int uiNumBlockGetWidth
+(
+	unsigned int uiValuesOr,
+	unsigned int uiIntegerCount,
+	unsigned int uiBlockDataLength
+)
+{
+
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+
+
+	if ( uiIntegerCount == 0 ) {
+		return (NUM_BLOCK_WIDTH_VARIABLE);
+	}
+
+	if ( uiValuesOr <= 0xFF ) {
+		uiWidth = NUM_BLOCK_WIDTH_1;
+	}
+	else if ( uiValuesOr <= 0xFFFF ) {
+		uiWidth = NUM_BLOCK_WIDTH_2;
+	}
+	else {
+		return (NUM_BLOCK_WIDTH_VARIABLE);
+	}
+
+	return (((uiIntegerCount * uiWidth) <= uiBlockDataLength) ? uiWidth : NUM_BLOCK_WIDTH_VARIABLE);
+
+}
+
+
+/*
+
+	Function:	vNumBlockWriteFixedWidth()
+
+	Purpose:	Writes integers as fixed width little endian integers.
+
+	Parameters:	puiValues			integers
+				uiValuesLength		number of integers
+				uiWidth				block width
+				pucData				where to write the integers
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumBlockWriteFixedWidth
+(
+	unsigned int *puiValues,
+	unsigned int uiValuesLength,
+	unsigned int uiWidth,
+	unsigned char *pucData
+)
+{
+
+	unsigned int	uiI = 0;
+
+
+	ASSERT((uiWidth == NUM_BLOCK_WIDTH_1) || (uiWidth == NUM_BLOCK_WIDTH_2));
+
+	if ( uiWidth == NUM_BLOCK_WIDTH_1 ) {
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			pucData[uiI] = (unsigned char)puiValues[uiI];
+		}
+	}
+	else {
+		for ( uiI = 0; uiI < uiValuesLength; uiI++, pucData += 2 ) {
+			pucData[0] = (unsigned char)puiValues[uiI];
+			pucData[1] = (unsigned char)(puiValues[uiI] >> 8);
+		}
+	}
+
+	return;
+
+}
+
+
+/*
+
+	Function:	vNumBlockDecodeFixedWidth()
+
+	Purpose:	Decodes fixed width integers, using the SSE4.1 decoders if
+				the processor has them.
+
+	Parameters:	pucData				data to decode
+				uiWidth				block width
+				puiValues			where to decode the integers
+				uiValuesLength		number of integers
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumBlockDecodeFixedWidth
+(
+	unsigned char *pucData,
+	unsigned int uiWidth,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength
+)
+{
+
+	ASSERT((uiWidth == NUM_BLOCK_WIDTH_1) || (uiWidth == NUM_BLOCK_WIDTH_2));
+
+#if defined(NUM_BLOCK_FIXED_WIDTH_SSE41)
+	if ( __builtin_cpu_supports("sse4.1") ) {
+		if ( uiWidth == NUM_BLOCK_WIDTH_1 ) {
+			vNumBlockDecodeWidth1Sse41(pucData, puiValues, uiValuesLength);
+		}
+		else {
+			vNumBlockDecodeWidth2Sse41(pucData, puiValues, uiValuesLength);
+		}
+		return;
+	}
+#endif	/* defined(NUM_BLOCK_FIXED_WIDTH_SSE41) */
+
+	if ( uiWidth == NUM_BLOCK_WIDTH_1 ) {
+		vNumBlockDecodeWidth1(pucData, puiValues, uiValuesLength);
+	}
+	else {
+		vNumBlockDecodeWidth2(pucData, puiValues, uiValuesLength);
+	}
+
+	return;
+
+}
+
+
+/*
+
+	Function:	uiNumBlockGetZeroRunLength()
+
+	Purpose:	Gets the length compact varint quads would be with the runs of
+				zero quads suppressed, from their headers.
+
+	Parameters:	pucData				compact varint quads
+				uiQuadCount			number of quads
+
+	Global Variables:	pvsCompactVarintSizesGlobal
+
+	Returns:	the length of the data with the zero runs suppressed
+
+*/
+static unsigned int uiNumBlockGetZeroRunLength
+(
+	unsigned char *pucData,
+	unsigned int uiQuadCount
+)
+{
+
+	unsigned int	uiZeroRunDataLength = 0;
+	unsigned int	uiZeroQuadCount = 0;
+	unsigned int	uiSize = 0;
+	unsigned int	uiI = 0;
+
+
+	for ( uiI = 0; uiI <= uiQuadCount; uiI++ ) {
+
+		/* Extend the run */
+		if ( (uiI < uiQuadCount) && (pucData[0] == 0) ) {
+			uiZeroQuadCount++;
+			pucData += NUM_COMPACT_VARINT_HEADER_SIZE;
+			continue;
+		}
+
+		/* End the run, a header and the number of further zero quads */
+		if ( uiZeroQuadCount > 0 ) {
+			NUM_GET_COMPRESSED_UINT_SIZE(uiZeroQuadCount - 1, uiSize);
+			uiZeroRunDataLength += NUM_COMPACT_VARINT_HEADER_SIZE + uiSize;
+			uiZeroQuadCount = 0;
+		}
+
+		if ( uiI < uiQuadCount ) {
+			uiZeroRunDataLength += pvsCompactVarintSizesGlobal[pucData[0]].ucLength;
+			pucData += pvsCompactVarintSizesGlobal[pucData[0]].ucLength;
+		}
+	}
+
+	return (uiZeroRunDataLength);
+
+}
+
+
+/*
+
+	Function:	pucNumBlockWriteZeroRuns()
+
+	Purpose:	Writes integers as compact varint quads with the runs of zero
+				quads suppressed, the last quad is padded with zeros.
+
+	Parameters:	puiValues			integers, no larger than NUM_COMPACT_VARINT_MAX_VALUE
+				uiValuesLength		number of integers
+				pucData				where to write the data
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data written
+
+*/
+static unsigned char *pucNumBlockWriteZeroRuns
+(
+	unsigned int *puiValues,
+	unsigned int uiValuesLength,
+	unsigned char *pucData
+)
+{
+
+	unsigned int	puiQuadValues[4];
+	unsigned int	uiZeroQuadCount = 0;
+	unsigned int	uiI = 0;
+	unsigned int	uiJ = 0;
+
+
+	for ( uiI = 0; uiI < uiValuesLength; uiI += 4 ) {
+
+		for ( uiJ = 0; uiJ < 4; uiJ++ ) {
+			puiQuadValues[uiJ] = ((uiI + uiJ) < uiValuesLength) ? puiValues[uiI + uiJ] : 0;
+		}
+
+		/* Extend the run */
+		if ( (puiQuadValues[0] | puiQuadValues[1] | puiQuadValues[2] | puiQuadValues[3]) == 0 ) {
+			uiZeroQuadCount++;
+			continue;
+		}
+
+		/* End the run */
+		if ( uiZeroQuadCount > 0 ) {
+			*pucData++ = 0;
+			NUM_WRITE_COMPRESSED_UINT(uiZeroQuadCount - 1, pucData);
+			uiZeroQuadCount = 0;
+		}
+
+		NUM_WRITE_COMPACT_VARINT_QUAD(puiQuadValues[0], puiQuadValues[1], puiQuadValues[2], puiQuadValues[3], pucData);
+	}
+
+	if ( uiZeroQuadCount > 0 ) {
+		*pucData++ = 0;
+		NUM_WRITE_COMPRESSED_UINT(uiZeroQuadCount - 1, pucData);
+	}
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	pucNumBlockDecodeZeroRuns()
+
+	Purpose:	Decodes compact varint quads with the runs of zero quads
+				suppressed, the runs are filled with memset() which uses
+				the widest stores the processor has. The values array must
+				be able to hold NUM_GET_BLOCK_DECODE_COUNT() integers and
+				the data must be padded.
+
+	Parameters:	pucData				data to decode
+				pucDataEnd			end of the data
+				puiValues			where to decode the integers
+				uiIntegerCount		number of integers
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data decoded, NULL if the data is corrupt
+
+*/
+static unsigned char *pucNumBlockDecodeZeroRuns
+(
+	unsigned char *pucData,
+	unsigned char *pucDataEnd,
+	unsigned int *puiValues,
+	unsigned int uiIntegerCount
+)
+{
+
+	unsigned int	uiQuadCount = (uiIntegerCount + 3) / 4;
+	unsigned int	uiZeroQuadCount = 0;
+	unsigned int	uiSize = 0;
+	unsigned int	uiI = 0;
+
+
+	for ( uiI = 0; uiI < uiQuadCount; ) {
+
+		if ( pucData >= pucDataEnd ) {
+			return (NULL);
+		}
+
+		/* A run of zero quads, which must not run past the end of the block */
+		if ( pucData[0] == 0 ) {
+
+			pucData += NUM_COMPACT_VARINT_HEADER_SIZE;
+			if ( (iNumReadCompressedUIntBounded(pucData, pucDataEnd - pucData, &uiZeroQuadCount, &uiSize) != NUM_NoError) ||
+					(uiZeroQuadCount >= (uiQuadCount - uiI)) ) {
+				return (NULL);
+			}
+			pucData += uiSize;
+			uiZeroQuadCount++;
+
+			memset(puiValues + (uiI * 4), 0, uiZeroQuadCount * 4 * sizeof(unsigned int));
+			uiI += uiZeroQuadCount;
+		}
+		else {
+			if ( NUM_QUAD_PAST_END(pvsCompactVarintSizesGlobal, pucData, pucDataEnd) ) {
+				return (NULL);
+			}
+			pucData = pucNumReadCompactVarintQuad(puiValues + (uiI * 4), puiValues + (uiI * 4) + 1, puiValues + (uiI * 4) + 2,
+					puiValues + (uiI * 4) + 3, pucData);
+			uiI++;
+		}
+	}
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	uiNumBlockGetZeroRunWidth()
+
+	Purpose:	Gets the width to store a block with, suppressing the zero
+				runs if the data is shorter than with the width chosen.
+
+	Parameters:	uiFormat				format
+				uiWidth					width chosen by uiNumBlockGetWidth()
+				uiIntegerCount			number of integers
+				uiBlockDataLength		length of the data in the format
+				uiZeroRunDataLength		length of the data with the zero runs suppressed
+
+	Global Variables:	none
+
+	Returns:	the block width
+
+*/
+static unsigned int uiNumBlockGetZeroRunWidth
+(
+	unsigned int uiFormat,
+	unsigned int uiWidth,
+	unsigned int uiIntegerCount,
+	unsigned int uiBlockDataLength,
+	unsigned int uiZeroRunDataLength
+)
+{
+
+	if ( uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		return (uiWidth);
+	}
+
+	if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+		uiBlockDataLength = uiIntegerCount * uiWidth;
+	}
+
+	return ((uiZeroRunDataLength < uiBlockDataLength) ? NUM_BLOCK_WIDTH_ZERO_RUN : uiWidth);
+
+}
+
+
+/*
+
+	Function:	pucNumBlockDecodeData()
+
+	Purpose:	Decodes the data of a variable width block, no integer is
+				read past the end of the data. The values array must be able
+				to hold NUM_GET_BLOCK_DECODE_COUNT() integers and the data
+				must be padded.
+
+	Parameters:	uiFormat			format
+				pucData				data to decode
+				pucDataEnd			end of the data
+				puiValues			where to decode the integers
+				uiIntegerCount		number of integers
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data decoded, NULL if the data is corrupt
+
+*/
+static unsigned char *pucNumBlockDecodeData
+(
+	unsigned int uiFormat,
+	unsigned char *pucData,
+	unsigned char *pucDataEnd,
+	unsigned int *puiValues,
+	unsigned int uiIntegerCount
+)
+{
+
+	unsigned int	uiSize = 0;
+	unsigned int	uiI = 0;
+
+
+	if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+		for ( uiI = 0; uiI < uiIntegerCount; uiI++ ) {
+			if ( iNumReadCompressedUIntBounded(pucData, pucDataEnd - pucData, puiValues + uiI, &uiSize) != NUM_NoError ) {
+				return (NULL);
+			}
+			pucData += uiSize;
+		}
+	}
+	else if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		pucData = pucNumDecodeVarintQuadsBounded(pucData, pucDataEnd, (uiIntegerCount + 3) / 4, puiValues);
+	}
+	else if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		pucData = pucNumDecodeCompactVarintQuadsBounded(pucData, pucDataEnd, (uiIntegerCount + 3) / 4, puiValues);
+	}
+	else {
+		for ( uiI = 0; (uiI < uiIntegerCount) && (pucData != NULL); uiI += 4 ) {
+			pucData = pucNumReadCompactVarintEscapeQuadBounded(puiValues + uiI, pucData, pucDataEnd);
+		}
+	}
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	iNumBlockCheckDataLength()
+
+	Purpose:	Checks that the length of the data of a variable width block
+				is within the shortest and the longest data the integers
+				can take in the format, so a corrupt header is rejected
+				before any of the data is read.
+
+	Parameters:	uiFormat				format
+				uiWidth					block width
+				uiIntegerCount			number of integers
+				uiBlockDataLength		length of the encoded data
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumBlockCheckDataLength
+(
+	unsigned int uiFormat,
+	unsigned int uiWidth,
+	unsigned int uiIntegerCount,
+	unsigned int uiBlockDataLength
+)
+{
+
+	unsigned int	uiQuadCount = (uiIntegerCount + 3) / 4;
+	unsigned int	uiMinLength = 0;
+	unsigned int	uiMaxLength = 0;
+
+
+	/* The length of fixed width data was checked with the header */
+	if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+		return (NUM_NoError);
+	}
+
+	if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+		uiMinLength = uiIntegerCount;
+		uiMaxLength = uiIntegerCount * NUM_COMPRESSED_UINT_MAX_SIZE;
+	}
+	else if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		uiMinLength = uiQuadCount * (NUM_VARINT_HEADER_SIZE + 4);
+		uiMaxLength = uiQuadCount * (NUM_VARINT_HEADER_SIZE + (4 * sizeof(unsigned int)));
+	}
+	else if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		uiMinLength = uiQuadCount * NUM_COMPACT_VARINT_HEADER_SIZE;
+		uiMaxLength = uiQuadCount * (NUM_COMPACT_VARINT_HEADER_SIZE + (4 * 3));
+	}
+	else {
+		uiMinLength = uiQuadCount * NUM_COMPACT_VARINT_HEADER_SIZE;
+		uiMaxLength = uiQuadCount * NUM_COMPACT_VARINT_ESCAPE_QUAD_MAX_SIZE;
+	}
+
+	/* A zero run is at least a header and a compressed uint, a single zero run can cover the block */
+	if ( uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN ) {
+		uiMinLength = (uiQuadCount > 0) ? (NUM_COMPACT_VARINT_HEADER_SIZE + 1) : 0;
+	}
+
+	if ( (uiBlockDataLength < uiMinLength) || (uiBlockDataLength > uiMaxLength) ) {
+		return (NUM_CorruptDataError);
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumBlockReadHeader()
+
+	Purpose:	Reads a block header.
+
+	Parameters:	pucData					data to read from
+				uiDataLength			length of the data
+				puiIntegerCount			return pointer for the number of integers in the block
+				puiWidth				return pointer for the block width
+				puiBlockDataLength		return pointer for the length of the encoded data
+				puiHeaderLength			return pointer for the length of the header
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockReadHeader
+(
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiIntegerCount,
+	unsigned int *puiWidth,
+	unsigned int *puiBlockDataLength,
+	unsigned int *puiHeaderLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned int	uiIntegerCountWidth = 0;
+	unsigned int	uiSize1 = 0;
+	unsigned int	uiSize2 = 0;
+
+
+	/* Check the parameters */
+	if ( pucData == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiIntegerCount == NULL) || (puiWidth == NULL) || (puiBlockDataLength == NULL) || (puiHeaderLength == NULL) ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Read the integer count and width, and the data length */
+	if ( (iError = iNumReadCompressedUIntBounded(pucData, uiDataLength, &uiIntegerCountWidth, &uiSize1)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	*puiIntegerCount = uiIntegerCountWidth >> NUM_BLOCK_WIDTH_BITS;
+	*puiWidth = uiIntegerCountWidth & NUM_BLOCK_WIDTH_MASK;
+
+	if ( (iError = iNumReadCompressedUIntBounded(pucData + uiSize1, uiDataLength - uiSize1, puiBlockDataLength, &uiSize2)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( *puiIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( (NUM_BLOCK_WIDTH_FIXED(*puiWidth) == true) && (*puiBlockDataLength != (*puiIntegerCount * *puiWidth)) ) {
+		return (NUM_CorruptDataError);
+	}
+
+	*puiHeaderLength = uiSize1 + uiSize2;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumBlockWrite()
+
+	Purpose:	Writes a block header and the encoded data. The encoded data
+				may already be located at the end of the header, in which
+				case it is moved up to abut the header.
+
+	Parameters:	uiIntegerCount			number of integers in the block
+				uiWidth					block width
+				pucBlockData			encoded data
+				uiBlockDataLength		length of the encoded data
+				pucData					where to write the block
+				puiDataLength			return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumBlockWrite
+(
+	unsigned int uiIntegerCount,
+	unsigned int uiWidth,
+	unsigned char *pucBlockData,
+	unsigned int uiBlockDataLength,
+	unsigned char *pucData,
+	unsigned int *puiDataLength
+)
+{
+
+	unsigned char	*pucDataPtr = pucData;
+
+
+	ASSERT(uiIntegerCount <= NUM_BLOCK_INTEGER_COUNT_MAX);
+	ASSERT(uiWidth <= NUM_BLOCK_WIDTH_ZERO_RUN);
+	ASSERT(pucBlockData != NULL);
+	ASSERT(pucData != NULL);
+	ASSERT(puiDataLength != NULL);
+
+
+	/* Write the header */
+	NUM_WRITE_COMPRESSED_UINT((uiIntegerCount << NUM_BLOCK_WIDTH_BITS) | uiWidth, pucDataPtr);
+	NUM_WRITE_COMPRESSED_UINT(uiBlockDataLength, pucDataPtr);
+
+	/* Move the data in after the header */
+	if ( pucDataPtr != pucBlockData ) {
+		memmove(pucDataPtr, pucBlockData, uiBlockDataLength);
+	}
+
+	*puiDataLength = (pucDataPtr - pucData) + uiBlockDataLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumBlockGetLength()
+
+	Purpose:	Gets the length of the block iNumBlockEncode() would
+				produce for a run of integers, without encoding them.
+
+	Parameters:	uiFormat			format
+				puiValues			integers
+				uiValuesLength		number of integers
+				puiDataLength		return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockGetLength
+(
+	unsigned int uiFormat,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength,
+	unsigned int *puiDataLength
+)
+{
+
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiZeroRunDataLength = 0;
+	unsigned int	uiZeroQuadCount = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiValuesOr = 0;
+	unsigned int	uiSize = 0;
+	unsigned int	uiRunSize = 0;
+	unsigned int	uiI = 0;
+	unsigned int	uiValue1 = 0;
+	unsigned int	uiValue2 = 0;
+	unsigned int	uiValue3 = 0;
+	unsigned int	uiValue4 = 0;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ((puiValues == NULL) && (uiValuesLength > 0)) || (uiValuesLength > NUM_BLOCK_INTEGER_COUNT_MAX) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDataLength == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Add up the data length, the last quad is padded with zeros */
+	if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			NUM_GET_COMPRESSED_UINT_SIZE(puiValues[uiI], uiSize);
+			uiBlockDataLength += uiSize;
+			uiValuesOr |= puiValues[uiI];
+		}
+	}
+	else {
+		for ( uiI = 0; uiI < uiValuesLength; uiI += 4 ) {
+
+			uiValue1 = puiValues[uiI];
+			uiValue2 = ((uiI + 1) < uiValuesLength) ? puiValues[uiI + 1] : 0;
+			uiValue3 = ((uiI + 2) < uiValuesLength) ? puiValues[uiI + 2] : 0;
+			uiValue4 = ((uiI + 3) < uiValuesLength) ? puiValues[uiI + 3] : 0;
+
+			if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+				NUM_GET_VARINT_QUAD_SIZE(uiValue1, uiValue2, uiValue3, uiValue4, uiSize);
+			}
+			else if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD ) {
+				NUM_GET_COMPACT_VARINT_ESCAPE_QUAD_SIZE(uiValue1, uiValue2, uiValue3, uiValue4, uiSize);
+			}
+			else {
+				if ( (uiValue1 > NUM_COMPACT_VARINT_MAX_VALUE) || (uiValue2 > NUM_COMPACT_VARINT_MAX_VALUE) ||
+						(uiValue3 > NUM_COMPACT_VARINT_MAX_VALUE) || (uiValue4 > NUM_COMPACT_VARINT_MAX_VALUE) ) {
+					return (NUM_ValueOverflowError);
+				}
+				NUM_GET_COMPACT_VARINT_QUAD_SIZE(uiValue1, uiValue2, uiValue3, uiValue4, uiSize);
+
+				/* Add up the length with the zero runs suppressed as well */
+				if ( (uiValue1 | uiValue2 | uiValue3 | uiValue4) == 0 ) {
+					uiZeroQuadCount++;
+				}
+				else {
+					if ( uiZeroQuadCount > 0 ) {
+						NUM_GET_COMPRESSED_UINT_SIZE(uiZeroQuadCount - 1, uiRunSize);
+						uiZeroRunDataLength += NUM_COMPACT_VARINT_HEADER_SIZE + uiRunSize;
+						uiZeroQuadCount = 0;
+					}
+					uiZeroRunDataLength += uiSize;
+				}
+			}
+
+			uiBlockDataLength += uiSize;
+			uiValuesOr |= uiValue1 | uiValue2 | uiValue3 | uiValue4;
+		}
+	}
+
+	/* End the last zero run */
+	if ( uiZeroQuadCount > 0 ) {
+		NUM_GET_COMPRESSED_UINT_SIZE(uiZeroQuadCount - 1, uiRunSize);
+		uiZeroRunDataLength += NUM_COMPACT_VARINT_HEADER_SIZE + uiRunSize;
+	}
+
+	/* Use a fixed width if we can, or suppress the zero runs */
+	uiWidth = uiNumBlockGetWidth(uiValuesOr, uiValuesLength, uiBlockDataLength);
+	uiWidth = uiNumBlockGetZeroRunWidth(uiFormat, uiWidth, uiValuesLength, uiBlockDataLength, uiZeroRunDataLength);
+
+	if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+		uiBlockDataLength = uiValuesLength * uiWidth;
+	}
+	else if ( uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN ) {
+		uiBlockDataLength = uiZeroRunDataLength;
+	}
+
+
+	/* Add the header */
+	NUM_GET_COMPRESSED_UINT_SIZE((uiValuesLength << NUM_BLOCK_WIDTH_BITS) | uiWidth, uiSize);
+	*puiDataLength = uiSize + uiBlockDataLength;
+
+	NUM_GET_COMPRESSED_UINT_SIZE(uiBlockDataLength, uiSize);
+	*puiDataLength += uiSize;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumBlockEncode()
+
+	Purpose:	Encodes integers into a block. The data must be at least
+				NUM_GET_BLOCK_MAX_SIZE() bytes long.
+
+	Parameters:	uiFormat			format
+				puiValues			integers to encode
+				uiValuesLength		number of integers to encode
+				pucData				where to write the block
+				puiDataLength		return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockEncode
+(
+	unsigned int uiFormat,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength,
+	unsigned char *pucData,
+	unsigned int *puiDataLength
+)
+{
+
+	unsigned char	*pucBlockData = NULL;
+	unsigned char	*pucDataPtr = NULL;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiValuesOr = 0;
+	unsigned int	uiI = 0;
+	unsigned int	uiValue1 = 0;
+	unsigned int	uiValue2 = 0;
+	unsigned int	uiValue3 = 0;
+	unsigned int	uiValue4 = 0;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiValues == NULL) && (uiValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiValuesLength > NUM_BLOCK_INTEGER_COUNT_MAX ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pucData == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDataLength == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Check that the values fit in a compact varint */
+	for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+		uiValuesOr |= puiValues[uiI];
+	}
+
+	if ( (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (uiValuesOr > NUM_COMPACT_VARINT_MAX_VALUE) ) {
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			if ( puiValues[uiI] > NUM_COMPACT_VARINT_MAX_VALUE ) {
+				return (NUM_ValueOverflowError);
+			}
+		}
+	}
+
+
+	/* Encode the data after the space reserved for the header */
+	pucBlockData = pucData + NUM_BLOCK_HEADER_MAX_SIZE;
+	pucDataPtr = pucBlockData;
+
+	if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			NUM_WRITE_COMPRESSED_UINT(puiValues[uiI], pucDataPtr);
+		}
+	}
+	else {
+		for ( uiI = 0; (uiI + 4) <= uiValuesLength; uiI += 4 ) {
+			NUM_WRITE_QUAD(uiFormat, puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], puiValues[uiI + 3], pucDataPtr);
+		}
+
+		/* Pad the last quad with zeros */
+		if ( uiI < uiValuesLength ) {
+			uiValue1 = puiValues[uiI];
+			uiValue2 = ((uiI + 1) < uiValuesLength) ? puiValues[uiI + 1] : 0;
+			uiValue3 = ((uiI + 2) < uiValuesLength) ? puiValues[uiI + 2] : 0;
+			uiValue4 = 0;
+			NUM_WRITE_QUAD(uiFormat, uiValue1, uiValue2, uiValue3, uiValue4, pucDataPtr);
+		}
+	}
+
+	/* Replace the data with fixed width integers if they are no longer, or suppress the zero runs if that is shorter still */
+	uiWidth = uiNumBlockGetWidth(uiValuesOr, uiValuesLength, pucDataPtr - pucBlockData);
+	if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		uiWidth = uiNumBlockGetZeroRunWidth(uiFormat, uiWidth, uiValuesLength, pucDataPtr - pucBlockData,
+				uiNumBlockGetZeroRunLength(pucBlockData, (uiValuesLength + 3) / 4));
+	}
+
+	if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+		vNumBlockWriteFixedWidth(puiValues, uiValuesLength, uiWidth, pucBlockData);
+		pucDataPtr = pucBlockData + (uiValuesLength * uiWidth);
+	}
+	else if ( uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN ) {
+		pucDataPtr = pucNumBlockWriteZeroRuns(puiValues, uiValuesLength, pucBlockData);
+	}
+
+
+	/* Write the block */
+	return (iNumBlockWrite(uiValuesLength, uiWidth, pucBlockData, pucDataPtr - pucBlockData, pucData, puiDataLength));
+
+}
+
+
+/*
+
+	Function:	iNumBlockDecode()
+
+	Purpose:	Decodes a block. The values array must be able to hold
+				NUM_GET_BLOCK_DECODE_COUNT() integers and the data must be
+				followed by NUM_READ_PADDING_SIZE readable bytes.
+
+	Parameters:	uiFormat			format
+				pucData				block to decode
+				uiDataLength		length of the data
+				puiValues			where to decode the integers
+				uiValuesCapacity	number of integers the values array can hold
+				puiValuesLength		return pointer for the number of integers decoded
+				puiBlockLength		return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockDecode
+(
+	unsigned int uiFormat,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiValues,
+	unsigned int uiValuesCapacity,
+	unsigned int *puiValuesLength,
+	unsigned int *puiBlockLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned char	*pucDataPtr = NULL;
+	unsigned char	*pucDataEndPtr = NULL;
+	unsigned int	uiIntegerCount = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiDecodeCount = 0;
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiHeaderLength = 0;
+#if defined(NUM_DECODE_LATENCY)
+	unsigned long long	ullStartTicks = ullNumGetTicks();
+	void				*pvNumHistogram = NULL;
+#endif	/* defined(NUM_DECODE_LATENCY) */
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pucData == NULL) || (puiValues == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiValuesLength == NULL) || (puiBlockLength == NULL) ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Read the header */
+	if ( (iError = iNumBlockReadHeader(pucData, uiDataLength, &uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (uiHeaderLength + uiBlockDataLength) > uiDataLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( (iError = iNumBlockCheckDataLength(uiFormat, uiWidth, uiIntegerCount, uiBlockDataLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	NUM_GET_BLOCK_DECODE_COUNT(uiIntegerCount, uiDecodeCount);
+	if ( uiDecodeCount > uiValuesCapacity ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Decode the data, no integer is read past the end of the data */
+	pucDataPtr = pucData + uiHeaderLength;
+	pucDataEndPtr = pucDataPtr + uiBlockDataLength;
+
+	if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+		vNumBlockDecodeFixedWidth(pucDataPtr, uiWidth, puiValues, uiIntegerCount);
+	}
+	else if ( uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN ) {
+		if ( (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) || (pucNumBlockDecodeZeroRuns(pucDataPtr, pucDataEndPtr, puiValues, uiIntegerCount) != pucDataEndPtr) ) {
+			return (NUM_CorruptDataError);
+		}
+	}
+	else if ( pucNumBlockDecodeData(uiFormat, pucDataPtr, pucDataEndPtr, puiValues, uiIntegerCount) != pucDataEndPtr ) {
+		return (NUM_CorruptDataError);
+	}
+
+	*puiValuesLength = uiIntegerCount;
+	*puiBlockLength = uiHeaderLength + uiBlockDataLength;
+
+
+#if defined(NUM_DECODE_LATENCY)
+	/* Record the latency in the histogram of the thread */
+	if ( iNumHistogramGetThread(&pvNumHistogram) == NUM_NoError ) {
+		iNumHistogramRecord(pvNumHistogram, ullNumGetTicks() - ullStartTicks);
+	}
+#endif	/* defined(NUM_DECODE_LATENCY) */
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ============================================
+** === Number storage functions (aggregate) ===
+** ============================================
+*/
+
+
+/* The aggregate kernels compute the sum, the smallest and largest integers
+** and the number of integers in a range as they decode, the integers are
+** never stored so a scan only reads the encoded data once. The quad kernels
+** walk the headers two quads at a time like the bulk quad decoders.
+*/
+
+
+/* Macro to read the integers of a quad whose sizes have been looked up
+** from its header
+*/
+#define NUM_READ_QUAD_VALUES(pvsMacroSize, puiMacroMasks, uiMacroHeaderSize, pucMacroData, puiMacroValues) \
+	{	\
+		memcpy(&(puiMacroValues)[0], (pucMacroData) + (uiMacroHeaderSize), sizeof(unsigned int));	\
+		memcpy(&(puiMacroValues)[1], (pucMacroData) + (pvsMacroSize)->ucOffset2, sizeof(unsigned int));	\
+		memcpy(&(puiMacroValues)[2], (pucMacroData) + (pvsMacroSize)->ucOffset3, sizeof(unsigned int));	\
+		memcpy(&(puiMacroValues)[3], (pucMacroData) + (pvsMacroSize)->ucOffset4, sizeof(unsigned int));	\
+		(puiMacroValues)[0] &= (puiMacroMasks)[(pvsMacroSize)->ucSize1];	\
+		(puiMacroValues)[1] &= (puiMacroMasks)[(pvsMacroSize)->ucSize2];	\
+		(puiMacroValues)[2] &= (puiMacroMasks)[(pvsMacroSize)->ucSize3];	\
+		(puiMacroValues)[3] &= (puiMacroMasks)[(pvsMacroSize)->ucSize4];	\
+	}
+
+
+/* Macro to add an integer to the aggregate locals, the range check is a
+** single unsigned compare
+*/
+#define NUM_AGGREGATE_VALUE(uiMacroValue) \
+	{	\
+		ullAggregateSum += (uiMacroValue);	\
+		uiAggregateMinValue = ((uiMacroValue) < uiAggregateMinValue) ? (uiMacroValue) : uiAggregateMinValue;	\
+		uiAggregateMaxValue = ((uiMacroValue) > uiAggregateMaxValue) ? (uiMacroValue) : uiAggregateMaxValue;	\
+		ullAggregateRangeCount += (((uiMacroValue) - uiAggregateRangeMinValue) <= uiAggregateRangeWidth);	\
+	}
+
+
+/* Add whole quads to the aggregate with SSE2, which every x86-64 processor
+** has. The integers are biased by 0x80000000 so the signed compares order
+** them as unsigned, the sums are widened to 64 bits and the range counts
+** the integers outside the range in 32 bit lanes, which can not overflow
+** as a call aggregates fewer than 2^32 integers
+*/
+#if defined(__SSE2__)
+#define NUM_AGGREGATE_SSE2
+#endif
+
+
+#if defined(NUM_AGGREGATE_SSE2)
+
+/* Macro to declare the quad aggregate locals */
+#define NUM_AGGREGATE_QUAD_DECLARE() \
+	__m128i		xmmAggregateZero = _mm_setzero_si128();	\
+	__m128i		xmmAggregateBias = _mm_set1_epi32((int)0x80000000);	\
+	__m128i		xmmAggregateSumLow = _mm_setzero_si128();	\
+	__m128i		xmmAggregateSumHigh = _mm_setzero_si128();	\
+	__m128i		xmmAggregateMinValue = _mm_set1_epi32((int)0x7FFFFFFF);	\
+	__m128i		xmmAggregateMaxValue = _mm_set1_epi32((int)0x80000000);	\
+	__m128i		xmmAggregateRangeMinValue = _mm_set1_epi32((int)uiAggregateRangeMinValue);	\
+	__m128i		xmmAggregateRangeWidth = _mm_set1_epi32((int)(uiAggregateRangeWidth ^ 0x80000000));	\
+	__m128i		xmmAggregateRangeMissCount = _mm_setzero_si128();	\
+	__m128i		xmmAggregateValues;	\
+	__m128i		xmmAggregateMask;	\
+	unsigned int	puiAggregateLanes[4];	\
+	unsigned long long	pullAggregateLanes[2];	\
+	unsigned long long	ullAggregateQuadCount = 0;
+
+/* Macro to add a quad to the quad aggregate locals, the integers are
+** inserted from registers rather than loaded from the stack where they
+** would stall on store forwarding
+*/
+#define NUM_AGGREGATE_QUAD(puiMacroValues) \
+	{	\
+		xmmAggregateValues = _mm_set_epi32((int)(puiMacroValues)[3], (int)(puiMacroValues)[2], (int)(puiMacroValues)[1], (int)(puiMacroValues)[0]);	\
+		xmmAggregateSumLow = _mm_add_epi64(xmmAggregateSumLow, _mm_unpacklo_epi32(xmmAggregateValues, xmmAggregateZero));	\
+		xmmAggregateSumHigh = _mm_add_epi64(xmmAggregateSumHigh, _mm_unpackhi_epi32(xmmAggregateValues, xmmAggregateZero));	\
+		xmmAggregateMask = _mm_sub_epi32(xmmAggregateValues, xmmAggregateRangeMinValue);	\
+		xmmAggregateMask = _mm_cmpgt_epi32(_mm_xor_si128(xmmAggregateMask, xmmAggregateBias), xmmAggregateRangeWidth);	\
+		xmmAggregateRangeMissCount = _mm_sub_epi32(xmmAggregateRangeMissCount, xmmAggregateMask);	\
+		xmmAggregateValues = _mm_xor_si128(xmmAggregateValues, xmmAggregateBias);	\
+		xmmAggregateMask = _mm_cmplt_epi32(xmmAggregateValues, xmmAggregateMinValue);	\
+		xmmAggregateMinValue = _mm_or_si128(_mm_and_si128(xmmAggregateMask, xmmAggregateValues), _mm_andnot_si128(xmmAggregateMask, xmmAggregateMinValue));	\
+		xmmAggregateMask = _mm_cmpgt_epi32(xmmAggregateValues, xmmAggregateMaxValue);	\
+		xmmAggregateMaxValue = _mm_or_si128(_mm_and_si128(xmmAggregateMask, xmmAggregateValues), _mm_andnot_si128(xmmAggregateMask, xmmAggregateMaxValue));	\
+		ullAggregateQuadCount++;	\
+	}
+
+/* Macro to fold the quad aggregate locals into the aggregate locals */
+#define NUM_AGGREGATE_QUAD_REDUCE() \
+	{	\
+		unsigned int	uiMacroLane = 0;	\
+\
+		_mm_storeu_si128((__m128i *)pullAggregateLanes, _mm_add_epi64(xmmAggregateSumLow, xmmAggregateSumHigh));	\
+		ullAggregateSum += pullAggregateLanes[0] + pullAggregateLanes[1];	\
+		_mm_storeu_si128((__m128i *)puiAggregateLanes, xmmAggregateRangeMissCount);	\
+		ullAggregateRangeCount += (ullAggregateQuadCount * 4) - puiAggregateLanes[0] - puiAggregateLanes[1] - puiAggregateLanes[2] - puiAggregateLanes[3];	\
+		if ( ullAggregateQuadCount > 0 ) {	\
+			_mm_storeu_si128((__m128i *)puiAggregateLanes, _mm_xor_si128(xmmAggregateMinValue, xmmAggregateBias));	\
+			for ( uiMacroLane = 0; uiMacroLane < 4; uiMacroLane++ ) {	\
+				uiAggregateMinValue = (puiAggregateLanes[uiMacroLane] < uiAggregateMinValue) ? puiAggregateLanes[uiMacroLane] : uiAggregateMinValue;	\
+			}	\
+			_mm_storeu_si128((__m128i *)puiAggregateLanes, _mm_xor_si128(xmmAggregateMaxValue, xmmAggregateBias));	\
+			for ( uiMacroLane = 0; uiMacroLane < 4; uiMacroLane++ ) {	\
+				uiAggregateMaxValue = (puiAggregateLanes[uiMacroLane] > uiAggregateMaxValue) ? puiAggregateLanes[uiMacroLane] : uiAggregateMaxValue;	\
+			}	\
+		}	\
+	}
+
+#else
+
+#define NUM_AGGREGATE_QUAD_DECLARE()
+
+#define NUM_AGGREGATE_QUAD(puiMacroValues) \
+	{	\
+		NUM_AGGREGATE_VALUE((puiMacroValues)[0]);	\
+		NUM_AGGREGATE_VALUE((puiMacroValues)[1]);	\
+		NUM_AGGREGATE_VALUE((puiMacroValues)[2]);	\
+		NUM_AGGREGATE_VALUE((puiMacroValues)[3]);	\
+	}
+
+#define NUM_AGGREGATE_QUAD_REDUCE()
+
+#endif	/* defined(NUM_AGGREGATE_SSE2) */
+
+
+/* Macro to define an aggregate kernel for a quad format, the last quad can
+** be partial, its padding is not aggregated. A bounded kernel returns NULL
+** if a quad runs past the end of the data like the bulk quad decoders
+*/
+#define NUM_DEFINE_AGGREGATE_QUADS(pucMacroFunction, tMacroSize, pvsMacroSizes, puiMacroMasks, uiMacroHeaderSize, bMacroBounded) \
+	static unsigned char *pucMacroFunction(unsigned char *pucData, unsigned char *pucDataEnd, unsigned int uiIntegerCount, struct numAggregate *pnaNumAggregate)	\
+	{	\
+		const tMacroSize	*pvsMacroSizes1 = NULL;	\
+		const tMacroSize	*pvsMacroSizes2 = NULL;	\
+		unsigned char		*pucMacroQuad2 = NULL;	\
+		unsigned int		puiMacroValues[8];	\
+		unsigned int		uiMacroI = 0;	\
+		unsigned long long	ullAggregateSum = 0;	\
+		unsigned int		uiAggregateMinValue = pnaNumAggregate->uiMinValue;	\
+		unsigned int		uiAggregateMaxValue = pnaNumAggregate->uiMaxValue;	\
+		unsigned int		uiAggregateRangeMinValue = pnaNumAggregate->uiRangeMinValue;	\
+		unsigned int		uiAggregateRangeWidth = pnaNumAggregate->uiRangeMaxValue - pnaNumAggregate->uiRangeMinValue;	\
+		unsigned long long	ullAggregateRangeCount = 0;	\
+		NUM_AGGREGATE_QUAD_DECLARE()	\
+\
+		pnaNumAggregate->ullCount += uiIntegerCount;	\
+\
+		/* Two quads at a time */	\
+		for ( ; uiIntegerCount >= 8; uiIntegerCount -= 8 ) {	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucData, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			pvsMacroSizes1 = pvsMacroSizes + pucData[0];	\
+			pucMacroQuad2 = pucData + pvsMacroSizes1->ucLength;	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucMacroQuad2, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			pvsMacroSizes2 = pvsMacroSizes + pucMacroQuad2[0];	\
+\
+			NUM_READ_QUAD_VALUES(pvsMacroSizes1, puiMacroMasks, uiMacroHeaderSize, pucData, puiMacroValues);	\
+			NUM_READ_QUAD_VALUES(pvsMacroSizes2, puiMacroMasks, uiMacroHeaderSize, pucMacroQuad2, puiMacroValues + 4);	\
+			pucData = pucMacroQuad2 + pvsMacroSizes2->ucLength;	\
+\
+			NUM_AGGREGATE_QUAD(puiMacroValues);	\
+			NUM_AGGREGATE_QUAD(puiMacroValues + 4);	\
+		}	\
+\
+		NUM_AGGREGATE_QUAD_REDUCE();	\
+\
+		/* The remaining quads, one at a time */	\
+		for ( ; uiIntegerCount > 0; uiIntegerCount -= (uiIntegerCount < 4) ? uiIntegerCount : 4 ) {	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucData, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			pvsMacroSizes1 = pvsMacroSizes + pucData[0];	\
+			NUM_READ_QUAD_VALUES(pvsMacroSizes1, puiMacroMasks, uiMacroHeaderSize, pucData, puiMacroValues);	\
+			pucData += pvsMacroSizes1->ucLength;	\
+\
+			for ( uiMacroI = 0; uiMacroI < ((uiIntegerCount < 4) ? uiIntegerCount : 4); uiMacroI++ ) {	\
+				NUM_AGGREGATE_VALUE(puiMacroValues[uiMacroI]);	\
+			}	\
+		}	\
+\
+		pnaNumAggregate->ullSum += ullAggregateSum;	\
+		pnaNumAggregate->uiMinValue = uiAggregateMinValue;	\
+		pnaNumAggregate->uiMaxValue = uiAggregateMaxValue;	\
+		pnaNumAggregate->ullRangeCount += ullAggregateRangeCount;	\
+\
+		return (pucData);	\
+	}
+
+
+/* Aggregate kernels */
+NUM_DEFINE_AGGREGATE_QUADS(pucNumAggregateVarintQuads, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, false)
+NUM_DEFINE_AGGREGATE_QUADS(pucNumAggregateCompactVarintQuads, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, false)
+
+/* Bounded aggregate kernels for blocks */
+NUM_DEFINE_AGGREGATE_QUADS(pucNumAggregateVarintQuadsBounded, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, true)
+NUM_DEFINE_AGGREGATE_QUADS(pucNumAggregateCompactVarintQuadsBounded, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, true)
+
+
+/*
+
+	Function:	pucNumAggregateCompressedUInts()
+
+	Purpose:	Aggregates compressed uints, no integer is read past the
+				end of the data.
+
+	Parameters:	pucData				data to aggregate
+				pucDataEnd			end of the data
+				uiIntegerCount		number of integers
+				pnaNumAggregate		aggregate
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data aggregated, NULL if the data is corrupt
+
+*/
+static unsigned char *pucNumAggregateCompressedUInts
+(
+	unsigned char *pucData,
+	unsigned char *pucDataEnd,
+	unsigned int uiIntegerCount,
+	struct numAggregate *pnaNumAggregate
+)
+{
+
+	unsigned int		uiValue = 0;
+	unsigned int		uiSize = 0;
+	unsigned long long	ullAggregateSum = 0;
+	unsigned int		uiAggregateMinValue = pnaNumAggregate->uiMinValue;
+	unsigned int		uiAggregateMaxValue = pnaNumAggregate->uiMaxValue;
+	unsigned int		uiAggregateRangeMinValue = pnaNumAggregate->uiRangeMinValue;
+	unsigned int		uiAggregateRangeWidth = pnaNumAggregate->uiRangeMaxValue - pnaNumAggregate->uiRangeMinValue;
+	unsigned long long	ullAggregateRangeCount = 0;
+
+
+	pnaNumAggregate->ullCount += uiIntegerCount;
+
+	for ( ; uiIntegerCount > 0; uiIntegerCount-- ) {
+		if ( iNumReadCompressedUIntBounded(pucData, pucDataEnd - pucData, &uiValue, &uiSize) != NUM_NoError ) {
+			return (NULL);
+		}
+		pucData += uiSize;
+		NUM_AGGREGATE_VALUE(uiValue);
+	}
+
+	pnaNumAggregate->ullSum += ullAggregateSum;
+	pnaNumAggregate->uiMinValue = uiAggregateMinValue;
+	pnaNumAggregate->uiMaxValue = uiAggregateMaxValue;
+	pnaNumAggregate->ullRangeCount += ullAggregateRangeCount;
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	pucNumAggregateCompactVarintEscapeQuads()
+
+	Purpose:	Aggregates compact varint escape quads, the last quad can be
+				partial, its padding is not aggregated.
+
+	Parameters:	pucData				data to aggregate
+				pucDataEnd			end of the data, NULL if the quads are not checked against it
+				uiIntegerCount		number of integers
+				pnaNumAggregate		aggregate
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data aggregated, NULL if a quad runs past the end of the data
+
+*/
+static unsigned char *pucNumAggregateCompactVarintEscapeQuads
+(
+	unsigned char *pucData,
+	unsigned char *pucDataEnd,
+	unsigned int uiIntegerCount,
+	struct numAggregate *pnaNumAggregate
+)
+{
+
+	unsigned int		puiValues[4];
+	unsigned int		uiI = 0;
+	unsigned long long	ullAggregateSum = 0;
+	unsigned int		uiAggregateMinValue = pnaNumAggregate->uiMinValue;
+	unsigned int		uiAggregateMaxValue = pnaNumAggregate->uiMaxValue;
+	unsigned int		uiAggregateRangeMinValue = pnaNumAggregate->uiRangeMinValue;
+	unsigned int		uiAggregateRangeWidth = pnaNumAggregate->uiRangeMaxValue - pnaNumAggregate->uiRangeMinValue;
+	unsigned long long	ullAggregateRangeCount = 0;
+
+
+	pnaNumAggregate->ullCount += uiIntegerCount;
+
+	while ( uiIntegerCount > 0 ) {
+
+		if ( pucDataEnd == NULL ) {
+			NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucData);
+		}
+		else if ( (pucData = pucNumReadCompactVarintEscapeQuadBounded(puiValues, pucData, pucDataEnd)) == NULL ) {
+			return (NULL);
+		}
+
+		for ( uiI = 0; (uiI < 4) && (uiIntegerCount > 0); uiI++, uiIntegerCount-- ) {
+			NUM_AGGREGATE_VALUE(puiValues[uiI]);
+		}
+	}
+
+	pnaNumAggregate->ullSum += ullAggregateSum;
+	pnaNumAggregate->uiMinValue = uiAggregateMinValue;
+	pnaNumAggregate->uiMaxValue = uiAggregateMaxValue;
+	pnaNumAggregate->ullRangeCount += ullAggregateRangeCount;
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	pucNumAggregateZeroRuns()
+
+	Purpose:	Aggregates compact varint quads with the runs of zero quads
+				suppressed, a run is added in one step.
+
+	Parameters:	pucData				data to aggregate
+				pucDataEnd			end of the data
+				uiIntegerCount		number of integers
+				pnaNumAggregate		aggregate
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data aggregated, NULL if the data is corrupt
+
+*/
+static unsigned char *pucNumAggregateZeroRuns
+(
+	unsigned char *pucData,
+	unsigned char *pucDataEnd,
+	unsigned int uiIntegerCount,
+	struct numAggregate *pnaNumAggregate
+)
+{
+
+	unsigned int		puiValues[4];
+	unsigned int		uiZeroQuadCount = 0;
+	unsigned int		uiZeroCount = 0;
+	unsigned int		uiSize = 0;
+	unsigned int		uiI = 0;
+	unsigned long long	ullAggregateSum = 0;
+	unsigned int		uiAggregateMinValue = pnaNumAggregate->uiMinValue;
+	unsigned int		uiAggregateMaxValue = pnaNumAggregate->uiMaxValue;
+	unsigned int		uiAggregateRangeMinValue = pnaNumAggregate->uiRangeMinValue;
+	unsigned int		uiAggregateRangeWidth = pnaNumAggregate->uiRangeMaxValue - pnaNumAggregate->uiRangeMinValue;
+	unsigned long long	ullAggregateRangeCount = 0;
+
+
+	pnaNumAggregate->ullCount += uiIntegerCount;
+
+	while ( uiIntegerCount > 0 ) {
+
+		if ( pucData >= pucDataEnd ) {
+			return (NULL);
+		}
+
+		/* A run of zero quads, the padding of the last quad is not counted */
+		if ( pucData[0] == 0 ) {
+
+			pucData += NUM_COMPACT_VARINT_HEADER_SIZE;
+			if ( (iNumReadCompressedUIntBounded(pucData, pucDataEnd - pucData, &uiZeroQuadCount, &uiSize) != NUM_NoError) ||
+					(uiZeroQuadCount >= ((uiIntegerCount + 3) / 4)) ) {
+				return (NULL);
+			}
+			pucData += uiSize;
+
+			uiZeroCount = ((uiZeroQuadCount + 1) * 4 < uiIntegerCount) ? (uiZeroQuadCount + 1) * 4 : uiIntegerCount;
+			uiAggregateMinValue = 0;
+			ullAggregateRangeCount += (uiAggregateRangeMinValue == 0) ? uiZeroCount : 0;
+			uiIntegerCount -= uiZeroCount;
+		}
+		else {
+			if ( NUM_QUAD_PAST_END(pvsCompactVarintSizesGlobal, pucData, pucDataEnd) ) {
+				return (NULL);
+			}
+			NUM_READ_COMPACT_VARINT_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucData);
+
+			for ( uiI = 0; (uiI < 4) && (uiIntegerCount > 0); uiI++, uiIntegerCount-- ) {
+				NUM_AGGREGATE_VALUE(puiValues[uiI]);
+			}
+		}
+	}
+
+	pnaNumAggregate->ullSum += ullAggregateSum;
+	pnaNumAggregate->uiMinValue = uiAggregateMinValue;
+	pnaNumAggregate->uiMaxValue = uiAggregateMaxValue;
+	pnaNumAggregate->ullRangeCount += ullAggregateRangeCount;
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	vNumAggregateFixedWidth()
+
+	Purpose:	Aggregates fixed width integers.
+
+	Parameters:	pucData				data to aggregate
+				uiWidth				block width
+				uiIntegerCount		number of integers
+				pnaNumAggregate		aggregate
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumAggregateFixedWidth
+(
+	unsigned char *pucData,
+	unsigned int uiWidth,
+	unsigned int uiIntegerCount,
+	struct numAggregate *pnaNumAggregate
+)
+{
+
+	unsigned int		uiValue = 0;
+	unsigned int		uiI = 0;
+	unsigned long long	ullAggregateSum = 0;
+	unsigned int		uiAggregateMinValue = pnaNumAggregate->uiMinValue;
+	unsigned int		uiAggregateMaxValue = pnaNumAggregate->uiMaxValue;
+	unsigned int		uiAggregateRangeMinValue = pnaNumAggregate->uiRangeMinValue;
+	unsigned int		uiAggregateRangeWidth = pnaNumAggregate->uiRangeMaxValue - pnaNumAggregate->uiRangeMinValue;
+	unsigned long long	ullAggregateRangeCount = 0;
+
+
+	ASSERT((uiWidth == NUM_BLOCK_WIDTH_1) || (uiWidth == NUM_BLOCK_WIDTH_2));
+
+	pnaNumAggregate->ullCount += uiIntegerCount;
+
+	if ( uiWidth == NUM_BLOCK_WIDTH_1 ) {
+		for ( uiI = 0; uiI < uiIntegerCount; uiI++ ) {
+			uiValue = pucData[uiI];
+			NUM_AGGREGATE_VALUE(uiValue);
+		}
+	}
+	else {
+		for ( uiI = 0; uiI < uiIntegerCount; uiI++, pucData += 2 ) {
+			uiValue = pucData[0] | ((unsigned int)pucData[1] << 8);
+			NUM_AGGREGATE_VALUE(uiValue);
+		}
+	}
+
+	pnaNumAggregate->ullSum += ullAggregateSum;
+	pnaNumAggregate->uiMinValue = uiAggregateMinValue;
+	pnaNumAggregate->uiMaxValue = uiAggregateMaxValue;
+	pnaNumAggregate->ullRangeCount += ullAggregateRangeCount;
+
+	return;
+
+}
+
+
+/*
+
+	Function:	iNumAggregateInit()
+
+	Purpose:	Sets up an aggregate.
+
+	Parameters:	pnaNumAggregate		aggregate
+				uiRangeMinValue		smallest integer in the range counted
+				uiRangeMaxValue		largest integer in the range counted
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumAggregateInit
+(
+	struct numAggregate *pnaNumAggregate,
+	unsigned int uiRangeMinValue,
+	unsigned int uiRangeMaxValue
+)
+{
+
+	/* Check the parameters */
+	if ( pnaNumAggregate == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiRangeMinValue > uiRangeMaxValue ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	memset(pnaNumAggregate, 0, sizeof(struct numAggregate));
+	pnaNumAggregate->uiMinValue = ~0U;
+	pnaNumAggregate->uiRangeMinValue = uiRangeMinValue;
+	pnaNumAggregate->uiRangeMaxValue = uiRangeMaxValue;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumAggregateQuads()
+
+	Purpose:	Aggregates a run of varint, compact varint or compact
+				varint escape quads without storing the integers. The data
+				must be followed by at least NUM_READ_PADDING_SIZE readable
+				bytes.
+
+	Parameters:	uiFormat			format, a quad format
+				pucData				data to aggregate
+				uiIntegerCount		number of integers, the padding of the last quad is skipped
+				pnaNumAggregate		aggregate
+				ppucDataEnd			return pointer for the end of the data aggregated (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumAggregateQuads
+(
+	unsigned int uiFormat,
+	unsigned char *pucData,
+	unsigned int uiIntegerCount,
+	struct numAggregate *pnaNumAggregate,
+	unsigned char **ppucDataEnd
+)
+{
+
+	unsigned char	*pucDataEnd = NULL;
+
+
+	/* Check the parameters */
+	if ( (uiFormat != NUM_FORMAT_VARINT_QUAD) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ((pucData == NULL) && (uiIntegerCount > 0)) || (pnaNumAggregate == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		pucDataEnd = pucNumAggregateVarintQuads(pucData, NULL, uiIntegerCount, pnaNumAggregate);
+	}
+	else if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		pucDataEnd = pucNumAggregateCompactVarintQuads(pucData, NULL, uiIntegerCount, pnaNumAggregate);
+	}
+	else {
+		pucDataEnd = pucNumAggregateCompactVarintEscapeQuads(pucData, NULL, uiIntegerCount, pnaNumAggregate);
+	}
+
+	if ( ppucDataEnd != NULL ) {
+		*ppucDataEnd = pucDataEnd;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumBlockAggregate()
+
+	Purpose:	Aggregates a block without storing the integers. The data
+				must be followed by NUM_READ_PADDING_SIZE readable bytes.
+
+	Parameters:	uiFormat			format
+				pucData				block to aggregate
+				uiDataLength		length of the data
+				pnaNumAggregate		aggregate
+				puiBlockLength		return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockAggregate
+(
+	unsigned int uiFormat,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	struct numAggregate *pnaNumAggregate,
+	unsigned int *puiBlockLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned char	*pucDataPtr = NULL;
+	unsigned char	*pucDataEndPtr = NULL;
+	unsigned int	uiIntegerCount = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiHeaderLength = 0;
+	struct numAggregate	naNumAggregate;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pucData == NULL) || (pnaNumAggregate == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiBlockLength == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Read the header */
+	if ( (iError = iNumBlockReadHeader(pucData, uiDataLength, &uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (uiHeaderLength + uiBlockDataLength) > uiDataLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( (iError = iNumBlockCheckDataLength(uiFormat, uiWidth, uiIntegerCount, uiBlockDataLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+
+	/* Aggregate into a copy so the aggregate is left alone if the block is corrupt, no integer is read past the end of the data */
+	naNumAggregate = *pnaNumAggregate;
+
+	pucDataPtr = pucData + uiHeaderLength;
+	pucDataEndPtr = pucDataPtr + uiBlockDataLength;
+
+	if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+		vNumAggregateFixedWidth(pucDataPtr, uiWidth, uiIntegerCount, &naNumAggregate);
+	}
+	else if ( uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN ) {
+		if ( uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+			return (NUM_CorruptDataError);
+		}
+		pucDataPtr = pucNumAggregateZeroRuns(pucDataPtr, pucDataEndPtr, uiIntegerCount, &naNumAggregate);
+	}
+	else if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+		pucDataPtr = pucNumAggregateCompressedUInts(pucDataPtr, pucDataEndPtr, uiIntegerCount, &naNumAggregate);
+	}
+	else if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		pucDataPtr = pucNumAggregateVarintQuadsBounded(pucDataPtr, pucDataEndPtr, uiIntegerCount, &naNumAggregate);
+	}
+	else if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD ) {
+		pucDataPtr = pucNumAggregateCompactVarintEscapeQuads(pucDataPtr, pucDataEndPtr, uiIntegerCount, &naNumAggregate);
+	}
+	else {
+		pucDataPtr = pucNumAggregateCompactVarintQuadsBounded(pucDataPtr, pucDataEndPtr, uiIntegerCount, &naNumAggregate);
+	}
+
+	if ( (NUM_BLOCK_WIDTH_FIXED(uiWidth) == false) && (pucDataPtr != pucDataEndPtr) ) {
+		return (NUM_CorruptDataError);
+	}
+
+	*pnaNumAggregate = naNumAggregate;
+	*puiBlockLength = uiHeaderLength + uiBlockDataLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =========================================
+** === Number storage functions (filter) ===
+** =========================================
+*/
+
+
+/* The filter kernels select the integers in an inclusive range as they
+** decode, setting a bit for each match in a bitmap, bit 0 of byte 0 being
+** the first integer, and/or writing the position of each match to a list.
+** Two quads are compared at a time, giving one bitmap byte. A 'greater
+** than X' filter is the range X + 1 to 0xFFFFFFFF.
+*/
+
+
+#if defined(NUM_AGGREGATE_SSE2)
+
+/* Macro to get the 4 bit match mask of a quad with SSE2, the integers are
+** inserted from registers like the aggregate kernels
+*/
+#define NUM_FILTER_QUAD_MASK(puiMacroValues, uiMacroRangeMinValue, uiMacroRangeWidth, uiMacroMask) \
+	{	\
+		__m128i		xmmMacroValues;	\
+\
+		xmmMacroValues = _mm_set_epi32((int)(puiMacroValues)[3], (int)(puiMacroValues)[2], (int)(puiMacroValues)[1], (int)(puiMacroValues)[0]);	\
+		xmmMacroValues = _mm_xor_si128(_mm_sub_epi32(xmmMacroValues, _mm_set1_epi32((int)(uiMacroRangeMinValue))), _mm_set1_epi32((int)0x80000000));	\
+		xmmMacroValues = _mm_cmpgt_epi32(xmmMacroValues, _mm_set1_epi32((int)((uiMacroRangeWidth) ^ 0x80000000)));	\
+		(uiMacroMask) = ~(unsigned int)_mm_movemask_ps(_mm_castsi128_ps(xmmMacroValues)) & 0xF;	\
+	}
+
+#else
+
+#define NUM_FILTER_QUAD_MASK(puiMacroValues, uiMacroRangeMinValue, uiMacroRangeWidth, uiMacroMask) \
+	{	\
+		(uiMacroMask) = ((((puiMacroValues)[0] - (uiMacroRangeMinValue)) <= (uiMacroRangeWidth)) << 0) |	\
+				((((puiMacroValues)[1] - (uiMacroRangeMinValue)) <= (uiMacroRangeWidth)) << 1) |	\
+				((((puiMacroValues)[2] - (uiMacroRangeMinValue)) <= (uiMacroRangeWidth)) << 2) |	\
+				((((puiMacroValues)[3] - (uiMacroRangeMinValue)) <= (uiMacroRangeWidth)) << 3);	\
+	}
+
+#endif	/* defined(NUM_AGGREGATE_SSE2) */
+
+
+/* Macro to store the match mask of up to 8 integers, the positions are
+** taken from the lowest set bit up
+*/
+#define NUM_FILTER_STORE_MASK(uiMacroMask, uiMacroPosition, pucMacroBitmap, puiMacroPositions, uiMacroMatchCount) \
+	{	\
+		unsigned int	uiMacroBits = (uiMacroMask);	\
+\
+		if ( (pucMacroBitmap) != NULL ) {	\
+			(pucMacroBitmap)[(uiMacroPosition) / 8] = (unsigned char)uiMacroBits;	\
+		}	\
+\
+		if ( (puiMacroPositions) != NULL ) {	\
+			for ( ; uiMacroBits != 0; uiMacroBits &= uiMacroBits - 1 ) {	\
+				(puiMacroPositions)[(uiMacroMatchCount)++] = (uiMacroPosition) + (unsigned int)__builtin_ctz(uiMacroBits);	\
+			}	\
+		}	\
+		else {	\
+			(uiMacroMatchCount) += (unsigned int)__builtin_popcount(uiMacroBits);	\
+		}	\
+	}
+
+
+/* Macro to define a filter kernel for a quad format, the last quad can be
+** partial, its padding is never selected. A bounded kernel returns NULL if
+** a quad runs past the end of the data like the bulk quad decoders
+*/
+#define NUM_DEFINE_FILTER_QUADS(pucMacroFunction, tMacroSize, pvsMacroSizes, puiMacroMasks, uiMacroHeaderSize, bMacroBounded) \
+	static unsigned char *pucMacroFunction(unsigned char *pucData, unsigned char *pucDataEnd, unsigned int uiIntegerCount, unsigned int uiRangeMinValue,	\
+			unsigned int uiRangeWidth, unsigned char *pucBitmap, unsigned int *puiPositions, unsigned int *puiMatchCount)	\
+	{	\
+		const tMacroSize	*pvsMacroSizes1 = NULL;	\
+		const tMacroSize	*pvsMacroSizes2 = NULL;	\
+		unsigned char		*pucMacroQuad2 = NULL;	\
+		unsigned int		puiMacroValues[8];	\
+		unsigned int		uiMacroMask1 = 0;	\
+		unsigned int		uiMacroMask2 = 0;	\
+		unsigned int		uiMacroPosition = 0;	\
+		unsigned int		uiMacroMatchCount = 0;	\
+\
+		/* Two quads at a time, a bitmap byte */	\
+		for ( ; (uiIntegerCount - uiMacroPosition) >= 8; uiMacroPosition += 8 ) {	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucData, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			pvsMacroSizes1 = pvsMacroSizes + pucData[0];	\
+			pucMacroQuad2 = pucData + pvsMacroSizes1->ucLength;	\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucMacroQuad2, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			pvsMacroSizes2 = pvsMacroSizes + pucMacroQuad2[0];	\
+\
+			NUM_READ_QUAD_VALUES(pvsMacroSizes1, puiMacroMasks, uiMacroHeaderSize, pucData, puiMacroValues);	\
+			NUM_READ_QUAD_VALUES(pvsMacroSizes2, puiMacroMasks, uiMacroHeaderSize, pucMacroQuad2, puiMacroValues + 4);	\
+			pucData = pucMacroQuad2 + pvsMacroSizes2->ucLength;	\
+\
+			NUM_FILTER_QUAD_MASK(puiMacroValues, uiRangeMinValue, uiRangeWidth, uiMacroMask1);	\
+			NUM_FILTER_QUAD_MASK(puiMacroValues + 4, uiRangeMinValue, uiRangeWidth, uiMacroMask2);	\
+			NUM_FILTER_STORE_MASK(uiMacroMask1 | (uiMacroMask2 << 4), uiMacroPosition, pucBitmap, puiPositions, uiMacroMatchCount);	\
+		}	\
+\
+		/* The remaining quads, up to 7 integers, the bits past the end are cleared */	\
+		if ( uiMacroPosition < uiIntegerCount ) {	\
+			uiMacroMask1 = 0;	\
+			uiMacroMask2 = 0;	\
+\
+			if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucData, pucDataEnd) ) {	\
+				return (NULL);	\
+			}	\
+			pvsMacroSizes1 = pvsMacroSizes + pucData[0];	\
+			NUM_READ_QUAD_VALUES(pvsMacroSizes1, puiMacroMasks, uiMacroHeaderSize, pucData, puiMacroValues);	\
+			pucData += pvsMacroSizes1->ucLength;	\
+			NUM_FILTER_QUAD_MASK(puiMacroValues, uiRangeMinValue, uiRangeWidth, uiMacroMask1);	\
+\
+			if ( (uiIntegerCount - uiMacroPosition) > 4 ) {	\
+				if ( (bMacroBounded) && NUM_QUAD_PAST_END(pvsMacroSizes, pucData, pucDataEnd) ) {	\
+					return (NULL);	\
+				}	\
+				pvsMacroSizes2 = pvsMacroSizes + pucData[0];	\
+				NUM_READ_QUAD_VALUES(pvsMacroSizes2, puiMacroMasks, uiMacroHeaderSize, pucData, puiMacroValues + 4);	\
+				pucData += pvsMacroSizes2->ucLength;	\
+				NUM_FILTER_QUAD_MASK(puiMacroValues + 4, uiRangeMinValue, uiRangeWidth, uiMacroMask2);	\
+			}	\
+\
+			uiMacroMask1 = (uiMacroMask1 | (uiMacroMask2 << 4)) & ((1U << (uiIntegerCount - uiMacroPosition)) - 1);	\
+			NUM_FILTER_STORE_MASK(uiMacroMask1, uiMacroPosition, pucBitmap, puiPositions, uiMacroMatchCount);	\
+		}	\
+\
+		*puiMatchCount = uiMacroMatchCount;	\
+\
+		return (pucData);	\
+	}
+
+
+/* Filter kernels */
+NUM_DEFINE_FILTER_QUADS(pucNumFilterVarintQuads, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, false)
+NUM_DEFINE_FILTER_QUADS(pucNumFilterCompactVarintQuads, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, false)
+
+/* Bounded filter kernels for blocks */
+NUM_DEFINE_FILTER_QUADS(pucNumFilterVarintQuadsBounded, struct varintSize, pvsVarintSizesGlobal, uiVarintMaskGlobal, NUM_VARINT_HEADER_SIZE, true)
+NUM_DEFINE_FILTER_QUADS(pucNumFilterCompactVarintQuadsBounded, struct compactVarintSize, pvsCompactVarintSizesGlobal, uiCompactVarintMaskGlobal, NUM_COMPACT_VARINT_HEADER_SIZE, true)
+
+
+/*
+
+	Function:	pucNumFilterQuadByQuad()
+
+	Purpose:	Selects the integers in an inclusive range from a fixed
+				width block or a compact varint block with the runs of zero
+				quads suppressed, one quad at a time. No integer is read
+				past the end of the data.
+
+	Parameters:	uiWidth				block width, fixed or zero run
+				pucData				data to filter
+				pucDataEnd			end of the data
+				uiIntegerCount		number of integers
+				uiRangeMinValue		smallest integer selected
+				uiRangeWidth		largest integer selected less the smallest
+				pucBitmap			where to write the bitmap (optional)
+				puiPositions		where to write the positions of the matches (optional)
+				puiMatchCount		return pointer for the number of matches
+
+	Global Variables:	none
+
+	Returns:	a pointer to the end of the data filtered, NULL if the data is corrupt
+
+*/
+static unsigned char *pucNumFilterQuadByQuad
+(
+	unsigned int uiWidth,
+	unsigned char *pucData,
+	unsigned char *pucDataEnd,
+	unsigned int uiIntegerCount,
+	unsigned int uiRangeMinValue,
+	unsigned int uiRangeWidth,
+	unsigned char *pucBitmap,
+	unsigned int *puiPositions,
+	unsigned int *puiMatchCount
+)
+{
+
+	unsigned int	puiValues[4];
+	unsigned int	uiQuadCount = (uiIntegerCount + 3) / 4;
+	unsigned int	uiZeroQuadCount = 0;
+	unsigned int	uiSize = 0;
+	unsigned int	uiMask = 0;
+	unsigned int	uiByteMask = 0;
+	unsigned int	uiMatchCount = 0;
+	unsigned int	uiI = 0;
+	unsigned int	uiJ = 0;
+
+
+	ASSERT((NUM_BLOCK_WIDTH_FIXED(uiWidth) == true) || (uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN));
+
+	for ( uiI = 0; uiI < uiQuadCount; uiI++ ) {
+
+		/* Get the integers of the quad, the padding of the last quad is zero */
+		if ( NUM_BLOCK_WIDTH_FIXED(uiWidth) == true ) {
+			for ( uiJ = 0; uiJ < 4; uiJ++ ) {
+				if ( ((uiI * 4) + uiJ) >= uiIntegerCount ) {
+					puiValues[uiJ] = 0;
+				}
+				else if ( uiWidth == NUM_BLOCK_WIDTH_1 ) {
+					puiValues[uiJ] = pucData[0];
+					pucData += 1;
+				}
+				else {
+					puiValues[uiJ] = pucData[0] | ((unsigned int)pucData[1] << 8);
+					pucData += 2;
+				}
+			}
+		}
+		else if ( uiZeroQuadCount > 0 ) {
+			memset(puiValues, 0, sizeof(puiValues));
+			uiZeroQuadCount--;
+		}
+		else {
+
+			if ( pucData >= pucDataEnd ) {
+				return (NULL);
+			}
+
+			/* A run of zero quads, which must not run past the end of the block */
+			if ( pucData[0] == 0 ) {
+				pucData += NUM_COMPACT_VARINT_HEADER_SIZE;
+				if ( (iNumReadCompressedUIntBounded(pucData, pucDataEnd - pucData, &uiZeroQuadCount, &uiSize) != NUM_NoError) ||
+						(uiZeroQuadCount >= (uiQuadCount - uiI)) ) {
+					return (NULL);
+				}
+				pucData += uiSize;
+				memset(puiValues, 0, sizeof(puiValues));
+			}
+			else {
+				if ( NUM_QUAD_PAST_END(pvsCompactVarintSizesGlobal, pucData, pucDataEnd) ) {
+					return (NULL);
+				}
+				NUM_READ_COMPACT_VARINT_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucData);
+			}
+		}
+
+		/* Two quads make a bitmap byte, the bits past the end are cleared */
+		NUM_FILTER_QUAD_MASK(puiValues, uiRangeMinValue, uiRangeWidth, uiMask);
+		uiByteMask |= uiMask << ((uiI % 2) * 4);
+
+		if ( ((uiI % 2) == 1) || ((uiI + 1) == uiQuadCount) ) {
+			if ( (uiIntegerCount - ((uiI / 2) * 8)) < 8 ) {
+				uiByteMask &= (1U << (uiIntegerCount - ((uiI / 2) * 8))) - 1;
+			}
+			NUM_FILTER_STORE_MASK(uiByteMask, (uiI / 2) * 8, pucBitmap, puiPositions, uiMatchCount);
+			uiByteMask = 0;
+		}
+	}
+
+	*puiMatchCount = uiMatchCount;
+
+	return (pucData);
+
+}
+
+
+/*
+
+	Function:	iNumFilterQuads()
+
+	Purpose:	Selects the integers in an inclusive range from a run of
+				varint or compact varint quads without storing them. The
+				data must be followed by at least NUM_READ_PADDING_SIZE
+				readable bytes.
+
+	Parameters:	uiFormat			format, a quad format
+				pucData				data to filter
+				uiIntegerCount		number of integers, the padding of the last quad is skipped
+				uiRangeMinValue		smallest integer selected
+				uiRangeMaxValue		largest integer selected
+				pucBitmap			where to write the bitmap, NUM_GET_FILTER_BITMAP_LENGTH() bytes (optional)
+				puiPositions		where to write the positions of the matches, room for uiIntegerCount positions (optional)
+				puiMatchCount		return pointer for the number of matches
+				ppucDataEnd			return pointer for the end of the data filtered (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumFilterQuads
+(
+	unsigned int uiFormat,
+	unsigned char *pucData,
+	unsigned int uiIntegerCount,
+	unsigned int uiRangeMinValue,
+	unsigned int uiRangeMaxValue,
+	unsigned char *pucBitmap,
+	unsigned int *puiPositions,
+	unsigned int *puiMatchCount,
+	unsigned char **ppucDataEnd
+)
+{
+
+	unsigned char	*pucDataEnd = NULL;
+
+
+	/* Check the parameters */
+	if ( (uiFormat != NUM_FORMAT_VARINT_QUAD) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pucData == NULL) && (uiIntegerCount > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiRangeMinValue > uiRangeMaxValue ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiMatchCount == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		pucDataEnd = pucNumFilterVarintQuads(pucData, NULL, uiIntegerCount, uiRangeMinValue, uiRangeMaxValue - uiRangeMinValue,
+				pucBitmap, puiPositions, puiMatchCount);
+	}
+	else {
+		pucDataEnd = pucNumFilterCompactVarintQuads(pucData, NULL, uiIntegerCount, uiRangeMinValue, uiRangeMaxValue - uiRangeMinValue,
+				pucBitmap, puiPositions, puiMatchCount);
+	}
+
+	if ( ppucDataEnd != NULL ) {
+		*ppucDataEnd = pucDataEnd;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumBlockFilter()
+
+	Purpose:	Selects the integers in an inclusive range from a varint
+				or compact varint block without storing them. The data must
+				be followed by NUM_READ_PADDING_SIZE readable bytes.
+
+	Parameters:	uiFormat			format, a quad format without escapes
+				pucData				block to filter
+				uiDataLength		length of the data
+				uiRangeMinValue		smallest integer selected
+				uiRangeMaxValue		largest integer selected
+				pucBitmap			where to write the bitmap, NUM_GET_FILTER_BITMAP_LENGTH() bytes for the block (optional)
+				puiPositions		where to write the positions of the matches, room for the integers of the block (optional)
+				puiMatchCount		return pointer for the number of matches
+				puiBlockLength		return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockFilter
+(
+	unsigned int uiFormat,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int uiRangeMinValue,
+	unsigned int uiRangeMaxValue,
+	unsigned char *pucBitmap,
+	unsigned int *puiPositions,
+	unsigned int *puiMatchCount,
+	unsigned int *puiBlockLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned char	*pucDataPtr = NULL;
+	unsigned char	*pucDataEndPtr = NULL;
+	unsigned int	uiIntegerCount = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiHeaderLength = 0;
+	unsigned int	uiMatchCount = 0;
+
+
+	/* Check the parameters */
+	if ( (uiFormat != NUM_FORMAT_VARINT_QUAD) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pucData == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiRangeMinValue > uiRangeMaxValue ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiMatchCount == NULL) || (puiBlockLength == NULL) ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Read the header, and check the data length before reading any data */
+	if ( (iError = iNumBlockReadHeader(pucData, uiDataLength, &uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (uiHeaderLength + uiBlockDataLength) > uiDataLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( (iError = iNumBlockCheckDataLength(uiFormat, uiWidth, uiIntegerCount, uiBlockDataLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+
+	/* Filter the data, no integer is read past the end of the data */
+	pucDataPtr = pucData + uiHeaderLength;
+	pucDataEndPtr = pucDataPtr + uiBlockDataLength;
+
+	if ( (uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN) && (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( uiWidth != NUM_BLOCK_WIDTH_VARIABLE ) {
+		pucDataPtr = pucNumFilterQuadByQuad(uiWidth, pucDataPtr, pucDataEndPtr, uiIntegerCount, uiRangeMinValue, uiRangeMaxValue - uiRangeMinValue,
+				pucBitmap, puiPositions, &uiMatchCount);
+	}
+	else if ( uiFormat == NUM_FORMAT_VARINT_QUAD ) {
+		pucDataPtr = pucNumFilterVarintQuadsBounded(pucDataPtr, pucDataEndPtr, uiIntegerCount, uiRangeMinValue, uiRangeMaxValue - uiRangeMinValue,
+				pucBitmap, puiPositions, &uiMatchCount);
+	}
+	else {
+		pucDataPtr = pucNumFilterCompactVarintQuadsBounded(pucDataPtr, pucDataEndPtr, uiIntegerCount, uiRangeMinValue, uiRangeMaxValue - uiRangeMinValue,
+				pucBitmap, puiPositions, &uiMatchCount);
+	}
+
+	if ( pucDataPtr != pucDataEndPtr ) {
+		return (NUM_CorruptDataError);
+	}
+
+	*puiMatchCount = uiMatchCount;
+	*puiBlockLength = uiHeaderLength + uiBlockDataLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage functions (ring buffer) ===
+** ==============================================
+*/
+
+
+/* Single producer, single consumer ring buffer, the producer and consumer
+** can run on separate threads without a lock
+*/
+struct numRingBuffer {
+	unsigned char		*pucData;
+	unsigned int		uiCapacity;
+	unsigned long long	ullWriteOffset;
+	unsigned long long	ullReadOffset;
+	boolean				bClosed;
+};
+
+
+/*
+
+	Function:	iNumRingBufferCreate()
+
+	Purpose:	Creates a ring buffer.
+
+	Parameters:	uiCapacity			capacity in bytes
+				ppvNumRingBuffer	return pointer for the ring buffer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumRingBufferCreate
+(
+	unsigned int uiCapacity,
+	void **ppvNumRingBuffer
+)
+{
+
+	struct numRingBuffer	*pnrbNumRingBuffer = NULL;
+
+
+	/* Check the parameters */
+	if ( uiCapacity == 0 ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumRingBuffer == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Allocate the ring buffer */
+	if ( (pnrbNumRingBuffer = (struct numRingBuffer *)calloc(1, sizeof(struct numRingBuffer))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	if ( (pnrbNumRingBuffer->pucData = (unsigned char *)malloc(uiCapacity)) == NULL ) {
+		free(pnrbNumRingBuffer);
+		return (NUM_MemError);
+	}
+
+	pnrbNumRingBuffer->uiCapacity = uiCapacity;
+
+	*ppvNumRingBuffer = (void *)pnrbNumRingBuffer;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumRingBufferFree()
+
+	Purpose:	Frees a ring buffer.
+
+	Parameters:	pvNumRingBuffer		ring buffer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumRingBufferFree
+(
+	void *pvNumRingBuffer
+)
+{
+
+	struct numRingBuffer	*pnrbNumRingBuffer = (struct numRingBuffer *)pvNumRingBuffer;
+
+
+	if ( pnrbNumRingBuffer == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	free(pnrbNumRingBuffer->pucData);
+	free(pnrbNumRingBuffer);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumRingBufferWrite()
+
+	Purpose:	Writes data to a ring buffer, the data is either written in
+				full or not at all.
+
+	Parameters:	pvNumRingBuffer		ring buffer
+				pucData				data to write
+				uiDataLength		length of the data
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_SinkError if there is not enough space
+
+*/
+int iNumRingBufferWrite
+(
+	void *pvNumRingBuffer,
+	unsigned char *pucData,
+	unsigned int uiDataLength
+)
+{
+
+	struct numRingBuffer	*pnrbNumRingBuffer = (struct numRingBuffer *)pvNumRingBuffer;
+	unsigned long long		ullWriteOffset = 0;
+	unsigned long long		ullReadOffset = 0;
+	unsigned int			uiStart = 0;
+	unsigned int			uiLength = 0;
+
+
+	/* Check the parameters */
+	if ( (pnrbNumRingBuffer == NULL) || ((pucData == NULL) && (uiDataLength > 0)) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Check that there is space, only the consumer moves the read offset */
+	ullWriteOffset = pnrbNumRingBuffer->ullWriteOffset;
+	ullReadOffset = __atomic_load_n(&pnrbNumRingBuffer->ullReadOffset, __ATOMIC_ACQUIRE);
+
+	if ( (pnrbNumRingBuffer->uiCapacity - (ullWriteOffset - ullReadOffset)) < uiDataLength ) {
+		return (NUM_SinkError);
+	}
+
+
+	/* Copy the data, wrapping around the end */
+	uiStart = ullWriteOffset % pnrbNumRingBuffer->uiCapacity;
+	uiLength = ((pnrbNumRingBuffer->uiCapacity - uiStart) < uiDataLength) ? (pnrbNumRingBuffer->uiCapacity - uiStart) : uiDataLength;
+
+	memcpy(pnrbNumRingBuffer->pucData + uiStart, pucData, uiLength);
+	memcpy(pnrbNumRingBuffer->pucData, pucData + uiLength, uiDataLength - uiLength);
+
+	__atomic_store_n(&pnrbNumRingBuffer->ullWriteOffset, ullWriteOffset + uiDataLength, __ATOMIC_RELEASE);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumRingBufferRead()
+
+	Purpose:	Reads up to a length of data from a ring buffer.
+
+	Parameters:	pvNumRingBuffer		ring buffer
+				pucData				where to read the data to
+				uiDataLength		length of the data
+				puiDataLengthRead	return pointer for the length of the data read
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumRingBufferRead
+(
+	void *pvNumRingBuffer,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiDataLengthRead
+)
+{
+
+	struct numRingBuffer	*pnrbNumRingBuffer = (struct numRingBuffer *)pvNumRingBuffer;
+	unsigned long long		ullWriteOffset = 0;
+	unsigned long long		ullReadOffset = 0;
+	unsigned int			uiStart = 0;
+	unsigned int			uiLength = 0;
+	unsigned int			uiAvailable = 0;
+
+
+	/* Check the parameters */
+	if ( (pnrbNumRingBuffer == NULL) || ((pucData == NULL) && (uiDataLength > 0)) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDataLengthRead == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Work out how much we can read, only the producer moves the write offset */
+	ullReadOffset = pnrbNumRingBuffer->ullReadOffset;
+	ullWriteOffset = __atomic_load_n(&pnrbNumRingBuffer->ullWriteOffset, __ATOMIC_ACQUIRE);
+
+	uiAvailable = ullWriteOffset - ullReadOffset;
+	if ( uiDataLength > uiAvailable ) {
+		uiDataLength = uiAvailable;
+	}
+
+
+	/* Copy the data, wrapping around the end */
+	uiStart = ullReadOffset % pnrbNumRingBuffer->uiCapacity;
+	uiLength = ((pnrbNumRingBuffer->uiCapacity - uiStart) < uiDataLength) ? (pnrbNumRingBuffer->uiCapacity - uiStart) : uiDataLength;
+
+	memcpy(pucData, pnrbNumRingBuffer->pucData + uiStart, uiLength);
+	memcpy(pucData + uiLength, pnrbNumRingBuffer->pucData, uiDataLength - uiLength);
+
+	__atomic_store_n(&pnrbNumRingBuffer->ullReadOffset, ullReadOffset + uiDataLength, __ATOMIC_RELEASE);
+
+	*puiDataLengthRead = uiDataLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumRingBufferClose()
+
+	Purpose:	Marks the end of the data in a ring buffer, called by the
+				producer once it has written all its data.
+
+	Parameters:	pvNumRingBuffer		ring buffer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumRingBufferClose
+(
+	void *pvNumRingBuffer
+)
+{
+
+	struct numRingBuffer	*pnrbNumRingBuffer = (struct numRingBuffer *)pvNumRingBuffer;
+
+
+	if ( pnrbNumRingBuffer == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	__atomic_store_n(&pnrbNumRingBuffer->bClosed, true, __ATOMIC_RELEASE);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumRingBufferIsDrained()
+
+	Purpose:	Checks whether a ring buffer has been closed by the producer
+				and all its data has been read.
+
+	Parameters:	pvNumRingBuffer		ring buffer
+				pbDrained			return pointer for the drained flag
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumRingBufferIsDrained
+(
+	void *pvNumRingBuffer,
+	boolean *pbDrained
+)
+{
+
+	struct numRingBuffer	*pnrbNumRingBuffer = (struct numRingBuffer *)pvNumRingBuffer;
+
+
+	if ( pnrbNumRingBuffer == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pbDrained == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+	/* Check the closed flag first so we see all the data written before the close */
+	*pbDrained = (__atomic_load_n(&pnrbNumRingBuffer->bClosed, __ATOMIC_ACQUIRE) == true) &&
+			(__atomic_load_n(&pnrbNumRingBuffer->ullWriteOffset, __ATOMIC_ACQUIRE) == pnrbNumRingBuffer->ullReadOffset);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =================================================
+** === Number storage functions (stream encoder) ===
+** =================================================
+*/
+
+
+/* Stream encoder structure */
+struct numStreamEncoder {
+	unsigned int			uiFormat;
+	unsigned int			uiBlockIntegerCount;
+
+	iNumStreamSinkCallback	iNumStreamSink;
+	void					*pvSinkContext;
+
+	unsigned int			puiQuadValues[4];		/* Partial quad */
+	unsigned int			uiQuadValuesLength;
+
+	unsigned char			*pucBlockData;			/* Current block, header space is reserved at the start */
+	unsigned char			*pucBlockDataPtr;
+	unsigned int			uiBlockIntegerCountCurrent;
+	unsigned int			uiBlockValuesOr;		/* All the integers in the current block or'ed, to pick the block width */
+	unsigned int			*puiBlockValues;		/* Current block decoded, when it is written as fixed width */
+
+	unsigned char			*pucBuffer;				/* Completed blocks waiting to be flushed */
+	unsigned int			uiBufferLength;
+	unsigned int			uiBufferCapacity;
+
+	unsigned long long		ullIntegerCount;
+	unsigned long long		ullByteCount;
+};
+
+
+/*
+
+	Function:	iNumStreamSinkFileDescriptor()
+
+	Purpose:	Sink callback which writes to a file descriptor, the context
+				is a pointer to the file descriptor.
+
+	Parameters:	pvSinkContext		pointer to the file descriptor
+				pucData				data to write
+				uiDataLength		length of the data
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamSinkFileDescriptor
+(
+	void *pvSinkContext,
+	unsigned char *pucData,
+	unsigned int uiDataLength
+)
+{
+
+	int			iFileDescriptor = -1;
+	ssize_t		zBytesWritten = 0;
+
+
+	if ( pvSinkContext == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	iFileDescriptor = *((int *)pvSinkContext);
+
+
+	/* Write all the data, restarting on interrupts */
+	while ( uiDataLength > 0 ) {
+
+		if ( (zBytesWritten = write(iFileDescriptor, pucData, uiDataLength)) == -1 ) {
+			if ( errno == EINTR ) {
+				continue;
+			}
+			return (NUM_SinkError);
+		}
+
+		pucData += zBytesWritten;
+		uiDataLength -= zBytesWritten;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamSinkRingBuffer()
+
+	Purpose:	Sink callback which writes to a ring buffer, the context
+				is the ring buffer.
+
+	Parameters:	pvSinkContext		ring buffer
+				pucData				data to write
+				uiDataLength		length of the data
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_SinkError if the ring buffer is full
+
+*/
+int iNumStreamSinkRingBuffer
+(
+	void *pvSinkContext,
+	unsigned char *pucData,
+	unsigned int uiDataLength
+)
+{
+
+	return (iNumRingBufferWrite(pvSinkContext, pucData, uiDataLength));
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderCreate()
+
+	Purpose:	Creates a stream encoder. Memory use is fixed at creation,
+				one block plus the flush buffer.
+
+	Parameters:	uiFormat				format
+				uiBlockIntegerCount		number of integers per block, a multiple of 4, 0 for the default
+				uiBufferLength			flush buffer length, 0 for the default
+				iNumStreamSink			sink callback
+				pvSinkContext			sink context
+				ppvNumStreamEncoder		return pointer for the stream encoder
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamEncoderCreate
+(
+	unsigned int uiFormat,
+	unsigned int uiBlockIntegerCount,
+	unsigned int uiBufferLength,
+	iNumStreamSinkCallback iNumStreamSink,
+	void *pvSinkContext,
+	void **ppvNumStreamEncoder
+)
+{
+
+	struct numStreamEncoder		*pnseNumStreamEncoder = NULL;
+	unsigned int				uiBlockMaxSize = 0;
+	unsigned int				uiDecodeCount = 0;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiBlockIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (uiBlockIntegerCount % 4) != 0 ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( iNumStreamSink == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumStreamEncoder == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Set the defaults */
+	if ( uiBlockIntegerCount == 0 ) {
+		uiBlockIntegerCount = NUM_BLOCK_INTEGER_COUNT_DEFAULT;
+	}
+
+	if ( uiBufferLength == 0 ) {
+		uiBufferLength = NUM_STREAM_BUFFER_LENGTH_DEFAULT;
+	}
+
+	/* The buffer needs to hold at least one full block */
+	NUM_GET_BLOCK_MAX_SIZE(uiBlockIntegerCount, uiBlockMaxSize);
+	if ( uiBufferLength < uiBlockMaxSize ) {
+		uiBufferLength = uiBlockMaxSize;
+	}
+
+
+	/* Allocate the encoder */
+	if ( (pnseNumStreamEncoder = (struct numStreamEncoder *)calloc(1, sizeof(struct numStreamEncoder))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	/* The block is padded so it can be decoded in place */
+	if ( (pnseNumStreamEncoder->pucBlockData = (unsigned char *)malloc(uiBlockMaxSize + NUM_READ_PADDING_SIZE)) == NULL ) {
+		free(pnseNumStreamEncoder);
+		return (NUM_MemError);
+	}
+
+	NUM_GET_BLOCK_DECODE_COUNT(uiBlockIntegerCount, uiDecodeCount);
+	if ( (pnseNumStreamEncoder->puiBlockValues = (unsigned int *)malloc(uiDecodeCount * sizeof(unsigned int))) == NULL ) {
+		free(pnseNumStreamEncoder->pucBlockData);
+		free(pnseNumStreamEncoder);
+		return (NUM_MemError);
+	}
+
+	if ( (pnseNumStreamEncoder->pucBuffer = (unsigned char *)malloc(uiBufferLength)) == NULL ) {
+		free(pnseNumStreamEncoder->puiBlockValues);
+		free(pnseNumStreamEncoder->pucBlockData);
+		free(pnseNumStreamEncoder);
+		return (NUM_MemError);
+	}
+
+	pnseNumStreamEncoder->uiFormat = uiFormat;
+	pnseNumStreamEncoder->uiBlockIntegerCount = uiBlockIntegerCount;
+	pnseNumStreamEncoder->iNumStreamSink = iNumStreamSink;
+	pnseNumStreamEncoder->pvSinkContext = pvSinkContext;
+	pnseNumStreamEncoder->pucBlockDataPtr = pnseNumStreamEncoder->pucBlockData + NUM_BLOCK_HEADER_MAX_SIZE;
+	pnseNumStreamEncoder->uiBufferCapacity = uiBufferLength;
+
+	*ppvNumStreamEncoder = (void *)pnseNumStreamEncoder;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderCommitBlock()
+
+	Purpose:	Moves the current block to the flush buffer, flushing the
+				buffer to the sink first if there is not enough space. The
+				block is left in place if the sink fails.
+
+				The block is rewritten as fixed width integers if that is
+				no longer than the format, or with the zero runs suppressed
+				if that is shorter still.
+
+	Parameters:	pnseNumStreamEncoder	stream encoder
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumStreamEncoderCommitBlock
+(
+	struct numStreamEncoder *pnseNumStreamEncoder
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned char	*pucBlockDataStart = NULL;
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiBlockLength = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+
+
+	ASSERT(pnseNumStreamEncoder != NULL);
+	ASSERT(pnseNumStreamEncoder->uiQuadValuesLength == 0);
+
+
+	/* Nothing to commit */
+	if ( pnseNumStreamEncoder->uiBlockIntegerCountCurrent == 0 ) {
+		return (NUM_NoError);
+	}
+
+
+	/* Make space in the buffer */
+	pucBlockDataStart = pnseNumStreamEncoder->pucBlockData + NUM_BLOCK_HEADER_MAX_SIZE;
+	uiBlockDataLength = pnseNumStreamEncoder->pucBlockDataPtr - pucBlockDataStart;
+
+	if ( (pnseNumStreamEncoder->uiBufferLength + NUM_BLOCK_HEADER_MAX_SIZE + uiBlockDataLength) > pnseNumStreamEncoder->uiBufferCapacity ) {
+
+		if ( (iError = pnseNumStreamEncoder->iNumStreamSink(pnseNumStreamEncoder->pvSinkContext, pnseNumStreamEncoder->pucBuffer,
+				pnseNumStreamEncoder->uiBufferLength)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		pnseNumStreamEncoder->ullByteCount += pnseNumStreamEncoder->uiBufferLength;
+		pnseNumStreamEncoder->uiBufferLength = 0;
+	}
+
+
+	/* Rewrite the block as fixed width integers or with the zero runs suppressed if we can */
+	uiWidth = uiNumBlockGetWidth(pnseNumStreamEncoder->uiBlockValuesOr, pnseNumStreamEncoder->uiBlockIntegerCountCurrent, uiBlockDataLength);
+	if ( pnseNumStreamEncoder->uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		uiWidth = uiNumBlockGetZeroRunWidth(pnseNumStreamEncoder->uiFormat, uiWidth, pnseNumStreamEncoder->uiBlockIntegerCountCurrent, uiBlockDataLength,
+				uiNumBlockGetZeroRunLength(pucBlockDataStart, (pnseNumStreamEncoder->uiBlockIntegerCountCurrent + 3) / 4));
+	}
+
+	if ( uiWidth != NUM_BLOCK_WIDTH_VARIABLE ) {
+		pucNumBlockDecodeData(pnseNumStreamEncoder->uiFormat, pucBlockDataStart, pucBlockDataStart + uiBlockDataLength,
+				pnseNumStreamEncoder->puiBlockValues, pnseNumStreamEncoder->uiBlockIntegerCountCurrent);
+
+		if ( uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN ) {
+			uiBlockDataLength = pucNumBlockWriteZeroRuns(pnseNumStreamEncoder->puiBlockValues, pnseNumStreamEncoder->uiBlockIntegerCountCurrent,
+					pucBlockDataStart) - pucBlockDataStart;
+		}
+		else {
+			vNumBlockWriteFixedWidth(pnseNumStreamEncoder->puiBlockValues, pnseNumStreamEncoder->uiBlockIntegerCountCurrent, uiWidth,
+					pucBlockDataStart);
+			uiBlockDataLength = pnseNumStreamEncoder->uiBlockIntegerCountCurrent * uiWidth;
+		}
+	}
+
+
+	/* Write the block to the buffer */
+	iNumBlockWrite(pnseNumStreamEncoder->uiBlockIntegerCountCurrent, uiWidth, pucBlockDataStart, uiBlockDataLength,
+			pnseNumStreamEncoder->pucBuffer + pnseNumStreamEncoder->uiBufferLength, &uiBlockLength);
+
+	pnseNumStreamEncoder->uiBufferLength += uiBlockLength;
+	pnseNumStreamEncoder->pucBlockDataPtr = pucBlockDataStart;
+	pnseNumStreamEncoder->uiBlockIntegerCountCurrent = 0;
+	pnseNumStreamEncoder->uiBlockValuesOr = 0;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	vNumStreamEncoderEncodeQuad()
+
+	Purpose:	Encodes the partial quad into the current block, padding
+				it with zeros if it is not full.
+
+	Parameters:	pnseNumStreamEncoder	stream encoder
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumStreamEncoderEncodeQuad
+(
+	struct numStreamEncoder *pnseNumStreamEncoder
+)
+{
+
+	unsigned int	*puiQuadValues = pnseNumStreamEncoder->puiQuadValues;
+
+
+	ASSERT(pnseNumStreamEncoder != NULL);
+	ASSERT(pnseNumStreamEncoder->uiFormat != NUM_FORMAT_COMPRESSED_UINT);
+
+
+	if ( pnseNumStreamEncoder->uiQuadValuesLength == 0 ) {
+		return;
+	}
+
+	/* Pad the quad */
+	for ( ; pnseNumStreamEncoder->uiQuadValuesLength < 4; pnseNumStreamEncoder->uiQuadValuesLength++ ) {
+		puiQuadValues[pnseNumStreamEncoder->uiQuadValuesLength] = 0;
+	}
+
+	NUM_WRITE_QUAD(pnseNumStreamEncoder->uiFormat, puiQuadValues[0], puiQuadValues[1], puiQuadValues[2], puiQuadValues[3],
+			pnseNumStreamEncoder->pucBlockDataPtr);
+
+	pnseNumStreamEncoder->uiQuadValuesLength = 0;
+
+	return;
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderAddIntegers()
+
+	Purpose:	Adds integers to a stream encoder. Integers are encoded a
+				quad at a time and complete blocks are passed to the sink
+				as the flush buffer fills up.
+
+				On error, integers up to the one which caused the error
+				have been added.
+
+	Parameters:	pvNumStreamEncoder		stream encoder
+				puiValues				integers to add
+				uiValuesLength			number of integers to add
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamEncoderAddIntegers
+(
+	void *pvNumStreamEncoder,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength
+)
+{
+
+	struct numStreamEncoder		*pnseNumStreamEncoder = (struct numStreamEncoder *)pvNumStreamEncoder;
+	int							iError = NUM_NoError;
+	unsigned int				uiFormat = 0;
+	unsigned int				uiI = 0;
+	unsigned int				uiQuadCount = 0;
+
+
+	/* Check the parameters */
+	if ( pnseNumStreamEncoder == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiValues == NULL) && (uiValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	uiFormat = pnseNumStreamEncoder->uiFormat;
+
+	for ( uiI = 0; uiI < uiValuesLength; ) {
+
+		/* Commit the current block if it is full */
+		if ( pnseNumStreamEncoder->uiBlockIntegerCountCurrent == pnseNumStreamEncoder->uiBlockIntegerCount ) {
+			if ( (iError = iNumStreamEncoderCommitBlock(pnseNumStreamEncoder)) != NUM_NoError ) {
+				return (iError);
+			}
+		}
+
+		if ( (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (puiValues[uiI] > NUM_COMPACT_VARINT_MAX_VALUE) ) {
+			return (NUM_ValueOverflowError);
+		}
+
+		/* Compressed uints go straight into the block */
+		if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+			NUM_WRITE_COMPRESSED_UINT(puiValues[uiI], pnseNumStreamEncoder->pucBlockDataPtr);
+			pnseNumStreamEncoder->uiBlockValuesOr |= puiValues[uiI];
+			pnseNumStreamEncoder->uiBlockIntegerCountCurrent++;
+			pnseNumStreamEncoder->ullIntegerCount++;
+			uiI++;
+			continue;
+		}
+
+		/* Encode whole quads directly from the values when we are on a quad boundary */
+		if ( pnseNumStreamEncoder->uiQuadValuesLength == 0 ) {
+
+			uiQuadCount = (pnseNumStreamEncoder->uiBlockIntegerCount - pnseNumStreamEncoder->uiBlockIntegerCountCurrent) / 4;
+			if ( uiQuadCount > ((uiValuesLength - uiI) / 4) ) {
+				uiQuadCount = (uiValuesLength - uiI) / 4;
+			}
+
+			if ( uiQuadCount > 0 ) {
+
+				if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+					unsigned int	uiJ = 0;
+					for ( uiJ = uiI; uiJ < (uiI + (uiQuadCount * 4)); uiJ++ ) {
+						if ( puiValues[uiJ] > NUM_COMPACT_VARINT_MAX_VALUE ) {
+							uiQuadCount = (uiJ - uiI) / 4;
+							break;
+						}
+					}
+				}
+
+				/* Fall through to the partial quad if the first quad has a value which is too large, it adds the integers up to it */
+				if ( uiQuadCount > 0 ) {
+
+					for ( ; uiQuadCount > 0; uiQuadCount--, uiI += 4 ) {
+						NUM_WRITE_QUAD(uiFormat, puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], puiValues[uiI + 3],
+								pnseNumStreamEncoder->pucBlockDataPtr);
+						pnseNumStreamEncoder->uiBlockValuesOr |= puiValues[uiI] | puiValues[uiI + 1] | puiValues[uiI + 2] | puiValues[uiI + 3];
+						pnseNumStreamEncoder->uiBlockIntegerCountCurrent += 4;
+						pnseNumStreamEncoder->ullIntegerCount += 4;
+					}
+
+					continue;
+				}
+			}
+		}
+
+		/* Otherwise add to the partial quad */
+		pnseNumStreamEncoder->puiQuadValues[pnseNumStreamEncoder->uiQuadValuesLength] = puiValues[uiI];
+		pnseNumStreamEncoder->uiQuadValuesLength++;
+		pnseNumStreamEncoder->uiBlockValuesOr |= puiValues[uiI];
+		pnseNumStreamEncoder->uiBlockIntegerCountCurrent++;
+		pnseNumStreamEncoder->ullIntegerCount++;
+		uiI++;
+
+		if ( pnseNumStreamEncoder->uiQuadValuesLength == 4 ) {
+			vNumStreamEncoderEncodeQuad(pnseNumStreamEncoder);
+		}
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderAddInteger()
+
+	Purpose:	Adds an integer to a stream encoder.
+
+	Parameters:	pvNumStreamEncoder		stream encoder
+				uiValue					integer to add
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamEncoderAddInteger
+(
+	void *pvNumStreamEncoder,
+	unsigned int uiValue
+)
+{
+
+	return (iNumStreamEncoderAddIntegers(pvNumStreamEncoder, &uiValue, 1));
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderFlush()
+
+	Purpose:	Flushes a stream encoder, the partial quad and the current
+				block are closed off and all the blocks are passed to the
+				sink. Encoding can continue after a flush.
+
+	Parameters:	pvNumStreamEncoder		stream encoder
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamEncoderFlush
+(
+	void *pvNumStreamEncoder
+)
+{
+
+	struct numStreamEncoder		*pnseNumStreamEncoder = (struct numStreamEncoder *)pvNumStreamEncoder;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnseNumStreamEncoder == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Close off the partial quad and the current block */
+	if ( pnseNumStreamEncoder->uiFormat != NUM_FORMAT_COMPRESSED_UINT ) {
+		vNumStreamEncoderEncodeQuad(pnseNumStreamEncoder);
+	}
+
+	if ( (iError = iNumStreamEncoderCommitBlock(pnseNumStreamEncoder)) != NUM_NoError ) {
+		return (iError);
+	}
+
+
+	/* Flush the buffer */
+	if ( pnseNumStreamEncoder->uiBufferLength > 0 ) {
+
+		if ( (iError = pnseNumStreamEncoder->iNumStreamSink(pnseNumStreamEncoder->pvSinkContext, pnseNumStreamEncoder->pucBuffer,
+				pnseNumStreamEncoder->uiBufferLength)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		pnseNumStreamEncoder->ullByteCount += pnseNumStreamEncoder->uiBufferLength;
+		pnseNumStreamEncoder->uiBufferLength = 0;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderGetCounts()
+
+	Purpose:	Gets the number of integers added to a stream encoder and
+				the number of bytes passed to the sink so far.
+
+	Parameters:	pvNumStreamEncoder		stream encoder
+				pullIntegerCount		return pointer for the integer count (optional)
+				pullByteCount			return pointer for the byte count (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamEncoderGetCounts
+(
+	void *pvNumStreamEncoder,
+	unsigned long long *pullIntegerCount,
+	unsigned long long *pullByteCount
+)
+{
+
+	struct numStreamEncoder		*pnseNumStreamEncoder = (struct numStreamEncoder *)pvNumStreamEncoder;
+
+
+	if ( pnseNumStreamEncoder == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pullIntegerCount != NULL ) {
+		*pullIntegerCount = pnseNumStreamEncoder->ullIntegerCount;
+	}
+
+	if ( pullByteCount != NULL ) {
+		*pullByteCount = pnseNumStreamEncoder->ullByteCount;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamEncoderClose()
+
+	Purpose:	Flushes and frees a stream encoder, the encoder is freed
+				even if the flush fails.
+
+	Parameters:	pvNumStreamEncoder		stream encoder
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamEncoderClose
+(
+	void *pvNumStreamEncoder
+)
+{
+
+	struct numStreamEncoder		*pnseNumStreamEncoder = (struct numStreamEncoder *)pvNumStreamEncoder;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnseNumStreamEncoder == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Flush the encoder */
+	iError = iNumStreamEncoderFlush(pvNumStreamEncoder);
+
+
+	/* Free the encoder */
+	free(pnseNumStreamEncoder->pucBuffer);
+	free(pnseNumStreamEncoder->puiBlockValues);
+	free(pnseNumStreamEncoder->pucBlockData);
+	free(pnseNumStreamEncoder);
+
+
+	return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =================================================
+** === Number storage functions (stream decoder) ===
+** =================================================
+*/
+
+
+/* Mapped source structure */
+struct numMappedSource {
+	int					iFileDescriptor;
+	off_t				zFileLength;
+	off_t				zOffset;				/* Read offset in the file */
+	unsigned int		uiWindowLength;
+	unsigned char		*pucWindow;
+	off_t				zWindowOffset;
+	size_t				zWindowLength;
+};
+
+
+/* Stream decoder structure */
+struct numStreamDecoder {
+	unsigned int				uiFormat;
+	unsigned int				uiBlockIntegerCount;
+
+	iNumStreamSourceCallback	iNumStreamSource;
+	void						*pvSourceContext;
+	boolean						bEndOfSource;
+
+	unsigned char				*pucBuffer;				/* Input, padded by NUM_READ_PADDING_SIZE */
+	unsigned int				uiBufferCapacity;
+	unsigned int				uiBufferStart;
+	unsigned int				uiBufferEnd;
+
+	unsigned int				*puiValues;				/* Current decoded block */
+	unsigned int				uiValuesLength;
+	unsigned int				uiValuesIndex;
+
+	unsigned long long			ullIntegerCount;
+};
+
+
+/*
+
+	Function:	iNumStreamSourceFileDescriptor()
+
+	Purpose:	Source callback which reads from a file descriptor, the
+				context is a pointer to the file descriptor.
+
+	Parameters:	pvSourceContext		pointer to the file descriptor
+				pucData				where to read the data to
+				uiDataLength		length of the data
+				puiDataLengthRead	return pointer for the length of the data read
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamSourceFileDescriptor
+(
+	void *pvSourceContext,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiDataLengthRead
+)
+{
+
+	ssize_t		zBytesRead = 0;
+
+
+	if ( pvSourceContext == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDataLengthRead == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Read the data, restarting on interrupts */
+	while ( (zBytesRead = read(*((int *)pvSourceContext), pucData, uiDataLength)) == -1 ) {
+		if ( errno != EINTR ) {
+			return (NUM_SourceError);
+		}
+	}
+
+	*puiDataLengthRead = zBytesRead;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamSourceRingBuffer()
+
+	Purpose:	Source callback which reads from a ring buffer, the context
+				is the ring buffer. Waits for the producer while the ring
+				buffer is empty and has not been closed.
+
+	Parameters:	pvSourceContext		ring buffer
+				pucData				where to read the data to
+				uiDataLength		length of the data
+				puiDataLengthRead	return pointer for the length of the data read
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamSourceRingBuffer
+(
+	void *pvSourceContext,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiDataLengthRead
+)
+{
+
+	int			iError = NUM_NoError;
+	boolean		bDrained = false;
+
+
+	if ( puiDataLengthRead == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	while ( true ) {
+
+		/* Check for the end before reading so no data can slip in between */
+		if ( (iError = iNumRingBufferIsDrained(pvSourceContext, &bDrained)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( (iError = iNumRingBufferRead(pvSourceContext, pucData, uiDataLength, puiDataLengthRead)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( (*puiDataLengthRead > 0) || (bDrained == true) || (uiDataLength == 0) ) {
+			break;
+		}
+
+		sched_yield();
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumMappedSourceCreate()
+
+	Purpose:	Creates a mapped source, the file is mapped a window at a
+				time and the kernel is asked to read ahead the next window
+				while the current one is being decoded.
+
+	Parameters:	iFileDescriptor			file descriptor
+				uiWindowLength			window length, 0 for the default
+				ppvNumMappedSource		return pointer for the mapped source
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumMappedSourceCreate
+(
+	int iFileDescriptor,
+	unsigned int uiWindowLength,
+	void **ppvNumMappedSource
+)
+{
+
+	struct numMappedSource	*pnmsNumMappedSource = NULL;
+	struct stat				stStat;
+	long					lPageSize = sysconf(_SC_PAGESIZE);
+
+
+	/* Check the parameters */
+	if ( iFileDescriptor < 0 ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumMappedSource == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( fstat(iFileDescriptor, &stStat) == -1 ) {
+		return (NUM_SourceError);
+	}
+
+
+	/* Windows are a whole number of pages */
+	if ( uiWindowLength == 0 ) {
+		uiWindowLength = NUM_MAPPED_SOURCE_WINDOW_LENGTH_DEFAULT;
+	}
+	uiWindowLength = ((uiWindowLength + lPageSize - 1) / lPageSize) * lPageSize;
+
+
+	if ( (pnmsNumMappedSource = (struct numMappedSource *)calloc(1, sizeof(struct numMappedSource))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnmsNumMappedSource->iFileDescriptor = iFileDescriptor;
+	pnmsNumMappedSource->zFileLength = stStat.st_size;
+	pnmsNumMappedSource->uiWindowLength = uiWindowLength;
+
+	*ppvNumMappedSource = (void *)pnmsNumMappedSource;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumMappedSourceFree()
+
+	Purpose:	Frees a mapped source, the file descriptor is not closed.
+
+	Parameters:	pvNumMappedSource		mapped source
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumMappedSourceFree
+(
+	void *pvNumMappedSource
+)
+{
+
+	struct numMappedSource	*pnmsNumMappedSource = (struct numMappedSource *)pvNumMappedSource;
+
+
+	if ( pnmsNumMappedSource == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pnmsNumMappedSource->pucWindow != NULL ) {
+		munmap(pnmsNumMappedSource->pucWindow, pnmsNumMappedSource->zWindowLength);
+	}
+
+	free(pnmsNumMappedSource);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamSourceMapped()
+
+	Purpose:	Source callback which reads from a mapped source, the context
+				is the mapped source.
+
+	Parameters:	pvSourceContext		mapped source
+				pucData				where to read the data to
+				uiDataLength		length of the data
+				puiDataLengthRead	return pointer for the length of the data read
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamSourceMapped
+(
+	void *pvSourceContext,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiDataLengthRead
+)
+{
+
+	struct numMappedSource	*pnmsNumMappedSource = (struct numMappedSource *)pvSourceContext;
+	unsigned int			uiDataLengthRead = 0;
+	unsigned int			uiLength = 0;
+	off_t					zWindowOffset = 0;
+
+
+	if ( pnmsNumMappedSource == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDataLengthRead == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	while ( (uiDataLengthRead < uiDataLength) && (pnmsNumMappedSource->zOffset < pnmsNumMappedSource->zFileLength) ) {
+
+		/* Map the window containing the read offset */
+		if ( (pnmsNumMappedSource->pucWindow == NULL) || (pnmsNumMappedSource->zOffset >= (pnmsNumMappedSource->zWindowOffset + (off_t)pnmsNumMappedSource->zWindowLength)) ) {
+
+			if ( pnmsNumMappedSource->pucWindow != NULL ) {
+				munmap(pnmsNumMappedSource->pucWindow, pnmsNumMappedSource->zWindowLength);
+				pnmsNumMappedSource->pucWindow = NULL;
+			}
+
+			zWindowOffset = (pnmsNumMappedSource->zOffset / pnmsNumMappedSource->uiWindowLength) * pnmsNumMappedSource->uiWindowLength;
+
+			pnmsNumMappedSource->zWindowLength = pnmsNumMappedSource->uiWindowLength;
+			if ( (zWindowOffset + (off_t)pnmsNumMappedSource->zWindowLength) > pnmsNumMappedSource->zFileLength ) {
+				pnmsNumMappedSource->zWindowLength = pnmsNumMappedSource->zFileLength - zWindowOffset;
+			}
+
+			if ( (pnmsNumMappedSource->pucWindow = (unsigned char *)mmap(NULL, pnmsNumMappedSource->zWindowLength, PROT_READ, MAP_SHARED,
+					pnmsNumMappedSource->iFileDescriptor, zWindowOffset)) == MAP_FAILED ) {
+				pnmsNumMappedSource->pucWindow = NULL;
+				return (NUM_SourceError);
+			}
+
+			pnmsNumMappedSource->zWindowOffset = zWindowOffset;
+
+			/* Read ahead this window and the next one */
+			madvise(pnmsNumMappedSource->pucWindow, pnmsNumMappedSource->zWindowLength, MADV_SEQUENTIAL);
+			posix_fadvise(pnmsNumMappedSource->iFileDescriptor, zWindowOffset + pnmsNumMappedSource->zWindowLength,
+					pnmsNumMappedSource->uiWindowLength, POSIX_FADV_WILLNEED);
+		}
+
+		/* Copy what we can from the window */
+		uiLength = (pnmsNumMappedSource->zWindowOffset + pnmsNumMappedSource->zWindowLength) - pnmsNumMappedSource->zOffset;
+		if ( uiLength > (uiDataLength - uiDataLengthRead) ) {
+			uiLength = uiDataLength - uiDataLengthRead;
+		}
+
+		memcpy(pucData + uiDataLengthRead, pnmsNumMappedSource->pucWindow + (pnmsNumMappedSource->zOffset - pnmsNumMappedSource->zWindowOffset), uiLength);
+
+		uiDataLengthRead += uiLength;
+		pnmsNumMappedSource->zOffset += uiLength;
+	}
+
+	*puiDataLengthRead = uiDataLengthRead;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamDecoderCreate()
+
+	Purpose:	Creates a stream decoder. Memory use is fixed at creation,
+				the input buffer plus one decoded block.
+
+	Parameters:	uiFormat				format
+				uiBlockIntegerCount		largest number of integers per block in the stream, 0 for the default
+				uiBufferLength			input buffer length, 0 for the default
+				iNumStreamSource		source callback
+				pvSourceContext			source context
+				ppvNumStreamDecoder		return pointer for the stream decoder
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamDecoderCreate
+(
+	unsigned int uiFormat,
+	unsigned int uiBlockIntegerCount,
+	unsigned int uiBufferLength,
+	iNumStreamSourceCallback iNumStreamSource,
+	void *pvSourceContext,
+	void **ppvNumStreamDecoder
+)
+{
+
+	struct numStreamDecoder		*pnsdNumStreamDecoder = NULL;
+	unsigned int				uiBlockMaxSize = 0;
+	unsigned int				uiDecodeCount = 0;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiBlockIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( iNumStreamSource == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumStreamDecoder == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Set the defaults */
+	if ( uiBlockIntegerCount == 0 ) {
+		uiBlockIntegerCount = NUM_BLOCK_INTEGER_COUNT_DEFAULT;
+	}
+
+	if ( uiBufferLength == 0 ) {
+		uiBufferLength = NUM_STREAM_BUFFER_LENGTH_DEFAULT;
+	}
+
+	/* The buffer needs to hold at least two full blocks so each refill reads at least a full block */
+	NUM_GET_BLOCK_MAX_SIZE(uiBlockIntegerCount, uiBlockMaxSize);
+	if ( uiBufferLength < (uiBlockMaxSize * 2) ) {
+		uiBufferLength = uiBlockMaxSize * 2;
+	}
+
+	NUM_GET_BLOCK_DECODE_COUNT(uiBlockIntegerCount, uiDecodeCount);
+
+
+	/* Allocate the decoder */
+	if ( (pnsdNumStreamDecoder = (struct numStreamDecoder *)calloc(1, sizeof(struct numStreamDecoder))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	if ( (pnsdNumStreamDecoder->pucBuffer = (unsigned char *)malloc(uiBufferLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+		free(pnsdNumStreamDecoder);
+		return (NUM_MemError);
+	}
+
+	if ( (pnsdNumStreamDecoder->puiValues = (unsigned int *)malloc(uiDecodeCount * sizeof(unsigned int))) == NULL ) {
+		free(pnsdNumStreamDecoder->pucBuffer);
+		free(pnsdNumStreamDecoder);
+		return (NUM_MemError);
+	}
+
+	pnsdNumStreamDecoder->uiFormat = uiFormat;
+	pnsdNumStreamDecoder->uiBlockIntegerCount = uiBlockIntegerCount;
+	pnsdNumStreamDecoder->iNumStreamSource = iNumStreamSource;
+	pnsdNumStreamDecoder->pvSourceContext = pvSourceContext;
+	pnsdNumStreamDecoder->uiBufferCapacity = uiBufferLength;
+
+	*ppvNumStreamDecoder = (void *)pnsdNumStreamDecoder;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamDecoderRefill()
+
+	Purpose:	Makes sure there are at least a number of bytes in the input
+				buffer, moving the unread data to the start of the buffer
+				and reading from the source. Fewer bytes are available only
+				at the end of the source.
+
+	Parameters:	pnsdNumStreamDecoder	stream decoder
+				uiLength				number of bytes wanted
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumStreamDecoderRefill
+(
+	struct numStreamDecoder *pnsdNumStreamDecoder,
+	unsigned int uiLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned int	uiDataLengthRead = 0;
+
+
+	ASSERT(pnsdNumStreamDecoder != NULL);
+	ASSERT(uiLength <= pnsdNumStreamDecoder->uiBufferCapacity);
+
+
+	if ( (pnsdNumStreamDecoder->uiBufferEnd - pnsdNumStreamDecoder->uiBufferStart) >= uiLength ) {
+		return (NUM_NoError);
+	}
+
+	/* Move the unread data to the start of the buffer */
+	if ( pnsdNumStreamDecoder->uiBufferStart > 0 ) {
+		memmove(pnsdNumStreamDecoder->pucBuffer, pnsdNumStreamDecoder->pucBuffer + pnsdNumStreamDecoder->uiBufferStart,
+				pnsdNumStreamDecoder->uiBufferEnd - pnsdNumStreamDecoder->uiBufferStart);
+		pnsdNumStreamDecoder->uiBufferEnd -= pnsdNumStreamDecoder->uiBufferStart;
+		pnsdNumStreamDecoder->uiBufferStart = 0;
+	}
+
+	/* Fill the buffer */
+	while ( (pnsdNumStreamDecoder->bEndOfSource == false) && (pnsdNumStreamDecoder->uiBufferEnd < pnsdNumStreamDecoder->uiBufferCapacity) ) {
+
+		if ( (iError = pnsdNumStreamDecoder->iNumStreamSource(pnsdNumStreamDecoder->pvSourceContext, pnsdNumStreamDecoder->pucBuffer + pnsdNumStreamDecoder->uiBufferEnd,
+				pnsdNumStreamDecoder->uiBufferCapacity - pnsdNumStreamDecoder->uiBufferEnd, &uiDataLengthRead)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( uiDataLengthRead == 0 ) {
+			pnsdNumStreamDecoder->bEndOfSource = true;
+		}
+
+		pnsdNumStreamDecoder->uiBufferEnd += uiDataLengthRead;
+
+		/* Stop once we have enough, short reads are normal for pipes and ring buffers */
+		if ( pnsdNumStreamDecoder->uiBufferEnd >= uiLength ) {
+			break;
+		}
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamDecoderDecodeBlock()
+
+	Purpose:	Decodes the next block from the input buffer into an array.
+
+	Parameters:	pnsdNumStreamDecoder	stream decoder
+				puiValues				where to decode the integers, must hold the decode count
+				puiValuesLength			return pointer for the number of integers decoded
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_EndOfStream at the end of the stream
+
+*/
+static int iNumStreamDecoderDecodeBlock
+(
+	struct numStreamDecoder *pnsdNumStreamDecoder,
+	unsigned int *puiValues,
+	unsigned int *puiValuesLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned int	uiAvailable = 0;
+	unsigned int	uiIntegerCount = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiHeaderLength = 0;
+	unsigned int	uiBlockLength = 0;
+	unsigned int	uiDecodeCount = 0;
+
+
+	ASSERT(pnsdNumStreamDecoder != NULL);
+	ASSERT(puiValues != NULL);
+	ASSERT(puiValuesLength != NULL);
+
+
+	/* Make sure we have the header */
+	if ( (iError = iNumStreamDecoderRefill(pnsdNumStreamDecoder, NUM_BLOCK_HEADER_MAX_SIZE)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	uiAvailable = pnsdNumStreamDecoder->uiBufferEnd - pnsdNumStreamDecoder->uiBufferStart;
+	if ( uiAvailable == 0 ) {
+		return (NUM_EndOfStream);
+	}
+
+	if ( (iError = iNumBlockReadHeader(pnsdNumStreamDecoder->pucBuffer + pnsdNumStreamDecoder->uiBufferStart, uiAvailable,
+			&uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( uiIntegerCount > pnsdNumStreamDecoder->uiBlockIntegerCount ) {
+		return (NUM_CorruptDataError);
+	}
+
+
+	/* Make sure we have the whole block */
+	uiBlockLength = uiHeaderLength + uiBlockDataLength;
+	if ( uiBlockLength > pnsdNumStreamDecoder->uiBufferCapacity ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( (iError = iNumStreamDecoderRefill(pnsdNumStreamDecoder, uiBlockLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (pnsdNumStreamDecoder->uiBufferEnd - pnsdNumStreamDecoder->uiBufferStart) < uiBlockLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+
+	/* Decode the block, the buffer is padded so the last quad can be read safely */
+	NUM_GET_BLOCK_DECODE_COUNT(uiIntegerCount, uiDecodeCount);
+	if ( (iError = iNumBlockDecode(pnsdNumStreamDecoder->uiFormat, pnsdNumStreamDecoder->pucBuffer + pnsdNumStreamDecoder->uiBufferStart,
+			uiBlockLength, puiValues, uiDecodeCount, puiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	pnsdNumStreamDecoder->uiBufferStart += uiBlockLength;
+	pnsdNumStreamDecoder->ullIntegerCount += *puiValuesLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamDecoderNextBatch()
+
+	Purpose:	Gets the next integers from a stream decoder, whole blocks
+				are decoded straight into the array when there is room.
+
+	Parameters:	pvNumStreamDecoder		stream decoder
+				puiValues				where to put the integers
+				uiValuesCapacity		number of integers the array can hold
+				puiValuesLength			return pointer for the number of integers returned
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_EndOfStream at the end of the stream
+
+*/
+int iNumStreamDecoderNextBatch
+(
+	void *pvNumStreamDecoder,
+	unsigned int *puiValues,
+	unsigned int uiValuesCapacity,
+	unsigned int *puiValuesLength
+)
+{
+
+	struct numStreamDecoder		*pnsdNumStreamDecoder = (struct numStreamDecoder *)pvNumStreamDecoder;
+	int							iError = NUM_NoError;
+	unsigned int				uiValuesLength = 0;
+	unsigned int				uiDecodeCount = 0;
+	unsigned int				uiLength = 0;
+
+
+	/* Check the parameters */
+	if ( (pnsdNumStreamDecoder == NULL) || (puiValues == NULL) || (uiValuesCapacity == 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiValuesLength == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	NUM_GET_BLOCK_DECODE_COUNT(pnsdNumStreamDecoder->uiBlockIntegerCount, uiDecodeCount);
+
+	while ( uiValuesLength < uiValuesCapacity ) {
+
+		/* Hand out what is left of the current block */
+		if ( pnsdNumStreamDecoder->uiValuesIndex < pnsdNumStreamDecoder->uiValuesLength ) {
+
+			uiLength = pnsdNumStreamDecoder->uiValuesLength - pnsdNumStreamDecoder->uiValuesIndex;
+			if ( uiLength > (uiValuesCapacity - uiValuesLength) ) {
+				uiLength = uiValuesCapacity - uiValuesLength;
+			}
+
+			memcpy(puiValues + uiValuesLength, pnsdNumStreamDecoder->puiValues + pnsdNumStreamDecoder->uiValuesIndex, uiLength * sizeof(unsigned int));
+			pnsdNumStreamDecoder->uiValuesIndex += uiLength;
+			uiValuesLength += uiLength;
+			continue;
+		}
+
+		/* Decode the next block straight into the array if it fits, otherwise into the block array */
+		if ( (uiValuesCapacity - uiValuesLength) >= uiDecodeCount ) {
+			iError = iNumStreamDecoderDecodeBlock(pnsdNumStreamDecoder, puiValues + uiValuesLength, &uiLength);
+			if ( iError == NUM_NoError ) {
+				uiValuesLength += uiLength;
+			}
+		}
+		else {
+			iError = iNumStreamDecoderDecodeBlock(pnsdNumStreamDecoder, pnsdNumStreamDecoder->puiValues, &pnsdNumStreamDecoder->uiValuesLength);
+			pnsdNumStreamDecoder->uiValuesIndex = 0;
+			if ( iError != NUM_NoError ) {
+				pnsdNumStreamDecoder->uiValuesLength = 0;
+			}
+		}
+
+		if ( iError == NUM_EndOfStream ) {
+			break;
+		}
+		else if ( iError != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+	*puiValuesLength = uiValuesLength;
+
+
+	return ((uiValuesLength > 0) ? NUM_NoError : NUM_EndOfStream);
+
+}
+
+
+/*
+
+	Function:	iNumStreamDecoderNext()
+
+	Purpose:	Gets the next integer from a stream decoder.
+
+	Parameters:	pvNumStreamDecoder		stream decoder
+				puiValue				return pointer for the integer
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_EndOfStream at the end of the stream
+
+*/
+int iNumStreamDecoderNext
+(
+	void *pvNumStreamDecoder,
+	unsigned int *puiValue
+)
+{
+
+	struct numStreamDecoder		*pnsdNumStreamDecoder = (struct numStreamDecoder *)pvNumStreamDecoder;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnsdNumStreamDecoder == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiValue == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Decode the next block if we have used up the current one */
+	while ( pnsdNumStreamDecoder->uiValuesIndex == pnsdNumStreamDecoder->uiValuesLength ) {
+
+		pnsdNumStreamDecoder->uiValuesIndex = 0;
+		if ( (iError = iNumStreamDecoderDecodeBlock(pnsdNumStreamDecoder, pnsdNumStreamDecoder->puiValues, &pnsdNumStreamDecoder->uiValuesLength)) != NUM_NoError ) {
+			pnsdNumStreamDecoder->uiValuesLength = 0;
+			return (iError);
+		}
+	}
+
+	*puiValue = pnsdNumStreamDecoder->puiValues[pnsdNumStreamDecoder->uiValuesIndex];
+	pnsdNumStreamDecoder->uiValuesIndex++;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamDecoderFree()
+
+	Purpose:	Frees a stream decoder, the source is not closed.
+
+	Parameters:	pvNumStreamDecoder		stream decoder
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamDecoderFree
+(
+	void *pvNumStreamDecoder
+)
+{
+
+	struct numStreamDecoder		*pnsdNumStreamDecoder = (struct numStreamDecoder *)pvNumStreamDecoder;
+
+
+	if ( pnsdNumStreamDecoder == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	free(pnsdNumStreamDecoder->puiValues);
+	free(pnsdNumStreamDecoder->pucBuffer);
+	free(pnsdNumStreamDecoder);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ========================================
+** === Number storage functions (merge) ===
+** ========================================
+*/
+
+
+/* Merge input structure, a stream decoder and a batch of its integers */
+struct numMergeInput {
+	void				*pvNumStreamDecoder;
+	unsigned int		*puiValues;
+	unsigned int		uiValuesLength;
+	unsigned int		uiValuesIndex;
+	boolean				bEndOfStream;
+};
+
+
+/* Macro to check whether an input comes before another in a merge, inputs at
+** the end of their stream come last, and ties go to the lower input so the
+** merge is stable
+*/
+#define NUM_MERGE_INPUT_BEFORE(pnmiNumMergeInputs, uiMacroInput1, uiMacroInput2) \
+	(((pnmiNumMergeInputs)[uiMacroInput1].bEndOfStream == false) && \
+			(((pnmiNumMergeInputs)[uiMacroInput2].bEndOfStream == true) || \
+			((pnmiNumMergeInputs)[uiMacroInput1].puiValues[(pnmiNumMergeInputs)[uiMacroInput1].uiValuesIndex] < \
+					(pnmiNumMergeInputs)[uiMacroInput2].puiValues[(pnmiNumMergeInputs)[uiMacroInput2].uiValuesIndex]) || \
+			(((pnmiNumMergeInputs)[uiMacroInput1].puiValues[(pnmiNumMergeInputs)[uiMacroInput1].uiValuesIndex] == \
+					(pnmiNumMergeInputs)[uiMacroInput2].puiValues[(pnmiNumMergeInputs)[uiMacroInput2].uiValuesIndex]) && \
+					((uiMacroInput1) < (uiMacroInput2)))))
+
+
+/*
+
+	Function:	iNumMergeInputAdvance()
+
+	Purpose:	Moves a merge input on to its next integer, decoding the next
+				batch when the current one is used up, and checks that the
+				input is sorted.
+
+	Parameters:	pnmiNumMergeInput	merge input
+				uiBatchLength		number of integers in a batch
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumMergeInputAdvance
+(
+	struct numMergeInput *pnmiNumMergeInput,
+	unsigned int uiBatchLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned int	uiValue = 0;
+
+
+	ASSERT(pnmiNumMergeInput != NULL);
+	ASSERT(pnmiNumMergeInput->bEndOfStream == false);
+
+
+	uiValue = pnmiNumMergeInput->puiValues[pnmiNumMergeInput->uiValuesIndex];
+
+	if ( ++pnmiNumMergeInput->uiValuesIndex == pnmiNumMergeInput->uiValuesLength ) {
+
+		pnmiNumMergeInput->uiValuesIndex = 0;
+		pnmiNumMergeInput->uiValuesLength = 0;
+
+		iError = iNumStreamDecoderNextBatch(pnmiNumMergeInput->pvNumStreamDecoder, pnmiNumMergeInput->puiValues, uiBatchLength, &pnmiNumMergeInput->uiValuesLength);
+
+		if ( iError == NUM_EndOfStream ) {
+			pnmiNumMergeInput->bEndOfStream = true;
+			return (NUM_NoError);
+		}
+		else if ( iError != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+	/* The inputs have to be sorted for the merge to be sorted */
+	if ( pnmiNumMergeInput->puiValues[pnmiNumMergeInput->uiValuesIndex] < uiValue ) {
+		return (NUM_CorruptDataError);
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumMergeStreamsTree()
+
+	Purpose:	Merges the inputs into a stream encoder with a loser tree,
+				the inputs have their first batch.
+
+	Parameters:	pnmiNumMergeInputs		merge inputs, a power of two of them
+				uiLeafCount				number of merge inputs
+				puiTree					tree, uiLeafCount entries
+				puiWinners				winners, uiLeafCount * 2 entries
+				puiValues				output batch
+				uiBatchLength			number of integers in a batch
+				bUnique					set to write integers in several streams once
+				pvNumStreamEncoder		stream encoder
+				pullIntegerCount		return pointer for the number of integers written
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumMergeStreamsTree
+(
+	struct numMergeInput *pnmiNumMergeInputs,
+	unsigned int uiLeafCount,
+	unsigned int *puiTree,
+	unsigned int *puiWinners,
+	unsigned int *puiValues,
+	unsigned int uiBatchLength,
+	boolean bUnique,
+	void *pvNumStreamEncoder,
+	unsigned long long *pullIntegerCount
+)
+{
+
+	unsigned int	uiValuesLength = 0;
+	unsigned int	uiInput = 0;
+	unsigned int	uiNode = 0;
+	unsigned int	uiLoser = 0;
+	unsigned int	uiValue = 0;
+	unsigned int	uiLastValue = 0;
+	int				iError = NUM_NoError;
+
+
+	ASSERT(pnmiNumMergeInputs != NULL);
+	ASSERT(puiTree != NULL);
+	ASSERT(puiWinners != NULL);
+	ASSERT(puiValues != NULL);
+	ASSERT(pullIntegerCount != NULL);
+
+
+	/* Build the tree bottom up, keeping the loser of each match and passing the winner up */
+	for ( uiInput = 0; uiInput < uiLeafCount; uiInput++ ) {
+		puiWinners[uiLeafCount + uiInput] = uiInput;
+	}
+
+	for ( uiNode = uiLeafCount - 1; uiNode > 0; uiNode-- ) {
+		if ( NUM_MERGE_INPUT_BEFORE(pnmiNumMergeInputs, puiWinners[uiNode * 2], puiWinners[(uiNode * 2) + 1]) ) {
+			puiWinners[uiNode] = puiWinners[uiNode * 2];
+			puiTree[uiNode] = puiWinners[(uiNode * 2) + 1];
+		}
+		else {
+			puiWinners[uiNode] = puiWinners[(uiNode * 2) + 1];
+			puiTree[uiNode] = puiWinners[uiNode * 2];
+		}
+	}
+
+	puiTree[0] = (uiLeafCount > 1) ? puiWinners[1] : 0;
+
+
+	/* Take the winner until all the inputs are at the end of their stream */
+	while ( pnmiNumMergeInputs[puiTree[0]].bEndOfStream == false ) {
+
+		uiInput = puiTree[0];
+		uiValue = pnmiNumMergeInputs[uiInput].puiValues[pnmiNumMergeInputs[uiInput].uiValuesIndex];
+
+		if ( (bUnique == false) || (*pullIntegerCount == 0) || (uiValue != uiLastValue) ) {
+
+			puiValues[uiValuesLength++] = uiValue;
+			uiLastValue = uiValue;
+			(*pullIntegerCount)++;
+
+			if ( uiValuesLength == uiBatchLength ) {
+				if ( (iError = iNumStreamEncoderAddIntegers(pvNumStreamEncoder, puiValues, uiValuesLength)) != NUM_NoError ) {
+					return (iError);
+				}
+				uiValuesLength = 0;
+			}
+		}
+
+		if ( (iError = iNumMergeInputAdvance(pnmiNumMergeInputs + uiInput, uiBatchLength)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		/* Replay the matches from the winner's leaf to the root, the winner of each match carries on up */
+		for ( uiNode = (uiLeafCount + uiInput) / 2; uiNode > 0; uiNode /= 2 ) {
+			if ( NUM_MERGE_INPUT_BEFORE(pnmiNumMergeInputs, puiTree[uiNode], uiInput) ) {
+				uiLoser = uiInput;
+				uiInput = puiTree[uiNode];
+				puiTree[uiNode] = uiLoser;
+			}
+		}
+
+		puiTree[0] = uiInput;
+	}
+
+	if ( uiValuesLength > 0 ) {
+		if ( (iError = iNumStreamEncoderAddIntegers(pvNumStreamEncoder, puiValues, uiValuesLength)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumMergeStreams()
+
+	Purpose:	Merges sorted streams into a stream encoder with a loser tree,
+				a k-way merge which takes log2(k) comparisons per integer.
+
+				The inputs are stream decoders, each buffering a batch of
+				integers, and the merged integers are buffered into batches
+				for the encoder, so a merge uses a bounded amount of memory
+				however long the streams are. The encoder is not flushed so
+				more integers can be added to it after the merge.
+
+				Integers which are in several streams are written once for
+				each stream, or once if unique is set, the merge stops with
+				NUM_CorruptDataError if a stream is not sorted.
+
+	Parameters:	ppvNumStreamDecoders	stream decoders
+				uiStreamCount			number of stream decoders
+				uiBatchLength			number of integers in a batch, 0 for the default
+				bUnique					set to write integers in several streams once
+				pvNumStreamEncoder		stream encoder
+				pullIntegerCount		return pointer for the number of integers written
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumMergeStreams
+(
+	void **ppvNumStreamDecoders,
+	unsigned int uiStreamCount,
+	unsigned int uiBatchLength,
+	boolean bUnique,
+	void *pvNumStreamEncoder,
+	unsigned long long *pullIntegerCount
+)
+{
+
+	struct numMergeInput	*pnmiNumMergeInputs = NULL;
+	unsigned int			*puiTree = NULL;				/* Losers, the winner is at 0 */
+	unsigned int			*puiWinners = NULL;
+	unsigned int			*puiValues = NULL;				/* Output batch followed by the input batches */
+	unsigned int			uiLeafCount = 1;
+	unsigned int			uiInput = 0;
+	int						iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( (ppvNumStreamDecoders == NULL) || (uiStreamCount == 0) || (pvNumStreamEncoder == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pullIntegerCount == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+	for ( uiInput = 0; uiInput < uiStreamCount; uiInput++ ) {
+		if ( ppvNumStreamDecoders[uiInput] == NULL ) {
+			return (NUM_InvalidParameter);
+		}
+	}
+
+
+	/* Default the batch length */
+	uiBatchLength = (uiBatchLength > 0) ? uiBatchLength : NUM_MERGE_BATCH_LENGTH_DEFAULT;
+
+	*pullIntegerCount = 0;
+
+
+	/* The tree has a power of two leaves, the leaves past the streams are inputs at the end of their stream */
+	while ( uiLeafCount < uiStreamCount ) {
+		uiLeafCount *= 2;
+	}
+
+	if ( ((pnmiNumMergeInputs = calloc(uiLeafCount, sizeof(struct numMergeInput))) == NULL) ||
+			((puiTree = malloc(uiLeafCount * sizeof(unsigned int))) == NULL) ||
+			((puiWinners = malloc(uiLeafCount * 2 * sizeof(unsigned int))) == NULL) ||
+			((puiValues = malloc(uiBatchLength * sizeof(unsigned int) * (uiStreamCount + 1))) == NULL) ) {
+		iError = NUM_MemError;
+	}
+
+
+	/* Set up the inputs, each with the first batch of its stream */
+	for ( uiInput = 0; (iError == NUM_NoError) && (uiInput < uiLeafCount); uiInput++ ) {
+
+		if ( uiInput >= uiStreamCount ) {
+			pnmiNumMergeInputs[uiInput].bEndOfStream = true;
+			continue;
+		}
+
+		pnmiNumMergeInputs[uiInput].pvNumStreamDecoder = ppvNumStreamDecoders[uiInput];
+		pnmiNumMergeInputs[uiInput].puiValues = puiValues + ((uiInput + 1) * uiBatchLength);
+
+		iError = iNumStreamDecoderNextBatch(pnmiNumMergeInputs[uiInput].pvNumStreamDecoder, pnmiNumMergeInputs[uiInput].puiValues, uiBatchLength,
+				&pnmiNumMergeInputs[uiInput].uiValuesLength);
+
+		if ( iError == NUM_EndOfStream ) {
+			pnmiNumMergeInputs[uiInput].bEndOfStream = true;
+			iError = NUM_NoError;
+		}
+	}
+
+
+	/* Merge */
+	if ( iError == NUM_NoError ) {
+		iError = iNumMergeStreamsTree(pnmiNumMergeInputs, uiLeafCount, puiTree, puiWinners, puiValues, uiBatchLength, bUnique, pvNumStreamEncoder, pullIntegerCount);
+	}
+
+
+	free(pnmiNumMergeInputs);
+	free(puiTree);
+	free(puiWinners);
+	free(puiValues);
+
+
+	return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ============================================
+** === Number storage functions (transcode) ===
+** ============================================
+*/
+
+
+/*
+
+	Function:	iNumBlockTranscode()
+
+	Purpose:	Transcodes a block from one format to another.
+
+				Fixed width blocks are the same in every format and are
+				copied, as are blocks whose format does not change, other
+				blocks are decoded with the bulk decoders into an array the
+				size of the block and encoded again, integers too large for
+				the target format give NUM_ValueOverflowError.
+
+				The data must be followed by NUM_READ_PADDING_SIZE readable
+				bytes, and the target data must be at least
+				NUM_GET_BLOCK_MAX_SIZE() bytes long for the integer count in
+				the block header.
+
+	Parameters:	uiSourceFormat			format of the block
+				pucData					block to transcode
+				uiDataLength			length of the data
+				uiTargetFormat			format to transcode to
+				pucTargetData			where to write the transcoded block
+				puiTargetDataLength		return pointer for the length of the transcoded block
+				puiBlockLength			return pointer for the length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumBlockTranscode
+(
+	unsigned int uiSourceFormat,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int uiTargetFormat,
+	unsigned char *pucTargetData,
+	unsigned int *puiTargetDataLength,
+	unsigned int *puiBlockLength
+)
+{
+
+	int				iError = NUM_NoError;
+	unsigned int	puiBlockValues[NUM_BLOCK_INTEGER_COUNT_DEFAULT];
+	unsigned int	*puiValues = puiBlockValues;
+	unsigned int	uiValuesLength = 0;
+	unsigned int	uiIntegerCount = 0;
+	unsigned int	uiWidth = NUM_BLOCK_WIDTH_VARIABLE;
+	unsigned int	uiDecodeCount = 0;
+	unsigned int	uiBlockDataLength = 0;
+	unsigned int	uiHeaderLength = 0;
+
+
+	/* Check the parameters */
+	if ( (NUM_FORMAT_VALID(uiSourceFormat) == false) || (NUM_FORMAT_VALID(uiTargetFormat) == false) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pucData == NULL) || (pucTargetData == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiTargetDataLength == NULL) || (puiBlockLength == NULL) ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Read the header */
+	if ( (iError = iNumBlockReadHeader(pucData, uiDataLength, &uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (uiHeaderLength + uiBlockDataLength) > uiDataLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+
+	/* Copy the block if it reads the same in the target format */
+	if ( (uiSourceFormat == uiTargetFormat) || (NUM_BLOCK_WIDTH_FIXED(uiWidth) == true) ) {
+		memcpy(pucTargetData, pucData, uiHeaderLength + uiBlockDataLength);
+		*puiTargetDataLength = uiHeaderLength + uiBlockDataLength;
+		*puiBlockLength = uiHeaderLength + uiBlockDataLength;
+		return (NUM_NoError);
+	}
+
+
+	/* Decode the block and encode it again, blocks larger than the default go through an allocated array */
+	NUM_GET_BLOCK_DECODE_COUNT(uiIntegerCount, uiDecodeCount);
+
+	if ( uiDecodeCount > NUM_BLOCK_INTEGER_COUNT_DEFAULT ) {
+		if ( (puiValues = malloc(uiDecodeCount * sizeof(unsigned int))) == NULL ) {
+			return (NUM_MemError);
+		}
+	}
+
+	if ( (iError = iNumBlockDecode(uiSourceFormat, pucData, uiDataLength, puiValues, uiDecodeCount, &uiValuesLength, puiBlockLength)) == NUM_NoError ) {
+		iError = iNumBlockEncode(uiTargetFormat, puiValues, uiValuesLength, pucTargetData, puiTargetDataLength);
+	}
+
+	if ( puiValues != puiBlockValues ) {
+		free(puiValues);
+	}
+
+
+	return (iError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamTranscode()
+
+	Purpose:	Transcodes a stream from one format to another, a stream
+				decoder feeds a stream encoder a block at a time so only a
+				block of integers is held however long the stream is. Files
+				are transcoded with the file descriptor or mapped sources and
+				the file descriptor sink.
+
+	Parameters:	uiSourceFormat				format of the stream
+				uiSourceBlockIntegerCount	largest number of integers per block in the stream, 0 for the default
+				iNumStreamSource			source callback
+				pvSourceContext				source context
+				uiTargetFormat				format to transcode to
+				uiTargetBlockIntegerCount	number of integers per block in the target, 0 for the default
+				iNumStreamSink				sink callback
+				pvSinkContext				sink context
+				pullIntegerCount			return pointer for the number of integers transcoded
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamTranscode
+(
+	unsigned int uiSourceFormat,
+	unsigned int uiSourceBlockIntegerCount,
+	iNumStreamSourceCallback iNumStreamSource,
+	void *pvSourceContext,
+	unsigned int uiTargetFormat,
+	unsigned int uiTargetBlockIntegerCount,
+	iNumStreamSinkCallback iNumStreamSink,
+	void *pvSinkContext,
+	unsigned long long *pullIntegerCount
+)
+{
+
+	int				iError = NUM_NoError;
+	int				iCloseError = NUM_NoError;
+	void			*pvNumStreamDecoder = NULL;
+	void			*pvNumStreamEncoder = NULL;
+	unsigned int	*puiValues = NULL;
+	unsigned int	uiValuesLength = 0;
+
+
+	/* Check the parameters */
+	if ( (NUM_FORMAT_VALID(uiSourceFormat) == false) || (NUM_FORMAT_VALID(uiTargetFormat) == false) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (iNumStreamSource == NULL) || (iNumStreamSink == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (uiSourceBlockIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX) || (uiTargetBlockIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pullIntegerCount == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Default the target block integer count */
+	uiTargetBlockIntegerCount = (uiTargetBlockIntegerCount > 0) ? uiTargetBlockIntegerCount : NUM_BLOCK_INTEGER_COUNT_DEFAULT;
+
+	*pullIntegerCount = 0;
+
+
+	/* Create the decoder and the encoder */
+	if ( (puiValues = malloc(uiTargetBlockIntegerCount * sizeof(unsigned int))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	if ( (iError = iNumStreamDecoderCreate(uiSourceFormat, uiSourceBlockIntegerCount, 0, iNumStreamSource, pvSourceContext, &pvNumStreamDecoder)) != NUM_NoError ) {
+		free(puiValues);
+		return (iError);
+	}
+
+	if ( (iError = iNumStreamEncoderCreate(uiTargetFormat, uiTargetBlockIntegerCount, 0, iNumStreamSink, pvSinkContext, &pvNumStreamEncoder)) != NUM_NoError ) {
+		iNumStreamDecoderFree(pvNumStreamDecoder);
+		free(puiValues);
+		return (iError);
+	}
+
+
+	/* Transcode a target block at a time */
+	while ( (iError = iNumStreamDecoderNextBatch(pvNumStreamDecoder, puiValues, uiTargetBlockIntegerCount, &uiValuesLength)) == NUM_NoError ) {
+
+		if ( (iError = iNumStreamEncoderAddIntegers(pvNumStreamEncoder, puiValues, uiValuesLength)) != NUM_NoError ) {
+			break;
+		}
+
+		*pullIntegerCount += uiValuesLength;
+	}
+
+	if ( iError == NUM_EndOfStream ) {
+		iError = NUM_NoError;
+	}
+
+
+	/* Close the encoder, which flushes it */
+	iCloseError = iNumStreamEncoderClose(pvNumStreamEncoder);
+	iNumStreamDecoderFree(pvNumStreamDecoder);
+	free(puiValues);
+
+
+	return ((iError != NUM_NoError) ? iError : iCloseError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =======================================
+** === Number storage functions (list) ===
+** =======================================
+*/
+
+
+/* A list is a sequence of full blocks followed by a tail of integers which
+** are kept decoded until there are enough to fill a block, so appends only
+** ever encode the tail. The blocks are kept in one buffer, each in a slot
+** with some slack after it, and as every block but the tail is full the
+** block holding an integer is found by dividing its index. An update
+** decodes and encodes only the block holding the integer, rewriting it in
+** its slot if it still fits, or moving it to a new slot at the end of the
+** buffer if not, the buffer is compacted once the abandoned slots add up
+** to more than the blocks.
+*/
+
+
+/* List block structure, the slot of a block in the buffer */
+struct numListBlock {
+	unsigned long long	ullOffset;
+	unsigned int		uiDataLength;
+	unsigned int		uiDataCapacity;
+};
+
+
+/* List structure */
+struct numList {
+	unsigned int			uiFormat;
+	unsigned int			uiBlockIntegerCount;
+	unsigned int			uiBlockSlack;
+
+	struct numListBlock		*pnlbNumListBlocks;
+	unsigned int			uiBlocksLength;
+	unsigned int			uiBlocksCapacity;
+
+	unsigned char			*pucData;				/* Blocks, padded by NUM_READ_PADDING_SIZE */
+	unsigned long long		ullDataLength;
+	unsigned long long		ullDataCapacity;
+	unsigned long long		ullAbandonedLength;		/* Slots abandoned by blocks which outgrew them */
+
+	unsigned int			*puiTailValues;			/* Integers which do not fill a block yet */
+	unsigned int			uiTailLength;
+
+	unsigned int			*puiBlockValues;		/* Decoded block, for gets and updates */
+	unsigned int			uiBlockValuesIndex;		/* Block held in the decoded block, or UINT_MAX */
+	unsigned char			*pucBlockData;			/* Encoded block, NUM_GET_BLOCK_MAX_SIZE() long */
+
+	unsigned long long		ullBlockRewriteCount;
+};
+
+
+/*
+
+	Function:	iNumListCreate()
+
+	Purpose:	Creates a list.
+
+	Parameters:	uiFormat				format
+				uiBlockIntegerCount		number of integers per block, 0 for the default
+				uiBlockSlack			bytes reserved after each block for updates, 0 for the default
+				ppvNumList				return pointer for the list
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListCreate
+(
+	unsigned int uiFormat,
+	unsigned int uiBlockIntegerCount,
+	unsigned int uiBlockSlack,
+	void **ppvNumList
+)
+{
+
+	struct numList	*pnlNumList = NULL;
+	unsigned int	uiDecodeCount = 0;
+	unsigned int	uiMaxSize = 0;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( uiBlockIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumList == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Default the block integer count and the slack */
+	uiBlockIntegerCount = (uiBlockIntegerCount > 0) ? uiBlockIntegerCount : NUM_BLOCK_INTEGER_COUNT_DEFAULT;
+	uiBlockSlack = (uiBlockSlack > 0) ? uiBlockSlack : NUM_LIST_BLOCK_SLACK_DEFAULT;
+
+	NUM_GET_BLOCK_DECODE_COUNT(uiBlockIntegerCount, uiDecodeCount);
+	NUM_GET_BLOCK_MAX_SIZE(uiBlockIntegerCount, uiMaxSize);
+
+
+	/* Allocate the list */
+	if ( (pnlNumList = calloc(1, sizeof(struct numList))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnlNumList->uiFormat = uiFormat;
+	pnlNumList->uiBlockIntegerCount = uiBlockIntegerCount;
+	pnlNumList->uiBlockSlack = uiBlockSlack;
+	pnlNumList->uiBlockValuesIndex = UINT_MAX;
+
+	if ( ((pnlNumList->puiTailValues = malloc(uiBlockIntegerCount * sizeof(unsigned int))) == NULL) ||
+			((pnlNumList->puiBlockValues = malloc(uiDecodeCount * sizeof(unsigned int))) == NULL) ||
+			((pnlNumList->pucBlockData = malloc(uiMaxSize)) == NULL) ) {
+		iNumListFree(pnlNumList);
+		return (NUM_MemError);
+	}
+
+
+	*ppvNumList = (void *)pnlNumList;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListAddSlot()
+
+	Purpose:	Adds a slot for a block at the end of the buffer and copies
+				the encoded block into it, growing the buffer if needed.
+
+	Parameters:	pnlNumList		list
+				pucData			encoded block
+				uiDataLength	length of the encoded block
+				pnlbNumListBlock	block to set the slot of
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumListAddSlot
+(
+	struct numList *pnlNumList,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	struct numListBlock *pnlbNumListBlock
+)
+{
+
+	unsigned char		*pucNewData = NULL;
+	unsigned long long	ullNewCapacity = 0;
+	unsigned int		uiDataCapacity = uiDataLength + pnlNumList->uiBlockSlack;
+
+
+	ASSERT(pnlNumList != NULL);
+	ASSERT(pucData != NULL);
+	ASSERT(pnlbNumListBlock != NULL);
+
+
+	/* Grow the buffer, doubling it so appends take amortized constant time */
+	if ( (pnlNumList->ullDataLength + uiDataCapacity + NUM_READ_PADDING_SIZE) > pnlNumList->ullDataCapacity ) {
+
+		ullNewCapacity = (pnlNumList->ullDataCapacity > 0) ? (pnlNumList->ullDataCapacity * 2) : 4096;
+		while ( ullNewCapacity < (pnlNumList->ullDataLength + uiDataCapacity + NUM_READ_PADDING_SIZE) ) {
+			ullNewCapacity *= 2;
+		}
+
+		if ( (pucNewData = realloc(pnlNumList->pucData, ullNewCapacity)) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnlNumList->pucData = pucNewData;
+		pnlNumList->ullDataCapacity = ullNewCapacity;
+	}
+
+
+	/* Copy the block into the slot, zeroing the slack so the padding after the last block is readable */
+	memcpy(pnlNumList->pucData + pnlNumList->ullDataLength, pucData, uiDataLength);
+	memset(pnlNumList->pucData + pnlNumList->ullDataLength + uiDataLength, 0, pnlNumList->uiBlockSlack + NUM_READ_PADDING_SIZE);
+
+	pnlbNumListBlock->ullOffset = pnlNumList->ullDataLength;
+	pnlbNumListBlock->uiDataLength = uiDataLength;
+	pnlbNumListBlock->uiDataCapacity = uiDataCapacity;
+
+	pnlNumList->ullDataLength += uiDataCapacity;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListCompact()
+
+	Purpose:	Compacts the buffer of a list, copying the blocks into new
+				slots in order and dropping the abandoned slots.
+
+	Parameters:	pnlNumList		list
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumListCompact
+(
+	struct numList *pnlNumList
+)
+{
+
+	unsigned char		*pucNewData = NULL;
+	unsigned long long	ullNewDataLength = 0;
+	unsigned int		uiDataCapacity = 0;
+	unsigned int		uiI = 0;
+
+
+	ASSERT(pnlNumList != NULL);
+
+
+	/* Allocate a new buffer for the blocks without the abandoned slots, keeping the same capacity */
+	if ( (pucNewData = malloc(pnlNumList->ullDataCapacity)) == NULL ) {
+		return (NUM_MemError);
+	}
+
+
+	/* Copy the blocks into new slots in order, each slot shrinks to the block and the slack */
+	for ( uiI = 0; uiI < pnlNumList->uiBlocksLength; uiI++ ) {
+
+		uiDataCapacity = pnlNumList->pnlbNumListBlocks[uiI].uiDataLength + pnlNumList->uiBlockSlack;
+
+		memcpy(pucNewData + ullNewDataLength, pnlNumList->pucData + pnlNumList->pnlbNumListBlocks[uiI].ullOffset, pnlNumList->pnlbNumListBlocks[uiI].uiDataLength);
+		memset(pucNewData + ullNewDataLength + pnlNumList->pnlbNumListBlocks[uiI].uiDataLength, 0, pnlNumList->uiBlockSlack);
+
+		pnlNumList->pnlbNumListBlocks[uiI].ullOffset = ullNewDataLength;
+		pnlNumList->pnlbNumListBlocks[uiI].uiDataCapacity = uiDataCapacity;
+
+		ullNewDataLength += uiDataCapacity;
+	}
+
+	memset(pucNewData + ullNewDataLength, 0, NUM_READ_PADDING_SIZE);
+
+
+	free(pnlNumList->pucData);
+
+	pnlNumList->pucData = pucNewData;
+	pnlNumList->ullDataLength = ullNewDataLength;
+	pnlNumList->ullAbandonedLength = 0;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListSealTail()
+
+	Purpose:	Encodes the tail of a list, which is full, into a new block.
+
+	Parameters:	pnlNumList		list
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumListSealTail
+(
+	struct numList *pnlNumList
+)
+{
+
+	struct numListBlock		*pnlbNewNumListBlocks = NULL;
+	unsigned int			uiNewBlocksCapacity = 0;
+	unsigned int			uiDataLength = 0;
+	int						iError = NUM_NoError;
+
+
+	ASSERT(pnlNumList != NULL);
+	ASSERT(pnlNumList->uiTailLength == pnlNumList->uiBlockIntegerCount);
+
+
+	/* Grow the blocks */
+	if ( pnlNumList->uiBlocksLength == pnlNumList->uiBlocksCapacity ) {
+
+		if ( pnlNumList->uiBlocksCapacity == UINT_MAX ) {
+			return (NUM_ValueOverflowError);
+		}
+
+		uiNewBlocksCapacity = (pnlNumList->uiBlocksCapacity > 0) ? ((pnlNumList->uiBlocksCapacity < (UINT_MAX / 2)) ? (pnlNumList->uiBlocksCapacity * 2) : UINT_MAX) : 64;
+
+		if ( (pnlbNewNumListBlocks = realloc(pnlNumList->pnlbNumListBlocks, uiNewBlocksCapacity * sizeof(struct numListBlock))) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnlNumList->pnlbNumListBlocks = pnlbNewNumListBlocks;
+		pnlNumList->uiBlocksCapacity = uiNewBlocksCapacity;
+	}
+
+
+	/* Encode the tail and add it in a new slot */
+	if ( (iError = iNumBlockEncode(pnlNumList->uiFormat, pnlNumList->puiTailValues, pnlNumList->uiTailLength, pnlNumList->pucBlockData, &uiDataLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (iError = iNumListAddSlot(pnlNumList, pnlNumList->pucBlockData, uiDataLength, pnlNumList->pnlbNumListBlocks + pnlNumList->uiBlocksLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	pnlNumList->uiBlocksLength++;
+	pnlNumList->uiTailLength = 0;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListDecodeBlock()
+
+	Purpose:	Decodes a block of a list into the decoded block, unless it
+				is there already.
+
+	Parameters:	pnlNumList		list
+				uiBlock			block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumListDecodeBlock
+(
+	struct numList *pnlNumList,
+	unsigned int uiBlock
+)
+{
+
+	struct numListBlock		*pnlbNumListBlock = NULL;
+	unsigned int			uiDecodeCount = 0;
+	unsigned int			uiValuesLength = 0;
+	unsigned int			uiBlockLength = 0;
+	int						iError = NUM_NoError;
+
+
+	ASSERT(pnlNumList != NULL);
+	ASSERT(uiBlock < pnlNumList->uiBlocksLength);
+
+
+	if ( pnlNumList->uiBlockValuesIndex == uiBlock ) {
+		return (NUM_NoError);
+	}
+
+	pnlbNumListBlock = pnlNumList->pnlbNumListBlocks + uiBlock;
+
+	NUM_GET_BLOCK_DECODE_COUNT(pnlNumList->uiBlockIntegerCount, uiDecodeCount);
+
+	pnlNumList->uiBlockValuesIndex = UINT_MAX;
+
+	if ( (iError = iNumBlockDecode(pnlNumList->uiFormat, pnlNumList->pucData + pnlbNumListBlock->ullOffset, pnlbNumListBlock->uiDataLength,
+			pnlNumList->puiBlockValues, uiDecodeCount, &uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( uiValuesLength != pnlNumList->uiBlockIntegerCount ) {
+		return (NUM_CorruptDataError);
+	}
+
+	pnlNumList->uiBlockValuesIndex = uiBlock;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListAppend()
+
+	Purpose:	Appends integers to a list, they go into the tail and the
+				tail is encoded into a block each time it fills up.
+
+	Parameters:	pvNumList			list
+				puiValues			integers to append
+				uiValuesLength		number of integers to append
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListAppend
+(
+	void *pvNumList,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength
+)
+{
+
+	struct numList	*pnlNumList = (struct numList *)pvNumList;
+	unsigned int	uiLength = 0;
+	unsigned int	uiI = 0;
+	int				iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnlNumList == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiValues == NULL) && (uiValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Check that the integers fit in a compact varint before any are appended */
+	if ( pnlNumList->uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			if ( puiValues[uiI] > NUM_COMPACT_VARINT_MAX_VALUE ) {
+				return (NUM_ValueOverflowError);
+			}
+		}
+	}
+
+
+	/* Fill the tail, sealing it into a block when it is full */
+	for ( uiI = 0; uiI < uiValuesLength; uiI += uiLength ) {
+
+		if ( pnlNumList->uiTailLength == pnlNumList->uiBlockIntegerCount ) {
+			if ( (iError = iNumListSealTail(pnlNumList)) != NUM_NoError ) {
+				return (iError);
+			}
+		}
+
+		uiLength = pnlNumList->uiBlockIntegerCount - pnlNumList->uiTailLength;
+		uiLength = (uiLength < (uiValuesLength - uiI)) ? uiLength : (uiValuesLength - uiI);
+
+		memcpy(pnlNumList->puiTailValues + pnlNumList->uiTailLength, puiValues + uiI, uiLength * sizeof(unsigned int));
+		pnlNumList->uiTailLength += uiLength;
+	}
+
+	if ( pnlNumList->uiTailLength == pnlNumList->uiBlockIntegerCount ) {
+		if ( (iError = iNumListSealTail(pnlNumList)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListGet()
+
+	Purpose:	Gets an integer from a list.
+
+	Parameters:	pvNumList		list
+				ullIndex		index of the integer
+				puiValue		return pointer for the integer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListGet
+(
+	void *pvNumList,
+	unsigned long long ullIndex,
+	unsigned int *puiValue
+)
+{
+
+	struct numList		*pnlNumList = (struct numList *)pvNumList;
+	unsigned long long	ullBlock = 0;
+	unsigned int		uiIndex = 0;
+	int					iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnlNumList == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiValue == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Every block but the tail is full */
+	ullBlock = ullIndex / pnlNumList->uiBlockIntegerCount;
+	uiIndex = ullIndex % pnlNumList->uiBlockIntegerCount;
+
+	if ( ullBlock == pnlNumList->uiBlocksLength ) {
+		if ( uiIndex >= pnlNumList->uiTailLength ) {
+			return (NUM_InvalidParameter);
+		}
+		*puiValue = pnlNumList->puiTailValues[uiIndex];
+		return (NUM_NoError);
+	}
+	else if ( ullBlock > pnlNumList->uiBlocksLength ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (iError = iNumListDecodeBlock(pnlNumList, (unsigned int)ullBlock)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	*puiValue = pnlNumList->puiBlockValues[uiIndex];
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListUpdate()
+
+	Purpose:	Updates an integer in a list, only the block holding the
+				integer is decoded and encoded again. The block is rewritten
+				in its slot if it fits, and moved to a new slot at the end
+				of the buffer if not.
+
+	Parameters:	pvNumList		list
+				ullIndex		index of the integer
+				uiValue			integer
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListUpdate
+(
+	void *pvNumList,
+	unsigned long long ullIndex,
+	unsigned int uiValue
+)
+{
+
+	struct numList			*pnlNumList = (struct numList *)pvNumList;
+	struct numListBlock		*pnlbNumListBlock = NULL;
+	unsigned long long		ullBlock = 0;
+	unsigned int			uiIndex = 0;
+	unsigned int			uiDataLength = 0;
+	unsigned int			uiDataCapacity = 0;
+	int						iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnlNumList == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pnlNumList->uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (uiValue > NUM_COMPACT_VARINT_MAX_VALUE) ) {
+		return (NUM_ValueOverflowError);
+	}
+
+
+	/* Integers in the tail are still decoded */
+	ullBlock = ullIndex / pnlNumList->uiBlockIntegerCount;
+	uiIndex = ullIndex % pnlNumList->uiBlockIntegerCount;
+
+	if ( ullBlock == pnlNumList->uiBlocksLength ) {
+		if ( uiIndex >= pnlNumList->uiTailLength ) {
+			return (NUM_InvalidParameter);
+		}
+		pnlNumList->puiTailValues[uiIndex] = uiValue;
+		return (NUM_NoError);
+	}
+	else if ( ullBlock > pnlNumList->uiBlocksLength ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Decode the block and update the integer, there is nothing to do if it is unchanged */
+	if ( (iError = iNumListDecodeBlock(pnlNumList, (unsigned int)ullBlock)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( pnlNumList->puiBlockValues[uiIndex] == uiValue ) {
+		return (NUM_NoError);
+	}
+
+	pnlNumList->puiBlockValues[uiIndex] = uiValue;
+
+
+	/* Encode the block, the decoded block is dropped if that fails as it no longer matches the encoded one */
+	if ( (iError = iNumBlockEncode(pnlNumList->uiFormat, pnlNumList->puiBlockValues, pnlNumList->uiBlockIntegerCount, pnlNumList->pucBlockData, &uiDataLength)) != NUM_NoError ) {
+		pnlNumList->uiBlockValuesIndex = UINT_MAX;
+		return (iError);
+	}
+
+	pnlbNumListBlock = pnlNumList->pnlbNumListBlocks + ullBlock;
+
+	if ( uiDataLength <= pnlbNumListBlock->uiDataCapacity ) {
+
+		/* Rewrite the block in its slot */
+		memcpy(pnlNumList->pucData + pnlbNumListBlock->ullOffset, pnlNumList->pucBlockData, uiDataLength);
+		pnlbNumListBlock->uiDataLength = uiDataLength;
+	}
+	else {
+
+		/* Move the block to a new slot, abandoning the old one */
+		uiDataCapacity = pnlbNumListBlock->uiDataCapacity;
+
+		if ( (iError = iNumListAddSlot(pnlNumList, pnlNumList->pucBlockData, uiDataLength, pnlbNumListBlock)) != NUM_NoError ) {
+			pnlNumList->uiBlockValuesIndex = UINT_MAX;
+			return (iError);
+		}
+
+		pnlNumList->ullAbandonedLength += uiDataCapacity;
+
+		/* Compact the buffer once the abandoned slots take more space than the blocks */
+		/* A failure is not an error, the update is done, the list is left unchanged and the next block move tries again */
+		if ( pnlNumList->ullAbandonedLength > (pnlNumList->ullDataLength - pnlNumList->ullAbandonedLength) ) {
+			iNumListCompact(pnlNumList);
+		}
+	}
+
+	pnlNumList->ullBlockRewriteCount++;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListGetCounts()
+
+	Purpose:	Gets the number of integers in a list, the length of its
+				buffer including the slack and the abandoned slots, and the
+				number of blocks rewritten by updates.
+
+	Parameters:	pvNumList				list
+				pullIntegerCount		return pointer for the integer count (optional)
+				pullDataLength			return pointer for the buffer length (optional)
+				pullBlockRewriteCount	return pointer for the block rewrite count (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListGetCounts
+(
+	void *pvNumList,
+	unsigned long long *pullIntegerCount,
+	unsigned long long *pullDataLength,
+	unsigned long long *pullBlockRewriteCount
+)
+{
+
+	struct numList	*pnlNumList = (struct numList *)pvNumList;
+
+
+	/* Check the parameters */
+	if ( pnlNumList == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	if ( pullIntegerCount != NULL ) {
+		*pullIntegerCount = ((unsigned long long)pnlNumList->uiBlocksLength * pnlNumList->uiBlockIntegerCount) + pnlNumList->uiTailLength;
+	}
+
+	if ( pullDataLength != NULL ) {
+		*pullDataLength = pnlNumList->ullDataLength;
+	}
+
+	if ( pullBlockRewriteCount != NULL ) {
+		*pullBlockRewriteCount = pnlNumList->ullBlockRewriteCount;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListWrite()
+
+	Purpose:	Writes a list to a sink as a stream, the blocks in order
+				followed by the tail as a final block, so it can be read
+				with a stream decoder created with the block integer count
+				of the list. The list is unchanged and can be appended to.
+
+	Parameters:	pvNumList			list
+				iNumStreamSink		sink callback
+				pvSinkContext		sink context
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListWrite
+(
+	void *pvNumList,
+	iNumStreamSinkCallback iNumStreamSink,
+	void *pvSinkContext
+)
+{
+
+	struct numList	*pnlNumList = (struct numList *)pvNumList;
+	unsigned int	uiDataLength = 0;
+	unsigned int	uiI = 0;
+	int				iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( (pnlNumList == NULL) || (iNumStreamSink == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Write the blocks */
+	for ( uiI = 0; uiI < pnlNumList->uiBlocksLength; uiI++ ) {
+		if ( (iError = iNumStreamSink(pvSinkContext, pnlNumList->pucData + pnlNumList->pnlbNumListBlocks[uiI].ullOffset,
+				pnlNumList->pnlbNumListBlocks[uiI].uiDataLength)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+
+	/* Write the tail */
+	if ( pnlNumList->uiTailLength > 0 ) {
+
+		if ( (iError = iNumBlockEncode(pnlNumList->uiFormat, pnlNumList->puiTailValues, pnlNumList->uiTailLength, pnlNumList->pucBlockData, &uiDataLength)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( (iError = iNumStreamSink(pvSinkContext, pnlNumList->pucBlockData, uiDataLength)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumListFree()
+
+	Purpose:	Frees a list.
+
+	Parameters:	pvNumList		list
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumListFree
+(
+	void *pvNumList
+)
+{
+
+	struct numList	*pnlNumList = (struct numList *)pvNumList;
+
+
+	if ( pnlNumList == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	free(pnlNumList->pnlbNumListBlocks);
+	free(pnlNumList->pucData);
+	free(pnlNumList->puiTailValues);
+	free(pnlNumList->puiBlockValues);
+	free(pnlNumList->pucBlockData);
+	free(pnlNumList);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ======================================
+** === Number storage functions (set) ===
+** ======================================
+*/
+
+
+/* A set holds sorted integers split into chunks by their high bits, the
+** low bits of the integers of a chunk are stored in one container, either a
+** list, which is a block of the gaps between the integers less one, or a
+** bitmap, whichever is shorter. Sparse chunks cost a byte or so for each
+** integer and dense chunks a bit. Set operations walk the containers of
+** both sets in chunk order, bitmaps are combined a word at a time, lists
+** are looked up in bitmaps or merged with lists, and the result of each
+** chunk is stored in whichever container is shorter.
+*/
+
+
+/* Container types */
+#define NUM_SET_CONTAINER_LIST						(1)
+#define NUM_SET_CONTAINER_BITMAP					(2)
+
+
+/* Low bits mask and bitmap word count */
+#define NUM_SET_CHUNK_MASK							(NUM_SET_CHUNK_LENGTH - 1)
+#define NUM_SET_BITMAP_WORD_COUNT					(NUM_SET_BITMAP_LENGTH / sizeof(unsigned long long))
+
+
+/* Bitmap macros */
+#define NUM_SET_BITMAP_TEST(pullMacroBitmap, uiMacroValue) \
+	((((pullMacroBitmap)[(uiMacroValue) >> 6]) >> ((uiMacroValue) & 63)) & 1)
+
+#define NUM_SET_BITMAP_SET(pullMacroBitmap, uiMacroValue) \
+	((pullMacroBitmap)[(uiMacroValue) >> 6] |= (1ULL << ((uiMacroValue) & 63)))
+
+
+/* Set container structure */
+struct numSetContainer {
+	unsigned long long	ullOffset;
+	unsigned int		uiKey;				/* High bits of the integers */
+	unsigned int		uiType;
+	unsigned int		uiCount;
+	unsigned int		uiDataLength;
+};
+
+
+/* Set structure */
+struct numSet {
+	unsigned int			uiFormat;
+
+	struct numSetContainer	*pnscNumSetContainers;
+	unsigned int			uiContainersLength;
+	unsigned int			uiContainersCapacity;
+
+	unsigned char			*pucData;			/* Containers, bitmaps aligned to 8 bytes, padded by NUM_READ_PADDING_SIZE */
+	unsigned long long		ullDataLength;
+	unsigned long long		ullDataCapacity;
+
+	unsigned long long		ullIntegerCount;
+};
+
+
+/* Set work structure, the low bits of a chunk of each set and of the result */
+struct numSetWork {
+	unsigned long long		*pullBitmap;
+	unsigned int			*puiValues1;
+	unsigned int			*puiValues2;
+	unsigned int			*puiValues;
+	unsigned int			*puiGaps;
+	unsigned char			*pucData;			/* Encoded list, NUM_GET_BLOCK_MAX_SIZE() long */
+};
+
+
+/*
+
+	Function:	iNumSetWorkCreate()
+
+	Purpose:	Allocates the work arrays for a set operation.
+
+	Parameters:	pnswNumSetWork		set work
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetWorkCreate
+(
+	struct numSetWork *pnswNumSetWork
+)
+{
+
+	unsigned int	uiMaxSize = 0;
+
+
+	ASSERT(pnswNumSetWork != NULL);
+
+
+	NUM_GET_BLOCK_MAX_SIZE(NUM_SET_CHUNK_LENGTH, uiMaxSize);
+
+	/* One allocation, the bitmap first so it is aligned */
+	if ( (pnswNumSetWork->pullBitmap = malloc(NUM_SET_BITMAP_LENGTH + (4 * NUM_SET_CHUNK_LENGTH * sizeof(unsigned int)) + uiMaxSize)) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnswNumSetWork->puiValues1 = (unsigned int *)(pnswNumSetWork->pullBitmap + NUM_SET_BITMAP_WORD_COUNT);
+	pnswNumSetWork->puiValues2 = pnswNumSetWork->puiValues1 + NUM_SET_CHUNK_LENGTH;
+	pnswNumSetWork->puiValues = pnswNumSetWork->puiValues2 + NUM_SET_CHUNK_LENGTH;
+	pnswNumSetWork->puiGaps = pnswNumSetWork->puiValues + NUM_SET_CHUNK_LENGTH;
+	pnswNumSetWork->pucData = (unsigned char *)(pnswNumSetWork->puiGaps + NUM_SET_CHUNK_LENGTH);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	uiNumSetGetBitmapValues()
+
+	Purpose:	Gets the low bits of the integers in a bitmap.
+
+	Parameters:	pullBitmap		bitmap
+				puiValues		return array for the low bits, NUM_SET_CHUNK_LENGTH long
+
+	Global Variables:	none
+
+	Returns:	number of integers
+
+*/
+static unsigned int uiNumSetGetBitmapValues
+(
+	unsigned long long *pullBitmap,
+	unsigned int *puiValues
+)
+{
+
+	unsigned long long	ullBits = 0;
+	unsigned int		uiValuesLength = 0;
+	unsigned int		uiI = 0;
+
+
+	ASSERT(pullBitmap != NULL);
+	ASSERT(puiValues != NULL);
+
+
+	for ( uiI = 0; uiI < NUM_SET_BITMAP_WORD_COUNT; uiI++ ) {
+		for ( ullBits = pullBitmap[uiI]; ullBits != 0; ullBits &= ullBits - 1 ) {
+			puiValues[uiValuesLength++] = (uiI * 64) + (unsigned int)__builtin_ctzll(ullBits);
+		}
+	}
+
+
+	return (uiValuesLength);
+
+}
+
+
+/*
+
+	Function:	iNumSetReserve()
+
+	Purpose:	Reserves space for a container at the end of the buffer of a
+				set, growing the buffer if needed.
+
+	Parameters:	pnsNumSet			set
+				uiDataLength		length of the container
+				uiAlignment			alignment of the container
+				pullOffset			return pointer for the offset of the container
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetReserve
+(
+	struct numSet *pnsNumSet,
+	unsigned int uiDataLength,
+	unsigned int uiAlignment,
+	unsigned long long *pullOffset
+)
+{
+
+	unsigned char		*pucNewData = NULL;
+	unsigned long long	ullNewDataCapacity = 0;
+	unsigned long long	ullOffset = 0;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT(uiAlignment > 0);
+	ASSERT(pullOffset != NULL);
+
+
+	ullOffset = ((pnsNumSet->ullDataLength + uiAlignment - 1) / uiAlignment) * uiAlignment;
+
+
+	/* Grow the buffer, keeping the padding free at the end */
+	if ( (ullOffset + uiDataLength + NUM_READ_PADDING_SIZE) > pnsNumSet->ullDataCapacity ) {
+
+		for ( ullNewDataCapacity = (pnsNumSet->ullDataCapacity > 0) ? pnsNumSet->ullDataCapacity : 4096;
+				ullNewDataCapacity < (ullOffset + uiDataLength + NUM_READ_PADDING_SIZE); ullNewDataCapacity *= 2 ) {
+			;
+		}
+
+		if ( (pucNewData = realloc(pnsNumSet->pucData, ullNewDataCapacity)) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnsNumSet->pucData = pucNewData;
+		pnsNumSet->ullDataCapacity = ullNewDataCapacity;
+	}
+
+	memset(pnsNumSet->pucData + ullOffset + uiDataLength, 0, NUM_READ_PADDING_SIZE);
+	pnsNumSet->ullDataLength = ullOffset + uiDataLength;
+
+	*pullOffset = ullOffset;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetAddContainer()
+
+	Purpose:	Adds a container to a set, its data is already in the buffer.
+
+	Parameters:	pnsNumSet			set
+				uiKey				high bits of the integers
+				uiType				container type
+				uiCount				number of integers
+				ullOffset			offset of the container
+				uiDataLength		length of the container
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetAddContainer
+(
+	struct numSet *pnsNumSet,
+	unsigned int uiKey,
+	unsigned int uiType,
+	unsigned int uiCount,
+	unsigned long long ullOffset,
+	unsigned int uiDataLength
+)
+{
+
+	struct numSetContainer	*pnscNewNumSetContainers = NULL;
+	struct numSetContainer	*pnscNumSetContainer = NULL;
+	unsigned int			uiNewContainersCapacity = 0;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT((uiType == NUM_SET_CONTAINER_LIST) || (uiType == NUM_SET_CONTAINER_BITMAP));
+	ASSERT(uiCount > 0);
+
+
+	/* Grow the containers, there are at most as many as there are chunks */
+	if ( pnsNumSet->uiContainersLength == pnsNumSet->uiContainersCapacity ) {
+
+		uiNewContainersCapacity = (pnsNumSet->uiContainersCapacity > 0) ? (pnsNumSet->uiContainersCapacity * 2) : 64;
+
+		if ( (pnscNewNumSetContainers = realloc(pnsNumSet->pnscNumSetContainers, uiNewContainersCapacity * sizeof(struct numSetContainer))) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnsNumSet->pnscNumSetContainers = pnscNewNumSetContainers;
+		pnsNumSet->uiContainersCapacity = uiNewContainersCapacity;
+	}
+
+	pnscNumSetContainer = pnsNumSet->pnscNumSetContainers + pnsNumSet->uiContainersLength;
+	pnscNumSetContainer->ullOffset = ullOffset;
+	pnscNumSetContainer->uiKey = uiKey;
+	pnscNumSetContainer->uiType = uiType;
+	pnscNumSetContainer->uiCount = uiCount;
+	pnscNumSetContainer->uiDataLength = uiDataLength;
+
+	pnsNumSet->uiContainersLength++;
+	pnsNumSet->ullIntegerCount += uiCount;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetAddValues()
+
+	Purpose:	Adds the integers of a chunk to a set, as a list if its
+				block is shorter than a bitmap, and as a bitmap if not.
+
+	Parameters:	pnsNumSet			set
+				pnswNumSetWork		set work
+				uiKey				high bits of the integers
+				puiValues			sorted integers, only their low bits are used
+				uiValuesLength		number of integers
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetAddValues
+(
+	struct numSet *pnsNumSet,
+	struct numSetWork *pnswNumSetWork,
+	unsigned int uiKey,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength
+)
+{
+
+	unsigned long long	*pullBitmap = NULL;
+	unsigned long long	ullOffset = 0;
+	unsigned int		uiDataLength = 0;
+	unsigned int		uiI = 0;
+	int					iError = NUM_NoError;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT(pnswNumSetWork != NULL);
+	ASSERT(puiValues != pnswNumSetWork->puiGaps);
+	ASSERT(uiValuesLength <= NUM_SET_CHUNK_LENGTH);
+
+
+	if ( uiValuesLength == 0 ) {
+		return (NUM_NoError);
+	}
+
+
+	/* Encode the gaps */
+	pnswNumSetWork->puiGaps[0] = puiValues[0] & NUM_SET_CHUNK_MASK;
+	for ( uiI = 1; uiI < uiValuesLength; uiI++ ) {
+		pnswNumSetWork->puiGaps[uiI] = (puiValues[uiI] & NUM_SET_CHUNK_MASK) - (puiValues[uiI - 1] & NUM_SET_CHUNK_MASK) - 1;
+	}
+
+	if ( (iError = iNumBlockEncode(pnsNumSet->uiFormat, pnswNumSetWork->puiGaps, uiValuesLength, pnswNumSetWork->pucData, &uiDataLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+
+	/* Add a list */
+	if ( uiDataLength < NUM_SET_BITMAP_LENGTH ) {
+
+		if ( (iError = iNumSetReserve(pnsNumSet, uiDataLength, 1, &ullOffset)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		memcpy(pnsNumSet->pucData + ullOffset, pnswNumSetWork->pucData, uiDataLength);
+
+		return (iNumSetAddContainer(pnsNumSet, uiKey, NUM_SET_CONTAINER_LIST, uiValuesLength, ullOffset, uiDataLength));
+	}
+
+
+	/* Add a bitmap */
+	if ( (iError = iNumSetReserve(pnsNumSet, NUM_SET_BITMAP_LENGTH, sizeof(unsigned long long), &ullOffset)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	pullBitmap = (unsigned long long *)(pnsNumSet->pucData + ullOffset);
+	memset(pullBitmap, 0, NUM_SET_BITMAP_LENGTH);
+
+	for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+		NUM_SET_BITMAP_SET(pullBitmap, puiValues[uiI] & NUM_SET_CHUNK_MASK);
+	}
+
+
+	return (iNumSetAddContainer(pnsNumSet, uiKey, NUM_SET_CONTAINER_BITMAP, uiValuesLength, ullOffset, NUM_SET_BITMAP_LENGTH));
+
+}
+
+
+/*
+
+	Function:	iNumSetAddBitmap()
+
+	Purpose:	Adds the integers of a chunk in a bitmap to a set. Bitmaps
+				with few integers go through iNumSetAddValues() as their
+				list may be shorter, as may any bitmap in a format with zero
+				runs, which stores runs of consecutive integers compactly.
+
+	Parameters:	pnsNumSet			set
+				pnswNumSetWork		set work
+				uiKey				high bits of the integers
+				pullBitmap			bitmap
+				uiCount				number of integers in the bitmap
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetAddBitmap
+(
+	struct numSet *pnsNumSet,
+	struct numSetWork *pnswNumSetWork,
+	unsigned int uiKey,
+	unsigned long long *pullBitmap,
+	unsigned int uiCount
+)
+{
+
+	unsigned long long	ullOffset = 0;
+	unsigned int		uiValuesLength = 0;
+	int					iError = NUM_NoError;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT(pnswNumSetWork != NULL);
+	ASSERT(pullBitmap != NULL);
+
+
+	if ( uiCount == 0 ) {
+		return (NUM_NoError);
+	}
+
+	if ( (uiCount < NUM_SET_BITMAP_LENGTH) || (pnsNumSet->uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) ) {
+		uiValuesLength = uiNumSetGetBitmapValues(pullBitmap, pnswNumSetWork->puiValues);
+		ASSERT(uiValuesLength == uiCount);
+		return (iNumSetAddValues(pnsNumSet, pnswNumSetWork, uiKey, pnswNumSetWork->puiValues, uiValuesLength));
+	}
+
+	if ( (iError = iNumSetReserve(pnsNumSet, NUM_SET_BITMAP_LENGTH, sizeof(unsigned long long), &ullOffset)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	memcpy(pnsNumSet->pucData + ullOffset, pullBitmap, NUM_SET_BITMAP_LENGTH);
+
+
+	return (iNumSetAddContainer(pnsNumSet, uiKey, NUM_SET_CONTAINER_BITMAP, uiCount, ullOffset, NUM_SET_BITMAP_LENGTH));
+
+}
+
+
+/*
+
+	Function:	iNumSetGetValues()
+
+	Purpose:	Gets the low bits of the integers in a container.
+
+	Parameters:	pnsNumSet				set
+				pnscNumSetContainer		container
+				puiValues				return array for the low bits, NUM_SET_CHUNK_LENGTH long
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetGetValues
+(
+	struct numSet *pnsNumSet,
+	struct numSetContainer *pnscNumSetContainer,
+	unsigned int *puiValues
+)
+{
+
+	unsigned int	uiValuesLength = 0;
+	unsigned int	uiBlockLength = 0;
+	unsigned int	uiValue = 0;
+	unsigned int	uiI = 0;
+	int				iError = NUM_NoError;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT(pnscNumSetContainer != NULL);
+	ASSERT(puiValues != NULL);
+
+
+	if ( pnscNumSetContainer->uiType == NUM_SET_CONTAINER_BITMAP ) {
+		uiNumSetGetBitmapValues((unsigned long long *)(pnsNumSet->pucData + pnscNumSetContainer->ullOffset), puiValues);
+		return (NUM_NoError);
+	}
+
+
+	/* Decode the gaps and add them up */
+	if ( (iError = iNumBlockDecode(pnsNumSet->uiFormat, pnsNumSet->pucData + pnscNumSetContainer->ullOffset, pnscNumSetContainer->uiDataLength,
+			puiValues, NUM_SET_CHUNK_LENGTH, &uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( uiValuesLength != pnscNumSetContainer->uiCount ) {
+		return (NUM_CorruptDataError);
+	}
+
+	for ( uiI = 1, uiValue = puiValues[0]; uiI < uiValuesLength; uiI++ ) {
+		if ( (uiValue += puiValues[uiI] + 1) > NUM_SET_CHUNK_MASK ) {
+			return (NUM_CorruptDataError);
+		}
+		puiValues[uiI] = uiValue;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetCopyContainer()
+
+	Purpose:	Copies a container to a set, it is copied as is if it is a
+				bitmap or if the sets have the same format.
+
+	Parameters:	pnsNumSet				set
+				pnswNumSetWork			set work
+				pnsNumSetSource			source set
+				pnscNumSetContainer		source container
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetCopyContainer
+(
+	struct numSet *pnsNumSet,
+	struct numSetWork *pnswNumSetWork,
+	struct numSet *pnsNumSetSource,
+	struct numSetContainer *pnscNumSetContainer
+)
+{
+
+	unsigned long long	ullOffset = 0;
+	int					iError = NUM_NoError;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT(pnswNumSetWork != NULL);
+	ASSERT(pnsNumSetSource != NULL);
+	ASSERT(pnscNumSetContainer != NULL);
+
+
+	if ( (pnscNumSetContainer->uiType == NUM_SET_CONTAINER_LIST) && (pnsNumSet->uiFormat != pnsNumSetSource->uiFormat) ) {
+		if ( (iError = iNumSetGetValues(pnsNumSetSource, pnscNumSetContainer, pnswNumSetWork->puiValues)) != NUM_NoError ) {
+			return (iError);
+		}
+		return (iNumSetAddValues(pnsNumSet, pnswNumSetWork, pnscNumSetContainer->uiKey, pnswNumSetWork->puiValues, pnscNumSetContainer->uiCount));
+	}
+
+	if ( (iError = iNumSetReserve(pnsNumSet, pnscNumSetContainer->uiDataLength,
+			(pnscNumSetContainer->uiType == NUM_SET_CONTAINER_BITMAP) ? sizeof(unsigned long long) : 1, &ullOffset)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	memcpy(pnsNumSet->pucData + ullOffset, pnsNumSetSource->pucData + pnscNumSetContainer->ullOffset, pnscNumSetContainer->uiDataLength);
+
+
+	return (iNumSetAddContainer(pnsNumSet, pnscNumSetContainer->uiKey, pnscNumSetContainer->uiType, pnscNumSetContainer->uiCount,
+			ullOffset, pnscNumSetContainer->uiDataLength));
+
+}
+
+
+/*
+
+	Function:	iNumSetIntersectContainers()
+
+	Purpose:	Intersects two containers of the same chunk into a set.
+
+	Parameters:	pnsNumSet				set
+				pnswNumSetWork			set work
+				pnsNumSet1				first set
+				pnscNumSetContainer1	container of the first set
+				pnsNumSet2				second set
+				pnscNumSetContainer2	container of the second set
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetIntersectContainers
+(
+	struct numSet *pnsNumSet,
+	struct numSetWork *pnswNumSetWork,
+	struct numSet *pnsNumSet1,
+	struct numSetContainer *pnscNumSetContainer1,
+	struct numSet *pnsNumSet2,
+	struct numSetContainer *pnscNumSetContainer2
+)
+{
+
+	unsigned long long	*pullBitmap1 = NULL;
+	unsigned long long	*pullBitmap2 = NULL;
+	unsigned int		*puiValues1 = pnswNumSetWork->puiValues1;
+	unsigned int		*puiValues2 = pnswNumSetWork->puiValues2;
+	unsigned int		*puiValues = pnswNumSetWork->puiValues;
+	unsigned int		uiValuesLength = 0;
+	unsigned int		uiCount = 0;
+	unsigned int		uiI = 0;
+	unsigned int		uiJ = 0;
+	int					iError = NUM_NoError;
+
+
+	ASSERT(pnscNumSetContainer1->uiKey == pnscNumSetContainer2->uiKey);
+
+
+	/* Two bitmaps, a word at a time */
+	if ( (pnscNumSetContainer1->uiType == NUM_SET_CONTAINER_BITMAP) && (pnscNumSetContainer2->uiType == NUM_SET_CONTAINER_BITMAP) ) {
+
+		pullBitmap1 = (unsigned long long *)(pnsNumSet1->pucData + pnscNumSetContainer1->ullOffset);
+		pullBitmap2 = (unsigned long long *)(pnsNumSet2->pucData + pnscNumSetContainer2->ullOffset);
+
+		for ( uiI = 0; uiI < NUM_SET_BITMAP_WORD_COUNT; uiI++ ) {
+			pnswNumSetWork->pullBitmap[uiI] = pullBitmap1[uiI] & pullBitmap2[uiI];
+			uiCount += (unsigned int)__builtin_popcountll(pnswNumSetWork->pullBitmap[uiI]);
+		}
+
+		return (iNumSetAddBitmap(pnsNumSet, pnswNumSetWork, pnscNumSetContainer1->uiKey, pnswNumSetWork->pullBitmap, uiCount));
+	}
+
+
+	/* A list and a bitmap, the list is looked up in the bitmap */
+	if ( (pnscNumSetContainer1->uiType == NUM_SET_CONTAINER_BITMAP) || (pnscNumSetContainer2->uiType == NUM_SET_CONTAINER_BITMAP) ) {
+
+		if ( pnscNumSetContainer1->uiType == NUM_SET_CONTAINER_BITMAP ) {
+			pullBitmap1 = (unsigned long long *)(pnsNumSet1->pucData + pnscNumSetContainer1->ullOffset);
+			iError = iNumSetGetValues(pnsNumSet2, pnscNumSetContainer2, puiValues1);
+			uiCount = pnscNumSetContainer2->uiCount;
+		}
+		else {
+			pullBitmap1 = (unsigned long long *)(pnsNumSet2->pucData + pnscNumSetContainer2->ullOffset);
+			iError = iNumSetGetValues(pnsNumSet1, pnscNumSetContainer1, puiValues1);
+			uiCount = pnscNumSetContainer1->uiCount;
+		}
+
+		if ( iError != NUM_NoError ) {
+			return (iError);
+		}
+
+		for ( uiI = 0; uiI < uiCount; uiI++ ) {
+			puiValues[uiValuesLength] = puiValues1[uiI];
+			uiValuesLength += (unsigned int)NUM_SET_BITMAP_TEST(pullBitmap1, puiValues1[uiI]);
+		}
+
+		return (iNumSetAddValues(pnsNumSet, pnswNumSetWork, pnscNumSetContainer1->uiKey, puiValues, uiValuesLength));
+	}
+
+
+	/* Two lists, merged */
+	if ( ((iError = iNumSetGetValues(pnsNumSet1, pnscNumSetContainer1, puiValues1)) != NUM_NoError) ||
+			((iError = iNumSetGetValues(pnsNumSet2, pnscNumSetContainer2, puiValues2)) != NUM_NoError) ) {
+		return (iError);
+	}
+
+	while ( (uiI < pnscNumSetContainer1->uiCount) && (uiJ < pnscNumSetContainer2->uiCount) ) {
+		if ( puiValues1[uiI] < puiValues2[uiJ] ) {
+			uiI++;
+		}
+		else if ( puiValues1[uiI] > puiValues2[uiJ] ) {
+			uiJ++;
+		}
+		else {
+			puiValues[uiValuesLength++] = puiValues1[uiI];
+			uiI++;
+			uiJ++;
+		}
+	}
+
+
+	return (iNumSetAddValues(pnsNumSet, pnswNumSetWork, pnscNumSetContainer1->uiKey, puiValues, uiValuesLength));
+
+}
+
+
+/*
+
+	Function:	iNumSetUnionContainers()
+
+	Purpose:	Unites two containers of the same chunk into a set.
+
+	Parameters:	pnsNumSet				set
+				pnswNumSetWork			set work
+				pnsNumSet1				first set
+				pnscNumSetContainer1	container of the first set
+				pnsNumSet2				second set
+				pnscNumSetContainer2	container of the second set
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetUnionContainers
+(
+	struct numSet *pnsNumSet,
+	struct numSetWork *pnswNumSetWork,
+	struct numSet *pnsNumSet1,
+	struct numSetContainer *pnscNumSetContainer1,
+	struct numSet *pnsNumSet2,
+	struct numSetContainer *pnscNumSetContainer2
+)
+{
+
+	unsigned long long	*pullBitmap1 = NULL;
+	unsigned long long	*pullBitmap2 = NULL;
+	unsigned int		*puiValues1 = pnswNumSetWork->puiValues1;
+	unsigned int		*puiValues2 = pnswNumSetWork->puiValues2;
+	unsigned int		*puiValues = pnswNumSetWork->puiValues;
+	unsigned int		uiValuesLength = 0;
+	unsigned int		uiCount = 0;
+	unsigned int		uiI = 0;
+	unsigned int		uiJ = 0;
+	int					iError = NUM_NoError;
+
+
+	ASSERT(pnscNumSetContainer1->uiKey == pnscNumSetContainer2->uiKey);
+
+
+	/* Two bitmaps, a word at a time */
+	if ( (pnscNumSetContainer1->uiType == NUM_SET_CONTAINER_BITMAP) && (pnscNumSetContainer2->uiType == NUM_SET_CONTAINER_BITMAP) ) {
+
+		pullBitmap1 = (unsigned long long *)(pnsNumSet1->pucData + pnscNumSetContainer1->ullOffset);
+		pullBitmap2 = (unsigned long long *)(pnsNumSet2->pucData + pnscNumSetContainer2->ullOffset);
+
+		for ( uiI = 0; uiI < NUM_SET_BITMAP_WORD_COUNT; uiI++ ) {
+			pnswNumSetWork->pullBitmap[uiI] = pullBitmap1[uiI] | pullBitmap2[uiI];
+			uiCount += (unsigned int)__builtin_popcountll(pnswNumSetWork->pullBitmap[uiI]);
+		}
+
+		return (iNumSetAddBitmap(pnsNumSet, pnswNumSetWork, pnscNumSetContainer1->uiKey, pnswNumSetWork->pullBitmap, uiCount));
+	}
+
+
+	/* A list and a bitmap, the list is set in a copy of the bitmap */
+	if ( (pnscNumSetContainer1->uiType == NUM_SET_CONTAINER_BITMAP) || (pnscNumSetContainer2->uiType == NUM_SET_CONTAINER_BITMAP) ) {
+
+		if ( pnscNumSetContainer1->uiType == NUM_SET_CONTAINER_BITMAP ) {
+			pullBitmap1 = (unsigned long long *)(pnsNumSet1->pucData + pnscNumSetContainer1->ullOffset);
+			uiCount = pnscNumSetContainer1->uiCount;
+			iError = iNumSetGetValues(pnsNumSet2, pnscNumSetContainer2, puiValues1);
+			uiValuesLength = pnscNumSetContainer2->uiCount;
+		}
+		else {
+			pullBitmap1 = (unsigned long long *)(pnsNumSet2->pucData + pnscNumSetContainer2->ullOffset);
+			uiCount = pnscNumSetContainer2->uiCount;
+			iError = iNumSetGetValues(pnsNumSet1, pnscNumSetContainer1, puiValues1);
+			uiValuesLength = pnscNumSetContainer1->uiCount;
+		}
+
+		if ( iError != NUM_NoError ) {
+			return (iError);
+		}
+
+		memcpy(pnswNumSetWork->pullBitmap, pullBitmap1, NUM_SET_BITMAP_LENGTH);
+
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			uiCount += (unsigned int)NUM_SET_BITMAP_TEST(pnswNumSetWork->pullBitmap, puiValues1[uiI]) ^ 1;
+			NUM_SET_BITMAP_SET(pnswNumSetWork->pullBitmap, puiValues1[uiI]);
+		}
+
+		return (iNumSetAddBitmap(pnsNumSet, pnswNumSetWork, pnscNumSetContainer1->uiKey, pnswNumSetWork->pullBitmap, uiCount));
+	}
+
+
+	/* Two lists, merged */
+	if ( ((iError = iNumSetGetValues(pnsNumSet1, pnscNumSetContainer1, puiValues1)) != NUM_NoError) ||
+			((iError = iNumSetGetValues(pnsNumSet2, pnscNumSetContainer2, puiValues2)) != NUM_NoError) ) {
+		return (iError);
+	}
+
+	while ( (uiI < pnscNumSetContainer1->uiCount) && (uiJ < pnscNumSetContainer2->uiCount) ) {
+		if ( puiValues1[uiI] < puiValues2[uiJ] ) {
+			puiValues[uiValuesLength++] = puiValues1[uiI++];
+		}
+		else if ( puiValues1[uiI] > puiValues2[uiJ] ) {
+			puiValues[uiValuesLength++] = puiValues2[uiJ++];
+		}
+		else {
+			puiValues[uiValuesLength++] = puiValues1[uiI];
+			uiI++;
+			uiJ++;
+		}
+	}
+
+	while ( uiI < pnscNumSetContainer1->uiCount ) {
+		puiValues[uiValuesLength++] = puiValues1[uiI++];
+	}
+
+	while ( uiJ < pnscNumSetContainer2->uiCount ) {
+		puiValues[uiValuesLength++] = puiValues2[uiJ++];
+	}
+
+
+	return (iNumSetAddValues(pnsNumSet, pnswNumSetWork, pnscNumSetContainer1->uiKey, puiValues, uiValuesLength));
+
+}
+
+
+/*
+
+	Function:	iNumSetCombine()
+
+	Purpose:	Intersects or unites two sets into a new set, walking their
+				containers in chunk order.
+
+	Parameters:	pnsNumSet			set, empty
+				pnsNumSet1			first set
+				pnsNumSet2			second set
+				bUnion				true to unite the sets, false to intersect them
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumSetCombine
+(
+	struct numSet *pnsNumSet,
+	struct numSet *pnsNumSet1,
+	struct numSet *pnsNumSet2,
+	boolean bUnion
+)
+{
+
+	struct numSetWork		nswNumSetWork;
+	struct numSetContainer	*pnscNumSetContainer1 = NULL;
+	struct numSetContainer	*pnscNumSetContainer2 = NULL;
+	unsigned int			uiI = 0;
+	unsigned int			uiJ = 0;
+	int						iError = NUM_NoError;
+
+
+	ASSERT(pnsNumSet != NULL);
+	ASSERT(pnsNumSet1 != NULL);
+	ASSERT(pnsNumSet2 != NULL);
+
+
+	if ( (iError = iNumSetWorkCreate(&nswNumSetWork)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	while ( (iError == NUM_NoError) && ((uiI < pnsNumSet1->uiContainersLength) || (uiJ < pnsNumSet2->uiContainersLength)) ) {
+
+		pnscNumSetContainer1 = (uiI < pnsNumSet1->uiContainersLength) ? (pnsNumSet1->pnscNumSetContainers + uiI) : NULL;
+		pnscNumSetContainer2 = (uiJ < pnsNumSet2->uiContainersLength) ? (pnsNumSet2->pnscNumSetContainers + uiJ) : NULL;
+
+		/* Chunks in only one set are copied for a union and skipped for an intersection */
+		if ( (pnscNumSetContainer2 == NULL) || ((pnscNumSetContainer1 != NULL) && (pnscNumSetContainer1->uiKey < pnscNumSetContainer2->uiKey)) ) {
+			if ( bUnion == true ) {
+				iError = iNumSetCopyContainer(pnsNumSet, &nswNumSetWork, pnsNumSet1, pnscNumSetContainer1);
+			}
+			uiI++;
+		}
+		else if ( (pnscNumSetContainer1 == NULL) || (pnscNumSetContainer1->uiKey > pnscNumSetContainer2->uiKey) ) {
+			if ( bUnion == true ) {
+				iError = iNumSetCopyContainer(pnsNumSet, &nswNumSetWork, pnsNumSet2, pnscNumSetContainer2);
+			}
+			uiJ++;
+		}
+		else {
+			iError = (bUnion == true) ?
+					iNumSetUnionContainers(pnsNumSet, &nswNumSetWork, pnsNumSet1, pnscNumSetContainer1, pnsNumSet2, pnscNumSetContainer2) :
+					iNumSetIntersectContainers(pnsNumSet, &nswNumSetWork, pnsNumSet1, pnscNumSetContainer1, pnsNumSet2, pnscNumSetContainer2);
+			uiI++;
+			uiJ++;
+		}
+
+		/* An intersection ends with either set */
+		if ( (bUnion == false) && ((uiI == pnsNumSet1->uiContainersLength) || (uiJ == pnsNumSet2->uiContainersLength)) ) {
+			break;
+		}
+	}
+
+	free(nswNumSetWork.pullBitmap);
+
+
+	return (iError);
+
+}
+
+
+/*
+
+	Function:	iNumSetCreate()
+
+	Purpose:	Creates a set from sorted integers.
+
+	Parameters:	uiFormat			format of the lists
+				puiValues			integers, sorted and unique
+				uiValuesLength		number of integers
+				ppvNumSet			return pointer for the set
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumSetCreate
+(
+	unsigned int uiFormat,
+	unsigned int *puiValues,
+	unsigned int uiValuesLength,
+	void **ppvNumSet
+)
+{
+
+	struct numSet		*pnsNumSet = NULL;
+	struct numSetWork	nswNumSetWork;
+	unsigned int		uiI = 0;
+	unsigned int		uiJ = 0;
+	int					iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( NUM_FORMAT_VALID(uiFormat) == false ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiValues == NULL) && (uiValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	for ( uiI = 1; uiI < uiValuesLength; uiI++ ) {
+		if ( puiValues[uiI] <= puiValues[uiI - 1] ) {
+			return (NUM_InvalidParameter);
+		}
+	}
+
+	if ( ppvNumSet == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Allocate the set */
+	if ( (pnsNumSet = calloc(1, sizeof(struct numSet))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnsNumSet->uiFormat = uiFormat;
+
+	if ( (iError = iNumSetWorkCreate(&nswNumSetWork)) != NUM_NoError ) {
+		iNumSetFree(pnsNumSet);
+		return (iError);
+	}
+
+
+	/* Add the integers a chunk at a time */
+	for ( uiI = 0; (uiI < uiValuesLength) && (iError == NUM_NoError); uiI = uiJ ) {
+		for ( uiJ = uiI + 1; (uiJ < uiValuesLength) && ((puiValues[uiJ] >> NUM_SET_CHUNK_BITS) == (puiValues[uiI] >> NUM_SET_CHUNK_BITS)); uiJ++ ) {
+			;
+		}
+		iError = iNumSetAddValues(pnsNumSet, &nswNumSetWork, puiValues[uiI] >> NUM_SET_CHUNK_BITS, puiValues + uiI, uiJ - uiI);
+	}
+
+	free(nswNumSetWork.pullBitmap);
+
+	if ( iError != NUM_NoError ) {
+		iNumSetFree(pnsNumSet);
+		return (iError);
+	}
+
+
+	*ppvNumSet = (void *)pnsNumSet;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetIntersect()
+
+	Purpose:	Intersects two sets into a new set, in the format of the
+				first set.
+
+	Parameters:	pvNumSet1		first set
+				pvNumSet2		second set
+				ppvNumSet		return pointer for the set
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumSetIntersect
+(
+	void *pvNumSet1,
+	void *pvNumSet2,
+	void **ppvNumSet
+)
+{
+
+	struct numSet	*pnsNumSet = NULL;
+	int				iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( (pvNumSet1 == NULL) || (pvNumSet2 == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumSet == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( (pnsNumSet = calloc(1, sizeof(struct numSet))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnsNumSet->uiFormat = ((struct numSet *)pvNumSet1)->uiFormat;
+
+	if ( (iError = iNumSetCombine(pnsNumSet, (struct numSet *)pvNumSet1, (struct numSet *)pvNumSet2, false)) != NUM_NoError ) {
+		iNumSetFree(pnsNumSet);
+		return (iError);
+	}
+
+
+	*ppvNumSet = (void *)pnsNumSet;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetUnion()
+
+	Purpose:	Unites two sets into a new set, in the format of the first
+				set.
+
+	Parameters:	pvNumSet1		first set
+				pvNumSet2		second set
+				ppvNumSet		return pointer for the set
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumSetUnion
+(
+	void *pvNumSet1,
+	void *pvNumSet2,
+	void **ppvNumSet
+)
+{
+
+	struct numSet	*pnsNumSet = NULL;
+	int				iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( (pvNumSet1 == NULL) || (pvNumSet2 == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumSet == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( (pnsNumSet = calloc(1, sizeof(struct numSet))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnsNumSet->uiFormat = ((struct numSet *)pvNumSet1)->uiFormat;
+
+	if ( (iError = iNumSetCombine(pnsNumSet, (struct numSet *)pvNumSet1, (struct numSet *)pvNumSet2, true)) != NUM_NoError ) {
+		iNumSetFree(pnsNumSet);
+		return (iError);
+	}
+
+
+	*ppvNumSet = (void *)pnsNumSet;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetDecode()
+
+	Purpose:	Decodes the integers of a set in order.
+
+	Parameters:	pvNumSet			set
+				puiValues			return array for the integers
+				uiValuesCapacity	capacity of the array
+				puiValuesLength		return pointer for the number of integers
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumSetDecode
+(
+	void *pvNumSet,
+	unsigned int *puiValues,
+	unsigned int uiValuesCapacity,
+	unsigned int *puiValuesLength
+)
+{
+
+	struct numSet			*pnsNumSet = (struct numSet *)pvNumSet;
+	struct numSetContainer	*pnscNumSetContainer = NULL;
+	struct numSetWork		nswNumSetWork;
+	unsigned int			uiValuesLength = 0;
+	unsigned int			uiI = 0;
+	unsigned int			uiJ = 0;
+	int						iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnsNumSet == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ((puiValues == NULL) && (pnsNumSet->ullIntegerCount > 0)) || (uiValuesCapacity < pnsNumSet->ullIntegerCount) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiValuesLength == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( (iError = iNumSetWorkCreate(&nswNumSetWork)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	for ( uiI = 0; (uiI < pnsNumSet->uiContainersLength) && (iError == NUM_NoError); uiI++ ) {
+
+		pnscNumSetContainer = pnsNumSet->pnscNumSetContainers + uiI;
+
+		if ( (iError = iNumSetGetValues(pnsNumSet, pnscNumSetContainer, nswNumSetWork.puiValues)) == NUM_NoError ) {
+			for ( uiJ = 0; uiJ < pnscNumSetContainer->uiCount; uiJ++ ) {
+				puiValues[uiValuesLength++] = (pnscNumSetContainer->uiKey << NUM_SET_CHUNK_BITS) | nswNumSetWork.puiValues[uiJ];
+			}
+		}
+	}
+
+	free(nswNumSetWork.pullBitmap);
+
+	if ( iError != NUM_NoError ) {
+		return (iError);
+	}
+
+
+	*puiValuesLength = uiValuesLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetGetCounts()
+
+	Purpose:	Gets the number of integers in a set, the length of its
+				containers, and the number of list and bitmap containers.
+
+	Parameters:	pvNumSet			set
+				pullIntegerCount	return pointer for the integer count (optional)
+				pullDataLength		return pointer for the data length (optional)
+				puiListCount		return pointer for the list container count (optional)
+				puiBitmapCount		return pointer for the bitmap container count (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumSetGetCounts
+(
+	void *pvNumSet,
+	unsigned long long *pullIntegerCount,
+	unsigned long long *pullDataLength,
+	unsigned int *puiListCount,
+	unsigned int *puiBitmapCount
+)
+{
+
+	struct numSet	*pnsNumSet = (struct numSet *)pvNumSet;
+	unsigned int	uiBitmapCount = 0;
+	unsigned int	uiI = 0;
+
+
+	/* Check the parameters */
+	if ( pnsNumSet == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	for ( uiI = 0; uiI < pnsNumSet->uiContainersLength; uiI++ ) {
+		uiBitmapCount += (pnsNumSet->pnscNumSetContainers[uiI].uiType == NUM_SET_CONTAINER_BITMAP) ? 1 : 0;
+	}
+
+	if ( pullIntegerCount != NULL ) {
+		*pullIntegerCount = pnsNumSet->ullIntegerCount;
+	}
+
+	if ( pullDataLength != NULL ) {
+		*pullDataLength = pnsNumSet->ullDataLength;
+	}
+
+	if ( puiListCount != NULL ) {
+		*puiListCount = pnsNumSet->uiContainersLength - uiBitmapCount;
+	}
+
+	if ( puiBitmapCount != NULL ) {
+		*puiBitmapCount = uiBitmapCount;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumSetFree()
+
+	Purpose:	Frees a set.
+
+	Parameters:	pvNumSet		set
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumSetFree
+(
+	void *pvNumSet
+)
+{
+
+	struct numSet	*pnsNumSet = (struct numSet *)pvNumSet;
+
+
+	if ( pnsNumSet == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	free(pnsNumSet->pnscNumSetContainers);
+	free(pnsNumSet->pucData);
+	free(pnsNumSet);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===========================================
+** === Number storage functions (postings) ===
+** ===========================================
+*/
+
+
+/* Postings are doc IDs, each with its positions, the frequency being the
+** number of positions. The postings are split into blocks and each field
+** is encoded in its own stream, a block of doc ID gaps, a block of
+** frequencies and one or more blocks of position gaps for each block of
+** postings, so the blocks of the streams line up. A skip entry for each
+** block holds the last doc ID and the offsets of the block in each stream,
+** so a cursor skips blocks without decoding them and only decodes the
+** frequencies and positions of a block when they are asked for.
+*/
+
+
+/* Posting stream structure, padded by NUM_READ_PADDING_SIZE */
+struct numPostingStream {
+	unsigned char		*pucData;
+	unsigned long long	ullDataLength;
+	unsigned long long	ullDataCapacity;
+};
+
+
+/* Posting skip structure, one for each block */
+struct numPostingSkip {
+	unsigned long long	ullDocOffset;
+	unsigned long long	ullTfOffset;
+	unsigned long long	ullPositionOffset;
+	unsigned int		uiLastDocID;
+	unsigned int		uiPostingCount;
+	unsigned int		uiPositionCount;
+};
+
+
+/* Postings structure */
+struct numPostings {
+	unsigned int				uiBlockPostingCount;
+
+	struct numPostingStream		npsDocStream;
+	struct numPostingStream		npsTfStream;
+	struct numPostingStream		npsPositionStream;
+
+	struct numPostingSkip		*pnpsNumPostingSkips;
+	unsigned int				uiSkipsLength;
+	unsigned int				uiSkipsCapacity;
+
+	unsigned int				*puiDocGaps;			/* Postings which do not fill a block yet */
+	unsigned int				*puiTfs;
+	unsigned int				uiTailLength;
+	unsigned int				*puiPositionGaps;
+	unsigned int				uiPositionsLength;
+	unsigned int				uiPositionsCapacity;
+
+	unsigned int				uiLastDocID;
+	unsigned long long			ullPostingCount;
+
+	unsigned char				*pucBlockData;			/* Encoded block, NUM_GET_BLOCK_MAX_SIZE() long */
+};
+
+
+/* Posting cursor structure */
+struct numPostingCursor {
+	struct numPostings		*pnpNumPostings;
+
+	boolean					bStarted;
+	unsigned int			uiBlock;					/* Current posting */
+	unsigned int			uiIndex;
+
+	unsigned int			*puiDocIDs;					/* Decoded blocks, or UINT_MAX */
+	unsigned int			uiDocIDsBlock;
+	unsigned int			*puiTfs;
+	unsigned int			uiTfsBlock;
+	unsigned int			*puiPositions;
+	unsigned int			uiPositionsCapacity;
+	unsigned int			*puiPositionOffsets;
+	unsigned int			uiPositionsBlock;
+
+	unsigned long long		ullDocBlockCount;
+	unsigned long long		ullTfBlockCount;
+	unsigned long long		ullPositionBlockCount;
+};
+
+
+/*
+
+	Function:	iNumPostingStreamAppend()
+
+	Purpose:	Appends a block to a posting stream.
+
+	Parameters:	pnpsNumPostingStream	posting stream
+				pucData					block
+				uiDataLength			length of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingStreamAppend
+(
+	struct numPostingStream *pnpsNumPostingStream,
+	unsigned char *pucData,
+	unsigned int uiDataLength
+)
+{
+
+	unsigned char		*pucNewData = NULL;
+	unsigned long long	ullNewDataCapacity = 0;
+
+
+	ASSERT(pnpsNumPostingStream != NULL);
+	ASSERT(pucData != NULL);
+
+
+	/* Grow the stream, keeping the padding free at the end */
+	if ( (pnpsNumPostingStream->ullDataLength + uiDataLength + NUM_READ_PADDING_SIZE) > pnpsNumPostingStream->ullDataCapacity ) {
+
+		for ( ullNewDataCapacity = (pnpsNumPostingStream->ullDataCapacity > 0) ? pnpsNumPostingStream->ullDataCapacity : 4096;
+				ullNewDataCapacity < (pnpsNumPostingStream->ullDataLength + uiDataLength + NUM_READ_PADDING_SIZE); ullNewDataCapacity *= 2 ) {
+			;
+		}
+
+		if ( (pucNewData = realloc(pnpsNumPostingStream->pucData, ullNewDataCapacity)) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnpsNumPostingStream->pucData = pucNewData;
+		pnpsNumPostingStream->ullDataCapacity = ullNewDataCapacity;
+	}
+
+	memcpy(pnpsNumPostingStream->pucData + pnpsNumPostingStream->ullDataLength, pucData, uiDataLength);
+	pnpsNumPostingStream->ullDataLength += uiDataLength;
+	memset(pnpsNumPostingStream->pucData + pnpsNumPostingStream->ullDataLength, 0, NUM_READ_PADDING_SIZE);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingsEncodeTail()
+
+	Purpose:	Encodes the tail of postings into a block of each stream,
+				the positions going into as many blocks as they need.
+
+	Parameters:	pnpNumPostings		postings
+				pnpsNumPostingSkip	return pointer for the skip entry of the block
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingsEncodeTail
+(
+	struct numPostings *pnpNumPostings,
+	struct numPostingSkip *pnpsNumPostingSkip
+)
+{
+
+	unsigned int	uiDataLength = 0;
+	unsigned int	uiLength = 0;
+	unsigned int	uiI = 0;
+	int				iError = NUM_NoError;
+
+
+	ASSERT(pnpNumPostings != NULL);
+	ASSERT(pnpsNumPostingSkip != NULL);
+
+
+	pnpsNumPostingSkip->ullDocOffset = pnpNumPostings->npsDocStream.ullDataLength;
+	pnpsNumPostingSkip->ullTfOffset = pnpNumPostings->npsTfStream.ullDataLength;
+	pnpsNumPostingSkip->ullPositionOffset = pnpNumPostings->npsPositionStream.ullDataLength;
+	pnpsNumPostingSkip->uiLastDocID = pnpNumPostings->uiLastDocID;
+	pnpsNumPostingSkip->uiPostingCount = pnpNumPostings->uiTailLength;
+	pnpsNumPostingSkip->uiPositionCount = pnpNumPostings->uiPositionsLength;
+
+	if ( ((iError = iNumBlockEncode(NUM_POSTING_DOC_FORMAT, pnpNumPostings->puiDocGaps, pnpNumPostings->uiTailLength, pnpNumPostings->pucBlockData, &uiDataLength)) != NUM_NoError) ||
+			((iError = iNumPostingStreamAppend(&pnpNumPostings->npsDocStream, pnpNumPostings->pucBlockData, uiDataLength)) != NUM_NoError) ) {
+		return (iError);
+	}
+
+	if ( ((iError = iNumBlockEncode(NUM_POSTING_TF_FORMAT, pnpNumPostings->puiTfs, pnpNumPostings->uiTailLength, pnpNumPostings->pucBlockData, &uiDataLength)) != NUM_NoError) ||
+			((iError = iNumPostingStreamAppend(&pnpNumPostings->npsTfStream, pnpNumPostings->pucBlockData, uiDataLength)) != NUM_NoError) ) {
+		return (iError);
+	}
+
+	for ( uiI = 0; uiI < pnpNumPostings->uiPositionsLength; uiI += uiLength ) {
+
+		uiLength = ((pnpNumPostings->uiPositionsLength - uiI) < NUM_BLOCK_INTEGER_COUNT_MAX) ? (pnpNumPostings->uiPositionsLength - uiI) : NUM_BLOCK_INTEGER_COUNT_MAX;
+
+		if ( ((iError = iNumBlockEncode(NUM_POSTING_POSITION_FORMAT, pnpNumPostings->puiPositionGaps + uiI, uiLength, pnpNumPostings->pucBlockData, &uiDataLength)) != NUM_NoError) ||
+				((iError = iNumPostingStreamAppend(&pnpNumPostings->npsPositionStream, pnpNumPostings->pucBlockData, uiDataLength)) != NUM_NoError) ) {
+			return (iError);
+		}
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingsSealTail()
+
+	Purpose:	Encodes the tail of postings into a block and adds its skip
+				entry, the streams are left as they were if that fails.
+
+	Parameters:	pnpNumPostings		postings
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingsSealTail
+(
+	struct numPostings *pnpNumPostings
+)
+{
+
+	struct numPostingSkip	*pnpsNewNumPostingSkips = NULL;
+	unsigned int			uiNewSkipsCapacity = 0;
+	int						iError = NUM_NoError;
+
+
+	ASSERT(pnpNumPostings != NULL);
+
+
+	if ( pnpNumPostings->uiTailLength == 0 ) {
+		return (NUM_NoError);
+	}
+
+
+	/* Grow the skip index */
+	if ( pnpNumPostings->uiSkipsLength == pnpNumPostings->uiSkipsCapacity ) {
+
+		if ( pnpNumPostings->uiSkipsCapacity == UINT_MAX ) {
+			return (NUM_ValueOverflowError);
+		}
+
+		uiNewSkipsCapacity = (pnpNumPostings->uiSkipsCapacity > 0) ? ((pnpNumPostings->uiSkipsCapacity < (UINT_MAX / 2)) ? (pnpNumPostings->uiSkipsCapacity * 2) : UINT_MAX) : 64;
+
+		if ( (pnpsNewNumPostingSkips = realloc(pnpNumPostings->pnpsNumPostingSkips, uiNewSkipsCapacity * sizeof(struct numPostingSkip))) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnpNumPostings->pnpsNumPostingSkips = pnpsNewNumPostingSkips;
+		pnpNumPostings->uiSkipsCapacity = uiNewSkipsCapacity;
+	}
+
+
+	/* Encode the tail, dropping any blocks it encoded if it failed */
+	if ( (iError = iNumPostingsEncodeTail(pnpNumPostings, pnpNumPostings->pnpsNumPostingSkips + pnpNumPostings->uiSkipsLength)) != NUM_NoError ) {
+		pnpNumPostings->npsDocStream.ullDataLength = pnpNumPostings->pnpsNumPostingSkips[pnpNumPostings->uiSkipsLength].ullDocOffset;
+		pnpNumPostings->npsTfStream.ullDataLength = pnpNumPostings->pnpsNumPostingSkips[pnpNumPostings->uiSkipsLength].ullTfOffset;
+		pnpNumPostings->npsPositionStream.ullDataLength = pnpNumPostings->pnpsNumPostingSkips[pnpNumPostings->uiSkipsLength].ullPositionOffset;
+		return (iError);
+	}
+
+	pnpNumPostings->uiSkipsLength++;
+	pnpNumPostings->uiTailLength = 0;
+	pnpNumPostings->uiPositionsLength = 0;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingsCreate()
+
+	Purpose:	Creates postings.
+
+	Parameters:	uiBlockPostingCount		number of postings per block, 0 for the default
+				ppvNumPostings			return pointer for the postings
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingsCreate
+(
+	unsigned int uiBlockPostingCount,
+	void **ppvNumPostings
+)
+{
+
+	struct numPostings	*pnpNumPostings = NULL;
+	unsigned int		uiMaxSize = 0;
+
+
+	/* Check the parameters */
+	if ( uiBlockPostingCount > NUM_BLOCK_INTEGER_COUNT_MAX ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumPostings == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Default the block posting count, blocks of positions can be as long as blocks can be */
+	uiBlockPostingCount = (uiBlockPostingCount > 0) ? uiBlockPostingCount : NUM_POSTING_BLOCK_POSTING_COUNT_DEFAULT;
+
+	NUM_GET_BLOCK_MAX_SIZE(NUM_BLOCK_INTEGER_COUNT_MAX, uiMaxSize);
+
+
+	/* Allocate the postings */
+	if ( (pnpNumPostings = calloc(1, sizeof(struct numPostings))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnpNumPostings->uiBlockPostingCount = uiBlockPostingCount;
+
+	if ( ((pnpNumPostings->puiDocGaps = malloc(uiBlockPostingCount * sizeof(unsigned int))) == NULL) ||
+			((pnpNumPostings->puiTfs = malloc(uiBlockPostingCount * sizeof(unsigned int))) == NULL) ||
+			((pnpNumPostings->pucBlockData = malloc(uiMaxSize)) == NULL) ) {
+		iNumPostingsFree(pnpNumPostings);
+		return (NUM_MemError);
+	}
+
+
+	*ppvNumPostings = (void *)pnpNumPostings;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingsAdd()
+
+	Purpose:	Adds a posting, its frequency is the number of its
+				positions.
+
+	Parameters:	pvNumPostings			postings
+				uiDocID					doc ID, greater than the last one added
+				puiPositions			positions, sorted and unique
+				uiPositionsLength		number of positions, from 1 to NUM_POSTING_TF_MAX
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingsAdd
+(
+	void *pvNumPostings,
+	unsigned int uiDocID,
+	unsigned int *puiPositions,
+	unsigned int uiPositionsLength
+)
+{
+
+	int					iError = NUM_NoError;
+	struct numPostings	*pnpNumPostings = (struct numPostings *)pvNumPostings;
+	unsigned int		*puiNewPositionGaps = NULL;
+	unsigned int		uiNewPositionsCapacity = 0;
+	unsigned int		uiI = 0;
+
+
+	/* Check the parameters */
+	if ( pnpNumPostings == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pnpNumPostings->ullPostingCount > 0) && (uiDocID <= pnpNumPostings->uiLastDocID) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiPositions == NULL) || (uiPositionsLength == 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	for ( uiI = 1; uiI < uiPositionsLength; uiI++ ) {
+		if ( puiPositions[uiI] <= puiPositions[uiI - 1] ) {
+			return (NUM_InvalidParameter);
+		}
+	}
+
+	if ( (uiPositionsLength > NUM_POSTING_TF_MAX) || (uiPositionsLength > (UINT_MAX - pnpNumPostings->uiPositionsLength)) ) {
+		return (NUM_ValueOverflowError);
+	}
+
+
+	/* Seal the tail if it is still full because sealing it failed on the last add */
+	if ( pnpNumPostings->uiTailLength == pnpNumPostings->uiBlockPostingCount ) {
+		if ( (iError = iNumPostingsSealTail(pnpNumPostings)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+
+	/* Grow the positions of the tail */
+	if ( (pnpNumPostings->uiPositionsLength + uiPositionsLength) > pnpNumPostings->uiPositionsCapacity ) {
+
+		for ( uiNewPositionsCapacity = (pnpNumPostings->uiPositionsCapacity > 0) ? pnpNumPostings->uiPositionsCapacity : 1024;
+				uiNewPositionsCapacity < (pnpNumPostings->uiPositionsLength + uiPositionsLength);
+				uiNewPositionsCapacity = (uiNewPositionsCapacity < (UINT_MAX / 2)) ? (uiNewPositionsCapacity * 2) : UINT_MAX ) {
+			;
+		}
+
+		if ( (puiNewPositionGaps = realloc(pnpNumPostings->puiPositionGaps, (size_t)uiNewPositionsCapacity * sizeof(unsigned int))) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnpNumPostings->puiPositionGaps = puiNewPositionGaps;
+		pnpNumPostings->uiPositionsCapacity = uiNewPositionsCapacity;
+	}
+
+
+	/* Add the posting to the tail, gaps and frequencies less one as they are never zero */
+	pnpNumPostings->puiDocGaps[pnpNumPostings->uiTailLength] = (pnpNumPostings->ullPostingCount > 0) ? (uiDocID - pnpNumPostings->uiLastDocID - 1) : uiDocID;
+	pnpNumPostings->puiTfs[pnpNumPostings->uiTailLength] = uiPositionsLength - 1;
+	pnpNumPostings->uiTailLength++;
+
+	pnpNumPostings->puiPositionGaps[pnpNumPostings->uiPositionsLength++] = puiPositions[0];
+	for ( uiI = 1; uiI < uiPositionsLength; uiI++ ) {
+		pnpNumPostings->puiPositionGaps[pnpNumPostings->uiPositionsLength++] = puiPositions[uiI] - puiPositions[uiI - 1] - 1;
+	}
+
+	pnpNumPostings->uiLastDocID = uiDocID;
+	pnpNumPostings->ullPostingCount++;
+
+
+	/* Seal the tail once it fills a block, the posting is added even if this fails
+	** and the tail is sealed again on the next add or flush
+	*/
+	if ( pnpNumPostings->uiTailLength == pnpNumPostings->uiBlockPostingCount ) {
+		return (iNumPostingsSealTail(pnpNumPostings));
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingsFlush()
+
+	Purpose:	Encodes the postings which do not fill a block yet into a
+				short block, cursors only see postings in blocks. Postings
+				can still be added.
+
+	Parameters:	pvNumPostings		postings
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingsFlush
+(
+	void *pvNumPostings
+)
+{
+
+	/* Check the parameters */
+	if ( pvNumPostings == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	return (iNumPostingsSealTail((struct numPostings *)pvNumPostings));
+
+}
+
+
+/*
+
+	Function:	iNumPostingsGetCounts()
+
+	Purpose:	Gets the number of postings and the length of each stream.
+
+	Parameters:	pvNumPostings				postings
+				pullPostingCount			return pointer for the posting count (optional)
+				pullDocDataLength			return pointer for the doc ID stream length (optional)
+				pullTfDataLength			return pointer for the frequency stream length (optional)
+				pullPositionDataLength		return pointer for the position stream length (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingsGetCounts
+(
+	void *pvNumPostings,
+	unsigned long long *pullPostingCount,
+	unsigned long long *pullDocDataLength,
+	unsigned long long *pullTfDataLength,
+	unsigned long long *pullPositionDataLength
+)
+{
+
+	struct numPostings	*pnpNumPostings = (struct numPostings *)pvNumPostings;
+
+
+	/* Check the parameters */
+	if ( pnpNumPostings == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	if ( pullPostingCount != NULL ) {
+		*pullPostingCount = pnpNumPostings->ullPostingCount;
+	}
+
+	if ( pullDocDataLength != NULL ) {
+		*pullDocDataLength = pnpNumPostings->npsDocStream.ullDataLength;
+	}
+
+	if ( pullTfDataLength != NULL ) {
+		*pullTfDataLength = pnpNumPostings->npsTfStream.ullDataLength;
+	}
+
+	if ( pullPositionDataLength != NULL ) {
+		*pullPositionDataLength = pnpNumPostings->npsPositionStream.ullDataLength;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingsFree()
+
+	Purpose:	Frees postings, after any cursors on them.
+
+	Parameters:	pvNumPostings		postings
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingsFree
+(
+	void *pvNumPostings
+)
+{
+
+	struct numPostings	*pnpNumPostings = (struct numPostings *)pvNumPostings;
+
+
+	if ( pnpNumPostings == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	free(pnpNumPostings->npsDocStream.pucData);
+	free(pnpNumPostings->npsTfStream.pucData);
+	free(pnpNumPostings->npsPositionStream.pucData);
+	free(pnpNumPostings->pnpsNumPostingSkips);
+	free(pnpNumPostings->puiDocGaps);
+	free(pnpNumPostings->puiTfs);
+	free(pnpNumPostings->puiPositionGaps);
+	free(pnpNumPostings->pucBlockData);
+	free(pnpNumPostings);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorDecode()
+
+	Purpose:	Decodes a block from a posting stream.
+
+	Parameters:	uiFormat				format
+				pnpsNumPostingStream	posting stream
+				ullOffset				offset of the block
+				puiValues				return array for the integers
+				uiValuesCapacity		capacity of the array
+				uiValuesLength			number of integers expected
+				pullBlockLength			return pointer for the length of the block (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingCursorDecode
+(
+	unsigned int uiFormat,
+	struct numPostingStream *pnpsNumPostingStream,
+	unsigned long long ullOffset,
+	unsigned int *puiValues,
+	unsigned int uiValuesCapacity,
+	unsigned int uiValuesLength,
+	unsigned int *puiBlockLength
+)
+{
+
+	unsigned long long	ullDataLength = 0;
+	unsigned int		uiValuesLengthRead = 0;
+	unsigned int		uiBlockLength = 0;
+	int					iError = NUM_NoError;
+
+
+	ASSERT(pnpsNumPostingStream != NULL);
+	ASSERT(puiValues != NULL);
+
+
+	if ( ullOffset > pnpsNumPostingStream->ullDataLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+	ullDataLength = pnpsNumPostingStream->ullDataLength - ullOffset;
+
+	if ( (iError = iNumBlockDecode(uiFormat, pnpsNumPostingStream->pucData + ullOffset, (ullDataLength < UINT_MAX) ? (unsigned int)ullDataLength : UINT_MAX,
+			puiValues, uiValuesCapacity, &uiValuesLengthRead, &uiBlockLength)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( uiValuesLengthRead != uiValuesLength ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( puiBlockLength != NULL ) {
+		*puiBlockLength = uiBlockLength;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorDecodeDocIDs()
+
+	Purpose:	Decodes the doc IDs of the current block of a cursor, unless
+				they are decoded already.
+
+	Parameters:	pnpcNumPostingCursor	posting cursor
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingCursorDecodeDocIDs
+(
+	struct numPostingCursor *pnpcNumPostingCursor
+)
+{
+
+	struct numPostings		*pnpNumPostings = pnpcNumPostingCursor->pnpNumPostings;
+	struct numPostingSkip	*pnpsNumPostingSkip = pnpNumPostings->pnpsNumPostingSkips + pnpcNumPostingCursor->uiBlock;
+	unsigned int			*puiDocIDs = pnpcNumPostingCursor->puiDocIDs;
+	unsigned int			uiDecodeCount = 0;
+	unsigned int			uiI = 0;
+	int						iError = NUM_NoError;
+
+
+	if ( pnpcNumPostingCursor->uiDocIDsBlock == pnpcNumPostingCursor->uiBlock ) {
+		return (NUM_NoError);
+	}
+
+	pnpcNumPostingCursor->uiDocIDsBlock = UINT_MAX;
+
+	NUM_GET_BLOCK_DECODE_COUNT(pnpNumPostings->uiBlockPostingCount, uiDecodeCount);
+
+	if ( (iError = iNumPostingCursorDecode(NUM_POSTING_DOC_FORMAT, &pnpNumPostings->npsDocStream, pnpsNumPostingSkip->ullDocOffset,
+			puiDocIDs, uiDecodeCount, pnpsNumPostingSkip->uiPostingCount, NULL)) != NUM_NoError ) {
+		return (iError);
+	}
+
+
+	/* Add up the gaps, from the last doc ID of the block before */
+	if ( pnpcNumPostingCursor->uiBlock > 0 ) {
+		puiDocIDs[0] += pnpsNumPostingSkip[-1].uiLastDocID + 1;
+	}
+
+	for ( uiI = 1; uiI < pnpsNumPostingSkip->uiPostingCount; uiI++ ) {
+		puiDocIDs[uiI] += puiDocIDs[uiI - 1] + 1;
+	}
+
+	if ( puiDocIDs[pnpsNumPostingSkip->uiPostingCount - 1] != pnpsNumPostingSkip->uiLastDocID ) {
+		return (NUM_CorruptDataError);
+	}
+
+	pnpcNumPostingCursor->uiDocIDsBlock = pnpcNumPostingCursor->uiBlock;
+	pnpcNumPostingCursor->ullDocBlockCount++;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorDecodeTfs()
+
+	Purpose:	Decodes the frequencies of the current block of a cursor,
+				unless they are decoded already.
+
+	Parameters:	pnpcNumPostingCursor	posting cursor
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingCursorDecodeTfs
+(
+	struct numPostingCursor *pnpcNumPostingCursor
+)
+{
+
+	struct numPostings		*pnpNumPostings = pnpcNumPostingCursor->pnpNumPostings;
+	struct numPostingSkip	*pnpsNumPostingSkip = pnpNumPostings->pnpsNumPostingSkips + pnpcNumPostingCursor->uiBlock;
+	unsigned int			uiDecodeCount = 0;
+	unsigned int			uiI = 0;
+	int						iError = NUM_NoError;
+
+
+	if ( pnpcNumPostingCursor->uiTfsBlock == pnpcNumPostingCursor->uiBlock ) {
+		return (NUM_NoError);
+	}
+
+	pnpcNumPostingCursor->uiTfsBlock = UINT_MAX;
+
+	NUM_GET_BLOCK_DECODE_COUNT(pnpNumPostings->uiBlockPostingCount, uiDecodeCount);
+
+	if ( (iError = iNumPostingCursorDecode(NUM_POSTING_TF_FORMAT, &pnpNumPostings->npsTfStream, pnpsNumPostingSkip->ullTfOffset,
+			pnpcNumPostingCursor->puiTfs, uiDecodeCount, pnpsNumPostingSkip->uiPostingCount, NULL)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	for ( uiI = 0; uiI < pnpsNumPostingSkip->uiPostingCount; uiI++ ) {
+		pnpcNumPostingCursor->puiTfs[uiI]++;
+	}
+
+	pnpcNumPostingCursor->uiTfsBlock = pnpcNumPostingCursor->uiBlock;
+	pnpcNumPostingCursor->ullTfBlockCount++;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorDecodePositions()
+
+	Purpose:	Decodes the positions of the current block of a cursor,
+				unless they are decoded already, and finds where the
+				positions of each posting start.
+
+	Parameters:	pnpcNumPostingCursor	posting cursor
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumPostingCursorDecodePositions
+(
+	struct numPostingCursor *pnpcNumPostingCursor
+)
+{
+
+	struct numPostings		*pnpNumPostings = pnpcNumPostingCursor->pnpNumPostings;
+	struct numPostingSkip	*pnpsNumPostingSkip = pnpNumPostings->pnpsNumPostingSkips + pnpcNumPostingCursor->uiBlock;
+	unsigned int			*puiNewPositions = NULL;
+	unsigned int			*puiPositions = NULL;
+	unsigned long long		ullOffset = 0;
+	unsigned int			uiCapacity = 0;
+	unsigned int			uiLength = 0;
+	unsigned int			uiBlockLength = 0;
+	unsigned int			uiPosition = 0;
+	unsigned int			uiI = 0;
+	unsigned int			uiJ = 0;
+	int						iError = NUM_NoError;
+
+
+	if ( pnpcNumPostingCursor->uiPositionsBlock == pnpcNumPostingCursor->uiBlock ) {
+		return (NUM_NoError);
+	}
+
+	if ( (iError = iNumPostingCursorDecodeTfs(pnpcNumPostingCursor)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	pnpcNumPostingCursor->uiPositionsBlock = UINT_MAX;
+
+
+	/* Grow the positions, the last block decodes up to three integers past its end */
+	if ( pnpsNumPostingSkip->uiPositionCount > (UINT_MAX - 3) ) {
+		return (NUM_CorruptDataError);
+	}
+
+	if ( (pnpsNumPostingSkip->uiPositionCount + 3) > pnpcNumPostingCursor->uiPositionsCapacity ) {
+
+		uiCapacity = pnpsNumPostingSkip->uiPositionCount + 3;
+
+		if ( (puiNewPositions = realloc(pnpcNumPostingCursor->puiPositions, (size_t)uiCapacity * sizeof(unsigned int))) == NULL ) {
+			return (NUM_MemError);
+		}
+
+		pnpcNumPostingCursor->puiPositions = puiNewPositions;
+		pnpcNumPostingCursor->uiPositionsCapacity = uiCapacity;
+	}
+
+	puiPositions = pnpcNumPostingCursor->puiPositions;
+
+
+	/* Decode the blocks of positions */
+	for ( uiI = 0, ullOffset = pnpsNumPostingSkip->ullPositionOffset; uiI < pnpsNumPostingSkip->uiPositionCount; uiI += uiLength, ullOffset += uiBlockLength ) {
+
+		uiLength = ((pnpsNumPostingSkip->uiPositionCount - uiI) < NUM_BLOCK_INTEGER_COUNT_MAX) ? (pnpsNumPostingSkip->uiPositionCount - uiI) : NUM_BLOCK_INTEGER_COUNT_MAX;
+
+		if ( (iError = iNumPostingCursorDecode(NUM_POSTING_POSITION_FORMAT, &pnpNumPostings->npsPositionStream, ullOffset,
+				puiPositions + uiI, pnpcNumPostingCursor->uiPositionsCapacity - uiI, uiLength, &uiBlockLength)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+
+	/* Add up the gaps of each posting */
+	for ( uiI = 0, uiLength = 0; uiI < pnpsNumPostingSkip->uiPostingCount; uiI++ ) {
+
+		if ( pnpcNumPostingCursor->puiTfs[uiI] > (pnpsNumPostingSkip->uiPositionCount - uiLength) ) {
+			return (NUM_CorruptDataError);
+		}
+
+		pnpcNumPostingCursor->puiPositionOffsets[uiI] = uiLength;
+
+		for ( uiJ = 1, uiPosition = puiPositions[uiLength]; uiJ < pnpcNumPostingCursor->puiTfs[uiI]; uiJ++ ) {
+			uiPosition += puiPositions[uiLength + uiJ] + 1;
+			puiPositions[uiLength + uiJ] = uiPosition;
+		}
+
+		uiLength += pnpcNumPostingCursor->puiTfs[uiI];
+	}
+
+	if ( uiLength != pnpsNumPostingSkip->uiPositionCount ) {
+		return (NUM_CorruptDataError);
+	}
+
+	pnpcNumPostingCursor->uiPositionsBlock = pnpcNumPostingCursor->uiBlock;
+	pnpcNumPostingCursor->ullPositionBlockCount++;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorCreate()
+
+	Purpose:	Creates a cursor on postings, the postings must not be
+				freed before the cursor.
+
+	Parameters:	pvNumPostings			postings
+				ppvNumPostingCursor		return pointer for the posting cursor
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingCursorCreate
+(
+	void *pvNumPostings,
+	void **ppvNumPostingCursor
+)
+{
+
+	struct numPostings			*pnpNumPostings = (struct numPostings *)pvNumPostings;
+	struct numPostingCursor		*pnpcNumPostingCursor = NULL;
+	unsigned int				uiDecodeCount = 0;
+
+
+	/* Check the parameters */
+	if ( pnpNumPostings == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumPostingCursor == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	NUM_GET_BLOCK_DECODE_COUNT(pnpNumPostings->uiBlockPostingCount, uiDecodeCount);
+
+
+	/* Allocate the cursor */
+	if ( (pnpcNumPostingCursor = calloc(1, sizeof(struct numPostingCursor))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnpcNumPostingCursor->pnpNumPostings = pnpNumPostings;
+	pnpcNumPostingCursor->bStarted = false;
+	pnpcNumPostingCursor->uiDocIDsBlock = UINT_MAX;
+	pnpcNumPostingCursor->uiTfsBlock = UINT_MAX;
+	pnpcNumPostingCursor->uiPositionsBlock = UINT_MAX;
+
+	if ( ((pnpcNumPostingCursor->puiDocIDs = malloc(uiDecodeCount * sizeof(unsigned int))) == NULL) ||
+			((pnpcNumPostingCursor->puiTfs = malloc(uiDecodeCount * sizeof(unsigned int))) == NULL) ||
+			((pnpcNumPostingCursor->puiPositionOffsets = malloc(uiDecodeCount * sizeof(unsigned int))) == NULL) ) {
+		iNumPostingCursorFree(pnpcNumPostingCursor);
+		return (NUM_MemError);
+	}
+
+
+	*ppvNumPostingCursor = (void *)pnpcNumPostingCursor;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorNext()
+
+	Purpose:	Moves a cursor to the next posting, only its doc ID is
+				decoded.
+
+	Parameters:	pvNumPostingCursor		posting cursor
+				puiDocID				return pointer for the doc ID
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_EndOfStream after the last posting
+
+*/
+int iNumPostingCursorNext
+(
+	void *pvNumPostingCursor,
+	unsigned int *puiDocID
+)
+{
+
+	struct numPostingCursor		*pnpcNumPostingCursor = (struct numPostingCursor *)pvNumPostingCursor;
+	struct numPostings			*pnpNumPostings = NULL;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnpcNumPostingCursor == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDocID == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	pnpNumPostings = pnpcNumPostingCursor->pnpNumPostings;
+
+	if ( pnpcNumPostingCursor->bStarted == false ) {
+		pnpcNumPostingCursor->bStarted = true;
+	}
+	else if ( pnpcNumPostingCursor->uiBlock < pnpNumPostings->uiSkipsLength ) {
+		if ( ++pnpcNumPostingCursor->uiIndex == pnpNumPostings->pnpsNumPostingSkips[pnpcNumPostingCursor->uiBlock].uiPostingCount ) {
+			pnpcNumPostingCursor->uiBlock++;
+			pnpcNumPostingCursor->uiIndex = 0;
+		}
+	}
+
+	if ( pnpcNumPostingCursor->uiBlock >= pnpNumPostings->uiSkipsLength ) {
+		return (NUM_EndOfStream);
+	}
+
+	if ( (iError = iNumPostingCursorDecodeDocIDs(pnpcNumPostingCursor)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	*puiDocID = pnpcNumPostingCursor->puiDocIDs[pnpcNumPostingCursor->uiIndex];
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorAdvance()
+
+	Purpose:	Moves a cursor to the first posting at or after the current
+				one with a doc ID at least the target doc ID, the skip index
+				is searched so blocks in between are not decoded.
+
+	Parameters:	pvNumPostingCursor		posting cursor
+				uiTargetDocID			target doc ID
+				puiDocID				return pointer for the doc ID
+
+	Global Variables:	none
+
+	Returns:	NUM error code, NUM_EndOfStream if there is no such posting
+
+*/
+int iNumPostingCursorAdvance
+(
+	void *pvNumPostingCursor,
+	unsigned int uiTargetDocID,
+	unsigned int *puiDocID
+)
+{
+
+	struct numPostingCursor		*pnpcNumPostingCursor = (struct numPostingCursor *)pvNumPostingCursor;
+	struct numPostings			*pnpNumPostings = NULL;
+	unsigned int				uiLow = 0;
+	unsigned int				uiHigh = 0;
+	unsigned int				uiMiddle = 0;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters */
+	if ( pnpcNumPostingCursor == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDocID == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	pnpNumPostings = pnpcNumPostingCursor->pnpNumPostings;
+	pnpcNumPostingCursor->bStarted = true;
+
+	if ( pnpcNumPostingCursor->uiBlock >= pnpNumPostings->uiSkipsLength ) {
+		return (NUM_EndOfStream);
+	}
+
+
+	/* Search the skip index for the first block whose last doc ID is at least the target */
+	for ( uiLow = pnpcNumPostingCursor->uiBlock, uiHigh = pnpNumPostings->uiSkipsLength; uiLow < uiHigh; ) {
+		uiMiddle = uiLow + ((uiHigh - uiLow) / 2);
+		if ( pnpNumPostings->pnpsNumPostingSkips[uiMiddle].uiLastDocID < uiTargetDocID ) {
+			uiLow = uiMiddle + 1;
+		}
+		else {
+			uiHigh = uiMiddle;
+		}
+	}
+
+	if ( uiLow > pnpcNumPostingCursor->uiBlock ) {
+		pnpcNumPostingCursor->uiBlock = uiLow;
+		pnpcNumPostingCursor->uiIndex = 0;
+	}
+
+	if ( pnpcNumPostingCursor->uiBlock >= pnpNumPostings->uiSkipsLength ) {
+		return (NUM_EndOfStream);
+	}
+
+
+	/* Scan the block, it holds a doc ID at least the target */
+	if ( (iError = iNumPostingCursorDecodeDocIDs(pnpcNumPostingCursor)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	while ( pnpcNumPostingCursor->puiDocIDs[pnpcNumPostingCursor->uiIndex] < uiTargetDocID ) {
+		pnpcNumPostingCursor->uiIndex++;
+	}
+
+	*puiDocID = pnpcNumPostingCursor->puiDocIDs[pnpcNumPostingCursor->uiIndex];
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorGetTf()
+
+	Purpose:	Gets the frequency of the current posting of a cursor, the
+				frequencies of its block are decoded the first time.
+
+	Parameters:	pvNumPostingCursor		posting cursor
+				puiTf					return pointer for the frequency
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingCursorGetTf
+(
+	void *pvNumPostingCursor,
+	unsigned int *puiTf
+)
+{
+
+	struct numPostingCursor		*pnpcNumPostingCursor = (struct numPostingCursor *)pvNumPostingCursor;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters, the cursor must be on a posting */
+	if ( (pnpcNumPostingCursor == NULL) || (pnpcNumPostingCursor->bStarted == false) ||
+			(pnpcNumPostingCursor->uiBlock >= pnpcNumPostingCursor->pnpNumPostings->uiSkipsLength) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiTf == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( (iError = iNumPostingCursorDecodeTfs(pnpcNumPostingCursor)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	*puiTf = pnpcNumPostingCursor->puiTfs[pnpcNumPostingCursor->uiIndex];
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorGetPositions()
+
+	Purpose:	Gets the positions of the current posting of a cursor, the
+				frequencies and positions of its block are decoded the first
+				time.
+
+	Parameters:	pvNumPostingCursor		posting cursor
+				puiPositions			return array for the positions
+				uiPositionsCapacity		capacity of the array
+				puiPositionsLength		return pointer for the number of positions
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingCursorGetPositions
+(
+	void *pvNumPostingCursor,
+	unsigned int *puiPositions,
+	unsigned int uiPositionsCapacity,
+	unsigned int *puiPositionsLength
+)
+{
+
+	struct numPostingCursor		*pnpcNumPostingCursor = (struct numPostingCursor *)pvNumPostingCursor;
+	unsigned int				uiTf = 0;
+	int							iError = NUM_NoError;
+
+
+	/* Check the parameters, the cursor must be on a posting */
+	if ( (pnpcNumPostingCursor == NULL) || (pnpcNumPostingCursor->bStarted == false) ||
+			(pnpcNumPostingCursor->uiBlock >= pnpcNumPostingCursor->pnpNumPostings->uiSkipsLength) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiPositions == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiPositionsLength == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( (iError = iNumPostingCursorDecodePositions(pnpcNumPostingCursor)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	uiTf = pnpcNumPostingCursor->puiTfs[pnpcNumPostingCursor->uiIndex];
+
+	if ( uiTf > uiPositionsCapacity ) {
+		return (NUM_InvalidParameter);
+	}
+
+	memcpy(puiPositions, pnpcNumPostingCursor->puiPositions + pnpcNumPostingCursor->puiPositionOffsets[pnpcNumPostingCursor->uiIndex], uiTf * sizeof(unsigned int));
+
+	*puiPositionsLength = uiTf;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorGetCounts()
+
+	Purpose:	Gets the number of blocks of each stream a cursor decoded.
+
+	Parameters:	pvNumPostingCursor			posting cursor
+				pullDocBlockCount			return pointer for the doc ID block count (optional)
+				pullTfBlockCount			return pointer for the frequency block count (optional)
+				pullPositionBlockCount		return pointer for the position block count (optional)
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingCursorGetCounts
+(
+	void *pvNumPostingCursor,
+	unsigned long long *pullDocBlockCount,
+	unsigned long long *pullTfBlockCount,
+	unsigned long long *pullPositionBlockCount
+)
+{
+
+	struct numPostingCursor		*pnpcNumPostingCursor = (struct numPostingCursor *)pvNumPostingCursor;
+
+
+	/* Check the parameters */
+	if ( pnpcNumPostingCursor == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	if ( pullDocBlockCount != NULL ) {
+		*pullDocBlockCount = pnpcNumPostingCursor->ullDocBlockCount;
+	}
+
+	if ( pullTfBlockCount != NULL ) {
+		*pullTfBlockCount = pnpcNumPostingCursor->ullTfBlockCount;
+	}
+
+	if ( pullPositionBlockCount != NULL ) {
+		*pullPositionBlockCount = pnpcNumPostingCursor->ullPositionBlockCount;
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumPostingCursorFree()
+
+	Purpose:	Frees a posting cursor.
+
+	Parameters:	pvNumPostingCursor		posting cursor
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumPostingCursorFree
+(
+	void *pvNumPostingCursor
+)
+{
+
+	struct numPostingCursor		*pnpcNumPostingCursor = (struct numPostingCursor *)pvNumPostingCursor;
+
+
+	if ( pnpcNumPostingCursor == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	free(pnpcNumPostingCursor->puiDocIDs);
+	free(pnpcNumPostingCursor->puiTfs);
+	free(pnpcNumPostingCursor->puiPositions);
+	free(pnpcNumPostingCursor->puiPositionOffsets);
+	free(pnpcNumPostingCursor);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage functions (thread pool) ===
+** ==============================================
+*/
+
+
+/* Range of task indices owned by a thread, the start is in the low 32 bits
+** and the end in the high 32 bits so both can be swapped in one go. The
+** owner takes tasks from the start and thieves take half from the end.
+*/
+struct numThreadPoolRange {
+	unsigned long long	ullRange;
+} __attribute__ ((aligned (NUM_CACHE_LINE_SIZE)));
+
+
+/* Macros to pack and unpack a task range */
+#define NUM_THREAD_POOL_RANGE_PACK(uiMacroStart, uiMacroEnd)		(((unsigned long long)(uiMacroEnd) << 32) | (unsigned long long)(uiMacroStart))
+#define NUM_THREAD_POOL_RANGE_START(ullMacroRange)					((unsigned int)((ullMacroRange) & 0xFFFFFFFF))
+#define NUM_THREAD_POOL_RANGE_END(ullMacroRange)					((unsigned int)((ullMacroRange) >> 32))
+
+
+/* Thread pool structure */
+struct numThreadPool {
+	unsigned int				uiThreadCount;			/* Including the thread calling iNumThreadPoolRun() */
+	pthread_t					*ptThreads;
+
+	pthread_mutex_t				tmMutex;
+	pthread_cond_t				tcStartCondition;
+	pthread_cond_t				tcDoneCondition;
+	unsigned long long			ullGeneration;
+	unsigned int				uiThreadsDone;
+	boolean						bShutdown;
+
+	iNumThreadPoolTaskCallback	iNumThreadPoolTask;
+	void						*pvTaskContext;
+	struct numThreadPoolRange	*pntprRanges;
+	int							iError;
+};
+
+
+/* Thread start structure */
+struct numThreadPoolStart {
+	struct numThreadPool		*pntpNumThreadPool;
+	unsigned int				uiIndex;
+};
+
+
+/*
+
+	Function:	vNumThreadPoolWork()
+
+	Purpose:	Runs tasks until there are none left, first from the thread's
+				own range and then by stealing half of another thread's range.
+
+	Parameters:	pntpNumThreadPool	thread pool
+				uiIndex				thread index
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumThreadPoolWork
+(
+	struct numThreadPool *pntpNumThreadPool,
+	unsigned int uiIndex
+)
+{
+
+	struct numThreadPoolRange	*pntprOwnRange = pntpNumThreadPool->pntprRanges + uiIndex;
+	struct numThreadPoolRange	*pntprVictimRange = NULL;
+	unsigned long long			ullRange = 0;
+	unsigned int				uiStart = 0;
+	unsigned int				uiEnd = 0;
+	unsigned int				uiMiddle = 0;
+	unsigned int				uiI = 0;
+	boolean						bStolen = false;
+	int							iError = NUM_NoError;
+	int							iNoError = NUM_NoError;
+
+
+	while ( true ) {
+
+		/* Take a task from the start of our own range */
+		ullRange = __atomic_load_n(&pntprOwnRange->ullRange, __ATOMIC_ACQUIRE);
+		uiStart = NUM_THREAD_POOL_RANGE_START(ullRange);
+		uiEnd = NUM_THREAD_POOL_RANGE_END(ullRange);
+
+		if ( uiStart < uiEnd ) {
+
+			if ( __atomic_compare_exchange_n(&pntprOwnRange->ullRange, &ullRange, NUM_THREAD_POOL_RANGE_PACK(uiStart + 1, uiEnd),
+					false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == false ) {
+				continue;
+			}
+
+			if ( (iError = pntpNumThreadPool->iNumThreadPoolTask(pntpNumThreadPool->pvTaskContext, uiStart)) != NUM_NoError ) {
+				iNoError = NUM_NoError;
+				__atomic_compare_exchange_n(&pntpNumThreadPool->iError, &iNoError, iError, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+			}
+
+			continue;
+		}
+
+
+		/* Our range is empty, steal the back half of another range */
+		for ( uiI = 1, bStolen = false; (uiI < pntpNumThreadPool->uiThreadCount) && (bStolen == false); uiI++ ) {
+
+			pntprVictimRange = pntpNumThreadPool->pntprRanges + ((uiIndex + uiI) % pntpNumThreadPool->uiThreadCount);
+
+			ullRange = __atomic_load_n(&pntprVictimRange->ullRange, __ATOMIC_ACQUIRE);
+			uiStart = NUM_THREAD_POOL_RANGE_START(ullRange);
+			uiEnd = NUM_THREAD_POOL_RANGE_END(ullRange);
+
+			while ( uiStart < uiEnd ) {
+
+				uiMiddle = uiStart + ((uiEnd - uiStart) / 2);
+
+				if ( __atomic_compare_exchange_n(&pntprVictimRange->ullRange, &ullRange, NUM_THREAD_POOL_RANGE_PACK(uiStart, uiMiddle),
+						false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == true ) {
+					__atomic_store_n(&pntprOwnRange->ullRange, NUM_THREAD_POOL_RANGE_PACK(uiMiddle, uiEnd), __ATOMIC_RELEASE);
+					bStolen = true;
+					break;
+				}
+
+				uiStart = NUM_THREAD_POOL_RANGE_START(ullRange);
+				uiEnd = NUM_THREAD_POOL_RANGE_END(ullRange);
+			}
+		}
+
+		/* Nothing left anywhere */
+		if ( bStolen == false ) {
+			break;
+		}
+	}
+
+
+	return;
+
+}
+
+
+/*
+
+	Function:	pvNumThreadPoolThread()
+
+	Purpose:	Thread pool thread, waits for work and runs it.
+
+	Parameters:	pvNumThreadPoolStart	thread start structure
+
+	Global Variables:	none
+
+	Returns:	NULL
+
+*/
+static void *pvNumThreadPoolThread
+(
+	void *pvNumThreadPoolStart
+)
+{
+
+	struct numThreadPoolStart	*pntpsNumThreadPoolStart = (struct numThreadPoolStart *)pvNumThreadPoolStart;
+	struct numThreadPool		*pntpNumThreadPool = pntpsNumThreadPoolStart->pntpNumThreadPool;
+	unsigned int				uiIndex = pntpsNumThreadPoolStart->uiIndex;
+	unsigned long long			ullGeneration = 0;
+
+
+	free(pntpsNumThreadPoolStart);
+
+	while ( true ) {
+
+		/* Wait for the next run */
+		pthread_mutex_lock(&pntpNumThreadPool->tmMutex);
+
+		while ( (pntpNumThreadPool->ullGeneration == ullGeneration) && (pntpNumThreadPool->bShutdown == false) ) {
+			pthread_cond_wait(&pntpNumThreadPool->tcStartCondition, &pntpNumThreadPool->tmMutex);
+		}
+
+		if ( pntpNumThreadPool->bShutdown == true ) {
+			pthread_mutex_unlock(&pntpNumThreadPool->tmMutex);
+			break;
+		}
+
+		ullGeneration = pntpNumThreadPool->ullGeneration;
+
+		pthread_mutex_unlock(&pntpNumThreadPool->tmMutex);
+
+
+		vNumThreadPoolWork(pntpNumThreadPool, uiIndex);
+
+
+		/* Tell the caller we are done */
+		pthread_mutex_lock(&pntpNumThreadPool->tmMutex);
+		pntpNumThreadPool->uiThreadsDone++;
+		pthread_cond_signal(&pntpNumThreadPool->tcDoneCondition);
+		pthread_mutex_unlock(&pntpNumThreadPool->tmMutex);
+	}
+
+
+	return (NULL);
+
+}
+
+
+/*
+
+	Function:	iNumThreadPoolCreate()
+
+	Purpose:	Creates a thread pool, the thread calling iNumThreadPoolRun()
+				counts as one of the threads.
+
+	Parameters:	uiThreadCount			number of threads, 0 for the number of processors
+				ppvNumThreadPool		return pointer for the thread pool
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumThreadPoolCreate
+(
+	unsigned int uiThreadCount,
+	void **ppvNumThreadPool
+)
+{
+
+	struct numThreadPool		*pntpNumThreadPool = NULL;
+	struct numThreadPoolStart	*pntpsNumThreadPoolStart = NULL;
+	unsigned int				uiI = 0;
+
+
+	/* Check the parameters */
+	if ( ppvNumThreadPool == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( uiThreadCount == 0 ) {
+		uiThreadCount = (sysconf(_SC_NPROCESSORS_ONLN) > 0) ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+	}
+
+
+	/* Allocate the thread pool */
+	if ( (pntpNumThreadPool = (struct numThreadPool *)calloc(1, sizeof(struct numThreadPool))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	if ( posix_memalign((void **)&pntpNumThreadPool->pntprRanges, NUM_CACHE_LINE_SIZE, uiThreadCount * sizeof(struct numThreadPoolRange)) != 0 ) {
+		free(pntpNumThreadPool);
+		return (NUM_MemError);
+	}
+	memset(pntpNumThreadPool->pntprRanges, 0, uiThreadCount * sizeof(struct numThreadPoolRange));
+
+	if ( (pntpNumThreadPool->ptThreads = (pthread_t *)calloc(uiThreadCount, sizeof(pthread_t))) == NULL ) {
+		free(pntpNumThreadPool->pntprRanges);
+		free(pntpNumThreadPool);
+		return (NUM_MemError);
+	}
+
+	pthread_mutex_init(&pntpNumThreadPool->tmMutex, NULL);
+	pthread_cond_init(&pntpNumThreadPool->tcStartCondition, NULL);
+	pthread_cond_init(&pntpNumThreadPool->tcDoneCondition, NULL);
+
+
+	/* Start the threads, index 0 is the calling thread */
+	for ( pntpNumThreadPool->uiThreadCount = 1, uiI = 1; uiI < uiThreadCount; uiI++ ) {
+
+		if ( (pntpsNumThreadPoolStart = (struct numThreadPoolStart *)malloc(sizeof(struct numThreadPoolStart))) == NULL ) {
+			break;
+		}
+
+		pntpsNumThreadPoolStart->pntpNumThreadPool = pntpNumThreadPool;
+		pntpsNumThreadPoolStart->uiIndex = uiI;
+
+		if ( pthread_create(pntpNumThreadPool->ptThreads + uiI, NULL, pvNumThreadPoolThread, (void *)pntpsNumThreadPoolStart) != 0 ) {
+			free(pntpsNumThreadPoolStart);
+			break;
+		}
+
+		pntpNumThreadPool->uiThreadCount++;
+	}
+
+	*ppvNumThreadPool = (void *)pntpNumThreadPool;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumThreadPoolRun()
+
+	Purpose:	Runs a number of tasks on a thread pool, returning when they
+				are all done. The tasks are split evenly between the threads
+				up front and threads which run out steal from the others.
+
+	Parameters:	pvNumThreadPool			thread pool
+				uiTaskCount				number of tasks
+				iNumThreadPoolTask		task callback
+				pvTaskContext			task context
+
+	Global Variables:	none
+
+	Returns:	NUM error code, the first error returned by a task
+
+*/
+int iNumThreadPoolRun
+(
+	void *pvNumThreadPool,
+	unsigned int uiTaskCount,
+	iNumThreadPoolTaskCallback iNumThreadPoolTask,
+	void *pvTaskContext
+)
+{
+
+	struct numThreadPool	*pntpNumThreadPool = (struct numThreadPool *)pvNumThreadPool;
+	unsigned int			uiI = 0;
+
+
+	/* Check the parameters */
+	if ( (pntpNumThreadPool == NULL) || (iNumThreadPoolTask == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Split the tasks */
+	for ( uiI = 0; uiI < pntpNumThreadPool->uiThreadCount; uiI++ ) {
+		pntpNumThreadPool->pntprRanges[uiI].ullRange = NUM_THREAD_POOL_RANGE_PACK(
+				(unsigned int)(((unsigned long long)uiTaskCount * uiI) / pntpNumThreadPool->uiThreadCount),
+				(unsigned int)(((unsigned long long)uiTaskCount * (uiI + 1)) / pntpNumThreadPool->uiThreadCount));
+	}
+
+	pntpNumThreadPool->iNumThreadPoolTask = iNumThreadPoolTask;
+	pntpNumThreadPool->pvTaskContext = pvTaskContext;
+	pntpNumThreadPool->iError = NUM_NoError;
+
+
+	/* Wake up the threads */
+	pthread_mutex_lock(&pntpNumThreadPool->tmMutex);
+	pntpNumThreadPool->uiThreadsDone = 0;
+	pntpNumThreadPool->ullGeneration++;
+	pthread_cond_broadcast(&pntpNumThreadPool->tcStartCondition);
+	pthread_mutex_unlock(&pntpNumThreadPool->tmMutex);
+
+
+	/* Do our share */
+	vNumThreadPoolWork(pntpNumThreadPool, 0);
+
+
+	/* Wait for the threads */
+	pthread_mutex_lock(&pntpNumThreadPool->tmMutex);
+	while ( pntpNumThreadPool->uiThreadsDone < (pntpNumThreadPool->uiThreadCount - 1) ) {
+		pthread_cond_wait(&pntpNumThreadPool->tcDoneCondition, &pntpNumThreadPool->tmMutex);
+	}
+	pthread_mutex_unlock(&pntpNumThreadPool->tmMutex);
+
+
+	return (pntpNumThreadPool->iError);
+
+}
+
+
+/*
+
+	Function:	iNumThreadPoolFree()
+
+	Purpose:	Stops the threads and frees a thread pool.
+
+	Parameters:	pvNumThreadPool			thread pool
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumThreadPoolFree
+(
+	void *pvNumThreadPool
+)
+{
+
+	struct numThreadPool	*pntpNumThreadPool = (struct numThreadPool *)pvNumThreadPool;
+	unsigned int			uiI = 0;
+
+
+	if ( pntpNumThreadPool == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	/* Stop the threads */
+	pthread_mutex_lock(&pntpNumThreadPool->tmMutex);
+	pntpNumThreadPool->bShutdown = true;
+	pthread_cond_broadcast(&pntpNumThreadPool->tcStartCondition);
+	pthread_mutex_unlock(&pntpNumThreadPool->tmMutex);
+
+	for ( uiI = 1; uiI < pntpNumThreadPool->uiThreadCount; uiI++ ) {
+		pthread_join(pntpNumThreadPool->ptThreads[uiI], NULL);
+	}
+
+
+	pthread_cond_destroy(&pntpNumThreadPool->tcDoneCondition);
+	pthread_cond_destroy(&pntpNumThreadPool->tcStartCondition);
+	pthread_mutex_destroy(&pntpNumThreadPool->tmMutex);
+
+	free(pntpNumThreadPool->ptThreads);
+	free(pntpNumThreadPool->pntprRanges);
+	free(pntpNumThreadPool);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===========================================
+** === Number storage functions (parallel) ===
+** ===========================================
+*/
+
+
+/* Parallel context structure, shared by the tasks */
+struct numParallelContext {
+	unsigned int			uiFormat;
+	unsigned int			uiBlockIntegerCount;
+	unsigned int			uiChunkIntegerCount;
+
+	unsigned int			*puiValues;
+	unsigned long long		ullValuesLength;
+
+	unsigned char			*pucData;
+	unsigned long long		*pullChunkOffsets;
+};
+
+
+/*
+
+	Function:	iNumParallelChunkLengthTask()
+
+	Purpose:	Task which works out the encoded length of a chunk and stores
+				it in the chunk offset array, ready for the prefix sum.
+
+	Parameters:	pvTaskContext		parallel context
+				uiTask				chunk index
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumParallelChunkLengthTask
+(
+	void *pvTaskContext,
+	unsigned int uiTask
+)
+{
+
+	struct numParallelContext	*pnpcNumParallelContext = (struct numParallelContext *)pvTaskContext;
+	int							iError = NUM_NoError;
+	unsigned long long			ullStart = (unsigned long long)uiTask * pnpcNumParallelContext->uiChunkIntegerCount;
+	unsigned long long			ullEnd = 0;
+	unsigned long long			ullChunkLength = 0;
+	unsigned int				uiBlockLength = 0;
+	unsigned int				uiValuesLength = 0;
+
+
+	ullEnd = ullStart + pnpcNumParallelContext->uiChunkIntegerCount;
+	if ( ullEnd > pnpcNumParallelContext->ullValuesLength ) {
+		ullEnd = pnpcNumParallelContext->ullValuesLength;
+	}
+
+	for ( ; ullStart < ullEnd; ullStart += uiValuesLength ) {
+
+		uiValuesLength = ((ullEnd - ullStart) < pnpcNumParallelContext->uiBlockIntegerCount) ? (ullEnd - ullStart) : pnpcNumParallelContext->uiBlockIntegerCount;
+
+		if ( (iError = iNumBlockGetLength(pnpcNumParallelContext->uiFormat, pnpcNumParallelContext->puiValues + ullStart, uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		ullChunkLength += uiBlockLength;
+	}
+
+	pnpcNumParallelContext->pullChunkOffsets[uiTask + 1] = ullChunkLength;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumParallelChunkEncodeTask()
+
+	Purpose:	Task which encodes a chunk at its offset in the data. Blocks
+				are encoded into a scratch buffer first because the encoder
+				uses more space than the final block while it works.
+
+	Parameters:	pvTaskContext		parallel context
+				uiTask				chunk index
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumParallelChunkEncodeTask
+(
+	void *pvTaskContext,
+	unsigned int uiTask
+)
+{
+
+	struct numParallelContext	*pnpcNumParallelContext = (struct numParallelContext *)pvTaskContext;
+	int							iError = NUM_NoError;
+	unsigned long long			ullStart = (unsigned long long)uiTask * pnpcNumParallelContext->uiChunkIntegerCount;
+	unsigned long long			ullEnd = 0;
+	unsigned char				*pucDataPtr = pnpcNumParallelContext->pucData + pnpcNumParallelContext->pullChunkOffsets[uiTask];
+	void						*pvNumArena = NULL;
+	unsigned char				*pucBlock = NULL;
+	unsigned int				uiBlockMaxSize = 0;
+	unsigned int				uiBlockLength = 0;
+	unsigned int				uiValuesLength = 0;
+
+
+	/* The scratch block comes from the arena of this thread so it is reused from chunk to chunk */
+	NUM_GET_BLOCK_MAX_SIZE(pnpcNumParallelContext->uiBlockIntegerCount, uiBlockMaxSize);
+	if ( (iError = iNumArenaGetThread(&pvNumArena)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	if ( (iError = iNumArenaAllocate(pvNumArena, uiBlockMaxSize, (void **)&pucBlock)) != NUM_NoError ) {
+		return (iError);
+	}
+
+	ullEnd = ullStart + pnpcNumParallelContext->uiChunkIntegerCount;
+	if ( ullEnd > pnpcNumParallelContext->ullValuesLength ) {
+		ullEnd = pnpcNumParallelContext->ullValuesLength;
+	}
+
+	for ( ; ullStart < ullEnd; ullStart += uiValuesLength ) {
+
+		uiValuesLength = ((ullEnd - ullStart) < pnpcNumParallelContext->uiBlockIntegerCount) ? (ullEnd - ullStart) : pnpcNumParallelContext->uiBlockIntegerCount;
+
+		if ( (iError = iNumBlockEncode(pnpcNumParallelContext->uiFormat, pnpcNumParallelContext->puiValues + ullStart, uiValuesLength, pucBlock, &uiBlockLength)) != NUM_NoError ) {
+			break;
+		}
+
+		memcpy(pucDataPtr, pucBlock, uiBlockLength);
+		pucDataPtr += uiBlockLength;
+	}
+
+	iNumArenaRelease(pvNumArena, pucBlock);
+
+
+	return (iError);
+
+}
+
+
+/*
+
+	Function:	iNumParallelChunkDecodeTask()
+
+	Purpose:	Task which decodes a chunk to its position in the values.
+
+	Parameters:	pvTaskContext		parallel context
+				uiTask				chunk index
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumParallelChunkDecodeTask
+(
+	void *pvTaskContext,
+	unsigned int uiTask
+)
+{
+
+	struct numParallelContext	*pnpcNumParallelContext = (struct numParallelContext *)pvTaskContext;
+	int							iError = NUM_NoError;
+	unsigned long long			ullStart = (unsigned long long)uiTask * pnpcNumParallelContext->uiChunkIntegerCount;
+	unsigned long long			ullEnd = 0;
+	unsigned long long			ullDecodeEnd = 0;
+	unsigned char				*pucDataPtr = pnpcNumParallelContext->pucData + pnpcNumParallelContext->pullChunkOffsets[uiTask];
+	unsigned char				*pucDataEndPtr = pnpcNumParallelContext->pucData + pnpcNumParallelContext->pullChunkOffsets[uiTask + 1];
+	unsigned int				uiBlockLength = 0;
+	unsigned int				uiValuesLength = 0;
+
+
+	/* Values are padded out to a whole quad at the very end */
+	ullEnd = ullStart + pnpcNumParallelContext->uiChunkIntegerCount;
+	ullDecodeEnd = (pnpcNumParallelContext->ullValuesLength + 3) & ~3ULL;
+	if ( ullEnd > ullDecodeEnd ) {
+		ullEnd = ullDecodeEnd;
+	}
+
+	for ( ; pucDataPtr < pucDataEndPtr; pucDataPtr += uiBlockLength, ullStart += uiValuesLength ) {
+
+		if ( ullStart >= ullEnd ) {
+			return (NUM_CorruptDataError);
+		}
+
+		if ( (iError = iNumBlockDecode(pnpcNumParallelContext->uiFormat, pucDataPtr, pucDataEndPtr - pucDataPtr, pnpcNumParallelContext->puiValues + ullStart,
+				(ullEnd - ullStart) > NUM_BLOCK_INTEGER_COUNT_MAX ? NUM_BLOCK_INTEGER_COUNT_MAX : (ullEnd - ullStart), &uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+			return (iError);
+		}
+	}
+
+	/* Check that the chunk was full, or ran to the end */
+	if ( (ullStart != ullEnd) && (ullStart != pnpcNumParallelContext->ullValuesLength) ) {
+		return (NUM_CorruptDataError);
+	}
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumParallelEncode()
+
+	Purpose:	Encodes an array of integers into blocks in parallel. The
+				array is split into chunks of whole blocks which are encoded
+				independently and laid end to end, so the data is the same
+				as the stream encoder would produce with the same block size.
+
+				The lengths of the chunks are worked out in a first pass so
+				the chunks can be encoded straight into place in the second.
+
+				The data and the chunk offsets are allocated from the arena
+				if one is passed, in which case they are released with
+				iNumArenaRelease(), otherwise they are freed with free().
+
+	Parameters:	pvNumThreadPool			thread pool
+				pvNumArena				arena to allocate from, NULL to use malloc()
+				uiFormat				format
+				uiBlockIntegerCount		number of integers per block, a multiple of 4, 0 for the default
+				uiChunkIntegerCount		number of integers per chunk, a multiple of the block integer count, 0 for the default
+				puiValues				integers to encode
+				ullValuesLength			number of integers to encode
+				ppucData				return pointer for the data, allocated and padded by NUM_READ_PADDING_SIZE
+				pullDataLength			return pointer for the data length
+				ppullChunkOffsets		return pointer for the chunk offsets, chunk count + 1 entries, allocated
+				puiChunkCount			return pointer for the chunk count
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumParallelEncode
+(
+	void *pvNumThreadPool,
+	void *pvNumArena,
+	unsigned int uiFormat,
+	unsigned int uiBlockIntegerCount,
+	unsigned int uiChunkIntegerCount,
+	unsigned int *puiValues,
+	unsigned long long ullValuesLength,
+	unsigned char **ppucData,
+	unsigned long long *pullDataLength,
+	unsigned long long **ppullChunkOffsets,
+	unsigned int *puiChunkCount
+)
+{
+
+	struct numParallelContext	npcNumParallelContext;
+	int							iError = NUM_NoError;
+	unsigned long long			ullChunkCount = 0;
+	unsigned int				uiI = 0;
+
+
+	/* Check the parameters */
+	if ( (pvNumThreadPool == NULL) || (NUM_FORMAT_VALID(uiFormat) == false) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (uiBlockIntegerCount > NUM_BLOCK_INTEGER_COUNT_MAX) || ((uiBlockIntegerCount % 4) != 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (puiValues == NULL) && (ullValuesLength > 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (ppucData == NULL) || (pullDataLength == NULL) || (ppullChunkOffsets == NULL) || (puiChunkCount == NULL) ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	/* Set the defaults */
+	if ( uiBlockIntegerCount == 0 ) {
+		uiBlockIntegerCount = NUM_BLOCK_INTEGER_COUNT_DEFAULT;
+	}
+
+	if ( uiChunkIntegerCount == 0 ) {
+		uiChunkIntegerCount = uiBlockIntegerCount * NUM_PARALLEL_CHUNK_BLOCK_COUNT_DEFAULT;
+	}
+
+	if ( (uiChunkIntegerCount % uiBlockIntegerCount) != 0 ) {
+		return (NUM_InvalidParameter);
+	}
+
+	ullChunkCount = (ullValuesLength + uiChunkIntegerCount - 1) / uiChunkIntegerCount;
+	if ( ullChunkCount > UINT_MAX - 1 ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	memset(&npcNumParallelContext, 0, sizeof(struct numParallelContext));
+	npcNumParallelContext.uiFormat = uiFormat;
+	npcNumParallelContext.uiBlockIntegerCount = uiBlockIntegerCount;
+	npcNumParallelContext.uiChunkIntegerCount = uiChunkIntegerCount;
+	npcNumParallelContext.puiValues = puiValues;
+	npcNumParallelContext.ullValuesLength = ullValuesLength;
+
+	if ( pvNumArena != NULL ) {
+		if ( (iError = iNumArenaAllocate(pvNumArena, (ullChunkCount + 1) * sizeof(unsigned long long), (void **)&npcNumParallelContext.pullChunkOffsets)) != NUM_NoError ) {
+			return (iError);
+		}
+		memset(npcNumParallelContext.pullChunkOffsets, 0, (ullChunkCount + 1) * sizeof(unsigned long long));
+	}
+	else if ( (npcNumParallelContext.pullChunkOffsets = (unsigned long long *)calloc(ullChunkCount + 1, sizeof(unsigned long long))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+
+	/* Get the chunk lengths and turn them into offsets */
+	if ( (iError = iNumThreadPoolRun(pvNumThreadPool, ullChunkCount, iNumParallelChunkLengthTask, (void *)&npcNumParallelContext)) != NUM_NoError ) {
+		goto bailFromiNumParallelEncode;
+	}
+
+	for ( uiI = 1; uiI <= ullChunkCount; uiI++ ) {
+		npcNumParallelContext.pullChunkOffsets[uiI] += npcNumParallelContext.pullChunkOffsets[uiI - 1];
+	}
+
+
+	/* Encode the chunks into place */
+	if ( pvNumArena != NULL ) {
+		if ( (iError = iNumArenaAllocate(pvNumArena, npcNumParallelContext.pullChunkOffsets[ullChunkCount] + NUM_READ_PADDING_SIZE, (void **)&npcNumParallelContext.pucData)) != NUM_NoError ) {
+			goto bailFromiNumParallelEncode;
+		}
+	}
+	else if ( (npcNumParallelContext.pucData = (unsigned char *)malloc(npcNumParallelContext.pullChunkOffsets[ullChunkCount] + NUM_READ_PADDING_SIZE)) == NULL ) {
+		iError = NUM_MemError;
+		goto bailFromiNumParallelEncode;
+	}
+
+	if ( (iError = iNumThreadPoolRun(pvNumThreadPool, ullChunkCount, iNumParallelChunkEncodeTask, (void *)&npcNumParallelContext)) != NUM_NoError ) {
+		goto bailFromiNumParallelEncode;
+	}
+
+	memset(npcNumParallelContext.pucData + npcNumParallelContext.pullChunkOffsets[ullChunkCount], 0, NUM_READ_PADDING_SIZE);
+
+
+	*ppucData = npcNumParallelContext.pucData;
+	*pullDataLength = npcNumParallelContext.pullChunkOffsets[ullChunkCount];
+	*ppullChunkOffsets = npcNumParallelContext.pullChunkOffsets;
+	*puiChunkCount = ullChunkCount;
+
+
+
+	/* Bail label */
+	bailFromiNumParallelEncode:
+
+	if ( iError != NUM_NoError ) {
+		if ( pvNumArena != NULL ) {
+			iNumArenaRelease(pvNumArena, npcNumParallelContext.pucData);
+			iNumArenaRelease(pvNumArena, npcNumParallelContext.pullChunkOffsets);
+		}
+		else {
+			free(npcNumParallelContext.pucData);
+			free(npcNumParallelContext.pullChunkOffsets);
+		}
+	}
+
+
+	return (iError);
+
+}
+
+
+/*
+
+	Function:	iNumParallelDecode()
+
+	Purpose:	Decodes data produced by iNumParallelEncode() in parallel, one
+				task per chunk. The values array must hold the number of
+				integers rounded up to a multiple of 4.
+
+	Parameters:	pvNumThreadPool			thread pool
+				uiFormat				format
+				uiChunkIntegerCount		number of integers per chunk used to encode
+				pucData					data, padded by NUM_READ_PADDING_SIZE
+				pullChunkOffsets		chunk offsets
+				uiChunkCount			chunk count
+				puiValues				where to decode the integers
+				ullValuesLength			number of integers encoded
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumParallelDecode
+(
+	void *pvNumThreadPool,
+	unsigned int uiFormat,
+	unsigned int uiChunkIntegerCount,
+	unsigned char *pucData,
+	unsigned long long *pullChunkOffsets,
+	unsigned int uiChunkCount,
+	unsigned int *puiValues,
+	unsigned long long ullValuesLength
+)
+{
+
+	struct numParallelContext	npcNumParallelContext;
+
+
+	/* Check the parameters */
+	if ( (pvNumThreadPool == NULL) || (NUM_FORMAT_VALID(uiFormat) == false) || (uiChunkIntegerCount == 0) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( (pucData == NULL) || (pullChunkOffsets == NULL) || (puiValues == NULL) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ullValuesLength > ((unsigned long long)uiChunkCount * uiChunkIntegerCount) ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+	memset(&npcNumParallelContext, 0, sizeof(struct numParallelContext));
+	npcNumParallelContext.uiFormat = uiFormat;
+	npcNumParallelContext.uiChunkIntegerCount = uiChunkIntegerCount;
+	npcNumParallelContext.puiValues = puiValues;
+	npcNumParallelContext.ullValuesLength = ullValuesLength;
+	npcNumParallelContext.pucData = pucData;
+	npcNumParallelContext.pullChunkOffsets = pullChunkOffsets;
+
+
+	return (iNumThreadPoolRun(pvNumThreadPool, uiChunkCount, iNumParallelChunkDecodeTask, (void *)&npcNumParallelContext));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===============================================
+** === Number storage functions (async source) ===
+** ===============================================
+*/
+
+
+/* The async source keeps a number of reads of the upcoming parts of a file
+** in flight while the stream decoder works on the data already read. Reads
+** are issued through io_uring when the kernel supports it, otherwise a
+** thread issues them with pread().
+*/
+
+
+/* Async source slot states */
+#define NUM_ASYNC_SLOT_FREE							(0)
+#define NUM_ASYNC_SLOT_PENDING						(1)
+#define NUM_ASYNC_SLOT_DONE							(2)
+
+
+/* Async source slot structure, one read */
+struct numAsyncSlot {
+	unsigned char		*pucBuffer;
+	off_t				zOffset;
+	unsigned int		uiLength;				/* Length requested */
+	int					iResult;				/* Length read, or -errno */
+	unsigned int		uiState;
+	struct iovec		ioIoVec;
+};
+
+
+#if defined(__linux__)
+/* io_uring rings, mapped from the kernel */
+struct numIoUring {
+	int					iRingFileDescriptor;
+
+	void				*pvSqRing;
+	size_t				zSqRingLength;
+	unsigned int		*puiSqHead;
+	unsigned int		*puiSqTail;
+	unsigned int		*puiSqMask;
+	unsigned int		*puiSqArray;
+	struct io_uring_sqe	*pisSqes;
+	size_t				zSqesLength;
+
+	void				*pvCqRing;
+	size_t				zCqRingLength;
+	unsigned int		*puiCqHead;
+	unsigned int		*puiCqTail;
+	unsigned int		*puiCqMask;
+	struct io_uring_cqe	*picCqes;
+};
+#endif	/* defined(__linux__) */
+
+
+/* Async source structure */
+struct numAsyncSource {
+	int					iFileDescriptor;
+	off_t				zFileLength;
+
+	struct numAsyncSlot	*pnasSlots;
+	unsigned int		uiQueueDepth;
+	unsigned int		uiReadLength;
+
+	off_t				zSubmitOffset;			/* Next offset to submit a read for */
+	unsigned int		uiSubmitSlot;			/* Next slot to submit a read into */
+	unsigned int		uiConsumeSlot;			/* Next slot to hand out */
+	unsigned int		uiConsumeIndex;			/* Position in that slot */
+
+	boolean				bIoUring;
+#if defined(__linux__)
+	struct numIoUring	niuNumIoUring;
+#endif	/* defined(__linux__) */
+
+	/* Fallback read thread */
+	pthread_t			tThread;
+	pthread_mutex_t		tmMutex;
+	pthread_cond_t		tcCondition;
+	boolean				bShutdown;
+};
+
+
+#if defined(__linux__)
+/*
+
+	Function:	iNumIoUringCreate()
+
+	Purpose:	Sets up an io_uring and maps its rings.
+
+	Parameters:	uiEntries			number of entries
+				pniuNumIoUring		io_uring to set up
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumIoUringCreate
+(
+	unsigned int uiEntries,
+	struct numIoUring *pniuNumIoUring
+)
+{
+
+	struct io_uring_params	iupParams;
+
+
+	ASSERT(pniuNumIoUring != NULL);
+
+
+	memset(pniuNumIoUring, 0, sizeof(struct numIoUring));
+	memset(&iupParams, 0, sizeof(struct io_uring_params));
+
+	if ( (pniuNumIoUring->iRingFileDescriptor = syscall(__NR_io_uring_setup, uiEntries, &iupParams)) == -1 ) {
+		return (NUM_SourceError);
+	}
+
+
+	/* Map the submission ring, the submission entries and the completion ring */
+	pniuNumIoUring->zSqRingLength = iupParams.sq_off.array + (iupParams.sq_entries * sizeof(unsigned int));
+	pniuNumIoUring->zSqesLength = iupParams.sq_entries * sizeof(struct io_uring_sqe);
+	pniuNumIoUring->zCqRingLength = iupParams.cq_off.cqes + (iupParams.cq_entries * sizeof(struct io_uring_cqe));
+
+	pniuNumIoUring->pvSqRing = mmap(NULL, pniuNumIoUring->zSqRingLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			pniuNumIoUring->iRingFileDescriptor, IORING_OFF_SQ_RING);
+	pniuNumIoUring->pisSqes = (struct io_uring_sqe *)mmap(NULL, pniuNumIoUring->zSqesLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			pniuNumIoUring->iRingFileDescriptor, IORING_OFF_SQES);
+	pniuNumIoUring->pvCqRing = mmap(NULL, pniuNumIoUring->zCqRingLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			pniuNumIoUring->iRingFileDescriptor, IORING_OFF_CQ_RING);
+
+	if ( (pniuNumIoUring->pvSqRing == MAP_FAILED) || (pniuNumIoUring->pisSqes == MAP_FAILED) || (pniuNumIoUring->pvCqRing == MAP_FAILED) ) {
+		if ( pniuNumIoUring->pvSqRing != MAP_FAILED ) {
+			munmap(pniuNumIoUring->pvSqRing, pniuNumIoUring->zSqRingLength);
+		}
+		if ( pniuNumIoUring->pisSqes != MAP_FAILED ) {
+			munmap(pniuNumIoUring->pisSqes, pniuNumIoUring->zSqesLength);
+		}
+		if ( pniuNumIoUring->pvCqRing != MAP_FAILED ) {
+			munmap(pniuNumIoUring->pvCqRing, pniuNumIoUring->zCqRingLength);
+		}
+		close(pniuNumIoUring->iRingFileDescriptor);
+		return (NUM_SourceError);
+	}
+
+	pniuNumIoUring->puiSqHead = (unsigned int *)((unsigned char *)pniuNumIoUring->pvSqRing + iupParams.sq_off.head);
+	pniuNumIoUring->puiSqTail = (unsigned int *)((unsigned char *)pniuNumIoUring->pvSqRing + iupParams.sq_off.tail);
+	pniuNumIoUring->puiSqMask = (unsigned int *)((unsigned char *)pniuNumIoUring->pvSqRing + iupParams.sq_off.ring_mask);
+	pniuNumIoUring->puiSqArray = (unsigned int *)((unsigned char *)pniuNumIoUring->pvSqRing + iupParams.sq_off.array);
+
+	pniuNumIoUring->puiCqHead = (unsigned int *)((unsigned char *)pniuNumIoUring->pvCqRing + iupParams.cq_off.head);
+	pniuNumIoUring->puiCqTail = (unsigned int *)((unsigned char *)pniuNumIoUring->pvCqRing + iupParams.cq_off.tail);
+	pniuNumIoUring->puiCqMask = (unsigned int *)((unsigned char *)pniuNumIoUring->pvCqRing + iupParams.cq_off.ring_mask);
+	pniuNumIoUring->picCqes = (struct io_uring_cqe *)((unsigned char *)pniuNumIoUring->pvCqRing + iupParams.cq_off.cqes);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	vNumIoUringFree()
+
+	Purpose:	Unmaps the rings and closes an io_uring.
+
+	Parameters:	pniuNumIoUring		io_uring
+
+	Global Variables:	none
+
+	Returns:	void
+
+*/
+static void vNumIoUringFree
+(
+	struct numIoUring *pniuNumIoUring
+)
+{
+
+	ASSERT(pniuNumIoUring != NULL);
+
+
+	munmap(pniuNumIoUring->pvCqRing, pniuNumIoUring->zCqRingLength);
+	munmap(pniuNumIoUring->pisSqes, pniuNumIoUring->zSqesLength);
+	munmap(pniuNumIoUring->pvSqRing, pniuNumIoUring->zSqRingLength);
+	close(pniuNumIoUring->iRingFileDescriptor);
+
+	return;
+
+}
+#endif	/* defined(__linux__) */
+
+
+/*
+
+	Function:	pvNumAsyncSourceThread()
+
+	Purpose:	Fallback read thread, fills the slots in order with pread()
+				as they are freed by the consumer.
+
+	Parameters:	pvNumAsyncSource	async source
+
+	Global Variables:	none
+
+	Returns:	NULL
+
+*/
+static void *pvNumAsyncSourceThread
+(
+	void *pvNumAsyncSource
+)
+{
+
+	struct numAsyncSource	*pnasNumAsyncSource = (struct numAsyncSource *)pvNumAsyncSource;
+	struct numAsyncSlot		*pnasNumAsyncSlot = NULL;
+	ssize_t					zBytesRead = 0;
+
+
+	while ( true ) {
+
+		/* Wait for the next slot to be handed a read */
+		pthread_mutex_lock(&pnasNumAsyncSource->tmMutex);
+
+		pnasNumAsyncSlot = pnasNumAsyncSource->pnasSlots + pnasNumAsyncSource->uiSubmitSlot;
+
+		while ( (pnasNumAsyncSlot->uiState != NUM_ASYNC_SLOT_PENDING) && (pnasNumAsyncSource->bShutdown == false) ) {
+			pthread_cond_wait(&pnasNumAsyncSource->tcCondition, &pnasNumAsyncSource->tmMutex);
+		}
+
+		if ( pnasNumAsyncSource->bShutdown == true ) {
+			pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+			break;
+		}
+
+		pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+
+
+		/* Read the data */
+		while ( ((zBytesRead = pread(pnasNumAsyncSource->iFileDescriptor, pnasNumAsyncSlot->pucBuffer, pnasNumAsyncSlot->uiLength,
+				pnasNumAsyncSlot->zOffset)) == -1) && (errno == EINTR) ) {
+			;
+		}
+
+
+		/* Hand the slot back */
+		pthread_mutex_lock(&pnasNumAsyncSource->tmMutex);
+		pnasNumAsyncSlot->iResult = (zBytesRead == -1) ? -errno : zBytesRead;
+		pnasNumAsyncSlot->uiState = NUM_ASYNC_SLOT_DONE;
+		pnasNumAsyncSource->uiSubmitSlot = (pnasNumAsyncSource->uiSubmitSlot + 1) % pnasNumAsyncSource->uiQueueDepth;
+		pthread_cond_broadcast(&pnasNumAsyncSource->tcCondition);
+		pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+	}
+
+
+	return (NULL);
+
+}
+
+
+/*
+
+	Function:	iNumAsyncSourceSubmit()
+
+	Purpose:	Submits reads into the free slots, in file order.
+
+	Parameters:	pnasNumAsyncSource		async source
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumAsyncSourceSubmit
+(
+	struct numAsyncSource *pnasNumAsyncSource
+)
+{
+
+	struct numAsyncSlot		*pnasNumAsyncSlot = NULL;
+	unsigned int			uiSubmitCount = 0;
+	unsigned int			uiSlot = 0;
+	unsigned int			uiI = 0;
+
+
+	ASSERT(pnasNumAsyncSource != NULL);
+
+
+	/* Walk the slots from the one after the last submitted, in file order,
+	** the read thread takes them in the same order
+	*/
+	if ( pnasNumAsyncSource->bIoUring == true ) {
+		uiSlot = pnasNumAsyncSource->uiSubmitSlot;
+	}
+	else {
+		uiSlot = pnasNumAsyncSource->uiConsumeSlot;
+		pthread_mutex_lock(&pnasNumAsyncSource->tmMutex);
+	}
+
+	for ( uiI = 0; uiI < pnasNumAsyncSource->uiQueueDepth; uiI++ ) {
+
+		if ( pnasNumAsyncSource->zSubmitOffset >= pnasNumAsyncSource->zFileLength ) {
+			break;
+		}
+
+		pnasNumAsyncSlot = pnasNumAsyncSource->pnasSlots + uiSlot;
+
+		if ( pnasNumAsyncSlot->uiState == NUM_ASYNC_SLOT_FREE ) {
+
+			pnasNumAsyncSlot->zOffset = pnasNumAsyncSource->zSubmitOffset;
+			pnasNumAsyncSlot->uiLength = pnasNumAsyncSource->uiReadLength;
+			if ( (pnasNumAsyncSlot->zOffset + pnasNumAsyncSlot->uiLength) > pnasNumAsyncSource->zFileLength ) {
+				pnasNumAsyncSlot->uiLength = pnasNumAsyncSource->zFileLength - pnasNumAsyncSlot->zOffset;
+			}
+			pnasNumAsyncSource->zSubmitOffset += pnasNumAsyncSlot->uiLength;
+
+#if defined(__linux__)
+			if ( pnasNumAsyncSource->bIoUring == true ) {
+
+				struct numIoUring	*pniuNumIoUring = &pnasNumAsyncSource->niuNumIoUring;
+				unsigned int		uiTail = *pniuNumIoUring->puiSqTail;
+				unsigned int		uiIndex = uiTail & *pniuNumIoUring->puiSqMask;
+				struct io_uring_sqe	*pisSqe = pniuNumIoUring->pisSqes + uiIndex;
+
+				pnasNumAsyncSlot->ioIoVec.iov_base = pnasNumAsyncSlot->pucBuffer;
+				pnasNumAsyncSlot->ioIoVec.iov_len = pnasNumAsyncSlot->uiLength;
+
+				memset(pisSqe, 0, sizeof(struct io_uring_sqe));
+				pisSqe->opcode = IORING_OP_READV;
+				pisSqe->fd = pnasNumAsyncSource->iFileDescriptor;
+				pisSqe->addr = (unsigned long)&pnasNumAsyncSlot->ioIoVec;
+				pisSqe->len = 1;
+				pisSqe->off = pnasNumAsyncSlot->zOffset;
+				pisSqe->user_data = uiSlot;
+
+				pniuNumIoUring->puiSqArray[uiIndex] = uiIndex;
+				__atomic_store_n(pniuNumIoUring->puiSqTail, uiTail + 1, __ATOMIC_RELEASE);
+
+				pnasNumAsyncSlot->uiState = NUM_ASYNC_SLOT_PENDING;
+				pnasNumAsyncSource->uiSubmitSlot = (uiSlot + 1) % pnasNumAsyncSource->uiQueueDepth;
+				uiSubmitCount++;
+			}
+			else
+#endif	/* defined(__linux__) */
+			{
+				pnasNumAsyncSlot->uiState = NUM_ASYNC_SLOT_PENDING;
+			}
+		}
+		else if ( pnasNumAsyncSource->bIoUring == true ) {
+			/* The ring is full */
+			break;
+		}
+
+		uiSlot = (uiSlot + 1) % pnasNumAsyncSource->uiQueueDepth;
+	}
+
+	if ( pnasNumAsyncSource->bIoUring == false ) {
+		pthread_cond_broadcast(&pnasNumAsyncSource->tcCondition);
+		pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+	}
+
+
+#if defined(__linux__)
+	/* Tell the kernel about the new reads */
+	if ( uiSubmitCount > 0 ) {
+		while ( syscall(__NR_io_uring_enter, pnasNumAsyncSource->niuNumIoUring.iRingFileDescriptor, uiSubmitCount, 0, 0, NULL, 0) == -1 ) {
+			if ( errno != EINTR ) {
+				return (NUM_SourceError);
+			}
+		}
+	}
+#endif	/* defined(__linux__) */
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumAsyncSourceWait()
+
+	Purpose:	Waits for the read in a slot to complete.
+
+	Parameters:	pnasNumAsyncSource		async source
+				pnasNumAsyncSlot		slot
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+static int iNumAsyncSourceWait
+(
+	struct numAsyncSource *pnasNumAsyncSource,
+	struct numAsyncSlot *pnasNumAsyncSlot
+)
+{
+
+	ASSERT(pnasNumAsyncSource != NULL);
+	ASSERT(pnasNumAsyncSlot != NULL);
+
+
+#if defined(__linux__)
+	if ( pnasNumAsyncSource->bIoUring == true ) {
+
+		struct numIoUring	*pniuNumIoUring = &pnasNumAsyncSource->niuNumIoUring;
+		struct io_uring_cqe	*picCqe = NULL;
+		unsigned int		uiHead = 0;
+
+		/* Reap completions, which can arrive in any order, until our slot is done */
+		while ( pnasNumAsyncSlot->uiState != NUM_ASYNC_SLOT_DONE ) {
+
+			uiHead = *pniuNumIoUring->puiCqHead;
+
+			if ( uiHead == __atomic_load_n(pniuNumIoUring->puiCqTail, __ATOMIC_ACQUIRE) ) {
+				if ( (syscall(__NR_io_uring_enter, pniuNumIoUring->iRingFileDescriptor, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) == -1) && (errno != EINTR) ) {
+					return (NUM_SourceError);
+				}
+				continue;
+			}
+
+			picCqe = pniuNumIoUring->picCqes + (uiHead & *pniuNumIoUring->puiCqMask);
+			pnasNumAsyncSource->pnasSlots[picCqe->user_data].iResult = picCqe->res;
+			pnasNumAsyncSource->pnasSlots[picCqe->user_data].uiState = NUM_ASYNC_SLOT_DONE;
+
+			__atomic_store_n(pniuNumIoUring->puiCqHead, uiHead + 1, __ATOMIC_RELEASE);
+		}
+
+		return (NUM_NoError);
+	}
+#endif	/* defined(__linux__) */
+
+
+	pthread_mutex_lock(&pnasNumAsyncSource->tmMutex);
+	while ( pnasNumAsyncSlot->uiState != NUM_ASYNC_SLOT_DONE ) {
+		pthread_cond_wait(&pnasNumAsyncSource->tcCondition, &pnasNumAsyncSource->tmMutex);
+	}
+	pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumAsyncSourceCreate()
+
+	Purpose:	Creates an async source and starts the first reads.
+
+	Parameters:	iFileDescriptor			file descriptor, read from the start
+				uiQueueDepth			number of reads kept in flight, 0 for the default
+				uiReadLength			length of each read, 0 for the default
+				bIoUring				true to use io_uring if the kernel supports it
+				ppvNumAsyncSource		return pointer for the async source
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumAsyncSourceCreate
+(
+	int iFileDescriptor,
+	unsigned int uiQueueDepth,
+	unsigned int uiReadLength,
+	boolean bIoUring,
+	void **ppvNumAsyncSource
+)
+{
+
+	struct numAsyncSource	*pnasNumAsyncSource = NULL;
+	struct stat				stStat;
+	int						iError = NUM_NoError;
+	unsigned int			uiI = 0;
+
+
+	/* Check the parameters */
+	if ( (iFileDescriptor < 0) || (uiQueueDepth > NUM_ASYNC_SOURCE_QUEUE_DEPTH_MAX) ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( ppvNumAsyncSource == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	if ( fstat(iFileDescriptor, &stStat) == -1 ) {
+		return (NUM_SourceError);
+	}
+
+
+	/* Set the defaults */
+	if ( uiQueueDepth == 0 ) {
+		uiQueueDepth = NUM_ASYNC_SOURCE_QUEUE_DEPTH_DEFAULT;
+	}
+
+	if ( uiReadLength == 0 ) {
+		uiReadLength = NUM_ASYNC_SOURCE_READ_LENGTH_DEFAULT;
+	}
+
+
+	/* Allocate the source and the slots */
+	if ( (pnasNumAsyncSource = (struct numAsyncSource *)calloc(1, sizeof(struct numAsyncSource))) == NULL ) {
+		return (NUM_MemError);
+	}
+
+	pnasNumAsyncSource->iFileDescriptor = iFileDescriptor;
+	pnasNumAsyncSource->zFileLength = stStat.st_size;
+	pnasNumAsyncSource->uiQueueDepth = uiQueueDepth;
+	pnasNumAsyncSource->uiReadLength = uiReadLength;
+
+	if ( (pnasNumAsyncSource->pnasSlots = (struct numAsyncSlot *)calloc(uiQueueDepth, sizeof(struct numAsyncSlot))) == NULL ) {
+		iError = NUM_MemError;
+		goto bailFromiNumAsyncSourceCreate;
+	}
+
+	for ( uiI = 0; uiI < uiQueueDepth; uiI++ ) {
+		if ( (pnasNumAsyncSource->pnasSlots[uiI].pucBuffer = (unsigned char *)malloc(uiReadLength)) == NULL ) {
+			iError = NUM_MemError;
+			goto bailFromiNumAsyncSourceCreate;
+		}
+	}
+
+	pthread_mutex_init(&pnasNumAsyncSource->tmMutex, NULL);
+	pthread_cond_init(&pnasNumAsyncSource->tcCondition, NULL);
+
+
+	/* Use io_uring if we can and start the first reads, if the kernel
+	** refuses the reads we fall back to the read thread
+	*/
+#if defined(__linux__)
+	if ( (bIoUring == true) && (iNumIoUringCreate(uiQueueDepth, &pnasNumAsyncSource->niuNumIoUring) == NUM_NoError) ) {
+
+		pnasNumAsyncSource->bIoUring = true;
+
+		if ( iNumAsyncSourceSubmit(pnasNumAsyncSource) != NUM_NoError ) {
+
+			vNumIoUringFree(&pnasNumAsyncSource->niuNumIoUring);
+			pnasNumAsyncSource->bIoUring = false;
+
+			for ( uiI = 0; uiI < uiQueueDepth; uiI++ ) {
+				pnasNumAsyncSource->pnasSlots[uiI].uiState = NUM_ASYNC_SLOT_FREE;
+			}
+			pnasNumAsyncSource->zSubmitOffset = 0;
+			pnasNumAsyncSource->uiSubmitSlot = 0;
+		}
+	}
+#endif	/* defined(__linux__) */
+
+	if ( pnasNumAsyncSource->bIoUring == false ) {
+
+		if ( pthread_create(&pnasNumAsyncSource->tThread, NULL, pvNumAsyncSourceThread, (void *)pnasNumAsyncSource) != 0 ) {
+			pthread_cond_destroy(&pnasNumAsyncSource->tcCondition);
+			pthread_mutex_destroy(&pnasNumAsyncSource->tmMutex);
+			iError = NUM_SourceError;
+			goto bailFromiNumAsyncSourceCreate;
+		}
+
+		/* Can't fail without io_uring */
+		iNumAsyncSourceSubmit(pnasNumAsyncSource);
+	}
+
+
+	*ppvNumAsyncSource = (void *)pnasNumAsyncSource;
+
+	return (NUM_NoError);
+
+
+
+	/* Bail label */
+	bailFromiNumAsyncSourceCreate:
+
+	if ( pnasNumAsyncSource->pnasSlots != NULL ) {
+		for ( uiI = 0; uiI < uiQueueDepth; uiI++ ) {
+			free(pnasNumAsyncSource->pnasSlots[uiI].pucBuffer);
+		}
+		free(pnasNumAsyncSource->pnasSlots);
+	}
+
+	free(pnasNumAsyncSource);
+
+
+	return (iError);
+
+}
+
+
+/*
+
+	Function:	iNumAsyncSourceIsIoUring()
+
+	Purpose:	Checks whether an async source is using io_uring or the
+				fallback read thread.
+
+	Parameters:	pvNumAsyncSource	async source
+				pbIoUring			return pointer for the io_uring flag
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumAsyncSourceIsIoUring
+(
+	void *pvNumAsyncSource,
+	boolean *pbIoUring
+)
+{
+
+	if ( pvNumAsyncSource == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( pbIoUring == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+	*pbIoUring = ((struct numAsyncSource *)pvNumAsyncSource)->bIoUring;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumAsyncSourceFree()
+
+	Purpose:	Frees an async source, waiting for reads in flight. The file
+				descriptor is not closed.
+
+	Parameters:	pvNumAsyncSource	async source
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumAsyncSourceFree
+(
+	void *pvNumAsyncSource
+)
+{
+
+	struct numAsyncSource	*pnasNumAsyncSource = (struct numAsyncSource *)pvNumAsyncSource;
+	unsigned int			uiI = 0;
+
+
+	if ( pnasNumAsyncSource == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+
+#if defined(__linux__)
+	if ( pnasNumAsyncSource->bIoUring == true ) {
+
+		/* The kernel may still be writing to the buffers */
+		for ( uiI = 0; uiI < pnasNumAsyncSource->uiQueueDepth; uiI++ ) {
+			if ( pnasNumAsyncSource->pnasSlots[uiI].uiState == NUM_ASYNC_SLOT_PENDING ) {
+				iNumAsyncSourceWait(pnasNumAsyncSource, pnasNumAsyncSource->pnasSlots + uiI);
+			}
+		}
+
+		vNumIoUringFree(&pnasNumAsyncSource->niuNumIoUring);
+	}
+	else
+#endif	/* defined(__linux__) */
+	{
+		pthread_mutex_lock(&pnasNumAsyncSource->tmMutex);
+		pnasNumAsyncSource->bShutdown = true;
+		pthread_cond_broadcast(&pnasNumAsyncSource->tcCondition);
+		pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+
+		pthread_join(pnasNumAsyncSource->tThread, NULL);
+	}
+
+	pthread_cond_destroy(&pnasNumAsyncSource->tcCondition);
+	pthread_mutex_destroy(&pnasNumAsyncSource->tmMutex);
+
+	for ( uiI = 0; uiI < pnasNumAsyncSource->uiQueueDepth; uiI++ ) {
+		free(pnasNumAsyncSource->pnasSlots[uiI].pucBuffer);
+	}
+	free(pnasNumAsyncSource->pnasSlots);
+	free(pnasNumAsyncSource);
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*
+
+	Function:	iNumStreamSourceAsync()
+
+	Purpose:	Source callback which reads from an async source, the context
+				is the async source. Each slot handed back is refilled with
+				the next part of the file straight away.
+
+	Parameters:	pvSourceContext		async source
+				pucData				where to read the data to
+				uiDataLength		length of the data
+				puiDataLengthRead	return pointer for the length of the data read
+
+	Global Variables:	none
+
+	Returns:	NUM error code
+
+*/
+int iNumStreamSourceAsync
+(
+	void *pvSourceContext,
+	unsigned char *pucData,
+	unsigned int uiDataLength,
+	unsigned int *puiDataLengthRead
+)
+{
+
+	struct numAsyncSource	*pnasNumAsyncSource = (struct numAsyncSource *)pvSourceContext;
+	struct numAsyncSlot		*pnasNumAsyncSlot = NULL;
+	int						iError = NUM_NoError;
+	unsigned int			uiDataLengthRead = 0;
+	unsigned int			uiLength = 0;
+	ssize_t					zBytesRead = 0;
+
+
+	if ( pnasNumAsyncSource == NULL ) {
+		return (NUM_InvalidParameter);
+	}
+
+	if ( puiDataLengthRead == NULL ) {
+		return (NUM_ReturnParameterError);
+	}
+
+
+	while ( uiDataLengthRead < uiDataLength ) {
+
+		pnasNumAsyncSlot = pnasNumAsyncSource->pnasSlots + pnasNumAsyncSource->uiConsumeSlot;
+
+		/* Nothing in flight means we are at the end of the file */
+		if ( pnasNumAsyncSlot->uiState == NUM_ASYNC_SLOT_FREE ) {
+			break;
+		}
+
+		if ( (iError = iNumAsyncSourceWait(pnasNumAsyncSource, pnasNumAsyncSlot)) != NUM_NoError ) {
+			return (iError);
+		}
+
+		if ( pnasNumAsyncSlot->iResult < 0 ) {
+			return (NUM_SourceError);
+		}
+
+		/* Finish off short reads synchronously, they are rare on regular files */
+		while ( (unsigned int)pnasNumAsyncSlot->iResult < pnasNumAsyncSlot->uiLength ) {
+
+			if ( (zBytesRead = pread(pnasNumAsyncSource->iFileDescriptor, pnasNumAsyncSlot->pucBuffer + pnasNumAsyncSlot->iResult,
+					pnasNumAsyncSlot->uiLength - pnasNumAsyncSlot->iResult, pnasNumAsyncSlot->zOffset + pnasNumAsyncSlot->iResult)) == -1 ) {
+				if ( errno == EINTR ) {
+					continue;
+				}
+				return (NUM_SourceError);
+			}
+
+			if ( zBytesRead == 0 ) {
+				return (NUM_SourceError);
+			}
+
+			pnasNumAsyncSlot->iResult += zBytesRead;
+		}
+
+		/* Copy what we can from the slot */
+		uiLength = pnasNumAsyncSlot->uiLength - pnasNumAsyncSource->uiConsumeIndex;
+		if ( uiLength > (uiDataLength - uiDataLengthRead) ) {
+			uiLength = uiDataLength - uiDataLengthRead;
+		}
+
+		memcpy(pucData + uiDataLengthRead, pnasNumAsyncSlot->pucBuffer + pnasNumAsyncSource->uiConsumeIndex, uiLength);
+		uiDataLengthRead += uiLength;
+		pnasNumAsyncSource->uiConsumeIndex += uiLength;
+
+		/* Free the slot once we have used it up and keep the queue full */
+		if ( pnasNumAsyncSource->uiConsumeIndex == pnasNumAsyncSlot->uiLength ) {
+
+			pthread_mutex_lock(&pnasNumAsyncSource->tmMutex);
+			pnasNumAsyncSlot->uiState = NUM_ASYNC_SLOT_FREE;
+			pthread_mutex_unlock(&pnasNumAsyncSource->tmMutex);
+
+			pnasNumAsyncSource->uiConsumeSlot = (pnasNumAsyncSource->uiConsumeSlot + 1) % pnasNumAsyncSource->uiQueueDepth;
+			pnasNumAsyncSource->uiConsumeIndex = 0;
+
+			if ( (iError = iNumAsyncSourceSubmit(pnasNumAsyncSource)) != NUM_NoError ) {
+				return (iError);
+			}
+		}
+	}
+
+	*puiDataLengthRead = uiDataLengthRead;
+
+
+	return (NUM_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,1795 @@
+/*****************************************************************************
+*       Copyright (C) 2009-2014, FS Consulting Inc. All rights reserved		 *
+*																			 *
+*  This notice is intended as a precaution against inadvertent publication	 *
+*  and does not constitute an admission or acknowledgement that publication	 *
+*  has occurred or constitute a waiver of confidentiality.					 *
+*																			 *
+*  This software is the proprietary and confidential property				 *
+*  of FS Consulting, Inc.													 *
+*****************************************************************************/
+
+
+/*{
+
+	Module:	varint.h
+
+	Author:	Francois Schiettecatte (fschiettecatte@gmail.com)
+
+	Creation Date:	January 7th, 2009
+
+	Purpose:	Integer encoding schemes, compressed uints, varints and compact
+				varints, along with the block, stream, parallel and memory
+				functions built on top of them.
+
+				The codecs are inline functions so they can be inlined into
+				the caller, the tables they use live in varint.c.
+
+}*/
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if !defined(VARINT_H)
+#define VARINT_H
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** C includes
+*/
+
+#include <string.h>
+#include <time.h>
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ linkage, the functions are C functions
+*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif	/* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** Assertion macro for the inline functions below, the library and the test
+** program have their own NUM_ASSERT() in varintPrivate.h. Compiles out.
+*/
+#define NUM_ASSERT(f)	 {}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==========================================
+** === Number storage macros (compressed) ===
+** ==========================================
+*/
+
+
+/* Masks for compressed numbers storage */
+#define NUM_COMPRESSED_CONTINUE_BIT				(0x80)		/* 1000 0000 */
+#define NUM_COMPRESSED_DATA_MASK				(0x7F)		/* 0111 1111 */
+#define NUM_COMPRESSED_DATA_BITS				(7)
+
+
+/* Macro for the maximum number of bytes occupied by a compressed 32 bit integer  */
+#define NUM_COMPRESSED_UINT_MAX_SIZE			(5)
+
+
+/* Returns the number of bytes occupied by a compressed 32 bit integer */
+static inline unsigned int uiNumGetCompressedUIntSize
+(
+	unsigned int uiValue
+)
+{
+
+	if ( uiValue < (1UL << 7) ) {
+		return (1);
+	}
+	else if ( uiValue < (1UL << 14) ) {
+		return (2);
+	}
+	else if ( uiValue < (1UL << 21) ) {
+		return (3);
+	}
+	else if ( uiValue < (1UL << 28) ) {
+		return (4);
+	}
+
+	return (5);
+
+}
+
+
+/* Skips over a compressed integer in memory, returns the pointer past it */
+static inline unsigned char *pucNumSkipCompressedUInt
+(
+	unsigned char *pucPtr
+)
+{
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	for ( ; *pucPtr & NUM_COMPRESSED_CONTINUE_BIT; pucPtr++ );
+
+	return (pucPtr + 1);
+
+}
+
+
+/* Reads a compressed integer from memory into puiValue, returns the pointer past it */
+static inline unsigned char *pucNumReadCompressedUInt
+(
+	unsigned int *puiValue,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned int	uiValue = 0;
+
+
+	NUM_ASSERT(puiValue != NULL);
+	NUM_ASSERT(pucPtr != NULL);
+
+	for ( uiValue = 0; uiValue <<= NUM_COMPRESSED_DATA_BITS, uiValue += (*pucPtr & NUM_COMPRESSED_DATA_MASK), *pucPtr & NUM_COMPRESSED_CONTINUE_BIT; pucPtr++ );
+
+	*puiValue = uiValue;
+
+	return (pucPtr + 1);
+
+}
+
+
+/* Compresses an unsigned integer and writes it to memory, returns the pointer past it */
+static inline unsigned char *pucNumWriteCompressedUInt
+(
+	unsigned int uiValue,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned int	uiSize = uiNumGetCompressedUIntSize(uiValue);
+	unsigned int	uiBytesLeft = 0;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	/* The last byte is the only one without the continue bit */
+	pucPtr[uiSize - 1] = (unsigned char)(uiValue & NUM_COMPRESSED_DATA_MASK);
+	uiValue >>= NUM_COMPRESSED_DATA_BITS;
+
+	for ( uiBytesLeft = uiSize - 1; uiBytesLeft > 0; uiBytesLeft-- ) {
+		pucPtr[uiBytesLeft - 1] = (unsigned char)(uiValue & NUM_COMPRESSED_DATA_MASK) | NUM_COMPRESSED_CONTINUE_BIT;
+		uiValue >>= NUM_COMPRESSED_DATA_BITS;
+	}
+
+	NUM_ASSERT(uiValue == 0);
+
+	return (pucPtr + uiSize);
+
+}
+
+
+/* Macros wrapping the functions above, the arguments are only evaluated once */
+#define NUM_GET_COMPRESSED_UINT_SIZE(uiMacroValue, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetCompressedUIntSize(uiMacroValue);	\
+	}
+
+#define NUM_SKIP_COMPRESSED_UINT(pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumSkipCompressedUInt(pucMacroPtr);	\
+	}
+
+#define NUM_READ_COMPRESSED_UINT(uiMacroValue, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadCompressedUInt(&(uiMacroValue), pucMacroPtr);	\
+	}
+
+#define NUM_WRITE_COMPRESSED_UINT(uiMacroValue, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteCompressedUInt(uiMacroValue, pucMacroPtr);	\
+	}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ======================================
+** === Number storage macros (varint) ===
+** ======================================
+*/
+
+
+/* Header size for a varint quad or trio */
+#define NUM_VARINT_HEADER_SIZE					(1)
+
+/* Number of bits used to encode the number of bytes in the varint */
+#define NUM_VARINT_HEADER_SIZE_BITS				(2)
+
+/* Number of bytes in a varint from its size code in the header, the size
+** tables in varint.c are generated from this
+*/
+#define NUM_VARINT_CODE_SIZE(uiMacroCode)		((uiMacroCode) + 1)
+
+
+/* Structure to store the byte size of each varint, the offset of each varint
+** from the header and the length of the quad, so all four varints can be
+** loaded at once and the next header is known after one lookup
+*/
+struct varintSize {
+	unsigned char	ucSize1;
+	unsigned char	ucSize2;
+	unsigned char	ucSize3;
+	unsigned char	ucSize4;
+	unsigned char	ucOffset2;
+	unsigned char	ucOffset3;
+	unsigned char	ucOffset4;
+	unsigned char	ucLength;
+};
+
+
+/* Masks used to mask out a varint in memory, and the byte size of each
+** varint based on the header, both in varint.c
+*/
+extern const unsigned int		uiVarintMaskGlobal[];
+extern const struct varintSize	pvsVarintSizesGlobal[];
+
+
+/* Returns the size of a varint */
+static inline unsigned int uiNumGetVarintSize
+(
+	unsigned int uiValue
+)
+{
+
+	if ( uiValue <= 0xFF ) {
+		return (1);
+	}
+	else if ( uiValue <= 0xFFFF ) {
+		return (2);
+	}
+	else if ( uiValue <= 0xFFFFFF ) {
+		return (3);
+	}
+
+	return (4);
+
+}
+
+
+/* Writes a varint of a given size, returns the pointer past it */
+static inline unsigned char *pucNumWriteVarint
+(
+	unsigned int uiValue,
+	unsigned int uiSize,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucValuePtr = (unsigned char *)&uiValue;
+
+
+	NUM_ASSERT((uiSize >= 1) && (uiSize <= 4));
+	NUM_ASSERT(pucPtr != NULL);
+
+	switch ( uiSize ) {
+		case 4: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+		case 3: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+		case 2: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+		case 1: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+	}
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a varint of a given size into puiValue, returns the pointer past it.
+** Four bytes are always loaded, see NUM_READ_PADDING_SIZE
+*/
+static inline unsigned char *pucNumReadVarint
+(
+	unsigned int *puiValue,
+	unsigned int uiSize,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned int	uiValue = 0;
+
+
+	NUM_ASSERT((uiSize >= 1) && (uiSize <= 4));
+	NUM_ASSERT(puiValue != NULL);
+	NUM_ASSERT(pucPtr != NULL);
+
+	memcpy(&uiValue, pucPtr, sizeof(unsigned int));
+	*puiValue = uiValue & uiVarintMaskGlobal[uiSize];
+
+	return (pucPtr + uiSize);
+
+}
+
+
+/* Returns the size of a varint quad */
+static inline unsigned int uiNumGetVarintQuadSize
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned int uiValue4
+)
+{
+
+	return (NUM_VARINT_HEADER_SIZE + uiNumGetVarintSize(uiValue1) + uiNumGetVarintSize(uiValue2) +
+			uiNumGetVarintSize(uiValue3) + uiNumGetVarintSize(uiValue4));
+
+}
+
+
+/* Writes a varint quad, returns the pointer past it */
+static inline unsigned char *pucNumWriteVarintQuad
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned int uiValue4,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucStartPtr = pucPtr;
+	unsigned char	ucQuartetHeader = '\0';
+	unsigned int	uiSize = 0;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pucPtr += NUM_VARINT_HEADER_SIZE;
+
+	uiSize = uiNumGetVarintSize(uiValue1);
+	ucQuartetHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue1, uiSize, pucPtr);
+
+	uiSize = uiNumGetVarintSize(uiValue2);
+	ucQuartetHeader <<= NUM_VARINT_HEADER_SIZE_BITS;
+	ucQuartetHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue2, uiSize, pucPtr);
+
+	uiSize = uiNumGetVarintSize(uiValue3);
+	ucQuartetHeader <<= NUM_VARINT_HEADER_SIZE_BITS;
+	ucQuartetHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue3, uiSize, pucPtr);
+
+	uiSize = uiNumGetVarintSize(uiValue4);
+	ucQuartetHeader <<= NUM_VARINT_HEADER_SIZE_BITS;
+	ucQuartetHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue4, uiSize, pucPtr);
+
+	*pucStartPtr = ucQuartetHeader;
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a varint quad, returns the pointer past it */
+static inline unsigned char *pucNumReadVarintQuad
+(
+	unsigned int *puiValue1,
+	unsigned int *puiValue2,
+	unsigned int *puiValue3,
+	unsigned int *puiValue4,
+	unsigned char *pucPtr
+)
+{
+
+	const struct varintSize		*pvsVarintSizesGlobalPtr = NULL;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pvsVarintSizesGlobalPtr = pvsVarintSizesGlobal + pucPtr[0];
+
+	/* The offsets are independent of each other so the loads can issue together */
+	pucNumReadVarint(puiValue1, pvsVarintSizesGlobalPtr->ucSize1, pucPtr + NUM_VARINT_HEADER_SIZE);
+	pucNumReadVarint(puiValue2, pvsVarintSizesGlobalPtr->ucSize2, pucPtr + pvsVarintSizesGlobalPtr->ucOffset2);
+	pucNumReadVarint(puiValue3, pvsVarintSizesGlobalPtr->ucSize3, pucPtr + pvsVarintSizesGlobalPtr->ucOffset3);
+	pucNumReadVarint(puiValue4, pvsVarintSizesGlobalPtr->ucSize4, pucPtr + pvsVarintSizesGlobalPtr->ucOffset4);
+
+	return (pucPtr + pvsVarintSizesGlobalPtr->ucLength);
+
+}
+
+
+/* Macros wrapping the functions above, the arguments are only evaluated once */
+#define NUM_GET_VARINT_SIZE(uiMacroValue, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetVarintSize(uiMacroValue);	\
+	}
+
+#define NUM_WRITE_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteVarint(uiMacroValue, uiMacroSize, pucMacroPtr);	\
+	}
+
+#define NUM_READ_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadVarint(&(uiMacroValue), uiMacroSize, pucMacroPtr);	\
+	}
+
+#define NUM_GET_VARINT_QUAD_SIZE(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetVarintQuadSize(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4);	\
+	}
+
+#define NUM_WRITE_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteVarintQuad(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+	}
+
+#define NUM_READ_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadVarintQuad(&(uiMacroValue1), &(uiMacroValue2), &(uiMacroValue3), &(uiMacroValue4), pucMacroPtr);	\
+	}
+
+
+/* Varint pairs and trios are the first two or three varints of a quad, the
+** sizes of the missing varints are left as 0 in the header so they are read
+** with the quad sizes table, the pair ends at the third offset and the trio
+** at the fourth
+*/
+
+
+/* Returns the size of a varint pair */
+static inline unsigned int uiNumGetVarintPairSize
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2
+)
+{
+
+	return (NUM_VARINT_HEADER_SIZE + uiNumGetVarintSize(uiValue1) + uiNumGetVarintSize(uiValue2));
+
+}
+
+
+/* Writes a varint pair, returns the pointer past it */
+static inline unsigned char *pucNumWriteVarintPair
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucStartPtr = pucPtr;
+	unsigned char	ucPairHeader = '\0';
+	unsigned int	uiSize = 0;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pucPtr += NUM_VARINT_HEADER_SIZE;
+
+	uiSize = uiNumGetVarintSize(uiValue1);
+	ucPairHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue1, uiSize, pucPtr);
+
+	uiSize = uiNumGetVarintSize(uiValue2);
+	ucPairHeader <<= NUM_VARINT_HEADER_SIZE_BITS;
+	ucPairHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue2, uiSize, pucPtr);
+
+	*pucStartPtr = ucPairHeader << (2 * NUM_VARINT_HEADER_SIZE_BITS);
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a varint pair, returns the pointer past it */
+static inline unsigned char *pucNumReadVarintPair
+(
+	unsigned int *puiValue1,
+	unsigned int *puiValue2,
+	unsigned char *pucPtr
+)
+{
+
+	const struct varintSize		*pvsVarintSizesGlobalPtr = NULL;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pvsVarintSizesGlobalPtr = pvsVarintSizesGlobal + pucPtr[0];
+
+	pucNumReadVarint(puiValue1, pvsVarintSizesGlobalPtr->ucSize1, pucPtr + NUM_VARINT_HEADER_SIZE);
+	pucNumReadVarint(puiValue2, pvsVarintSizesGlobalPtr->ucSize2, pucPtr + pvsVarintSizesGlobalPtr->ucOffset2);
+
+	return (pucPtr + pvsVarintSizesGlobalPtr->ucOffset3);
+
+}
+
+
+/* Returns the size of a varint trio */
+static inline unsigned int uiNumGetVarintTrioSize
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3
+)
+{
+
+	return (NUM_VARINT_HEADER_SIZE + uiNumGetVarintSize(uiValue1) + uiNumGetVarintSize(uiValue2) + uiNumGetVarintSize(uiValue3));
+
+}
+
+
+/* Writes a varint trio, returns the pointer past it */
+static inline unsigned char *pucNumWriteVarintTrio
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucStartPtr = pucPtr;
+	unsigned char	ucTrioHeader = '\0';
+	unsigned int	uiSize = 0;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pucPtr += NUM_VARINT_HEADER_SIZE;
+
+	uiSize = uiNumGetVarintSize(uiValue1);
+	ucTrioHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue1, uiSize, pucPtr);
+
+	uiSize = uiNumGetVarintSize(uiValue2);
+	ucTrioHeader <<= NUM_VARINT_HEADER_SIZE_BITS;
+	ucTrioHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue2, uiSize, pucPtr);
+
+	uiSize = uiNumGetVarintSize(uiValue3);
+	ucTrioHeader <<= NUM_VARINT_HEADER_SIZE_BITS;
+	ucTrioHeader |= (uiSize - 1);
+	pucPtr = pucNumWriteVarint(uiValue3, uiSize, pucPtr);
+
+	*pucStartPtr = ucTrioHeader << NUM_VARINT_HEADER_SIZE_BITS;
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a varint trio, returns the pointer past it */
+static inline unsigned char *pucNumReadVarintTrio
+(
+	unsigned int *puiValue1,
+	unsigned int *puiValue2,
+	unsigned int *puiValue3,
+	unsigned char *pucPtr
+)
+{
+
+	const struct varintSize		*pvsVarintSizesGlobalPtr = NULL;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pvsVarintSizesGlobalPtr = pvsVarintSizesGlobal + pucPtr[0];
+
+	pucNumReadVarint(puiValue1, pvsVarintSizesGlobalPtr->ucSize1, pucPtr + NUM_VARINT_HEADER_SIZE);
+	pucNumReadVarint(puiValue2, pvsVarintSizesGlobalPtr->ucSize2, pucPtr + pvsVarintSizesGlobalPtr->ucOffset2);
+	pucNumReadVarint(puiValue3, pvsVarintSizesGlobalPtr->ucSize3, pucPtr + pvsVarintSizesGlobalPtr->ucOffset3);
+
+	return (pucPtr + pvsVarintSizesGlobalPtr->ucOffset4);
+
+}
+
+
+/* Macros wrapping the functions above, the arguments are only evaluated once */
+#define NUM_GET_VARINT_PAIR_SIZE(uiMacroValue1, uiMacroValue2, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetVarintPairSize(uiMacroValue1, uiMacroValue2);	\
+	}
+
+#define NUM_WRITE_VARINT_PAIR(uiMacroValue1, uiMacroValue2, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteVarintPair(uiMacroValue1, uiMacroValue2, pucMacroPtr);	\
+	}
+
+#define NUM_READ_VARINT_PAIR(uiMacroValue1, uiMacroValue2, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadVarintPair(&(uiMacroValue1), &(uiMacroValue2), pucMacroPtr);	\
+	}
+
+#define NUM_GET_VARINT_TRIO_SIZE(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetVarintTrioSize(uiMacroValue1, uiMacroValue2, uiMacroValue3);	\
+	}
+
+#define NUM_WRITE_VARINT_TRIO(uiMacroValue1, uiMacroValue2, uiMacroValue3, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteVarintTrio(uiMacroValue1, uiMacroValue2, uiMacroValue3, pucMacroPtr);	\
+	}
+
+#define NUM_READ_VARINT_TRIO(uiMacroValue1, uiMacroValue2, uiMacroValue3, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadVarintTrio(&(uiMacroValue1), &(uiMacroValue2), &(uiMacroValue3), pucMacroPtr);	\
+	}
+
+
+/* A varint octet is eight varints behind a 16 bit header, the first header
+** byte is the quad header of the first four varints and the second byte the
+** quad header of the last four, followed by the first four varints and then
+** the last four. Both halves are read with the quad sizes table, and neither
+** lookup waits on the other.
+*/
+
+
+/* Header size for a varint octet */
+#define NUM_VARINT_OCTET_HEADER_SIZE			(2)
+
+/* Maximum size of a varint octet */
+#define NUM_VARINT_OCTET_MAX_SIZE				(NUM_VARINT_OCTET_HEADER_SIZE + (8 * sizeof(unsigned int)))
+
+
+/* Returns the size of a varint octet */
+static inline unsigned int uiNumGetVarintOctetSize
+(
+	unsigned int *puiValues
+)
+{
+
+	NUM_ASSERT(puiValues != NULL);
+
+	return (NUM_VARINT_OCTET_HEADER_SIZE + uiNumGetVarintSize(puiValues[0]) + uiNumGetVarintSize(puiValues[1]) +
+			uiNumGetVarintSize(puiValues[2]) + uiNumGetVarintSize(puiValues[3]) + uiNumGetVarintSize(puiValues[4]) +
+			uiNumGetVarintSize(puiValues[5]) + uiNumGetVarintSize(puiValues[6]) + uiNumGetVarintSize(puiValues[7]));
+
+}
+
+
+/* Writes a varint octet, returns the pointer past it */
+static inline unsigned char *pucNumWriteVarintOctet
+(
+	unsigned int *puiValues,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucStartPtr = pucPtr;
+	unsigned int	uiSize = 0;
+	unsigned int	uiI = 0;
+
+
+	NUM_ASSERT(puiValues != NULL);
+	NUM_ASSERT(pucPtr != NULL);
+
+	pucStartPtr[0] = '\0';
+	pucStartPtr[1] = '\0';
+
+	pucPtr += NUM_VARINT_OCTET_HEADER_SIZE;
+
+	for ( uiI = 0; uiI < 8; uiI++ ) {
+		uiSize = uiNumGetVarintSize(puiValues[uiI]);
+		pucStartPtr[uiI / 4] |= (uiSize - 1) << (NUM_VARINT_HEADER_SIZE_BITS * (3 - (uiI % 4)));
+		pucPtr = pucNumWriteVarint(puiValues[uiI], uiSize, pucPtr);
+	}
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a varint octet, returns the pointer past it */
+static inline unsigned char *pucNumReadVarintOctet
+(
+	unsigned int *puiValues,
+	unsigned char *pucPtr
+)
+{
+
+	const struct varintSize		*pvsVarintSizesLowPtr = NULL;
+	const struct varintSize		*pvsVarintSizesHighPtr = NULL;
+	unsigned char				*pucLowPtr = NULL;
+	unsigned char				*pucHighPtr = NULL;
+
+
+	NUM_ASSERT(puiValues != NULL);
+	NUM_ASSERT(pucPtr != NULL);
+
+	pvsVarintSizesLowPtr = pvsVarintSizesGlobal + pucPtr[0];
+	pvsVarintSizesHighPtr = pvsVarintSizesGlobal + pucPtr[1];
+
+	/* The quad offsets count the quad header, so each half is read from the byte before its data */
+	pucLowPtr = pucPtr + NUM_VARINT_OCTET_HEADER_SIZE - NUM_VARINT_HEADER_SIZE;
+	pucHighPtr = pucLowPtr + pvsVarintSizesLowPtr->ucLength - NUM_VARINT_HEADER_SIZE;
+
+	pucNumReadVarint(puiValues + 0, pvsVarintSizesLowPtr->ucSize1, pucLowPtr + NUM_VARINT_HEADER_SIZE);
+	pucNumReadVarint(puiValues + 1, pvsVarintSizesLowPtr->ucSize2, pucLowPtr + pvsVarintSizesLowPtr->ucOffset2);
+	pucNumReadVarint(puiValues + 2, pvsVarintSizesLowPtr->ucSize3, pucLowPtr + pvsVarintSizesLowPtr->ucOffset3);
+	pucNumReadVarint(puiValues + 3, pvsVarintSizesLowPtr->ucSize4, pucLowPtr + pvsVarintSizesLowPtr->ucOffset4);
+	pucNumReadVarint(puiValues + 4, pvsVarintSizesHighPtr->ucSize1, pucHighPtr + NUM_VARINT_HEADER_SIZE);
+	pucNumReadVarint(puiValues + 5, pvsVarintSizesHighPtr->ucSize2, pucHighPtr + pvsVarintSizesHighPtr->ucOffset2);
+	pucNumReadVarint(puiValues + 6, pvsVarintSizesHighPtr->ucSize3, pucHighPtr + pvsVarintSizesHighPtr->ucOffset3);
+	pucNumReadVarint(puiValues + 7, pvsVarintSizesHighPtr->ucSize4, pucHighPtr + pvsVarintSizesHighPtr->ucOffset4);
+
+	return (pucPtr + pvsVarintSizesLowPtr->ucLength + pvsVarintSizesHighPtr->ucLength);
+
+}
+
+
+/* Macros wrapping the functions above, the arguments are only evaluated once */
+#define NUM_GET_VARINT_OCTET_SIZE(puiMacroValues, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetVarintOctetSize(puiMacroValues);	\
+	}
+
+#define NUM_WRITE_VARINT_OCTET(puiMacroValues, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteVarintOctet(puiMacroValues, pucMacroPtr);	\
+	}
+
+#define NUM_READ_VARINT_OCTET(puiMacroValues, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadVarintOctet(puiMacroValues, pucMacroPtr);	\
+	}
+
+
+/* Macro to get the maximum length of a run of uiMacroValuesLength integers
+** encoded as varint octets, the tail of fewer than eight integers is never
+** longer than an octet
+*/
+#define NUM_GET_VARINT_OCTETS_MAX_SIZE(uiMacroValuesLength, uiMacroSize) \
+	{	\
+		uiMacroSize = (((uiMacroValuesLength) + 7) / 8) * NUM_VARINT_OCTET_MAX_SIZE;	\
+	}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage macros (compact varint) ===
+** ==============================================
+*/
+
+
+/* Header size for a varint quad or trio */
+#define NUM_COMPACT_VARINT_HEADER_SIZE						(1)
+
+/* Number of bits used to encode the number of bytes in the varint */
+#define NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS			(2)
+
+/* Number of bytes in a compact varint from its size code in the header, the
+** size tables in varint.c are generated from this
+*/
+#define NUM_COMPACT_VARINT_CODE_SIZE(uiMacroCode)			(uiMacroCode)
+
+
+/* Structure to store the byte size of each compact varint, the offset of
+** each compact varint from the header and the length of the quad
+*/
+struct compactVarintSize {
+	unsigned char	ucSize1;
+	unsigned char	ucSize2;
+	unsigned char	ucSize3;
+	unsigned char	ucSize4;
+	unsigned char	ucOffset2;
+	unsigned char	ucOffset3;
+	unsigned char	ucOffset4;
+	unsigned char	ucLength;
+};
+
+
+/* Masks used to mask out a compact varint in memory, and the byte size of
+** each compact varint based on the header, both in varint.c
+*/
+extern const unsigned int				uiCompactVarintMaskGlobal[];
+extern const struct compactVarintSize	pvsCompactVarintSizesGlobal[];
+
+
+/* Returns the size of a compact varint, 0 takes no space */
+static inline unsigned int uiNumGetCompactVarintSize
+(
+	unsigned int uiValue
+)
+{
+
+	NUM_ASSERT(uiValue <= 0xFFFFFF);
+
+	if ( uiValue == 0 ) {
+		return (0);
+	}
+	else if ( uiValue <= 0xFF ) {
+		return (1);
+	}
+	else if ( uiValue <= 0xFFFF ) {
+		return (2);
+	}
+
+	return (3);
+
+}
+
+
+/* Writes a compact varint of a given size, returns the pointer past it */
+static inline unsigned char *pucNumWriteCompactVarint
+(
+	unsigned int uiValue,
+	unsigned int uiSize,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucValuePtr = (unsigned char *)&uiValue;
+
+
+	NUM_ASSERT(uiSize <= 3);
+	NUM_ASSERT(pucPtr != NULL);
+
+	switch ( uiSize ) {
+		case 3: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+		case 2: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+		case 1: *pucPtr = *pucValuePtr; pucPtr++; pucValuePtr++;
+		case 0:	;
+	}
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a compact varint of a given size into puiValue, returns the pointer
+** past it. Four bytes are always loaded, see NUM_READ_PADDING_SIZE
+*/
+static inline unsigned char *pucNumReadCompactVarint
+(
+	unsigned int *puiValue,
+	unsigned int uiSize,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned int	uiValue = 0;
+
+
+	NUM_ASSERT(uiSize <= 3);
+	NUM_ASSERT(puiValue != NULL);
+	NUM_ASSERT(pucPtr != NULL);
+
+	memcpy(&uiValue, pucPtr, sizeof(unsigned int));
+	*puiValue = uiValue & uiCompactVarintMaskGlobal[uiSize];
+
+	return (pucPtr + uiSize);
+
+}
+
+
+/* Returns the size of a compact varint quad */
+static inline unsigned int uiNumGetCompactVarintQuadSize
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned int uiValue4
+)
+{
+
+	return (NUM_COMPACT_VARINT_HEADER_SIZE + uiNumGetCompactVarintSize(uiValue1) + uiNumGetCompactVarintSize(uiValue2) +
+			uiNumGetCompactVarintSize(uiValue3) + uiNumGetCompactVarintSize(uiValue4));
+
+}
+
+
+/* Writes a compact varint quad, returns the pointer past it */
+static inline unsigned char *pucNumWriteCompactVarintQuad
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned int uiValue4,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	*pucStartPtr = pucPtr;
+	unsigned char	ucQuartetHeader = '\0';
+	unsigned int	uiSize = 0;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pucPtr += NUM_COMPACT_VARINT_HEADER_SIZE;
+
+	uiSize = uiNumGetCompactVarintSize(uiValue1);
+	ucQuartetHeader |= uiSize;
+	pucPtr = pucNumWriteCompactVarint(uiValue1, uiSize, pucPtr);
+
+	uiSize = uiNumGetCompactVarintSize(uiValue2);
+	ucQuartetHeader <<= NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS;
+	ucQuartetHeader |= uiSize;
+	pucPtr = pucNumWriteCompactVarint(uiValue2, uiSize, pucPtr);
+
+	uiSize = uiNumGetCompactVarintSize(uiValue3);
+	ucQuartetHeader <<= NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS;
+	ucQuartetHeader |= uiSize;
+	pucPtr = pucNumWriteCompactVarint(uiValue3, uiSize, pucPtr);
+
+	uiSize = uiNumGetCompactVarintSize(uiValue4);
+	ucQuartetHeader <<= NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS;
+	ucQuartetHeader |= uiSize;
+	pucPtr = pucNumWriteCompactVarint(uiValue4, uiSize, pucPtr);
+
+	*pucStartPtr = ucQuartetHeader;
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a compact varint quad, returns the pointer past it */
+static inline unsigned char *pucNumReadCompactVarintQuad
+(
+	unsigned int *puiValue1,
+	unsigned int *puiValue2,
+	unsigned int *puiValue3,
+	unsigned int *puiValue4,
+	unsigned char *pucPtr
+)
+{
+
+	const struct compactVarintSize	*pvsVarintSizesGlobalPtr = NULL;
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pvsVarintSizesGlobalPtr = pvsCompactVarintSizesGlobal + pucPtr[0];
+
+	/* The offsets are independent of each other so the loads can issue together */
+	pucNumReadCompactVarint(puiValue1, pvsVarintSizesGlobalPtr->ucSize1, pucPtr + NUM_COMPACT_VARINT_HEADER_SIZE);
+	pucNumReadCompactVarint(puiValue2, pvsVarintSizesGlobalPtr->ucSize2, pucPtr + pvsVarintSizesGlobalPtr->ucOffset2);
+	pucNumReadCompactVarint(puiValue3, pvsVarintSizesGlobalPtr->ucSize3, pucPtr + pvsVarintSizesGlobalPtr->ucOffset3);
+	pucNumReadCompactVarint(puiValue4, pvsVarintSizesGlobalPtr->ucSize4, pucPtr + pvsVarintSizesGlobalPtr->ucOffset4);
+
+	return (pucPtr + pvsVarintSizesGlobalPtr->ucLength);
+
+}
+
+
+/* Macros wrapping the functions above, the arguments are only evaluated once */
+#define NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetCompactVarintSize(uiMacroValue);	\
+	}
+
+#define NUM_WRITE_COMPACT_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteCompactVarint(uiMacroValue, uiMacroSize, pucMacroPtr);	\
+	}
+
+#define NUM_READ_COMPACT_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadCompactVarint(&(uiMacroValue), uiMacroSize, pucMacroPtr);	\
+	}
+
+#define NUM_GET_COMPACT_VARINT_QUAD_SIZE(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetCompactVarintQuadSize(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4);	\
+	}
+
+#define NUM_WRITE_COMPACT_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteCompactVarintQuad(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+	}
+
+#define NUM_READ_COMPACT_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadCompactVarintQuad(&(uiMacroValue1), &(uiMacroValue2), &(uiMacroValue3), &(uiMacroValue4), pucMacroPtr);	\
+	}
+
+
+/* Compact varint escape quads store integers too large for a compact
+** varint. A 3 byte 0xFFFFFF is an escape, the integer follows the quad
+** as 4 little endian bytes, in the order of the integers, so only quads
+** whose header has a 3 byte size need to be checked for escapes
+*/
+#define NUM_COMPACT_VARINT_ESCAPE_VALUE						(0xFFFFFF)
+#define NUM_COMPACT_VARINT_ESCAPE_SIZE						(4)
+
+/* Maximum size of a compact varint escape quad, the largest quad of all */
+#define NUM_COMPACT_VARINT_ESCAPE_QUAD_MAX_SIZE				(NUM_COMPACT_VARINT_HEADER_SIZE + (4 * (3 + NUM_COMPACT_VARINT_ESCAPE_SIZE)))
+
+/* Macro to check whether a compact varint quad header has a 3 byte size */
+#define NUM_COMPACT_VARINT_HEADER_HAS_SIZE_3(ucMacroHeader)	(((ucMacroHeader) & ((ucMacroHeader) >> 1) & 0x55) != 0)
+
+
+/* Returns the size of a compact varint escape quad */
+static inline unsigned int uiNumGetCompactVarintEscapeQuadSize
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned int uiValue4
+)
+{
+
+	unsigned int	uiSize = 0;
+
+
+	uiSize = uiNumGetCompactVarintQuadSize((uiValue1 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue1 : NUM_COMPACT_VARINT_ESCAPE_VALUE,
+			(uiValue2 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue2 : NUM_COMPACT_VARINT_ESCAPE_VALUE,
+			(uiValue3 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue3 : NUM_COMPACT_VARINT_ESCAPE_VALUE,
+			(uiValue4 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue4 : NUM_COMPACT_VARINT_ESCAPE_VALUE);
+
+	uiSize += ((uiValue1 >= NUM_COMPACT_VARINT_ESCAPE_VALUE) + (uiValue2 >= NUM_COMPACT_VARINT_ESCAPE_VALUE) +
+			(uiValue3 >= NUM_COMPACT_VARINT_ESCAPE_VALUE) + (uiValue4 >= NUM_COMPACT_VARINT_ESCAPE_VALUE)) * NUM_COMPACT_VARINT_ESCAPE_SIZE;
+
+	return (uiSize);
+
+}
+
+
+/* Writes a compact varint escape quad, returns the pointer past it */
+static inline unsigned char *pucNumWriteCompactVarintEscapeQuad
+(
+	unsigned int uiValue1,
+	unsigned int uiValue2,
+	unsigned int uiValue3,
+	unsigned int uiValue4,
+	unsigned char *pucPtr
+)
+{
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	pucPtr = pucNumWriteCompactVarintQuad((uiValue1 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue1 : NUM_COMPACT_VARINT_ESCAPE_VALUE,
+			(uiValue2 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue2 : NUM_COMPACT_VARINT_ESCAPE_VALUE,
+			(uiValue3 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue3 : NUM_COMPACT_VARINT_ESCAPE_VALUE,
+			(uiValue4 < NUM_COMPACT_VARINT_ESCAPE_VALUE) ? uiValue4 : NUM_COMPACT_VARINT_ESCAPE_VALUE, pucPtr);
+
+	/* Append the escaped integers */
+	if ( uiValue1 >= NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+		memcpy(pucPtr, &uiValue1, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+		pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+	}
+
+	if ( uiValue2 >= NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+		memcpy(pucPtr, &uiValue2, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+		pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+	}
+
+	if ( uiValue3 >= NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+		memcpy(pucPtr, &uiValue3, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+		pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+	}
+
+	if ( uiValue4 >= NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+		memcpy(pucPtr, &uiValue4, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+		pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+	}
+
+	return (pucPtr);
+
+}
+
+
+/* Reads a compact varint escape quad, returns the pointer past it */
+static inline unsigned char *pucNumReadCompactVarintEscapeQuad
+(
+	unsigned int *puiValue1,
+	unsigned int *puiValue2,
+	unsigned int *puiValue3,
+	unsigned int *puiValue4,
+	unsigned char *pucPtr
+)
+{
+
+	unsigned char	ucHeader = '\0';
+
+
+	NUM_ASSERT(pucPtr != NULL);
+
+	ucHeader = pucPtr[0];
+	pucPtr = pucNumReadCompactVarintQuad(puiValue1, puiValue2, puiValue3, puiValue4, pucPtr);
+
+	/* Read the escaped integers, only a 3 byte size can be an escape */
+	if ( NUM_COMPACT_VARINT_HEADER_HAS_SIZE_3(ucHeader) ) {
+
+		if ( *puiValue1 == NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+			memcpy(puiValue1, pucPtr, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+			pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+		}
+
+		if ( *puiValue2 == NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+			memcpy(puiValue2, pucPtr, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+			pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+		}
+
+		if ( *puiValue3 == NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+			memcpy(puiValue3, pucPtr, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+			pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+		}
+
+		if ( *puiValue4 == NUM_COMPACT_VARINT_ESCAPE_VALUE ) {
+			memcpy(puiValue4, pucPtr, NUM_COMPACT_VARINT_ESCAPE_SIZE);
+			pucPtr += NUM_COMPACT_VARINT_ESCAPE_SIZE;
+		}
+	}
+
+	return (pucPtr);
+
+}
+
+
+/* Macros wrapping the functions above, the arguments are only evaluated once */
+#define NUM_GET_COMPACT_VARINT_ESCAPE_QUAD_SIZE(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, uiMacroSize) \
+	{	\
+		uiMacroSize = uiNumGetCompactVarintEscapeQuadSize(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4);	\
+	}
+
+#define NUM_WRITE_COMPACT_VARINT_ESCAPE_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumWriteCompactVarintEscapeQuad(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+	}
+
+#define NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		pucMacroPtr = pucNumReadCompactVarintEscapeQuad(&(uiMacroValue1), &(uiMacroValue2), &(uiMacroValue3), &(uiMacroValue4), pucMacroPtr);	\
+	}
+
+
+/* Macro to write a compact varint quad, checking that the integers fit
+** in a compact varint. Nothing is written and iMacroError is set to
+** NUM_ValueOverflowError if they do not, NUM_WRITE_COMPACT_VARINT_QUAD
+** only asserts
+*/
+#define NUM_WRITE_COMPACT_VARINT_QUAD_CHECKED(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr, iMacroError) \
+	{	\
+		unsigned int	uiMacroCheckValue1 = (uiMacroValue1);	\
+		unsigned int	uiMacroCheckValue2 = (uiMacroValue2);	\
+		unsigned int	uiMacroCheckValue3 = (uiMacroValue3);	\
+		unsigned int	uiMacroCheckValue4 = (uiMacroValue4);	\
+\
+		if ( (uiMacroCheckValue1 | uiMacroCheckValue2 | uiMacroCheckValue3 | uiMacroCheckValue4) > NUM_COMPACT_VARINT_MAX_VALUE ) {	\
+			iMacroError = NUM_ValueOverflowError;	\
+		}	\
+		else {	\
+			pucMacroPtr = pucNumWriteCompactVarintQuad(uiMacroCheckValue1, uiMacroCheckValue2, uiMacroCheckValue3, uiMacroCheckValue4, pucMacroPtr);	\
+			iMacroError = NUM_NoError;	\
+		}	\
+	}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==================================
+** === Number storage error codes ===
+** ==================================
+*/
+
+
+/* Return codes */
+#define NUM_NoError									(0)
+#define NUM_MemError								(-1)
+#define NUM_InvalidParameter						(-2)
+#define NUM_ReturnParameterError					(-3)
+#define NUM_ValueOverflowError						(-4)
+#define NUM_CorruptDataError						(-5)
+#define NUM_SinkError								(-6)
+#define NUM_SourceError								(-7)
+#define NUM_EndOfStream								(-8)
+
+
+/* Encoding formats */
+#define NUM_FORMAT_COMPRESSED_UINT					(1)
+#define NUM_FORMAT_VARINT_QUAD						(2)
+#define NUM_FORMAT_COMPACT_VARINT_QUAD				(3)
+#define NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD		(4)
+
+/* Macro to check that a format is valid */
+#define NUM_FORMAT_VALID(uiMacroFormat)				(((uiMacroFormat) >= NUM_FORMAT_COMPRESSED_UINT) && ((uiMacroFormat) <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD))
+
+
+/* Largest value that can be stored in a compact varint, compact varint
+** escape quads store any unsigned int
+*/
+#define NUM_COMPACT_VARINT_MAX_VALUE				(0xFFFFFF)
+
+
+/* Padding needed after encoded data, varints are read as an unsigned int
+** regardless of their size so the last varint can read past the end of the data
+*/
+#define NUM_READ_PADDING_SIZE						(sizeof(unsigned int))
+
+
+/* Cache line size, used to align buffers */
+#define NUM_CACHE_LINE_SIZE							(64)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ========================================
+** === Number storage functions (arena) ===
+** ========================================
+*/
+
+
+/* Arena flags */
+#define NUM_ARENA_FLAG_NONE							(0)
+#define NUM_ARENA_FLAG_HUGE_PAGES					(1 << 0)	/* MAP_HUGETLB, falling back to transparent huge pages */
+#define NUM_ARENA_FLAG_PREFAULT						(1 << 1)	/* Fault the pages in when they are mapped */
+
+
+/* Default region length, the length mapped at a time */
+#define NUM_ARENA_REGION_LENGTH_DEFAULT				(8 * 1024 * 1024)
+
+
+/* Functions */
+int iNumArenaCreate(unsigned long long ullRegionLength, unsigned int uiFlags, void **ppvNumArena);
+int iNumArenaAllocate(void *pvNumArena, unsigned long long ullLength, void **ppvData);
+int iNumArenaRelease(void *pvNumArena, void *pvData);
+int iNumArenaGetCounts(void *pvNumArena, unsigned long long *pullMappedLength, unsigned long long *pullAllocations, unsigned long long *pullReuses);
+int iNumArenaFree(void *pvNumArena);
+int iNumArenaGetThread(void **ppvNumArena);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ============================================
+** === Number storage functions (histogram) ===
+** ============================================
+*/
+
+
+/* Histograms bucket values logarithmically, each power of two is split into
+** 2^NUM_HISTOGRAM_SUB_BUCKET_BITS linear sub buckets, so values are kept to
+** within about 3% over the whole 64 bit range
+*/
+#define NUM_HISTOGRAM_SUB_BUCKET_BITS				(5)
+#define NUM_HISTOGRAM_BUCKET_COUNT					((65 - NUM_HISTOGRAM_SUB_BUCKET_BITS) << NUM_HISTOGRAM_SUB_BUCKET_BITS)
+
+
+/* Returns a timestamp in ticks, the time stamp counter where there is one,
+** nanoseconds otherwise, see iNumGetTickNanoseconds()
+*/
+static inline unsigned long long ullNumGetTicks
+(
+	void
+)
+{
+
+#if defined(__x86_64__) || defined(__i386__)
+	return (__builtin_ia32_rdtsc());
+#else
+	struct timespec		tsTimeSpec;
+
+	clock_gettime(CLOCK_MONOTONIC, &tsTimeSpec);
+
+	return (((unsigned long long)tsTimeSpec.tv_sec * 1000000000ULL) + tsTimeSpec.tv_nsec);
+#endif	/* defined(__x86_64__) || defined(__i386__) */
+
+}
+
+
+/* Functions */
+int iNumHistogramCreate(void **ppvNumHistogram);
+int iNumHistogramRecord(void *pvNumHistogram, unsigned long long ullValue);
+int iNumHistogramMerge(void *pvNumHistogram, void *pvNumHistogramSource);
+int iNumHistogramReset(void *pvNumHistogram);
+int iNumHistogramGetCounts(void *pvNumHistogram, unsigned long long *pullCount, unsigned long long *pullMinValue, unsigned long long *pullMaxValue, double *pdMeanValue);
+int iNumHistogramGetPercentile(void *pvNumHistogram, double dPercentile, unsigned long long *pullValue);
+int iNumHistogramFree(void *pvNumHistogram);
+int iNumHistogramGetThread(void **ppvNumHistogram);
+int iNumHistogramMergeThreads(void *pvNumHistogram);
+int iNumHistogramResetThreads(void);
+int iNumGetTickNanoseconds(double *pdNanoseconds);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage functions (quad decode) ===
+** ==============================================
+*/
+
+
+/* Quads decoded per iteration by the bulk quad decoders */
+#define NUM_QUAD_DECODE_UNROLL_DEFAULT				(4)
+#define NUM_QUAD_DECODE_UNROLL_MAX					(4)
+
+
+/* Functions */
+int iNumDecodeQuads(unsigned int uiFormat, unsigned int uiUnroll, unsigned char *pucData, unsigned int uiQuadCount, unsigned int *puiValues, unsigned char **ppucDataEnd);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===============================================
+** === Number storage functions (varint octet) ===
+** ===============================================
+*/
+
+
+/* Functions */
+int iNumEncodeVarintOctets(unsigned int *puiValues, unsigned int uiValuesLength, unsigned char *pucData, unsigned char **ppucDataEnd);
+int iNumDecodeVarintOctets(unsigned char *pucData, unsigned int uiValuesLength, unsigned int *puiValues, unsigned char **ppucDataEnd);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ========================================
+** === Number storage functions (block) ===
+** ========================================
+*/
+
+
+/* Number of integers in a block */
+#define NUM_BLOCK_INTEGER_COUNT_DEFAULT				(128)
+#define NUM_BLOCK_INTEGER_COUNT_MAX					(65536)
+
+/* Maximum size of the block header, the integer count and the data length */
+#define NUM_BLOCK_HEADER_MAX_SIZE					(NUM_COMPRESSED_UINT_MAX_SIZE * 2)
+
+
+/* Block widths, stored in the low bits of the integer count in the block
+** header. Blocks where every integer fits in 1 or 2 bytes are stored as
+** fixed width integers regardless of the format, unless the format is
+** shorter, and are decoded without the size table.
+**
+** Compact varint blocks with runs of all zero quads are stored with the
+** runs suppressed if that is shorter, a zero quad header is followed by
+** the number of further zero quads in the run as a compressed uint
+*/
+#define NUM_BLOCK_WIDTH_VARIABLE					(0)
+#define NUM_BLOCK_WIDTH_1							(1)
+#define NUM_BLOCK_WIDTH_2							(2)
+#define NUM_BLOCK_WIDTH_ZERO_RUN					(3)
+#define NUM_BLOCK_WIDTH_BITS						(2)
+#define NUM_BLOCK_WIDTH_MASK						((1 << NUM_BLOCK_WIDTH_BITS) - 1)
+
+/* Macro to check whether a block width is a fixed width */
+#define NUM_BLOCK_WIDTH_FIXED(uiMacroWidth)			(((uiMacroWidth) == NUM_BLOCK_WIDTH_1) || ((uiMacroWidth) == NUM_BLOCK_WIDTH_2))
+
+
+/* Macro to get the number of integers needed to decode a block, quads
+** are always decoded whole so the count is rounded up to a multiple of 4
+*/
+#define NUM_GET_BLOCK_DECODE_COUNT(uiMacroIntegerCount, uiMacroDecodeCount) \
+	{	\
+		uiMacroDecodeCount = ((uiMacroIntegerCount) + 3) & ~3U;	\
+	}
+
+
+/* Macro to get the maximum size of an encoded block. A compact varint
+** escape quad is longer than any other quad and than four compressed uints
+** so one bound covers all the formats
+*/
+#define NUM_GET_BLOCK_MAX_SIZE(uiMacroIntegerCount, uiMacroSize) \
+	{	\
+		unsigned int	uiMacroDecodeCount = 0;	\
+\
+		NUM_GET_BLOCK_DECODE_COUNT(uiMacroIntegerCount, uiMacroDecodeCount);	\
+		uiMacroSize = NUM_BLOCK_HEADER_MAX_SIZE + ((uiMacroDecodeCount / 4) * NUM_COMPACT_VARINT_ESCAPE_QUAD_MAX_SIZE);	\
+	}
+
+
+/* Macro to write a quad in any of the quad formats */
+#define NUM_WRITE_QUAD(uiMacroFormat, uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		NUM_ASSERT(((uiMacroFormat) == NUM_FORMAT_VARINT_QUAD) || ((uiMacroFormat) == NUM_FORMAT_COMPACT_VARINT_QUAD) ||	\
+				((uiMacroFormat) == NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD));	\
+\
+		if ( (uiMacroFormat) == NUM_FORMAT_VARINT_QUAD ) {	\
+			NUM_WRITE_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+		}	\
+		else if ( (uiMacroFormat) == NUM_FORMAT_COMPACT_VARINT_QUAD ) {	\
+			NUM_WRITE_COMPACT_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+		}	\
+		else {	\
+			NUM_WRITE_COMPACT_VARINT_ESCAPE_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+		}	\
+	}
+
+
+/* Macro to read a quad in any of the quad formats */
+#define NUM_READ_QUAD(uiMacroFormat, uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
+	{	\
+		NUM_ASSERT(((uiMacroFormat) == NUM_FORMAT_VARINT_QUAD) || ((uiMacroFormat) == NUM_FORMAT_COMPACT_VARINT_QUAD) ||	\
+				((uiMacroFormat) == NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD));	\
+\
+		if ( (uiMacroFormat) == NUM_FORMAT_VARINT_QUAD ) {	\
+			NUM_READ_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+		}	\
+		else if ( (uiMacroFormat) == NUM_FORMAT_COMPACT_VARINT_QUAD ) {	\
+			NUM_READ_COMPACT_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+		}	\
+		else {	\
+			NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr);	\
+		}	\
+	}
+
+
+/* Functions */
+int iNumBlockReadHeader(unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiIntegerCount, unsigned int *puiWidth, unsigned int *puiBlockDataLength, unsigned int *puiHeaderLength);
+int iNumBlockGetLength(unsigned int uiFormat, unsigned int *puiValues, unsigned int uiValuesLength, unsigned int *puiDataLength);
+int iNumBlockEncode(unsigned int uiFormat, unsigned int *puiValues, unsigned int uiValuesLength, unsigned char *pucData, unsigned int *puiDataLength);
+int iNumBlockDecode(unsigned int uiFormat, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiValues, unsigned int uiValuesCapacity, unsigned int *puiValuesLength, unsigned int *puiBlockLength);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ============================================
+** === Number storage functions (aggregate) ===
+** ============================================
+*/
+
+
+/* Aggregate structure, the sum, smallest and largest of the integers and
+** the number of them in an inclusive range, set up with iNumAggregateInit()
+** and accumulated over any number of calls
+*/
+struct numAggregate {
+	unsigned long long	ullCount;
+	unsigned long long	ullSum;
+	unsigned int		uiMinValue;
+	unsigned int		uiMaxValue;
+	unsigned int		uiRangeMinValue;
+	unsigned int		uiRangeMaxValue;
+	unsigned long long	ullRangeCount;
+};
+
+
+/* Functions */
+int iNumAggregateInit(struct numAggregate *pnaNumAggregate, unsigned int uiRangeMinValue, unsigned int uiRangeMaxValue);
+int iNumAggregateQuads(unsigned int uiFormat, unsigned char *pucData, unsigned int uiIntegerCount, struct numAggregate *pnaNumAggregate, unsigned char **ppucDataEnd);
+int iNumBlockAggregate(unsigned int uiFormat, unsigned char *pucData, unsigned int uiDataLength, struct numAggregate *pnaNumAggregate, unsigned int *puiBlockLength);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =========================================
+** === Number storage functions (filter) ===
+** =========================================
+*/
+
+
+/* Macro to get the length of the bitmap for a number of integers */
+#define NUM_GET_FILTER_BITMAP_LENGTH(uiMacroIntegerCount)	(((uiMacroIntegerCount) + 7) / 8)
+
+
+/* Functions */
+int iNumFilterQuads(unsigned int uiFormat, unsigned char *pucData, unsigned int uiIntegerCount, unsigned int uiRangeMinValue,
+		unsigned int uiRangeMaxValue, unsigned char *pucBitmap, unsigned int *puiPositions, unsigned int *puiMatchCount,
+		unsigned char **ppucDataEnd);
+int iNumBlockFilter(unsigned int uiFormat, unsigned char *pucData, unsigned int uiDataLength, unsigned int uiRangeMinValue,
+		unsigned int uiRangeMaxValue, unsigned char *pucBitmap, unsigned int *puiPositions, unsigned int *puiMatchCount,
+		unsigned int *puiBlockLength);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage functions (ring buffer) ===
+** ==============================================
+*/
+
+
+/* Functions */
+int iNumRingBufferCreate(unsigned int uiCapacity, void **ppvNumRingBuffer);
+int iNumRingBufferFree(void *pvNumRingBuffer);
+int iNumRingBufferWrite(void *pvNumRingBuffer, unsigned char *pucData, unsigned int uiDataLength);
+int iNumRingBufferRead(void *pvNumRingBuffer, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiDataLengthRead);
+int iNumRingBufferClose(void *pvNumRingBuffer);
+int iNumRingBufferIsDrained(void *pvNumRingBuffer, unsigned short *pbDrained);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =================================================
+** === Number storage functions (stream encoder) ===
+** =================================================
+*/
+
+
+/* Sink callback, called with encoded blocks, must consume all the data
+** or return an error in which case the data will be offered again on the
+** next flush
+*/
+typedef int (*iNumStreamSinkCallback)(void *pvSinkContext, unsigned char *pucData, unsigned int uiDataLength);
+
+
+/* Default size of the buffer where blocks accumulate before being flushed to the sink */
+#define NUM_STREAM_BUFFER_LENGTH_DEFAULT			(65536)
+
+
+/* Functions */
+int iNumStreamSinkFileDescriptor(void *pvSinkContext, unsigned char *pucData, unsigned int uiDataLength);
+int iNumStreamSinkRingBuffer(void *pvSinkContext, unsigned char *pucData, unsigned int uiDataLength);
+int iNumStreamEncoderCreate(unsigned int uiFormat, unsigned int uiBlockIntegerCount, unsigned int uiBufferLength, iNumStreamSinkCallback iNumStreamSink, void *pvSinkContext, void **ppvNumStreamEncoder);
+int iNumStreamEncoderAddIntegers(void *pvNumStreamEncoder, unsigned int *puiValues, unsigned int uiValuesLength);
+int iNumStreamEncoderAddInteger(void *pvNumStreamEncoder, unsigned int uiValue);
+int iNumStreamEncoderFlush(void *pvNumStreamEncoder);
+int iNumStreamEncoderGetCounts(void *pvNumStreamEncoder, unsigned long long *pullIntegerCount, unsigned long long *pullByteCount);
+int iNumStreamEncoderClose(void *pvNumStreamEncoder);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =================================================
+** === Number storage functions (stream decoder) ===
+** =================================================
+*/
+
+
+/* Source callback, reads up to a length of data, returning a length of 0
+** at the end of the data
+*/
+typedef int (*iNumStreamSourceCallback)(void *pvSourceContext, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiDataLengthRead);
+
+
+/* Default mapped source window length */
+#define NUM_MAPPED_SOURCE_WINDOW_LENGTH_DEFAULT		(4 * 1024 * 1024)
+
+
+/* Functions */
+int iNumStreamSourceFileDescriptor(void *pvSourceContext, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiDataLengthRead);
+int iNumStreamSourceRingBuffer(void *pvSourceContext, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiDataLengthRead);
+int iNumMappedSourceCreate(int iFileDescriptor, unsigned int uiWindowLength, void **ppvNumMappedSource);
+int iNumMappedSourceFree(void *pvNumMappedSource);
+int iNumStreamSourceMapped(void *pvSourceContext, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiDataLengthRead);
+int iNumStreamDecoderCreate(unsigned int uiFormat, unsigned int uiBlockIntegerCount, unsigned int uiBufferLength, iNumStreamSourceCallback iNumStreamSource, void *pvSourceContext, void **ppvNumStreamDecoder);
+int iNumStreamDecoderNextBatch(void *pvNumStreamDecoder, unsigned int *puiValues, unsigned int uiValuesCapacity, unsigned int *puiValuesLength);
+int iNumStreamDecoderNext(void *pvNumStreamDecoder, unsigned int *puiValue);
+int iNumStreamDecoderFree(void *pvNumStreamDecoder);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ========================================
+** === Number storage functions (merge) ===
+** ========================================
+*/
+
+
+/* Default number of integers buffered for each input and for the output */
+#define NUM_MERGE_BATCH_LENGTH_DEFAULT				(256)
+
+
+/* Functions */
+int iNumMergeStreams(void **ppvNumStreamDecoders, unsigned int uiStreamCount, unsigned int uiBatchLength, unsigned short bUnique, void *pvNumStreamEncoder, unsigned long long *pullIntegerCount);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ============================================
+** === Number storage functions (transcode) ===
+** ============================================
+*/
+
+
+/* Functions */
+int iNumBlockTranscode(unsigned int uiSourceFormat, unsigned char *pucData, unsigned int uiDataLength, unsigned int uiTargetFormat, unsigned char *pucTargetData, unsigned int *puiTargetDataLength, unsigned int *puiBlockLength);
+int iNumStreamTranscode(unsigned int uiSourceFormat, unsigned int uiSourceBlockIntegerCount, iNumStreamSourceCallback iNumStreamSource, void *pvSourceContext, unsigned int uiTargetFormat, unsigned int uiTargetBlockIntegerCount, iNumStreamSinkCallback iNumStreamSink, void *pvSinkContext, unsigned long long *pullIntegerCount);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** =======================================
+** === Number storage functions (list) ===
+** =======================================
+*/
+
+
+/* Default number of bytes reserved after each block so updates which make
+** the block longer can be rewritten in place
+*/
+#define NUM_LIST_BLOCK_SLACK_DEFAULT				(16)
+
+
+/* Functions */
+int iNumListCreate(unsigned int uiFormat, unsigned int uiBlockIntegerCount, unsigned int uiBlockSlack, void **ppvNumList);
+int iNumListAppend(void *pvNumList, unsigned int *puiValues, unsigned int uiValuesLength);
+int iNumListGet(void *pvNumList, unsigned long long ullIndex, unsigned int *puiValue);
+int iNumListUpdate(void *pvNumList, unsigned long long ullIndex, unsigned int uiValue);
+int iNumListGetCounts(void *pvNumList, unsigned long long *pullIntegerCount, unsigned long long *pullDataLength, unsigned long long *pullBlockRewriteCount);
+int iNumListWrite(void *pvNumList, iNumStreamSinkCallback iNumStreamSink, void *pvSinkContext);
+int iNumListFree(void *pvNumList);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ======================================
+** === Number storage functions (set) ===
+** ======================================
+*/
+
+
+/* Number of bits in the chunk of a set integer, the integers of a chunk
+** share their high bits and are stored in one container
+*/
+#define NUM_SET_CHUNK_BITS							(16)
+#define NUM_SET_CHUNK_LENGTH						(1 << NUM_SET_CHUNK_BITS)
+
+
+/* Length of a bitmap container, a chunk is stored as a bitmap when its
+** encoded list would be at least this long
+*/
+#define NUM_SET_BITMAP_LENGTH						(NUM_SET_CHUNK_LENGTH / 8)
+
+
+/* Functions */
+int iNumSetCreate(unsigned int uiFormat, unsigned int *puiValues, unsigned int uiValuesLength, void **ppvNumSet);
+int iNumSetIntersect(void *pvNumSet1, void *pvNumSet2, void **ppvNumSet);
+int iNumSetUnion(void *pvNumSet1, void *pvNumSet2, void **ppvNumSet);
+int iNumSetDecode(void *pvNumSet, unsigned int *puiValues, unsigned int uiValuesCapacity, unsigned int *puiValuesLength);
+int iNumSetGetCounts(void *pvNumSet, unsigned long long *pullIntegerCount, unsigned long long *pullDataLength, unsigned int *puiListCount, unsigned int *puiBitmapCount);
+int iNumSetFree(void *pvNumSet);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===========================================
+** === Number storage functions (postings) ===
+** ===========================================
+*/
+
+
+/* Default number of postings per block, the doc IDs, frequencies and
+** positions of the postings of a block are each encoded in their own
+** stream, and the blocks of the streams line up with the skip index
+*/
+#define NUM_POSTING_BLOCK_POSTING_COUNT_DEFAULT		(NUM_BLOCK_INTEGER_COUNT_DEFAULT)
+
+
+/* Stream formats, doc ID gaps less one, frequencies less one, where zero
+** runs suit frequencies of one, and position gaps less one within a doc
+*/
+#define NUM_POSTING_DOC_FORMAT						(NUM_FORMAT_VARINT_QUAD)
+#define NUM_POSTING_TF_FORMAT						(NUM_FORMAT_COMPACT_VARINT_QUAD)
+#define NUM_POSTING_POSITION_FORMAT					(NUM_FORMAT_VARINT_QUAD)
+
+
+/* Maximum frequency */
+#define NUM_POSTING_TF_MAX							(NUM_COMPACT_VARINT_MAX_VALUE + 1)
+
+
+/* Functions */
+int iNumPostingsCreate(unsigned int uiBlockPostingCount, void **ppvNumPostings);
+int iNumPostingsAdd(void *pvNumPostings, unsigned int uiDocID, unsigned int *puiPositions, unsigned int uiPositionsLength);
+int iNumPostingsFlush(void *pvNumPostings);
+int iNumPostingsGetCounts(void *pvNumPostings, unsigned long long *pullPostingCount, unsigned long long *pullDocDataLength, unsigned long long *pullTfDataLength, unsigned long long *pullPositionDataLength);
+int iNumPostingsFree(void *pvNumPostings);
+int iNumPostingCursorCreate(void *pvNumPostings, void **ppvNumPostingCursor);
+int iNumPostingCursorNext(void *pvNumPostingCursor, unsigned int *puiDocID);
+int iNumPostingCursorAdvance(void *pvNumPostingCursor, unsigned int uiTargetDocID, unsigned int *puiDocID);
+int iNumPostingCursorGetTf(void *pvNumPostingCursor, unsigned int *puiTf);
+int iNumPostingCursorGetPositions(void *pvNumPostingCursor, unsigned int *puiPositions, unsigned int uiPositionsCapacity, unsigned int *puiPositionsLength);
+int iNumPostingCursorGetCounts(void *pvNumPostingCursor, unsigned long long *pullDocBlockCount, unsigned long long *pullTfBlockCount, unsigned long long *pullPositionBlockCount);
+int iNumPostingCursorFree(void *pvNumPostingCursor);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ==============================================
+** === Number storage functions (thread pool) ===
+** ==============================================
+*/
+
+
+/* Task callback, called once for each task index */
+typedef int (*iNumThreadPoolTaskCallback)(void *pvTaskContext, unsigned int uiTask);
+
+
+/* Functions */
+int iNumThreadPoolCreate(unsigned int uiThreadCount, void **ppvNumThreadPool);
+int iNumThreadPoolRun(void *pvNumThreadPool, unsigned int uiTaskCount, iNumThreadPoolTaskCallback iNumThreadPoolTask, void *pvTaskContext);
+int iNumThreadPoolFree(void *pvNumThreadPool);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===========================================
+** === Number storage functions (parallel) ===
+** ===========================================
+*/
+
+
+/* Number of blocks in a chunk, chunks are the unit of parallel work */
+#define NUM_PARALLEL_CHUNK_BLOCK_COUNT_DEFAULT		(256)
+
+
+/* Functions */
+int iNumParallelEncode(void *pvNumThreadPool, void *pvNumArena, unsigned int uiFormat, unsigned int uiBlockIntegerCount, unsigned int uiChunkIntegerCount, unsigned int *puiValues, unsigned long long ullValuesLength, unsigned char **ppucData, unsigned long long *pullDataLength, unsigned long long **ppullChunkOffsets, unsigned int *puiChunkCount);
+int iNumParallelDecode(void *pvNumThreadPool, unsigned int uiFormat, unsigned int uiChunkIntegerCount, unsigned char *pucData, unsigned long long *pullChunkOffsets, unsigned int uiChunkCount, unsigned int *puiValues, unsigned long long ullValuesLength);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** ===============================================
+** === Number storage functions (async source) ===
+** ===============================================
+*/
+
+
+/* Default queue depth and read length */
+#define NUM_ASYNC_SOURCE_QUEUE_DEPTH_DEFAULT		(8)
+#define NUM_ASYNC_SOURCE_QUEUE_DEPTH_MAX			(256)
+#define NUM_ASYNC_SOURCE_READ_LENGTH_DEFAULT		(256 * 1024)
+
+
+/* Functions */
+int iNumAsyncSourceCreate(int iFileDescriptor, unsigned int uiQueueDepth, unsigned int uiReadLength, unsigned short bIoUring, void **ppvNumAsyncSource);
+int iNumAsyncSourceIsIoUring(void *pvNumAsyncSource, unsigned short *pbIoUring);
+int iNumAsyncSourceFree(void *pvNumAsyncSource);
+int iNumStreamSourceAsync(void *pvSourceContext, unsigned char *pucData, unsigned int uiDataLength, unsigned int *puiDataLengthRead);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(__cplusplus)
+}
+#endif	/* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#endif	/* !defined(VARINT_H) */
@@ -0,0 +1,127 @@
+/*****************************************************************************
+*       Copyright (C) 2009-2014, FS Consulting Inc. All rights reserved		 *
+*																			 *
+*  This notice is intended as a precaution against inadvertent publication	 *
+*  and does not constitute an admission or acknowledgement that publication	 *
+*  has occurred or constitute a waiver of confidentiality.					 *
+*																			 *
+*  This software is the proprietary and confidential property				 *
+*  of FS Consulting, Inc.													 *
+*****************************************************************************/
+
+
+/*{
+
+	Module:	varintPrivate.h
+
+	Author:	Francois Schiettecatte (fschiettecatte@gmail.com)
+
+	Creation Date:	January 7th, 2009
+
+	Purpose:	Types, constants and macros shared by varint.c and the test
+				program, kept out of varint.h so they are not exported to
+				the programs using the library.
+
+}*/
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if !defined(VARINT_PRIVATE_H)
+#define VARINT_PRIVATE_H
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** Define the kind of C compiler we are using
+**
+*/
+
+/*
+** Check for the STDC define although the ANSI
+** standard wants us to look for __STDC__
+*/
+#if defined(STDC)
+#if !defined(__STDC__)
+#define __STDC__
+#endif	/* !defined(__STDC__) */
+#endif	/* defined(STDC) */
+
+/* Check for the __GNUC__ define */
+#if defined(__GNUC__)
+#if !defined(__STDC__)
+#define __STDC__
+#endif	/* !defined(__STDC__) */
+#endif	/* defined(__GNUC__) */
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** Check for various compiler defined symbols
+*/
+
+#if !defined(__FILE__)
+#define __FILE__		"Undefined __FILE__"
+#endif	/* defined(__FILE__) */
+
+#if !defined(__LINE__)
+#define __LINE__		(-1)
+#endif	/* defined(__LINE__) */
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** Additional types
+*/
+
+#if !defined(boolean)
+typedef unsigned short		boolean;
+#endif	/* !defined(boolean) */ 
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+** Additional contants
+*/
+
+#if !defined(NULL)
+#define NULL				(0)
+#endif	/* !defined(NULL) */
+
+
+#if !defined(true)
+#define true 				(1)
+#endif	/* !defined(true) */
+
+#if !defined(false)
+#define false 				(0)
+#endif	/* !defined(false) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* #define DEBUG	(1) */
+
+/*
+** Assertion macro, use this to wrap around a condition that must 
+** always be true to test that it is true. Compiles out when DEBUG
+** is not defined.
+*/
+#if defined(DEBUG)
+/* #define ASSERT(f)	 { if (!(f)) { printf("Assertion failed, file: '%s', line: %d\n", __FILE__, __LINE__); fflush(NULL); abort(); } } */
+#define ASSERT(f)	 {}
+#else
+#define ASSERT(f)	 {}
+#endif	/* defined(DEBUG) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#endif	/* !defined(VARINT_PRIVATE_H) */
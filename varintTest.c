@@ -18,13 +18,16 @@
 
 	Creation Date:	January 7th, 2009
 
-	Purpose:	Test integer encoding schemes
+	Purpose:	Test integer encoding schemes, the schemes themselves are
+				in varint.h and varint.c
 	
 	Compile and run as follows:
 	
-		gcc -g -o varintTest varintTest.c && ./varintTest
+		make && ./varintTest
 
-		gcc -O3 -o varintTest varintTest.c && ./varintTest
+		gcc -g -o varintTest varintTest.c varint.c -lpthread -lm && ./varintTest
+
+		gcc -O3 -o varintTest varintTest.c varint.c -lpthread -lm && ./varintTest
 
 }*/
 
@@ -64,7 +67,15 @@
 #include <sys/wait.h>
 #include <sys/mman.h>
 #include <sys/file.h>
+#include <sys/uio.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/io_uring.h>
+#include <linux/perf_event.h>
+#endif	/* defined(__linux__) */
 #include <semaphore.h>
+#include <sched.h>
 #include <pthread.h>
 #include <ctype.h>
 #include <dirent.h>
@@ -95,680 +106,212 @@
 /*---------------------------------------------------------------------------*/
 
 /*
-** Define the kind of C compiler we are using
-**
-*/
-
-/*
-** Check for the STDC define although the ANSI
-** standard wants us to look for __STDC__
+** Library includes
 */
-#if defined(STDC)
-#if !defined(__STDC__)
-#define __STDC__
-#endif	/* !defined(__STDC__) */
-#endif	/* defined(STDC) */
 
-/* Check for the __GNUC__ define */
-#if defined(__GNUC__)
-#if !defined(__STDC__)
-#define __STDC__
-#endif	/* !defined(__STDC__) */
-#endif	/* defined(__GNUC__) */
+#include "varint.h"
+#include "varintPrivate.h"
 
 
 /*---------------------------------------------------------------------------*/
 
-/*
-** Check for various compiler defined symbols
-*/
 
-#if !defined(__FILE__)
-#define __FILE__		"Undefined __FILE__"
-#endif	/* defined(__FILE__) */
+/* Macro to get the diff between two timeval structures */
+#define UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal) \
+{ \
+	tvDiffTimeVal.tv_sec = tvEndTimeVal.tv_sec - tvStartTimeVal.tv_sec; \
+	tvDiffTimeVal.tv_usec = tvEndTimeVal.tv_usec - tvStartTimeVal.tv_usec; \
+	if ( tvDiffTimeVal.tv_usec < 0 ) { \
+		tvDiffTimeVal.tv_sec--; \
+		tvDiffTimeVal.tv_usec += 1000000; \
+	} \
+}
 
-#if !defined(__LINE__)
-#define __LINE__		(-1)
-#endif	/* defined(__LINE__) */
 
+/* Macro to convert a timeval structure to microseconds */
+#define UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvTimeVal, dDouble) \
+{ \
+	dDouble = ((double)tvTimeVal.tv_sec * 1000000) + (double)tvTimeVal.tv_usec; \
+}
 
-/*---------------------------------------------------------------------------*/
 
-/*
-** Additional types
+/* Macro to hide a value from the optimizer, it has to assume the value was
+** changed so reads through a pointer are not hoisted out of the timed loops
 */
+#if defined(__GNUC__)
+#define UTL_BENCHMARK_LAUNDER(tValue) \
+{ \
+	__asm__ __volatile__ ("" : "+r" (tValue)); \
+}
+#else
+#define UTL_BENCHMARK_LAUNDER(tValue) \
+{ \
+	volatile void *pvValue = (void *)&(tValue); \
+	(void)pvValue; \
+}
+#endif	/* defined(__GNUC__) */
 
-#if !defined(boolean)
-typedef unsigned short		boolean;
-#endif	/* !defined(boolean) */ 
-
-
-/*---------------------------------------------------------------------------*/
 
-/*
-** Additional contants
+/* Macro to check the checksum of the timed reads against the checksum of a
+** warm up repetition, there is nothing to check against without a warm up
 */
-
-#if !defined(NULL)
-#define NULL				(0)
-#endif	/* !defined(NULL) */
-
-
-#if !defined(true)
-#define true 				(1)
-#endif	/* !defined(true) */
-
-#if !defined(false)
-#define false 				(0)
-#endif	/* !defined(false) */
+#define UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum) \
+{ \
+	if ( (WARM_UP_REPETITIONS > 0) && ((ullChecksum) != ((ullExpectedChecksum) * REPETITIONS)) ) { \
+		printf("Failed, checksum: %llu, expected: %llu.\n", (ullChecksum), (ullExpectedChecksum) * REPETITIONS); \
+		exit (-1); \
+	} \
+}
 
 
 /*---------------------------------------------------------------------------*/
 
 
-/* #define DEBUG	(1) */
-
-/*
-** Assertion macro, use this to wrap around a condition that must 
-** always be true to test that it is true. Compiles out when DEBUG
-** is not defined.
-*/
-#if defined(DEBUG)
-/* #define ASSERT(f)	 { if (!(f)) { printf("Assertion failed, file: '%s', line: %d\n", __FILE__, __LINE__); fflush(NULL); abort(); } } */
-#define ASSERT(f)	 {}
-#else
-#define ASSERT(f)	 {}
-#endif	/* defined(DEBUG) */
-
+/* Performance test */
+#define COMPRESSED_UINT_IN_PLACE					(1)
+#define VARINT_IN_PLACE								(1)
+#define COMPACT_VARINT_IN_PLACE						(1)
 
-/*---------------------------------------------------------------------------*/
+#define COMPRESSED_UINT_ACROSS_MEMORY				(1)
+#define VARINT_ACROSS_MEMORY						(1)
+#define COMPACT_VARINT_ACROSS_MEMORY				(1)
 
+/* #define PARALLEL_ACROSS_MEMORY					(1) */
 
-/*
-** ========================================== 
-** === Number storage macros (compressed) ===
-** ==========================================
+/* Reads varint and compact varint across memory with the bulk quad decoders,
+** once for each unroll factor
 */
+/* #define UNROLL_ACROSS_MEMORY						(1) */
 
-
-/* Masks for compressed numbers storage */
-#define NUM_COMPRESSED_CONTINUE_BIT				(0x80)		/* 1000 0000 */
-#define NUM_COMPRESSED_DATA_MASK				(0x7F)		/* 0111 1111 */
-#define NUM_COMPRESSED_DATA_BITS				(7)
-
-
-
-/* Macro to get the number of bytes occupied by a compressed 32 bit integer.
-** The integer to evaluate should be set in uiMacroValue and the number of 
-** bytes is placed in uiMacroSize
+/* Reads varint integers across memory as quads with the bulk quad decoder
+** and as octets, with the AVX2 octet decoder if the processor has it
 */
-#define NUM_GET_COMPRESSED_UINT_SIZE(uiMacroValue, uiMacroSize) \
-	{	\
-		if ( uiMacroValue < (1UL << 7) )	\
-			uiMacroSize = 1;	\
-		else if ( uiMacroValue < (1UL << 14) )	\
-			uiMacroSize = 2;	\
-		else if ( uiMacroValue < (1UL << 21) )	\
-			uiMacroSize = 3;	\
-		else if ( uiMacroValue < (1UL << 28) )	\
-			uiMacroSize = 4;	\
-		else	\
-			uiMacroSize = 5;	\
-	}
-
-
-/* Macro for the maximum number of bytes occupied by a compressed 32 bit integer  */
-#define NUM_COMPRESSED_UINT_MAX_SIZE			(5)
+/* #define OCTET_ACROSS_MEMORY						(1) */
 
-
-/* Macro for skipping over a compressed integer in memory  */
-#define NUM_SKIP_COMPRESSED_UINT(pucMacroPtr) \
-	{	\
-		ASSERT(pucMacroPtr != NULL);	\
-		for ( ; *pucMacroPtr & NUM_COMPRESSED_CONTINUE_BIT; pucMacroPtr++ );	\
-		pucMacroPtr++;	\
-	}
-
-
-/* Macro for reading a compressed integer from memory. The integer is 
-** read starting at pucMacroPtr and is stored in uiMacroValue
+/* Looks up integers at random positions in buffers sized from the L1 cache
+** to ten times the last level cache, skipping forward from an index entry
+** every RANDOM_ACCESS_STRIDE integers. Compact varint buffers stop growing
+** once the integers reach the compact varint maximum value
 */
-/* Newer and faster */
-#define NUM_READ_COMPRESSED_UINT(uiMacroValue, pucMacroPtr) \
-	{	\
-		ASSERT(pucMacroPtr != NULL);	\
-		for ( uiMacroValue = 0; uiMacroValue <<= NUM_COMPRESSED_DATA_BITS, uiMacroValue += (*pucMacroPtr & NUM_COMPRESSED_DATA_MASK), *pucMacroPtr & NUM_COMPRESSED_CONTINUE_BIT; pucMacroPtr++ );	\
-		pucMacroPtr++;	\
-	}
-
-/* Older and slower */
-/* #define NUM_READ_COMPRESSED_UINT(uiMacroValue, pucMacroPtr) \ */
-/* 	{	unsigned char ucMacroByte = '\0';	\ */
-/* 		ASSERT(pucMacroPtr != NULL);	\ */
-/* 		uiMacroValue = 0;	\ */
-/* 		do { 	\ */
-/* 			uiMacroValue = uiMacroValue << NUM_COMPRESSED_DATA_BITS;	\ */
-/* 			ucMacroByte = *(pucMacroPtr++);	\ */
-/* 			uiMacroValue += (ucMacroByte & NUM_COMPRESSED_DATA_MASK); 	\ */
-/* 		}	\ */
-/* 		while ( ucMacroByte & NUM_COMPRESSED_CONTINUE_BIT );	\ */
-/* 	} */
-
-
-/* Macro for compressing an unsigned integer and writing it to memory */
-#define NUM_WRITE_COMPRESSED_UINT(uiMacroValue, pucMacroPtr) \
-	{	\
-		unsigned char ucMacroByte = '\0';	\
-		unsigned int uiMacroLocalValue = uiMacroValue;	\
-		unsigned int uiMacroSize = 0; 	\
-		unsigned int uiMacroBytesLeft = 0;	\
-		ASSERT(uiMacroValue >= 0);	\
-		ASSERT(pucMacroPtr != NULL);	\
-		NUM_GET_COMPRESSED_UINT_SIZE(uiMacroLocalValue, uiMacroSize); \
-		for ( uiMacroBytesLeft = uiMacroSize; uiMacroBytesLeft > 0; uiMacroBytesLeft-- ) { 	\
-			ucMacroByte = (unsigned char)(uiMacroLocalValue & NUM_COMPRESSED_DATA_MASK);	\
-			if ( uiMacroBytesLeft != uiMacroSize )	{ \
-				ucMacroByte |= NUM_COMPRESSED_CONTINUE_BIT;	\
-			}	\
-			pucMacroPtr[uiMacroBytesLeft - 1] = ucMacroByte;	\
-			uiMacroLocalValue >>= NUM_COMPRESSED_DATA_BITS;	\
-		}	\
-		pucMacroPtr += uiMacroSize; 	\
-		ASSERT(uiMacroLocalValue == 0);	\
-	}
-
-
-/*---------------------------------------------------------------------------*/
+/* #define RANDOM_ACCESS								(1) */
 
-
-/*
-** ====================================== 
-** === Number storage macros (varint) ===
-** ======================================
+/* Times every block decode by format and block size and reports the
+** latency percentiles
 */
+/* #define DECODE_LATENCY							(1) */
 
+/* Sums, finds the smallest and largest and counts a range of varint and
+** compact varint integers across memory, decoding then aggregating and
+** with the aggregate kernels
+*/
+/* #define AGGREGATE_ACROSS_MEMORY					(1) */
 
-/* Masks used to mask out a varint in memory */
-static unsigned int	uiVarintMaskGlobal[] = {0x0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+/* Selects the middle half of varint and compact varint integers across
+** memory into a bitmap, decoding then comparing and with the filter kernels
+*/
+/* #define FILTER_ACROSS_MEMORY						(1) */
 
 
-/* Structure to store the byte size of each varint */
-struct varintSize {
-	unsigned char	ucSize1;
-	unsigned char	ucSize2;
-	unsigned char	ucSize3;
-	unsigned char	ucSize4;
-};
+/* Measures the read and memcpy() bandwidth of buffers sized from the L1
+** cache to ten times the last level cache, the across memory benchmarks
+** report their decodes against the read bandwidth of their own buffer
+*/
+#define ROOFLINE									(1)
+#define ROOFLINE_BYTES								(1ULL << 31)	/* Bytes read per measurement */
 
 
-/* Structure which tells us the byte size of each varint based on the offset */
-static struct varintSize pvsVarintSizesGlobal[] = 
-{
-	/*   0 - 00 00 00 00 */	{1,	1,	1,	1},		/*   1 - 00 00 00 01 */	{1,	1,	1,	2},		/*   2 - 00 00 00 10 */	{1,	1,	1,	3},		/*   3 - 00 00 00 11 */	{1,	1,	1,	4},
-	/*   4 - 00 00 01 00 */	{1,	1,	2,	1},		/*   5 - 00 00 01 01 */	{1,	1,	2,	2},		/*   6 - 00 00 01 10 */	{1,	1,	2,	3},		/*   7 - 00 00 01 11 */	{1,	1,	2,	4},
-	/*   8 - 00 00 10 00 */	{1,	1,	3,	1},		/*   9 - 00 00 10 01 */	{1,	1,	3,	2},		/*  10 - 00 00 10 10 */	{1,	1,	3,	3},		/*  11 - 00 00 10 11 */	{1,	1,	3,	4},
-	/*  12 - 00 00 11 00 */	{1,	1,	4,	1},		/*  13 - 00 00 11 01 */	{1,	1,	4,	2},		/*  14 - 00 00 11 10 */	{1,	1,	4,	3},		/*  15 - 00 00 11 11 */	{1,	1,	4,	4},
-	/*  16 - 00 01 00 00 */	{1,	2,	1,	1},		/*  17 - 00 01 00 01 */	{1,	2,	1,	2},		/*  18 - 00 01 00 10 */	{1,	2,	1,	3},		/*  19 - 00 01 00 11 */	{1,	2,	1,	4},
-	/*  20 - 00 01 01 00 */	{1,	2,	2,	1},		/*  21 - 00 01 01 01 */	{1,	2,	2,	2},		/*  22 - 00 01 01 10 */	{1,	2,	2,	3},		/*  23 - 00 01 01 11 */	{1,	2,	2,	4},
-	/*  24 - 00 01 10 00 */	{1,	2,	3,	1},		/*  25 - 00 01 10 01 */	{1,	2,	3,	2},		/*  26 - 00 01 10 10 */	{1,	2,	3,	3},		/*  27 - 00 01 10 11 */	{1,	2,	3,	4},
-	/*  28 - 00 01 11 00 */	{1,	2,	4,	1},		/*  29 - 00 01 11 01 */	{1,	2,	4,	2},		/*  30 - 00 01 11 10 */	{1,	2,	4,	3},		/*  31 - 00 01 11 11 */	{1,	2,	4,	4},
-	/*  32 - 00 10 00 00 */	{1,	3,	1,	1},		/*  33 - 00 10 00 01 */	{1,	3,	1,	2},		/*  34 - 00 10 00 10 */	{1,	3,	1,	3},		/*  35 - 00 10 00 11 */	{1,	3,	1,	4},
-	/*  36 - 00 10 01 00 */	{1,	3,	2,	1},		/*  37 - 00 10 01 01 */	{1,	3,	2,	2},		/*  38 - 00 10 01 10 */	{1,	3,	2,	3},		/*  39 - 00 10 01 11 */	{1,	3,	2,	4},
-	/*  40 - 00 10 10 00 */	{1,	3,	3,	1},		/*  41 - 00 10 10 01 */	{1,	3,	3,	2},		/*  42 - 00 10 10 10 */	{1,	3,	3,	3},		/*  43 - 00 10 10 11 */	{1,	3,	3,	4},
-	/*  44 - 00 10 11 00 */	{1,	3,	4,	1},		/*  45 - 00 10 11 01 */	{1,	3,	4,	2},		/*  46 - 00 10 11 10 */	{1,	3,	4,	3},		/*  47 - 00 10 11 11 */	{1,	3,	4,	4},
-	/*  48 - 00 11 00 00 */	{1,	4,	1,	1},		/*  49 - 00 11 00 01 */	{1,	4,	1,	2},		/*  50 - 00 11 00 10 */	{1,	4,	1,	3},		/*  51 - 00 11 00 11 */	{1,	4,	1,	4},
-	/*  52 - 00 11 01 00 */	{1,	4,	2,	1},		/*  53 - 00 11 01 01 */	{1,	4,	2,	2},		/*  54 - 00 11 01 10 */	{1,	4,	2,	3},		/*  55 - 00 11 01 11 */	{1,	4,	2,	4},
-	/*  56 - 00 11 10 00 */	{1,	4,	3,	1},		/*  57 - 00 11 10 01 */	{1,	4,	3,	2},		/*  58 - 00 11 10 10 */	{1,	4,	3,	3},		/*  59 - 00 11 10 11 */	{1,	4,	3,	4},
-	/*  60 - 00 11 11 00 */	{1,	4,	4,	1},		/*  61 - 00 11 11 01 */	{1,	4,	4,	2},		/*  62 - 00 11 11 10 */	{1,	4,	4,	3},		/*  63 - 00 11 11 11 */	{1,	4,	4,	4},
-	/*  64 - 01 00 00 00 */	{2,	1,	1,	1},		/*  65 - 01 00 00 01 */	{2,	1,	1,	2},		/*  66 - 01 00 00 10 */	{2,	1,	1,	3},		/*  67 - 01 00 00 11 */	{2,	1,	1,	4},
-	/*  68 - 01 00 01 00 */	{2,	1,	2,	1},		/*  69 - 01 00 01 01 */	{2,	1,	2,	2},		/*  70 - 01 00 01 10 */	{2,	1,	2,	3},		/*  71 - 01 00 01 11 */	{2,	1,	2,	4},
-	/*  72 - 01 00 10 00 */	{2,	1,	3,	1},		/*  73 - 01 00 10 01 */	{2,	1,	3,	2},		/*  74 - 01 00 10 10 */	{2,	1,	3,	3},		/*  75 - 01 00 10 11 */	{2,	1,	3,	4},
-	/*  76 - 01 00 11 00 */	{2,	1,	4,	1},		/*  77 - 01 00 11 01 */	{2,	1,	4,	2},		/*  78 - 01 00 11 10 */	{2,	1,	4,	3},		/*  79 - 01 00 11 11 */	{2,	1,	4,	4},
-	/*  80 - 01 01 00 00 */	{2,	2,	1,	1},		/*  81 - 01 01 00 01 */	{2,	2,	1,	2},		/*  82 - 01 01 00 10 */	{2,	2,	1,	3},		/*  83 - 01 01 00 11 */	{2,	2,	1,	4},
-	/*  84 - 01 01 01 00 */	{2,	2,	2,	1},		/*  85 - 01 01 01 01 */	{2,	2,	2,	2},		/*  86 - 01 01 01 10 */	{2,	2,	2,	3},		/*  87 - 01 01 01 11 */	{2,	2,	2,	4},
-	/*  88 - 01 01 10 00 */	{2,	2,	3,	1},		/*  89 - 01 01 10 01 */	{2,	2,	3,	2},		/*  90 - 01 01 10 10 */	{2,	2,	3,	3},		/*  91 - 01 01 10 11 */	{2,	2,	3,	4},
-	/*  92 - 01 01 11 00 */	{2,	2,	4,	1},		/*  93 - 01 01 11 01 */	{2,	2,	4,	2},		/*  94 - 01 01 11 10 */	{2,	2,	4,	3},		/*  95 - 01 01 11 11 */	{2,	2,	4,	4},
-	/*  96 - 01 10 00 00 */	{2,	3,	1,	1},		/*  97 - 01 10 00 01 */	{2,	3,	1,	2},		/*  98 - 01 10 00 10 */	{2,	3,	1,	3},		/*  99 - 01 10 00 11 */	{2,	3,	1,	4},
-	/* 100 - 01 10 01 00 */	{2,	3,	2,	1},		/* 101 - 01 10 01 01 */	{2,	3,	2,	2},		/* 102 - 01 10 01 10 */	{2,	3,	2,	3},		/* 103 - 01 10 01 11 */	{2,	3,	2,	4},
-	/* 104 - 01 10 10 00 */	{2,	3,	3,	1},		/* 105 - 01 10 10 01 */	{2,	3,	3,	2},		/* 106 - 01 10 10 10 */	{2,	3,	3,	3},		/* 107 - 01 10 10 11 */	{2,	3,	3,	4},
-	/* 108 - 01 10 11 00 */	{2,	3,	4,	1},		/* 109 - 01 10 11 01 */	{2,	3,	4,	2},		/* 110 - 01 10 11 10 */	{2,	3,	4,	3},		/* 111 - 01 10 11 11 */	{2,	3,	4,	4},
-	/* 112 - 01 11 00 00 */	{2,	4,	1,	1},		/* 113 - 01 11 00 01 */	{2,	4,	1,	2},		/* 114 - 01 11 00 10 */	{2,	4,	1,	3},		/* 115 - 01 11 00 11 */	{2,	4,	1,	4},
-	/* 116 - 01 11 01 00 */	{2,	4,	2,	1},		/* 117 - 01 11 01 01 */	{2,	4,	2,	2},		/* 118 - 01 11 01 10 */	{2,	4,	2,	3},		/* 119 - 01 11 01 11 */	{2,	4,	2,	4},
-	/* 120 - 01 11 10 00 */	{2,	4,	3,	1},		/* 121 - 01 11 10 01 */	{2,	4,	3,	2},		/* 122 - 01 11 10 10 */	{2,	4,	3,	3},		/* 123 - 01 11 10 11 */	{2,	4,	3,	4},
-	/* 124 - 01 11 11 00 */	{2,	4,	4,	1},		/* 125 - 01 11 11 01 */	{2,	4,	4,	2},		/* 126 - 01 11 11 10 */	{2,	4,	4,	3},		/* 127 - 01 11 11 11 */	{2,	4,	4,	4},
-	/* 128 - 10 00 00 00 */	{3,	1,	1,	1},		/* 129 - 10 00 00 01 */	{3,	1,	1,	2},		/* 130 - 10 00 00 10 */	{3,	1,	1,	3},		/* 131 - 10 00 00 11 */	{3,	1,	1,	4},
-	/* 132 - 10 00 01 00 */	{3,	1,	2,	1},		/* 133 - 10 00 01 01 */	{3,	1,	2,	2},		/* 134 - 10 00 01 10 */	{3,	1,	2,	3},		/* 135 - 10 00 01 11 */	{3,	1,	2,	4},
-	/* 136 - 10 00 10 00 */	{3,	1,	3,	1},		/* 137 - 10 00 10 01 */	{3,	1,	3,	2},		/* 138 - 10 00 10 10 */	{3,	1,	3,	3},		/* 139 - 10 00 10 11 */	{3,	1,	3,	4},
-	/* 140 - 10 00 11 00 */	{3,	1,	4,	1},		/* 141 - 10 00 11 01 */	{3,	1,	4,	2},		/* 142 - 10 00 11 10 */	{3,	1,	4,	3},		/* 143 - 10 00 11 11 */	{3,	1,	4,	4},
-	/* 144 - 10 01 00 00 */	{3,	2,	1,	1},		/* 145 - 10 01 00 01 */	{3,	2,	1,	2},		/* 146 - 10 01 00 10 */	{3,	2,	1,	3},		/* 147 - 10 01 00 11 */	{3,	2,	1,	4},
-	/* 148 - 10 01 01 00 */	{3,	2,	2,	1},		/* 149 - 10 01 01 01 */	{3,	2,	2,	2},		/* 150 - 10 01 01 10 */	{3,	2,	2,	3},		/* 151 - 10 01 01 11 */	{3,	2,	2,	4},
-	/* 152 - 10 01 10 00 */	{3,	2,	3,	1},		/* 153 - 10 01 10 01 */	{3,	2,	3,	2},		/* 154 - 10 01 10 10 */	{3,	2,	3,	3},		/* 155 - 10 01 10 11 */	{3,	2,	3,	4},
-	/* 156 - 10 01 11 00 */	{3,	2,	4,	1},		/* 157 - 10 01 11 01 */	{3,	2,	4,	2},		/* 158 - 10 01 11 10 */	{3,	2,	4,	3},		/* 159 - 10 01 11 11 */	{3,	2,	4,	4},
-	/* 160 - 10 10 00 00 */	{3,	3,	1,	1},		/* 161 - 10 10 00 01 */	{3,	3,	1,	2},		/* 162 - 10 10 00 10 */	{3,	3,	1,	3},		/* 163 - 10 10 00 11 */	{3,	3,	1,	4},
-	/* 164 - 10 10 01 00 */	{3,	3,	2,	1},		/* 165 - 10 10 01 01 */	{3,	3,	2,	2},		/* 166 - 10 10 01 10 */	{3,	3,	2,	3},		/* 167 - 10 10 01 11 */	{3,	3,	2,	4},
-	/* 168 - 10 10 10 00 */	{3,	3,	3,	1},		/* 169 - 10 10 10 01 */	{3,	3,	3,	2},		/* 170 - 10 10 10 10 */	{3,	3,	3,	3},		/* 171 - 10 10 10 11 */	{3,	3,	3,	4},
-	/* 172 - 10 10 11 00 */	{3,	3,	4,	1},		/* 173 - 10 10 11 01 */	{3,	3,	4,	2},		/* 174 - 10 10 11 10 */	{3,	3,	4,	3},		/* 175 - 10 10 11 11 */	{3,	3,	4,	4},
-	/* 176 - 10 11 00 00 */	{3,	4,	1,	1},		/* 177 - 10 11 00 01 */	{3,	4,	1,	2},		/* 178 - 10 11 00 10 */	{3,	4,	1,	3},		/* 179 - 10 11 00 11 */	{3,	4,	1,	4},
-	/* 180 - 10 11 01 00 */	{3,	4,	2,	1},		/* 181 - 10 11 01 01 */	{3,	4,	2,	2},		/* 182 - 10 11 01 10 */	{3,	4,	2,	3},		/* 183 - 10 11 01 11 */	{3,	4,	2,	4},
-	/* 184 - 10 11 10 00 */	{3,	4,	3,	1},		/* 185 - 10 11 10 01 */	{3,	4,	3,	2},		/* 186 - 10 11 10 10 */	{3,	4,	3,	3},		/* 187 - 10 11 10 11 */	{3,	4,	3,	4},
-	/* 188 - 10 11 11 00 */	{3,	4,	4,	1},		/* 189 - 10 11 11 01 */	{3,	4,	4,	2},		/* 190 - 10 11 11 10 */	{3,	4,	4,	3},		/* 191 - 10 11 11 11 */	{3,	4,	4,	4},
-	/* 192 - 11 00 00 00 */	{4,	1,	1,	1},		/* 193 - 11 00 00 01 */	{4,	1,	1,	2},		/* 194 - 11 00 00 10 */	{4,	1,	1,	3},		/* 195 - 11 00 00 11 */	{4,	1,	1,	4},
-	/* 196 - 11 00 01 00 */	{4,	1,	2,	1},		/* 197 - 11 00 01 01 */	{4,	1,	2,	2},		/* 198 - 11 00 01 10 */	{4,	1,	2,	3},		/* 199 - 11 00 01 11 */	{4,	1,	2,	4},
-	/* 200 - 11 00 10 00 */	{4,	1,	3,	1},		/* 201 - 11 00 10 01 */	{4,	1,	3,	2},		/* 202 - 11 00 10 10 */	{4,	1,	3,	3},		/* 203 - 11 00 10 11 */	{4,	1,	3,	4},
-	/* 204 - 11 00 11 00 */	{4,	1,	4,	1},		/* 205 - 11 00 11 01 */	{4,	1,	4,	2},		/* 206 - 11 00 11 10 */	{4,	1,	4,	3},		/* 207 - 11 00 11 11 */	{4,	1,	4,	4},
-	/* 208 - 11 01 00 00 */	{4,	2,	1,	1},		/* 209 - 11 01 00 01 */	{4,	2,	1,	2},		/* 210 - 11 01 00 10 */	{4,	2,	1,	3},		/* 211 - 11 01 00 11 */	{4,	2,	1,	4},
-	/* 212 - 11 01 01 00 */	{4,	2,	2,	1},		/* 213 - 11 01 01 01 */	{4,	2,	2,	2},		/* 214 - 11 01 01 10 */	{4,	2,	2,	3},		/* 215 - 11 01 01 11 */	{4,	2,	2,	4},
-	/* 216 - 11 01 10 00 */	{4,	2,	3,	1},		/* 217 - 11 01 10 01 */	{4,	2,	3,	2},		/* 218 - 11 01 10 10 */	{4,	2,	3,	3},		/* 219 - 11 01 10 11 */	{4,	2,	3,	4},
-	/* 220 - 11 01 11 00 */	{4,	2,	4,	1},		/* 221 - 11 01 11 01 */	{4,	2,	4,	2},		/* 222 - 11 01 11 10 */	{4,	2,	4,	3},		/* 223 - 11 01 11 11 */	{4,	2,	4,	4},
-	/* 224 - 11 10 00 00 */	{4,	3,	1,	1},		/* 225 - 11 10 00 01 */	{4,	3,	1,	2},		/* 226 - 11 10 00 10 */	{4,	3,	1,	3},		/* 227 - 11 10 00 11 */	{4,	3,	1,	4},
-	/* 228 - 11 10 01 00 */	{4,	3,	2,	1},		/* 229 - 11 10 01 01 */	{4,	3,	2,	2},		/* 230 - 11 10 01 10 */	{4,	3,	2,	3},		/* 231 - 11 10 01 11 */	{4,	3,	2,	4},
-	/* 232 - 11 10 10 00 */	{4,	3,	3,	1},		/* 233 - 11 10 10 01 */	{4,	3,	3,	2},		/* 234 - 11 10 10 10 */	{4,	3,	3,	3},		/* 235 - 11 10 10 11 */	{4,	3,	3,	4},
-	/* 236 - 11 10 11 00 */	{4,	3,	4,	1},		/* 237 - 11 10 11 01 */	{4,	3,	4,	2},		/* 238 - 11 10 11 10 */	{4,	3,	4,	3},		/* 239 - 11 10 11 11 */	{4,	3,	4,	4},
-	/* 240 - 11 11 00 00 */	{4,	4,	1,	1},		/* 241 - 11 11 00 01 */	{4,	4,	1,	2},		/* 242 - 11 11 00 10 */	{4,	4,	1,	3},		/* 243 - 11 11 00 11 */	{4,	4,	1,	4},
-	/* 244 - 11 11 01 00 */	{4,	4,	2,	1},		/* 245 - 11 11 01 01 */	{4,	4,	2,	2},		/* 246 - 11 11 01 10 */	{4,	4,	2,	3},		/* 247 - 11 11 01 11 */	{4,	4,	2,	4},
-	/* 248 - 11 11 10 00 */	{4,	4,	3,	1},		/* 249 - 11 11 10 01 */	{4,	4,	3,	2},		/* 250 - 11 11 10 10 */	{4,	4,	3,	3},		/* 251 - 11 11 10 11 */	{4,	4,	3,	4},
-	/* 252 - 11 11 11 00 */	{4,	4,	4,	1},		/* 253 - 11 11 11 01 */	{4,	4,	4,	2},		/* 254 - 11 11 11 10 */	{4,	4,	4,	3},		/* 255 - 11 11 11 11 */	{4,	4,	4,	4},
-};
+/* Allocates the across memory data from a pre-faulted huge page arena
+** rather than with malloc() and memset()
+*/
+/* #define ARENA_ALLOCATION							(1) */
 
 
-/* Macro to get the size of a varint */
-#define NUM_GET_VARINT_SIZE(uiMacroValue, uiMacroSize) \
-	{	\
-		ASSERT((uiMacroValue >= 0) && (uiMacroValue <= 0xFFFFFFFF));	\
-\
-		if ( uiMacroValue <= 0xFF ) {	\
-			uiMacroSize = 1;	\
-		}	\
-		else if ( uiMacroValue <= 0xFFFF ) {	\
-			uiMacroSize = 2;	\
-		}	\
-		else if ( uiMacroValue <= 0xFFFFFF ) {	\
-			uiMacroSize = 3;	\
-		}	\
-		else if ( uiMacroValue <= 0xFFFFFFFF ) {	\
-			uiMacroSize = 4;	\
-		}	\
-		else {	\
-/* 			iUtlLogPanic(UTL_LOG_CONTEXT, "Value exceeds maximum size for a compact varint, value: %u", uiMacroValue); */	\
-		}	\
-	}
-
-
-
-/* Macro to write a varint */
-#define NUM_WRITE_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
-	{	\
-		ASSERT((uiMacroValue >= 0) && (uiMacroValue <= 0xFFFFFFFF));	\
-		ASSERT(uiMacroValue >= 0);	\
-		ASSERT((uiMacroSize >= 1) && (uiMacroSize <= 4));	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		unsigned char	*pucMacroValuePtr = (unsigned char *)&uiMacroValue;	\
-\
-		switch ( uiMacroSize ) {	\
-			case 4: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-			case 3: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-			case 2: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-			case 1: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-		}	\
-	}
-
-
-/* Macro to read a varint */
-#define NUM_READ_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
-	{	\
-		ASSERT((uiMacroSize >= 1) && (uiMacroSize <= 4));	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		uiMacroValue = (unsigned int)*((unsigned int *)(pucMacroPtr));	\
-		uiMacroValue &= uiVarintMaskGlobal[uiMacroSize];	\
-		pucMacroPtr += uiMacroSize;	\
-	}
-
-
-
-/* Header size for a varint quad or trio */
-#define NUM_VARINT_HEADER_SIZE					(1)
-
-/* Number of bits used to encode the number of bytes in the varint */
-#define NUM_VARINT_HEADER_SIZE_BITS				(2)
-
-
-/* Macro to get the size of a varint quad */
-#define NUM_GET_VARINT_QUAD_SIZE(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, uiMacroSize) \
-	{	\
-		ASSERT((uiMacroValue1 >= 0) && (uiMacroValue1 <= 0xFFFFFFFF));	\
-		ASSERT((uiMacroValue2 >= 0) && (uiMacroValue2 <= 0xFFFFFFFF));	\
-		ASSERT((uiMacroValue3 >= 0) && (uiMacroValue3 <= 0xFFFFFFFF));	\
-		ASSERT((uiMacroValue4 >= 0) && (uiMacroValue4 <= 0xFFFFFFFF));	\
-\
-		unsigned int	uiMacroLocalSize = 0;	\
-\
-		uiMacroSize = NUM_VARINT_HEADER_SIZE;	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue1, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue2, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue3, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue4, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-	}
-
-
-/* Macro to write a varint quad */
-#define NUM_WRITE_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
-	{	\
-		ASSERT((uiMacroValue1 >= 0) && (uiMacroValue1 <= 0xFFFFFFFF));	\
-		ASSERT((uiMacroValue2 >= 0) && (uiMacroValue2 <= 0xFFFFFFFF));	\
-		ASSERT((uiMacroValue3 >= 0) && (uiMacroValue3 <= 0xFFFFFFFF));	\
-		ASSERT((uiMacroValue4 >= 0) && (uiMacroValue4 <= 0xFFFFFFFF));	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		unsigned char	*pucMacroStartPtr = pucMacroPtr;	\
-		unsigned char	ucMacroQuartetHeader = '\0';	\
-		unsigned int	uiMacroSize = 0;	\
-\
-		pucMacroPtr += NUM_VARINT_HEADER_SIZE;	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue1, uiMacroSize);	\
-		ucMacroQuartetHeader |= (uiMacroSize - 1);	\
-		NUM_WRITE_VARINT(uiMacroValue1, uiMacroSize, pucMacroPtr);	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue2, uiMacroSize);	\
-		ucMacroQuartetHeader <<= NUM_VARINT_HEADER_SIZE_BITS;	\
-		ucMacroQuartetHeader |= (uiMacroSize - 1);	\
-		NUM_WRITE_VARINT(uiMacroValue2, uiMacroSize, pucMacroPtr);	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue3, uiMacroSize);	\
-		ucMacroQuartetHeader <<= NUM_VARINT_HEADER_SIZE_BITS;	\
-		ucMacroQuartetHeader |= (uiMacroSize - 1);	\
-		NUM_WRITE_VARINT(uiMacroValue3, uiMacroSize, pucMacroPtr);	\
-\
-		NUM_GET_VARINT_SIZE(uiMacroValue4, uiMacroSize);	\
-		ucMacroQuartetHeader <<= NUM_VARINT_HEADER_SIZE_BITS;	\
-		ucMacroQuartetHeader |= (uiMacroSize - 1);	\
-		NUM_WRITE_VARINT(uiMacroValue4, uiMacroSize, pucMacroPtr);	\
-\
-		*pucMacroStartPtr = ucMacroQuartetHeader;	\
-	}
-
-
-/* Macro to read a varint quad */
-#define NUM_READ_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
-	{	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		struct varintSize	*pvsVarintSizesGlobalPtr = pvsVarintSizesGlobal + pucMacroPtr[0];	\
-\
-		pucMacroPtr += NUM_VARINT_HEADER_SIZE;	\
-\
-		NUM_READ_VARINT(uiMacroValue1, pvsVarintSizesGlobalPtr->ucSize1, pucMacroPtr) \
-		NUM_READ_VARINT(uiMacroValue2, pvsVarintSizesGlobalPtr->ucSize2, pucMacroPtr) \
-		NUM_READ_VARINT(uiMacroValue3, pvsVarintSizesGlobalPtr->ucSize3, pucMacroPtr) \
-		NUM_READ_VARINT(uiMacroValue4, pvsVarintSizesGlobalPtr->ucSize4, pucMacroPtr) \
-	}
+/* Checks the values read in the untimed warm up, the timed loops sum the
+** values read into a checksum so they are not optimized away either way
+*/
+#define CHECK_READ									(1)
 
 
-/*---------------------------------------------------------------------------*/
+/* Untimed repetitions run before the timed ones, they warm up the caches
+** and the branch predictors, and give the checksum to check against
+*/
+#define WARM_UP_REPETITIONS							(1)
 
 
-/*
-** ============================================== 
-** === Number storage macros (compact varint) ===
-** ==============================================
+/* Pins the benchmarks to a processor, the thread pools inherit the pinning
+** so leave this off for the parallel benchmarks
 */
+/* #define BENCHMARK_CPU								(0) */
 
+/* Checks that the processor frequency is stable before running, warning if
+** the spread of the frequency check exceeds FREQUENCY_SPREAD_MAX
+*/
+#define FREQUENCY_CHECK								(1)
+#define FREQUENCY_SPREAD_MAX						(0.05)
 
-/* Masks used to mask out a compact varint in memory */
-static unsigned int	uiCompactVarintMaskGlobal[] = {0x0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
 
+/* Regression check, run with -o <file> to append the results to a baseline
+** file, and with -c <file> to check the results against a baseline file,
+** exiting with 1 if any result is slower than the median of its baseline
+** runs by more than REGRESSION_THRESHOLD, or by more than
+** REGRESSION_NOISE_MULTIPLE times the noise if that is larger, the noise
+** being the spread of the baseline runs or of the frequency check
+*/
+#define REGRESSION_THRESHOLD						(0.05)
+#define REGRESSION_NOISE_MULTIPLE					(2)
 
-/* Structure to store the byte size of each compact varint */
-struct compactVarintSize {
-	unsigned char	ucSize1;
-	unsigned char	ucSize2;
-	unsigned char	ucSize3;
-	unsigned char	ucSize4;
-};
+/* Set if any benchmark records results for the regression check */
+#if defined(COMPRESSED_UINT_IN_PLACE) || defined(VARINT_IN_PLACE) || defined(COMPACT_VARINT_IN_PLACE) || \
+		defined(COMPRESSED_UINT_ACROSS_MEMORY) || defined(VARINT_ACROSS_MEMORY) || defined(COMPACT_VARINT_ACROSS_MEMORY) || \
+		defined(PARALLEL_ACROSS_MEMORY) || defined(UNROLL_ACROSS_MEMORY) || defined(OCTET_ACROSS_MEMORY) || \
+		defined(RANDOM_ACCESS) || defined(AGGREGATE_ACROSS_MEMORY) || defined(FILTER_ACROSS_MEMORY)
+#define RECORD_RESULTS								(1)
+#endif	/* Benchmarks which record results */
 
 
-/* Structure which tells us the byte size of each compact varint based on the offset */
-static struct compactVarintSize pvsCompactVarintSizesGlobal[] = 
-{
-	/*   0 - 00 00 00 00 */	{0,	0,	0,	0},		/*   1 - 00 00 00 01 */	{0,	0,	0,	1},		/*   2 - 00 00 00 10 */	{0,	0,	0,	2},		/*   3 - 00 00 00 11 */	{0,	0,	0,	3},
-	/*   4 - 00 00 01 00 */	{0,	0,	1,	0},		/*   5 - 00 00 01 01 */	{0,	0,	1,	1},		/*   6 - 00 00 01 10 */	{0,	0,	1,	2},		/*   7 - 00 00 01 11 */	{0,	0,	1,	3},
-	/*   8 - 00 00 10 00 */	{0,	0,	2,	0},		/*   9 - 00 00 10 01 */	{0,	0,	2,	1},		/*  10 - 00 00 10 10 */	{0,	0,	2,	2},		/*  11 - 00 00 10 11 */	{0,	0,	2,	3},
-	/*  12 - 00 00 11 00 */	{0,	0,	3,	0},		/*  13 - 00 00 11 01 */	{0,	0,	3,	1},		/*  14 - 00 00 11 10 */	{0,	0,	3,	2},		/*  15 - 00 00 11 11 */	{0,	0,	3,	3},
-	/*  16 - 00 01 00 00 */	{0,	1,	0,	0},		/*  17 - 00 01 00 01 */	{0,	1,	0,	1},		/*  18 - 00 01 00 10 */	{0,	1,	0,	2},		/*  19 - 00 01 00 11 */	{0,	1,	0,	3},
-	/*  20 - 00 01 01 00 */	{0,	1,	1,	0},		/*  21 - 00 01 01 01 */	{0,	1,	1,	1},		/*  22 - 00 01 01 10 */	{0,	1,	1,	2},		/*  23 - 00 01 01 11 */	{0,	1,	1,	3},
-	/*  24 - 00 01 10 00 */	{0,	1,	2,	0},		/*  25 - 00 01 10 01 */	{0,	1,	2,	1},		/*  26 - 00 01 10 10 */	{0,	1,	2,	2},		/*  27 - 00 01 10 11 */	{0,	1,	2,	3},
-	/*  28 - 00 01 11 00 */	{0,	1,	3,	0},		/*  29 - 00 01 11 01 */	{0,	1,	3,	1},		/*  30 - 00 01 11 10 */	{0,	1,	3,	2},		/*  31 - 00 01 11 11 */	{0,	1,	3,	3},
-	/*  32 - 00 10 00 00 */	{0,	2,	0,	0},		/*  33 - 00 10 00 01 */	{0,	2,	0,	1},		/*  34 - 00 10 00 10 */	{0,	2,	0,	2},		/*  35 - 00 10 00 11 */	{0,	2,	0,	3},
-	/*  36 - 00 10 01 00 */	{0,	2,	1,	0},		/*  37 - 00 10 01 01 */	{0,	2,	1,	1},		/*  38 - 00 10 01 10 */	{0,	2,	1,	2},		/*  39 - 00 10 01 11 */	{0,	2,	1,	3},
-	/*  40 - 00 10 10 00 */	{0,	2,	2,	0},		/*  41 - 00 10 10 01 */	{0,	2,	2,	1},		/*  42 - 00 10 10 10 */	{0,	2,	2,	2},		/*  43 - 00 10 10 11 */	{0,	2,	2,	3},
-	/*  44 - 00 10 11 00 */	{0,	2,	3,	0},		/*  45 - 00 10 11 01 */	{0,	2,	3,	1},		/*  46 - 00 10 11 10 */	{0,	2,	3,	2},		/*  47 - 00 10 11 11 */	{0,	2,	3,	3},
-	/*  48 - 00 11 00 00 */	{0,	3,	0,	0},		/*  49 - 00 11 00 01 */	{0,	3,	0,	1},		/*  50 - 00 11 00 10 */	{0,	3,	0,	2},		/*  51 - 00 11 00 11 */	{0,	3,	0,	3},
-	/*  52 - 00 11 01 00 */	{0,	3,	1,	0},		/*  53 - 00 11 01 01 */	{0,	3,	1,	1},		/*  54 - 00 11 01 10 */	{0,	3,	1,	2},		/*  55 - 00 11 01 11 */	{0,	3,	1,	3},
-	/*  56 - 00 11 10 00 */	{0,	3,	2,	0},		/*  57 - 00 11 10 01 */	{0,	3,	2,	1},		/*  58 - 00 11 10 10 */	{0,	3,	2,	2},		/*  59 - 00 11 10 11 */	{0,	3,	2,	3},
-	/*  60 - 00 11 11 00 */	{0,	3,	3,	0},		/*  61 - 00 11 11 01 */	{0,	3,	3,	1},		/*  62 - 00 11 11 10 */	{0,	3,	3,	2},		/*  63 - 00 11 11 11 */	{0,	3,	3,	3},
-	/*  64 - 01 00 00 00 */	{1,	0,	0,	0},		/*  65 - 01 00 00 01 */	{1,	0,	0,	1},		/*  66 - 01 00 00 10 */	{1,	0,	0,	2},		/*  67 - 01 00 00 11 */	{1,	0,	0,	3},
-	/*  68 - 01 00 01 00 */	{1,	0,	1,	0},		/*  69 - 01 00 01 01 */	{1,	0,	1,	1},		/*  70 - 01 00 01 10 */	{1,	0,	1,	2},		/*  71 - 01 00 01 11 */	{1,	0,	1,	3},
-	/*  72 - 01 00 10 00 */	{1,	0,	2,	0},		/*  73 - 01 00 10 01 */	{1,	0,	2,	1},		/*  74 - 01 00 10 10 */	{1,	0,	2,	2},		/*  75 - 01 00 10 11 */	{1,	0,	2,	3},
-	/*  76 - 01 00 11 00 */	{1,	0,	3,	0},		/*  77 - 01 00 11 01 */	{1,	0,	3,	1},		/*  78 - 01 00 11 10 */	{1,	0,	3,	2},		/*  79 - 01 00 11 11 */	{1,	0,	3,	3},
-	/*  80 - 01 01 00 00 */	{1,	1,	0,	0},		/*  81 - 01 01 00 01 */	{1,	1,	0,	1},		/*  82 - 01 01 00 10 */	{1,	1,	0,	2},		/*  83 - 01 01 00 11 */	{1,	1,	0,	3},
-	/*  84 - 01 01 01 00 */	{1,	1,	1,	0},		/*  85 - 01 01 01 01 */	{1,	1,	1,	1},		/*  86 - 01 01 01 10 */	{1,	1,	1,	2},		/*  87 - 01 01 01 11 */	{1,	1,	1,	3},
-	/*  88 - 01 01 10 00 */	{1,	1,	2,	0},		/*  89 - 01 01 10 01 */	{1,	1,	2,	1},		/*  90 - 01 01 10 10 */	{1,	1,	2,	2},		/*  91 - 01 01 10 11 */	{1,	1,	2,	3},
-	/*  92 - 01 01 11 00 */	{1,	1,	3,	0},		/*  93 - 01 01 11 01 */	{1,	1,	3,	1},		/*  94 - 01 01 11 10 */	{1,	1,	3,	2},		/*  95 - 01 01 11 11 */	{1,	1,	3,	3},
-	/*  96 - 01 10 00 00 */	{1,	2,	0,	0},		/*  97 - 01 10 00 01 */	{1,	2,	0,	1},		/*  98 - 01 10 00 10 */	{1,	2,	0,	2},		/*  99 - 01 10 00 11 */	{1,	2,	0,	3},
-	/* 100 - 01 10 01 00 */	{1,	2,	1,	0},		/* 101 - 01 10 01 01 */	{1,	2,	1,	1},		/* 102 - 01 10 01 10 */	{1,	2,	1,	2},		/* 103 - 01 10 01 11 */	{1,	2,	1,	3},
-	/* 104 - 01 10 10 00 */	{1,	2,	2,	0},		/* 105 - 01 10 10 01 */	{1,	2,	2,	1},		/* 106 - 01 10 10 10 */	{1,	2,	2,	2},		/* 107 - 01 10 10 11 */	{1,	2,	2,	3},
-	/* 108 - 01 10 11 00 */	{1,	2,	3,	0},		/* 109 - 01 10 11 01 */	{1,	2,	3,	1},		/* 110 - 01 10 11 10 */	{1,	2,	3,	2},		/* 111 - 01 10 11 11 */	{1,	2,	3,	3},
-	/* 112 - 01 11 00 00 */	{1,	3,	0,	0},		/* 113 - 01 11 00 01 */	{1,	3,	0,	1},		/* 114 - 01 11 00 10 */	{1,	3,	0,	2},		/* 115 - 01 11 00 11 */	{1,	3,	0,	3},
-	/* 116 - 01 11 01 00 */	{1,	3,	1,	0},		/* 117 - 01 11 01 01 */	{1,	3,	1,	1},		/* 118 - 01 11 01 10 */	{1,	3,	1,	2},		/* 119 - 01 11 01 11 */	{1,	3,	1,	3},
-	/* 120 - 01 11 10 00 */	{1,	3,	2,	0},		/* 121 - 01 11 10 01 */	{1,	3,	2,	1},		/* 122 - 01 11 10 10 */	{1,	3,	2,	2},		/* 123 - 01 11 10 11 */	{1,	3,	2,	3},
-	/* 124 - 01 11 11 00 */	{1,	3,	3,	0},		/* 125 - 01 11 11 01 */	{1,	3,	3,	1},		/* 126 - 01 11 11 10 */	{1,	3,	3,	2},		/* 127 - 01 11 11 11 */	{1,	3,	3,	3},
-	/* 128 - 10 00 00 00 */	{2,	0,	0,	0},		/* 129 - 10 00 00 01 */	{2,	0,	0,	1},		/* 130 - 10 00 00 10 */	{2,	0,	0,	2},		/* 131 - 10 00 00 11 */	{2,	0,	0,	3},
-	/* 132 - 10 00 01 00 */	{2,	0,	1,	0},		/* 133 - 10 00 01 01 */	{2,	0,	1,	1},		/* 134 - 10 00 01 10 */	{2,	0,	1,	2},		/* 135 - 10 00 01 11 */	{2,	0,	1,	3},
-	/* 136 - 10 00 10 00 */	{2,	0,	2,	0},		/* 137 - 10 00 10 01 */	{2,	0,	2,	1},		/* 138 - 10 00 10 10 */	{2,	0,	2,	2},		/* 139 - 10 00 10 11 */	{2,	0,	2,	3},
-	/* 140 - 10 00 11 00 */	{2,	0,	3,	0},		/* 141 - 10 00 11 01 */	{2,	0,	3,	1},		/* 142 - 10 00 11 10 */	{2,	0,	3,	2},		/* 143 - 10 00 11 11 */	{2,	0,	3,	3},
-	/* 144 - 10 01 00 00 */	{2,	1,	0,	0},		/* 145 - 10 01 00 01 */	{2,	1,	0,	1},		/* 146 - 10 01 00 10 */	{2,	1,	0,	2},		/* 147 - 10 01 00 11 */	{2,	1,	0,	3},
-	/* 148 - 10 01 01 00 */	{2,	1,	1,	0},		/* 149 - 10 01 01 01 */	{2,	1,	1,	1},		/* 150 - 10 01 01 10 */	{2,	1,	1,	2},		/* 151 - 10 01 01 11 */	{2,	1,	1,	3},
-	/* 152 - 10 01 10 00 */	{2,	1,	2,	0},		/* 153 - 10 01 10 01 */	{2,	1,	2,	1},		/* 154 - 10 01 10 10 */	{2,	1,	2,	2},		/* 155 - 10 01 10 11 */	{2,	1,	2,	3},
-	/* 156 - 10 01 11 00 */	{2,	1,	3,	0},		/* 157 - 10 01 11 01 */	{2,	1,	3,	1},		/* 158 - 10 01 11 10 */	{2,	1,	3,	2},		/* 159 - 10 01 11 11 */	{2,	1,	3,	3},
-	/* 160 - 10 10 00 00 */	{2,	2,	0,	0},		/* 161 - 10 10 00 01 */	{2,	2,	0,	1},		/* 162 - 10 10 00 10 */	{2,	2,	0,	2},		/* 163 - 10 10 00 11 */	{2,	2,	0,	3},
-	/* 164 - 10 10 01 00 */	{2,	2,	1,	0},		/* 165 - 10 10 01 01 */	{2,	2,	1,	1},		/* 166 - 10 10 01 10 */	{2,	2,	1,	2},		/* 167 - 10 10 01 11 */	{2,	2,	1,	3},
-	/* 168 - 10 10 10 00 */	{2,	2,	2,	0},		/* 169 - 10 10 10 01 */	{2,	2,	2,	1},		/* 170 - 10 10 10 10 */	{2,	2,	2,	2},		/* 171 - 10 10 10 11 */	{2,	2,	2,	3},
-	/* 172 - 10 10 11 00 */	{2,	2,	3,	0},		/* 173 - 10 10 11 01 */	{2,	2,	3,	1},		/* 174 - 10 10 11 10 */	{2,	2,	3,	2},		/* 175 - 10 10 11 11 */	{2,	2,	3,	3},
-	/* 176 - 10 11 00 00 */	{2,	3,	0,	0},		/* 177 - 10 11 00 01 */	{2,	3,	0,	1},		/* 178 - 10 11 00 10 */	{2,	3,	0,	2},		/* 179 - 10 11 00 11 */	{2,	3,	0,	3},
-	/* 180 - 10 11 01 00 */	{2,	3,	1,	0},		/* 181 - 10 11 01 01 */	{2,	3,	1,	1},		/* 182 - 10 11 01 10 */	{2,	3,	1,	2},		/* 183 - 10 11 01 11 */	{2,	3,	1,	3},
-	/* 184 - 10 11 10 00 */	{2,	3,	2,	0},		/* 185 - 10 11 10 01 */	{2,	3,	2,	1},		/* 186 - 10 11 10 10 */	{2,	3,	2,	2},		/* 187 - 10 11 10 11 */	{2,	3,	2,	3},
-	/* 188 - 10 11 11 00 */	{2,	3,	3,	0},		/* 189 - 10 11 11 01 */	{2,	3,	3,	1},		/* 190 - 10 11 11 10 */	{2,	3,	3,	2},		/* 191 - 10 11 11 11 */	{2,	3,	3,	3},
-	/* 192 - 11 00 00 00 */	{3,	0,	0,	0},		/* 193 - 11 00 00 01 */	{3,	0,	0,	1},		/* 194 - 11 00 00 10 */	{3,	0,	0,	2},		/* 195 - 11 00 00 11 */	{3,	0,	0,	3},
-	/* 196 - 11 00 01 00 */	{3,	0,	1,	0},		/* 197 - 11 00 01 01 */	{3,	0,	1,	1},		/* 198 - 11 00 01 10 */	{3,	0,	1,	2},		/* 199 - 11 00 01 11 */	{3,	0,	1,	3},
-	/* 200 - 11 00 10 00 */	{3,	0,	2,	0},		/* 201 - 11 00 10 01 */	{3,	0,	2,	1},		/* 202 - 11 00 10 10 */	{3,	0,	2,	2},		/* 203 - 11 00 10 11 */	{3,	0,	2,	3},
-	/* 204 - 11 00 11 00 */	{3,	0,	3,	0},		/* 205 - 11 00 11 01 */	{3,	0,	3,	1},		/* 206 - 11 00 11 10 */	{3,	0,	3,	2},		/* 207 - 11 00 11 11 */	{3,	0,	3,	3},
-	/* 208 - 11 01 00 00 */	{3,	1,	0,	0},		/* 209 - 11 01 00 01 */	{3,	1,	0,	1},		/* 210 - 11 01 00 10 */	{3,	1,	0,	2},		/* 211 - 11 01 00 11 */	{3,	1,	0,	3},
-	/* 212 - 11 01 01 00 */	{3,	1,	1,	0},		/* 213 - 11 01 01 01 */	{3,	1,	1,	1},		/* 214 - 11 01 01 10 */	{3,	1,	1,	2},		/* 215 - 11 01 01 11 */	{3,	1,	1,	3},
-	/* 216 - 11 01 10 00 */	{3,	1,	2,	0},		/* 217 - 11 01 10 01 */	{3,	1,	2,	1},		/* 218 - 11 01 10 10 */	{3,	1,	2,	2},		/* 219 - 11 01 10 11 */	{3,	1,	2,	3},
-	/* 220 - 11 01 11 00 */	{3,	1,	3,	0},		/* 221 - 11 01 11 01 */	{3,	1,	3,	1},		/* 222 - 11 01 11 10 */	{3,	1,	3,	2},		/* 223 - 11 01 11 11 */	{3,	1,	3,	3},
-	/* 224 - 11 10 00 00 */	{3,	2,	0,	0},		/* 225 - 11 10 00 01 */	{3,	2,	0,	1},		/* 226 - 11 10 00 10 */	{3,	2,	0,	2},		/* 227 - 11 10 00 11 */	{3,	2,	0,	3},
-	/* 228 - 11 10 01 00 */	{3,	2,	1,	0},		/* 229 - 11 10 01 01 */	{3,	2,	1,	1},		/* 230 - 11 10 01 10 */	{3,	2,	1,	2},		/* 231 - 11 10 01 11 */	{3,	2,	1,	3},
-	/* 232 - 11 10 10 00 */	{3,	2,	2,	0},		/* 233 - 11 10 10 01 */	{3,	2,	2,	1},		/* 234 - 11 10 10 10 */	{3,	2,	2,	2},		/* 235 - 11 10 10 11 */	{3,	2,	2,	3},
-	/* 236 - 11 10 11 00 */	{3,	2,	3,	0},		/* 237 - 11 10 11 01 */	{3,	2,	3,	1},		/* 238 - 11 10 11 10 */	{3,	2,	3,	2},		/* 239 - 11 10 11 11 */	{3,	2,	3,	3},
-	/* 240 - 11 11 00 00 */	{3,	3,	0,	0},		/* 241 - 11 11 00 01 */	{3,	3,	0,	1},		/* 242 - 11 11 00 10 */	{3,	3,	0,	2},		/* 243 - 11 11 00 11 */	{3,	3,	0,	3},
-	/* 244 - 11 11 01 00 */	{3,	3,	1,	0},		/* 245 - 11 11 01 01 */	{3,	3,	1,	1},		/* 246 - 11 11 01 10 */	{3,	3,	1,	2},		/* 247 - 11 11 01 11 */	{3,	3,	1,	3},
-	/* 248 - 11 11 10 00 */	{3,	3,	2,	0},		/* 249 - 11 11 10 01 */	{3,	3,	2,	1},		/* 250 - 11 11 10 10 */	{3,	3,	2,	2},		/* 251 - 11 11 10 11 */	{3,	3,	2,	3},
-	/* 252 - 11 11 11 00 */	{3,	3,	3,	0},		/* 253 - 11 11 11 01 */	{3,	3,	3,	1},		/* 254 - 11 11 11 10 */	{3,	3,	3,	2},		/* 255 - 11 11 11 11 */	{3,	3,	3,	3},
-};
+/* Defines which control the nature of the performance test */
+#define DATA_LENGTH									(1000)
+#define STRING_LENGTH								(1000)
 
+#define NUMBER_1									(1235)
+#define NUMBER_2									(123456)
+#define NUMBER_3									(1234567)
+#define NUMBER_4									(12345678)
 
-/* Macro to get the size of a compact varint */
-#define NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue, uiMacroSize) \
-	{	\
-		ASSERT((uiMacroValue >= 0) && (uiMacroValue <= 0xFFFFFF));	\
-\
-		if ( uiMacroValue == 0 ) {	\
-			uiMacroSize = 0;	\
-		}	\
-		else if ( uiMacroValue <= 0xFF ) {	\
-			uiMacroSize = 1;	\
-		}	\
-		else if ( uiMacroValue <= 0xFFFF ) {	\
-			uiMacroSize = 2;	\
-		}	\
-		else if ( uiMacroValue <= 0xFFFFFF ) {	\
-			uiMacroSize = 3;	\
-		}	\
-		else {	\
-/* 			iUtlLogPanic(UTL_LOG_CONTEXT, "Value exceeds maximum size for a compact varint, value: %u", uiMacroValue); */	\
-		}	\
-	}
-
-
-
-/* Macro to write a compact varint */
-#define NUM_WRITE_COMPACT_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
-	{	\
-		ASSERT((uiMacroValue >= 0) && (uiMacroValue <= 0xFFFFFF));	\
-		ASSERT((uiMacroSize >= 0) && (uiMacroSize <= 3));	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		unsigned char	*pucMacroValuePtr = (unsigned char *)&uiMacroValue;	\
-\
-		switch ( uiMacroSize ) {	\
-			case 3: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-			case 2: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-			case 1: *pucMacroPtr = *pucMacroValuePtr; pucMacroPtr++; pucMacroValuePtr++;	\
-			case 0:	; \
-		}	\
-	}
-
-
-/* Macro to read a compact varint */
-#define NUM_READ_COMPACT_VARINT(uiMacroValue, uiMacroSize, pucMacroPtr) \
-	{	\
-		ASSERT((uiMacroSize >= 0) && (uiMacroSize <= 3));	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		uiMacroValue = (unsigned int)*((unsigned int *)(pucMacroPtr));	\
-		uiMacroValue &= uiCompactVarintMaskGlobal[uiMacroSize];	\
-		pucMacroPtr += uiMacroSize;	\
-	}
-
-
-
-/* Header size for a varint quad or trio */
-#define NUM_COMPACT_VARINT_HEADER_SIZE						(1)
-
-/* Number of bits used to encode the number of bytes in the varint */
-#define NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS			(2)
-
-
-/* Macro to get the size of a compact varint quad */
-#define NUM_GET_COMPACT_VARINT_QUAD_SIZE(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, uiMacroSize) \
-	{	\
-		ASSERT((uiMacroValue1 >= 0) && (uiMacroValue1 <= 0xFFFFFF));	\
-		ASSERT((uiMacroValue2 >= 0) && (uiMacroValue2 <= 0xFFFFFF));	\
-		ASSERT((uiMacroValue3 >= 0) && (uiMacroValue3 <= 0xFFFFFF));	\
-		ASSERT((uiMacroValue4 >= 0) && (uiMacroValue4 <= 0xFFFFFF));	\
-\
-		unsigned int	uiMacroLocalSize = 0;	\
-\
-		uiMacroSize = NUM_COMPACT_VARINT_HEADER_SIZE;	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue1, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue2, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue3, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue4, uiMacroLocalSize);	\
-		uiMacroSize += uiMacroLocalSize;	\
-	}
-
-
-/* Macro to write a compact varint quad */
-#define NUM_WRITE_COMPACT_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
-	{	\
-		ASSERT((uiMacroValue1 >= 0) && (uiMacroValue1 <= 0xFFFFFF));	\
-		ASSERT((uiMacroValue2 >= 0) && (uiMacroValue2 <= 0xFFFFFF));	\
-		ASSERT((uiMacroValue3 >= 0) && (uiMacroValue3 <= 0xFFFFFF));	\
-		ASSERT((uiMacroValue4 >= 0) && (uiMacroValue4 <= 0xFFFFFF));	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		unsigned char	*pucMacroStartPtr = pucMacroPtr;	\
-		unsigned char	ucMacroQuartetHeader = '\0';	\
-		unsigned int	uiMacroSize = 0;	\
-\
-		pucMacroPtr += NUM_COMPACT_VARINT_HEADER_SIZE;	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue1, uiMacroSize);	\
-		ucMacroQuartetHeader |= uiMacroSize;	\
-		NUM_WRITE_COMPACT_VARINT(uiMacroValue1, uiMacroSize, pucMacroPtr);	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue2, uiMacroSize);	\
-		ucMacroQuartetHeader <<= NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS;	\
-		ucMacroQuartetHeader |= uiMacroSize;	\
-		NUM_WRITE_COMPACT_VARINT(uiMacroValue2, uiMacroSize, pucMacroPtr);	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue3, uiMacroSize);	\
-		ucMacroQuartetHeader <<= NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS;	\
-		ucMacroQuartetHeader |= uiMacroSize;	\
-		NUM_WRITE_COMPACT_VARINT(uiMacroValue3, uiMacroSize, pucMacroPtr);	\
-\
-		NUM_GET_COMPACT_VARINT_SIZE(uiMacroValue4, uiMacroSize);	\
-		ucMacroQuartetHeader <<= NUM_COMPACT_VARINT_HEADER_BYTE_COUNT_BITS;	\
-		ucMacroQuartetHeader |= uiMacroSize;	\
-		NUM_WRITE_COMPACT_VARINT(uiMacroValue4, uiMacroSize, pucMacroPtr);	\
-\
-		*pucMacroStartPtr = ucMacroQuartetHeader;	\
-	}
-
-
-/* Macro to read a compact varint quad */
-#define NUM_READ_COMPACT_VARINT_QUAD(uiMacroValue1, uiMacroValue2, uiMacroValue3, uiMacroValue4, pucMacroPtr) \
-	{	\
-		ASSERT(pucMacroPtr != NULL);	\
-\
-		struct compactVarintSize	*pvsVarintSizesGlobalPtr = pvsCompactVarintSizesGlobal + pucMacroPtr[0];	\
-\
-		pucMacroPtr += NUM_COMPACT_VARINT_HEADER_SIZE;	\
-\
-		NUM_READ_COMPACT_VARINT(uiMacroValue1, pvsVarintSizesGlobalPtr->ucSize1, pucMacroPtr) \
-		NUM_READ_COMPACT_VARINT(uiMacroValue2, pvsVarintSizesGlobalPtr->ucSize2, pucMacroPtr) \
-		NUM_READ_COMPACT_VARINT(uiMacroValue3, pvsVarintSizesGlobalPtr->ucSize3, pucMacroPtr) \
-		NUM_READ_COMPACT_VARINT(uiMacroValue4, pvsVarintSizesGlobalPtr->ucSize4, pucMacroPtr) \
-	}
+#define REPETITIONS									(60)
+#define ITERATIONS									(16000000)
 
+#define THREAD_COUNT								(0)		/* 0 for the number of processors */
 
-/*---------------------------------------------------------------------------*/
+#define RANDOM_ACCESS_LOOKUPS						(4000000)
+#define RANDOM_ACCESS_STRIDE						(64)	/* A multiple of 4 */
 
+#define MERGE_STREAM_COUNT_MAX						(17)	/* Not a power of two */
 
-/* Macro to get the diff between two timeval structures */
-#define UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal) \
-{ \
-	tvDiffTimeVal.tv_sec = tvEndTimeVal.tv_sec - tvStartTimeVal.tv_sec; \
-	tvDiffTimeVal.tv_usec = tvEndTimeVal.tv_usec - tvStartTimeVal.tv_usec; \
-	if ( tvDiffTimeVal.tv_usec < 0 ) { \
-		tvDiffTimeVal.tv_sec--; \
-		tvDiffTimeVal.tv_usec += 1000000; \
-	} \
-}
 
 
-/* Macro to convert a timeval structure to microseconds */
-#define UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvTimeVal, dDouble) \
-{ \
-	dDouble = ((double)tvTimeVal.tv_sec * 1000000) + (double)tvTimeVal.tv_usec; \
-}
+/* Integrity tests */
+/* #define TEST_VARINT_1								(1) */
+/* #define TEST_VARINT_2								(1) */
+/* #define TEST_COMPACT_VARINT_1						(1) */
+/* #define TEST_COMPACT_VARINT_2						(1) */
+/* #define TEST_STREAM_ENCODER							(1) */
+/* #define TEST_STREAM_DECODER							(1) */
+/* #define TEST_PARALLEL								(1) */
+/* #define TEST_ASYNC_SOURCE							(1) */
+/* #define TEST_ARENA									(1) */
+/* #define TEST_FIXED_WIDTH							(1) */
+/* #define TEST_HISTOGRAM								(1) */
+/* #define TEST_AGGREGATE								(1) */
+/* #define TEST_FILTER								(1) */
+/* #define TEST_ZERO_RUN								(1) */
+/* #define TEST_COMPACT_VARINT_ESCAPE					(1) */
+/* #define TEST_VARINT_OCTET							(1) */
+/* #define TEST_MERGE									(1) */
+/* #define TEST_TRANSCODE								(1) */
+/* #define TEST_LIST									(1) */
+/* #define TEST_SET									(1) */
+/* #define TEST_POSTING								(1) */
 
 
 /*---------------------------------------------------------------------------*/
@@ -856,955 +399,5638 @@ unsigned char *pucUtlStringsFormatIntegerString
 /*---------------------------------------------------------------------------*/
 
 
-/* Performance test */
-#define COMPRESSED_UINT_IN_PLACE					(1)
-#define VARINT_IN_PLACE								(1)
-#define COMPACT_VARINT_IN_PLACE						(1)
+#if defined(RANDOM_ACCESS)
 
-#define COMPRESSED_UINT_ACROSS_MEMORY				(1)
-#define VARINT_ACROSS_MEMORY						(1)
-#define COMPACT_VARINT_ACROSS_MEMORY				(1)
+/*
+
+	Function:	iUtlPerfCacheMissesOpen()
+
+	Purpose:	Opens a hardware counter for the cache misses of this
+				thread, the counter starts disabled.
+
+	Parameters:	none
+
+	Global Variables:	none
 
+	Returns:	the counter file descriptor, -1 if there are no counters
 
-/* Checks the values read, disabling this causes the 
-** optimizer to optimize away the VARINT and COMPACT_VARINT
-** loops which messes up the stats.
 */
-#define CHECK_READ									(1)
+static int iUtlPerfCacheMissesOpen
+(
+	void
+)
+{
 
+#if defined(__linux__)
+	struct perf_event_attr	peaPerfEventAttr;
 
-/* Defines which control the nature of the performance test */
-#define DATA_LENGTH									(1000)
-#define STRING_LENGTH								(1000)
 
-#define NUMBER_1									(1235)
-#define NUMBER_2									(123456)
-#define NUMBER_3									(1234567)
-#define NUMBER_4									(12345678)
+	memset(&peaPerfEventAttr, 0, sizeof(struct perf_event_attr));
+	peaPerfEventAttr.type = PERF_TYPE_HARDWARE;
+	peaPerfEventAttr.size = sizeof(struct perf_event_attr);
+	peaPerfEventAttr.config = PERF_COUNT_HW_CACHE_MISSES;
+	peaPerfEventAttr.disabled = 1;
+	peaPerfEventAttr.exclude_kernel = 1;
+	peaPerfEventAttr.exclude_hv = 1;
 
-#define REPETITIONS									(60)
-#define ITERATIONS									(16000000)
+	return ((int)syscall(__NR_perf_event_open, &peaPerfEventAttr, 0, -1, -1, 0));
+#else
+	return (-1);
+#endif	/* defined(__linux__) */
 
+}
 
 
-/* Integrity tests */
-/* #define TEST_VARINT_1								(1) */
-/* #define TEST_VARINT_2								(1) */
-/* #define TEST_COMPACT_VARINT_1						(1) */
-/* #define TEST_COMPACT_VARINT_2						(1) */
+/*
 
+	Function:	iUtlPerfCacheMissesStart()
 
-/*---------------------------------------------------------------------------*/
+	Purpose:	Resets and enables a cache miss counter.
 
+	Parameters:	iPerfFileDescriptor		counter file descriptor
 
-/*{
+	Global Variables:	none
 
-	Function:	main()
+	Returns:	0 on success, -1 on error
 
-	Purpose:	Main.
+*/
+static int iUtlPerfCacheMissesStart
+(
+	int iPerfFileDescriptor
+)
+{
 
-	Called by:	main()
+#if defined(__linux__)
+	if ( iPerfFileDescriptor == -1 ) {
+		return (-1);
+	}
 
-	Parameters:	void
+	if ( (ioctl(iPerfFileDescriptor, PERF_EVENT_IOC_RESET, 0) == -1) || (ioctl(iPerfFileDescriptor, PERF_EVENT_IOC_ENABLE, 0) == -1) ) {
+		return (-1);
+	}
+
+	return (0);
+#else
+	return (-1);
+#endif	/* defined(__linux__) */
+
+}
+
+
+/*
+
+	Function:	iUtlPerfCacheMissesStop()
+
+	Purpose:	Disables a cache miss counter and reads it.
+
+	Parameters:	iPerfFileDescriptor		counter file descriptor
+				pullCacheMisses			return pointer for the cache misses
 
 	Global Variables:	none
 
-	Returns:	int
+	Returns:	0 on success, -1 on error
 
-}*/
-int main
+*/
+static int iUtlPerfCacheMissesStop
 (
-	int argc,
-	char *argv[]
+	int iPerfFileDescriptor,
+	unsigned long long *pullCacheMisses
 )
 {
 
+#if defined(__linux__)
+	if ( iPerfFileDescriptor == -1 ) {
+		return (-1);
+	}
 
-	printf("\n");
+	if ( (ioctl(iPerfFileDescriptor, PERF_EVENT_IOC_DISABLE, 0) == -1) ||
+			(read(iPerfFileDescriptor, pullCacheMisses, sizeof(unsigned long long)) != sizeof(unsigned long long)) ) {
+		return (-1);
+	}
 
+	return (0);
+#else
+	return (-1);
+#endif	/* defined(__linux__) */
 
-#if defined(COMPRESSED_UINT_IN_PLACE)
-	/* Testing compressed uint in place */
-	{
-	
-		unsigned char		pucData[DATA_LENGTH];
-		unsigned char		*pucDataPtr = NULL;
-	
-		unsigned int		uiValueWritten1 = NUMBER_1;
-		unsigned int		uiValueWritten2 = NUMBER_2;
-		unsigned int		uiValueWritten3 = NUMBER_3;
-		unsigned int		uiValueWritten4 = NUMBER_4;
-		unsigned int		uiValueRead1 = 0;
-		unsigned int		uiValueRead2 = 0;
-		unsigned int		uiValueRead3 = 0;
-		unsigned int		uiValueRead4 = 0;
-	
-		unsigned int		uiI = 0;
-		unsigned int		uiJ = 0;
-	
-		unsigned long long	ullTotalIterations = 0;
+}
 
-		struct timeval		tvStartTimeVal;
-		struct timeval		tvEndTimeVal;
-		struct timeval		tvDiffTimeVal;
-		double				dMicroSeconds = 0;
-		unsigned char		pucNumberString[STRING_LENGTH];
-		unsigned char		pucString[STRING_LENGTH];
-	
-		
-		memset(pucData, DATA_LENGTH, 0);
-	
-		pucDataPtr = pucData;
-		NUM_WRITE_COMPRESSED_UINT(uiValueWritten1, pucDataPtr);
-		NUM_WRITE_COMPRESSED_UINT(uiValueWritten2, pucDataPtr);
-		NUM_WRITE_COMPRESSED_UINT(uiValueWritten3, pucDataPtr);
-		NUM_WRITE_COMPRESSED_UINT(uiValueWritten4, pucDataPtr);
-	
-	
-		gettimeofday(&tvStartTimeVal, NULL);
-	
-		for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
-	
-			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+#endif	/* defined(RANDOM_ACCESS) */
 
-				pucDataPtr = pucData;
-				NUM_READ_COMPRESSED_UINT(uiValueRead1, pucDataPtr);
-				NUM_READ_COMPRESSED_UINT(uiValueRead2, pucDataPtr);
-				NUM_READ_COMPRESSED_UINT(uiValueRead3, pucDataPtr);
-				NUM_READ_COMPRESSED_UINT(uiValueRead4, pucDataPtr);
-	
-#if defined(CHECK_READ)
-				if ( uiValueRead1 != uiValueWritten1 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
-					exit (-1);
-				}
-		
-				if ( uiValueRead2 != uiValueWritten2 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
-					exit (-1);
-				}
-		
-				if ( uiValueRead3 != uiValueWritten3 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
-					exit (-1);
-				}
-		
-				if ( uiValueRead4 != uiValueWritten4 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+
+/*---------------------------------------------------------------------------*/
+
+
+/* Number of times the frequency check spin loop is timed, and the number of
+** iterations in the loop
+*/
+#define UTL_BENCHMARK_FREQUENCY_SAMPLES				(10)
+#define UTL_BENCHMARK_FREQUENCY_SPIN				(20000000UL)
+
+
+/* Fraction of the read bandwidth from which a decode is bandwidth bound */
+#define UTL_BENCHMARK_BANDWIDTH_BOUND				(0.8)
+
+
+/* Length of the strings formatted by the benchmark functions */
+#define UTL_BENCHMARK_STRING_LENGTH					(1000)
+
+
+/* Benchmark results, recorded for the regression check, and the maximum
+** number of results held, a baseline holds the results of a few runs
+*/
+#define UTL_BENCHMARK_NAME_LENGTH					(128)
+#define UTL_BENCHMARK_RESULTS_MAX					(4096)
+
+struct utlBenchmarkResult {
+	unsigned char		pucCodec[UTL_BENCHMARK_NAME_LENGTH];
+	unsigned char		pucDistribution[UTL_BENCHMARK_NAME_LENGTH];
+	unsigned char		pucOperation[UTL_BENCHMARK_NAME_LENGTH];
+	double				dPerSecond;
+};
+
+static struct utlBenchmarkResult	pubrUtlBenchmarkResultsGlobal[UTL_BENCHMARK_RESULTS_MAX];
+static unsigned int					uiUtlBenchmarkResultsLengthGlobal = 0;
+
+
+#if defined(BENCHMARK_CPU)
+
+/*
+
+	Function:	iUtlBenchmarkPinThread()
+
+	Purpose:	Pins this thread to a processor so the benchmarks are not
+				moved between processors while they are timed, threads
+				created after this inherit the pinning.
+
+	Parameters:	iCpu		processor
+
+	Global Variables:	none
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkPinThread
+(
+	int iCpu
+)
+{
+
+#if defined(__linux__)
+	cpu_set_t	csCpuSet;
+
+
+	if ( iCpu < 0 ) {
+		return (-1);
+	}
+
+	CPU_ZERO(&csCpuSet);
+	CPU_SET(iCpu, &csCpuSet);
+
+	return ((sched_setaffinity(0, sizeof(cpu_set_t), &csCpuSet) == 0) ? 0 : -1);
+#else
+	return (-1);
+#endif	/* defined(__linux__) */
+
+}
+
+#endif	/* defined(BENCHMARK_CPU) */
+
+
+#if defined(FREQUENCY_CHECK)
+
+/*
+
+	Function:	iUtlBenchmarkCheckFrequency()
+
+	Purpose:	Times a spin loop of dependent instructions a few times, it
+				runs at one cycle per iteration so the spread of the times is
+				the spread of the processor frequency, and the fastest time
+				gives the frequency.
+
+	Parameters:	pdSpread		return pointer for the spread, the slowest
+								time over the fastest less one
+				pdHertz			return pointer for the frequency (optional)
+
+	Global Variables:	none
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkCheckFrequency
+(
+	double *pdSpread,
+	double *pdHertz
+)
+{
+
+	struct timespec		tsStartTimeSpec;
+	struct timespec		tsEndTimeSpec;
+	unsigned long		ulI = 0;
+	unsigned long		ulStep = 0;
+	unsigned int		uiJ = 0;
+	double				dNanoSeconds = 0;
+	double				dMinNanoSeconds = DBL_MAX;
+	double				dMaxNanoSeconds = 0;
+
+
+	if ( pdSpread == NULL ) {
+		return (-1);
+	}
+
+	for ( uiJ = 0; uiJ < UTL_BENCHMARK_FREQUENCY_SAMPLES; uiJ++ ) {
+
+		if ( clock_gettime(CLOCK_MONOTONIC, &tsStartTimeSpec) == -1 ) {
+			return (-1);
+		}
+
+		/* Four dependent additions per loop so the loop branch does not limit it, the step is
+		** laundered so the additions are register additions, some processors eliminate
+		** additions of constants when renaming
+		*/
+		ulStep = 1;
+		UTL_BENCHMARK_LAUNDER(ulStep);
+
+		for ( ulI = 0; ulI < UTL_BENCHMARK_FREQUENCY_SPIN; ) {
+			ulI += ulStep;
+			UTL_BENCHMARK_LAUNDER(ulI);
+			ulI += ulStep;
+			UTL_BENCHMARK_LAUNDER(ulI);
+			ulI += ulStep;
+			UTL_BENCHMARK_LAUNDER(ulI);
+			ulI += ulStep;
+			UTL_BENCHMARK_LAUNDER(ulI);
+		}
+
+		if ( clock_gettime(CLOCK_MONOTONIC, &tsEndTimeSpec) == -1 ) {
+			return (-1);
+		}
+
+		dNanoSeconds = ((double)(tsEndTimeSpec.tv_sec - tsStartTimeSpec.tv_sec) * 1000000000) + (double)(tsEndTimeSpec.tv_nsec - tsStartTimeSpec.tv_nsec);
+		dMinNanoSeconds = (dNanoSeconds < dMinNanoSeconds) ? dNanoSeconds : dMinNanoSeconds;
+		dMaxNanoSeconds = (dNanoSeconds > dMaxNanoSeconds) ? dNanoSeconds : dMaxNanoSeconds;
+	}
+
+	*pdSpread = (dMaxNanoSeconds / dMinNanoSeconds) - 1;
+
+	if ( pdHertz != NULL ) {
+		*pdHertz = ((double)UTL_BENCHMARK_FREQUENCY_SPIN * 1000000000) / dMinNanoSeconds;
+	}
+
+	return (0);
+
+}
+
+
+/*
+
+	Function:	iUtlBenchmarkGetGovernor()
+
+	Purpose:	Gets the frequency scaling governor of a processor.
+
+	Parameters:	iCpu				processor
+				pucGovernor			return pointer for the governor
+				uiGovernorLength	length of the return pointer
+
+	Global Variables:	none
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkGetGovernor
+(
+	int iCpu,
+	unsigned char *pucGovernor,
+	unsigned int uiGovernorLength
+)
+{
+
+	unsigned char	pucFilePath[256];
+	FILE			*pfFile = NULL;
+
+
+	if ( (pucGovernor == NULL) || (uiGovernorLength == 0) ) {
+		return (-1);
+	}
+
+	snprintf(pucFilePath, sizeof(pucFilePath), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", (iCpu < 0) ? 0 : iCpu);
+
+	if ( (pfFile = fopen(pucFilePath, "r")) == NULL ) {
+		return (-1);
+	}
+
+	if ( fgets(pucGovernor, uiGovernorLength, pfFile) == NULL ) {
+		fclose(pfFile);
+		return (-1);
+	}
+
+	fclose(pfFile);
+
+	pucGovernor[strcspn(pucGovernor, "\n")] = '\0';
+
+	return (0);
+
+}
+
+#endif	/* defined(FREQUENCY_CHECK) */
+
+
+#if defined(ROOFLINE)
+
+/*
+
+	Function:	iUtlBenchmarkReadBandwidth()
+
+	Purpose:	Measures the bandwidth of streaming reads over a buffer, the
+				reads are summed into four independent sums so the loop is
+				bound by the loads rather than by the additions.
+
+	Parameters:	pucData				data
+				ullDataLength		data length, rounded down to 32 bytes
+				uiRepetitions		number of reads over the data
+				pdBytesPerSecond	return pointer for the bandwidth
+
+	Global Variables:	none
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkReadBandwidth
+(
+	unsigned char *pucData,
+	unsigned long long ullDataLength,
+	unsigned int uiRepetitions,
+	double *pdBytesPerSecond
+)
+{
+
+	unsigned long long	*pullData = (unsigned long long *)pucData;
+	unsigned long long	ullWords = ullDataLength / (sizeof(unsigned long long) * 4) * 4;
+	unsigned long long	ullI = 0;
+	unsigned int		uiI = 0;
+	unsigned long long	ullSum1 = 0;
+	unsigned long long	ullSum2 = 0;
+	unsigned long long	ullSum3 = 0;
+	unsigned long long	ullSum4 = 0;
+
+	struct timespec		tsStartTimeSpec;
+	struct timespec		tsEndTimeSpec;
+	double				dNanoSeconds = 0;
+
+
+	if ( (pucData == NULL) || (ullWords == 0) || (uiRepetitions == 0) || (pdBytesPerSecond == NULL) ) {
+		return (-1);
+	}
+
+	if ( clock_gettime(CLOCK_MONOTONIC, &tsStartTimeSpec) == -1 ) {
+		return (-1);
+	}
+
+	for ( uiI = 0; uiI < uiRepetitions; uiI++ ) {
+
+		UTL_BENCHMARK_LAUNDER(pullData);
+
+		for ( ullI = 0; ullI < ullWords; ullI += 4 ) {
+			ullSum1 += pullData[ullI];
+			ullSum2 += pullData[ullI + 1];
+			ullSum3 += pullData[ullI + 2];
+			ullSum4 += pullData[ullI + 3];
+		}
+	}
+
+	if ( clock_gettime(CLOCK_MONOTONIC, &tsEndTimeSpec) == -1 ) {
+		return (-1);
+	}
+
+	ullSum1 += ullSum2 + ullSum3 + ullSum4;
+	UTL_BENCHMARK_LAUNDER(ullSum1);
+
+	dNanoSeconds = ((double)(tsEndTimeSpec.tv_sec - tsStartTimeSpec.tv_sec) * 1000000000) + (double)(tsEndTimeSpec.tv_nsec - tsStartTimeSpec.tv_nsec);
+
+	*pdBytesPerSecond = ((double)(ullWords * sizeof(unsigned long long)) * uiRepetitions * 1000000000) / dNanoSeconds;
+
+	return (0);
+
+}
+
+
+/*
+
+	Function:	iUtlBenchmarkCopyBandwidth()
+
+	Purpose:	Measures the bandwidth of memcpy() copying the first half of a
+				buffer to the second half, counting the bytes read and the
+				bytes written.
+
+	Parameters:	pucData				data
+				ullDataLength		data length
+				uiRepetitions		number of copies
+				pdBytesPerSecond	return pointer for the bandwidth
+
+	Global Variables:	none
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkCopyBandwidth
+(
+	unsigned char *pucData,
+	unsigned long long ullDataLength,
+	unsigned int uiRepetitions,
+	double *pdBytesPerSecond
+)
+{
+
+	unsigned long long	ullCopyLength = ullDataLength / 2;
+	unsigned int		uiI = 0;
+
+	struct timespec		tsStartTimeSpec;
+	struct timespec		tsEndTimeSpec;
+	double				dNanoSeconds = 0;
+
+
+	if ( (pucData == NULL) || (ullCopyLength == 0) || (uiRepetitions == 0) || (pdBytesPerSecond == NULL) ) {
+		return (-1);
+	}
+
+	if ( clock_gettime(CLOCK_MONOTONIC, &tsStartTimeSpec) == -1 ) {
+		return (-1);
+	}
+
+	for ( uiI = 0; uiI < uiRepetitions; uiI++ ) {
+		UTL_BENCHMARK_LAUNDER(pucData);
+		memcpy(pucData + ullCopyLength, pucData, ullCopyLength);
+	}
+
+	if ( clock_gettime(CLOCK_MONOTONIC, &tsEndTimeSpec) == -1 ) {
+		return (-1);
+	}
+
+	dNanoSeconds = ((double)(tsEndTimeSpec.tv_sec - tsStartTimeSpec.tv_sec) * 1000000000) + (double)(tsEndTimeSpec.tv_nsec - tsStartTimeSpec.tv_nsec);
+
+	*pdBytesPerSecond = ((double)ullCopyLength * 2 * uiRepetitions * 1000000000) / dNanoSeconds;
+
+	return (0);
+
+}
+
+
+/*
+
+	Function:	iUtlBenchmarkPrintRoofline()
+
+	Purpose:	Prints a decode against the read bandwidth of the buffer it
+				was decoded from, measured here on the same buffer, and the
+				integers decoded per cycle. A decode close to the read
+				bandwidth is bound by the memory, one well short of it is
+				bound by the decoding.
+
+	Parameters:	pucData				data decoded
+				ullDataLength		data length
+				uiRepetitions		number of times the data was decoded
+				ullIntegers			number of integers decoded
+				dMicroSeconds		decode time
+				dHertz				processor frequency, 0 if not known
+
+	Global Variables:	none
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkPrintRoofline
+(
+	unsigned char *pucData,
+	unsigned long long ullDataLength,
+	unsigned int uiRepetitions,
+	unsigned long long ullIntegers,
+	double dMicroSeconds,
+	double dHertz
+)
+{
+
+	double			dBytesPerSecond = 0;
+	double			dReadBytesPerSecond = 0;
+	unsigned char	pucNumberString[UTL_BENCHMARK_STRING_LENGTH];
+	unsigned char	pucString[UTL_BENCHMARK_STRING_LENGTH];
+
+
+	if ( (pucData == NULL) || (dMicroSeconds <= 0) ) {
+		return (-1);
+	}
+
+	dBytesPerSecond = ((double)ullDataLength * uiRepetitions * 1000000) / dMicroSeconds;
+
+	snprintf(pucNumberString, UTL_BENCHMARK_STRING_LENGTH, "%.0f", dBytesPerSecond / 1000000);
+	printf("\tDecode bandwidth (MB/second) : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, UTL_BENCHMARK_STRING_LENGTH));
+
+	if ( iUtlBenchmarkReadBandwidth(pucData, ullDataLength, uiRepetitions, &dReadBytesPerSecond) == 0 ) {
+		snprintf(pucNumberString, UTL_BENCHMARK_STRING_LENGTH, "%.0f", dReadBytesPerSecond / 1000000);
+		printf("\tRead bandwidth (MB/second) : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, UTL_BENCHMARK_STRING_LENGTH));
+		printf("\tFraction of read bandwidth : %.2f, %s bound\n", dBytesPerSecond / dReadBytesPerSecond,
+				((dBytesPerSecond / dReadBytesPerSecond) >= UTL_BENCHMARK_BANDWIDTH_BOUND) ? "bandwidth" : "compute");
+	}
+
+	if ( dHertz > 0 ) {
+		printf("\tIntegers/cycle : %.2f\n", ((double)ullIntegers * 1000000) / (dMicroSeconds * dHertz));
+	}
+	else {
+		printf("\tIntegers/cycle : not available\n");
+	}
+
+	return (0);
+
+}
+
+#endif	/* defined(ROOFLINE) */
+
+
+#if defined(RECORD_RESULTS)
+
+/*
+
+	Function:	iUtlBenchmarkRecord()
+
+	Purpose:	Records a benchmark result for the regression check.
+
+	Parameters:	pucCodec			codec
+				pucDistribution		distribution of the integers
+				pucOperation		operation
+				dPerSecond			integers (or lookups) per second
+
+	Global Variables:	pubrUtlBenchmarkResultsGlobal, uiUtlBenchmarkResultsLengthGlobal
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkRecord
+(
+	unsigned char *pucCodec,
+	unsigned char *pucDistribution,
+	unsigned char *pucOperation,
+	double dPerSecond
+)
+{
+
+	struct utlBenchmarkResult	*pubrResult = NULL;
+
+
+	if ( (pucCodec == NULL) || (pucDistribution == NULL) || (pucOperation == NULL) ) {
+		return (-1);
+	}
+
+	if ( uiUtlBenchmarkResultsLengthGlobal >= UTL_BENCHMARK_RESULTS_MAX ) {
+		return (-1);
+	}
+
+	pubrResult = pubrUtlBenchmarkResultsGlobal + uiUtlBenchmarkResultsLengthGlobal;
+
+	snprintf(pubrResult->pucCodec, UTL_BENCHMARK_NAME_LENGTH, "%s", pucCodec);
+	snprintf(pubrResult->pucDistribution, UTL_BENCHMARK_NAME_LENGTH, "%s", pucDistribution);
+	snprintf(pubrResult->pucOperation, UTL_BENCHMARK_NAME_LENGTH, "%s", pucOperation);
+	pubrResult->dPerSecond = dPerSecond;
+
+	uiUtlBenchmarkResultsLengthGlobal++;
+
+	return (0);
+
+}
+
+#endif	/* defined(RECORD_RESULTS) */
+
+
+/*
+
+	Function:	iUtlBenchmarkWriteResults()
+
+	Purpose:	Appends the recorded benchmark results to a results file, one
+				tab separated codec, distribution, operation and rate per
+				line, so runs appended to the same file make up a baseline.
+
+	Parameters:	pucFilePath		results file path
+
+	Global Variables:	pubrUtlBenchmarkResultsGlobal, uiUtlBenchmarkResultsLengthGlobal
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkWriteResults
+(
+	unsigned char *pucFilePath
+)
+{
+
+	FILE			*pfFile = NULL;
+	unsigned int	uiI = 0;
+
+
+	if ( pucFilePath == NULL ) {
+		return (-1);
+	}
+
+	if ( (pfFile = fopen(pucFilePath, "a")) == NULL ) {
+		return (-1);
+	}
+
+	for ( uiI = 0; uiI < uiUtlBenchmarkResultsLengthGlobal; uiI++ ) {
+		fprintf(pfFile, "%s\t%s\t%s\t%.0f\n", pubrUtlBenchmarkResultsGlobal[uiI].pucCodec, pubrUtlBenchmarkResultsGlobal[uiI].pucDistribution,
+				pubrUtlBenchmarkResultsGlobal[uiI].pucOperation, pubrUtlBenchmarkResultsGlobal[uiI].dPerSecond);
+	}
+
+	return ((fclose(pfFile) == 0) ? 0 : -1);
+
+}
+
+
+/*
+
+	Function:	iUtlBenchmarkCheckResults()
+
+	Purpose:	Checks the recorded benchmark results against a baseline
+				written by iUtlBenchmarkWriteResults(), printing a report.
+
+				Each result is compared with the median of its baseline runs,
+				it has regressed if it is slower by more than the threshold,
+				the threshold is the larger of the minimum threshold and a
+				multiple of the noise, the noise being the larger of the
+				spread of the baseline runs and the spread measured now.
+
+	Parameters:	pucFilePath			baseline file path
+				dThreshold			minimum threshold
+				dNoiseMultiple		multiple of the noise
+				dNoise				noise measured now, 0 if not known
+				puiRegressions		return pointer for the number of regressions
+
+	Global Variables:	pubrUtlBenchmarkResultsGlobal, uiUtlBenchmarkResultsLengthGlobal
+
+	Returns:	0 on success, -1 on error
+
+*/
+static int iUtlBenchmarkCheckResults
+(
+	unsigned char *pucFilePath,
+	double dThreshold,
+	double dNoiseMultiple,
+	double dNoise,
+	unsigned int *puiRegressions
+)
+{
+
+	struct utlBenchmarkResult	*pubrBaseline = NULL;
+	unsigned int				uiBaselineLength = 0;
+	struct utlBenchmarkResult	*pubrResult = NULL;
+	FILE						*pfFile = NULL;
+	unsigned char				pucLine[(UTL_BENCHMARK_NAME_LENGTH * 3) + 64];
+	unsigned char				*pucCodec = NULL;
+	unsigned char				*pucDistribution = NULL;
+	unsigned char				*pucOperation = NULL;
+	unsigned char				*pucPerSecond = NULL;
+	unsigned char				*pucStrtokPtr = NULL;
+
+	double						pdSamples[UTL_BENCHMARK_RESULTS_MAX];
+	unsigned int				uiSamplesLength = 0;
+	double						dSample = 0;
+	double						dMedian = 0;
+	double						dSpread = 0;
+	double						dChange = 0;
+	double						dResultThreshold = 0;
+	unsigned int				uiI = 0;
+	unsigned int				uiJ = 0;
+	unsigned int				uiK = 0;
+
+
+	if ( (pucFilePath == NULL) || (puiRegressions == NULL) ) {
+		return (-1);
+	}
+
+	*puiRegressions = 0;
+
+	if ( (pubrBaseline = malloc(UTL_BENCHMARK_RESULTS_MAX * sizeof(struct utlBenchmarkResult))) == NULL ) {
+		return (-1);
+	}
+
+	if ( (pfFile = fopen(pucFilePath, "r")) == NULL ) {
+		free(pubrBaseline);
+		return (-1);
+	}
+
+	/* Read the baseline, skipping malformed lines */
+	while ( (uiBaselineLength < UTL_BENCHMARK_RESULTS_MAX) && (fgets(pucLine, sizeof(pucLine), pfFile) != NULL) ) {
+
+		if ( ((pucCodec = strtok_r(pucLine, "\t\n", (char **)&pucStrtokPtr)) == NULL) ||
+				((pucDistribution = strtok_r(NULL, "\t\n", (char **)&pucStrtokPtr)) == NULL) ||
+				((pucOperation = strtok_r(NULL, "\t\n", (char **)&pucStrtokPtr)) == NULL) ||
+				((pucPerSecond = strtok_r(NULL, "\t\n", (char **)&pucStrtokPtr)) == NULL) ) {
+			continue;
+		}
+
+		snprintf(pubrBaseline[uiBaselineLength].pucCodec, UTL_BENCHMARK_NAME_LENGTH, "%s", pucCodec);
+		snprintf(pubrBaseline[uiBaselineLength].pucDistribution, UTL_BENCHMARK_NAME_LENGTH, "%s", pucDistribution);
+		snprintf(pubrBaseline[uiBaselineLength].pucOperation, UTL_BENCHMARK_NAME_LENGTH, "%s", pucOperation);
+		pubrBaseline[uiBaselineLength].dPerSecond = strtod(pucPerSecond, NULL);
+		uiBaselineLength++;
+	}
+
+	fclose(pfFile);
+
+
+	printf("Regression check against: %s\n", pucFilePath);
+
+	for ( uiI = 0; uiI < uiUtlBenchmarkResultsLengthGlobal; uiI++ ) {
+
+		pubrResult = pubrUtlBenchmarkResultsGlobal + uiI;
+
+		/* Gather the baseline runs of this result, sorted by insertion */
+		for ( uiJ = 0, uiSamplesLength = 0; uiJ < uiBaselineLength; uiJ++ ) {
+
+			if ( (strcmp(pubrBaseline[uiJ].pucCodec, pubrResult->pucCodec) != 0) ||
+					(strcmp(pubrBaseline[uiJ].pucDistribution, pubrResult->pucDistribution) != 0) ||
+					(strcmp(pubrBaseline[uiJ].pucOperation, pubrResult->pucOperation) != 0) ) {
+				continue;
+			}
+
+			dSample = pubrBaseline[uiJ].dPerSecond;
+			for ( uiK = uiSamplesLength; (uiK > 0) && (pdSamples[uiK - 1] > dSample); uiK-- ) {
+				pdSamples[uiK] = pdSamples[uiK - 1];
+			}
+			pdSamples[uiK] = dSample;
+			uiSamplesLength++;
+		}
+
+		printf("\t%s, %s, %s : ", pubrResult->pucCodec, pubrResult->pucDistribution, pubrResult->pucOperation);
+
+		if ( uiSamplesLength == 0 ) {
+			printf("no baseline\n");
+			continue;
+		}
+
+		dMedian = ((uiSamplesLength % 2) == 1) ? pdSamples[uiSamplesLength / 2] :
+				(pdSamples[(uiSamplesLength / 2) - 1] + pdSamples[uiSamplesLength / 2]) / 2;
+
+		if ( dMedian <= 0 ) {
+			printf("no baseline\n");
+			continue;
+		}
+
+		dSpread = (pdSamples[uiSamplesLength - 1] - pdSamples[0]) / dMedian;
+		dSpread = (dNoise > dSpread) ? dNoise : dSpread;
+		dResultThreshold = ((dSpread * dNoiseMultiple) > dThreshold) ? (dSpread * dNoiseMultiple) : dThreshold;
+		dChange = (pubrResult->dPerSecond / dMedian) - 1;
+
+		printf("%+.1f%% (baseline runs: %u, threshold: %.1f%%)%s\n", dChange * 100, uiSamplesLength, dResultThreshold * 100,
+				(dChange < -dResultThreshold) ? ", REGRESSED" : "");
+
+		if ( dChange < -dResultThreshold ) {
+			(*puiRegressions)++;
+		}
+	}
+
+	printf("Regressions: %u\n\n", *puiRegressions);
+
+	free(pubrBaseline);
+
+	return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*{
+
+	Function:	main()
+
+	Purpose:	Main.
+
+	Called by:	main()
+
+	Parameters:	void
+
+	Global Variables:	none
+
+	Returns:	int
+
+}*/
+int main
+(
+	int argc,
+	char *argv[]
+)
+{
+
+#if defined(FREQUENCY_CHECK) || defined(ROOFLINE)
+	double			dHertz = 0;
+#endif	/* defined(FREQUENCY_CHECK) || defined(ROOFLINE) */
+	double			dNoise = 0;
+	unsigned char	*pucResultsFilePath = NULL;
+	unsigned char	*pucBaselineFilePath = NULL;
+	unsigned int	uiRegressions = 0;
+	int				iOption = 0;
+
+
+	while ( (iOption = getopt(argc, argv, "o:c:")) != -1 ) {
+		switch ( iOption ) {
+			case 'o':
+				pucResultsFilePath = (unsigned char *)optarg;
+				break;
+			case 'c':
+				pucBaselineFilePath = (unsigned char *)optarg;
+				break;
+			default:
+				printf("Usage: %s [-o results file] [-c baseline file]\n", argv[0]);
+				exit (-1);
+		}
+	}
+
+
+	printf("\n");
+
+
+#if defined(BENCHMARK_CPU)
+	/* Pin to a processor so the timings are not spread across processors */
+	if ( iUtlBenchmarkPinThread(BENCHMARK_CPU) == -1 ) {
+		printf("Failed to pin to processor %d, running unpinned.\n\n", BENCHMARK_CPU);
+	}
+#endif	/* defined(BENCHMARK_CPU) */
+
+
+#if defined(FREQUENCY_CHECK)
+	/* Check that the processor frequency is stable, frequency scaling and turbo make the timings drift */
+	{
+
+		double			dSpread = 0;
+		unsigned char	pucGovernor[STRING_LENGTH];
+
+
+		if ( iUtlBenchmarkCheckFrequency(&dSpread, &dHertz) == 0 ) {
+			printf("Frequency check spread: %.1f%%%s\n", dSpread * 100, (dSpread > FREQUENCY_SPREAD_MAX) ? ", the frequency is not stable, timings will vary" : "");
+			printf("Frequency (MHz): %.0f\n", dHertz / 1000000);
+			dNoise = dSpread;
+		}
+
+#if defined(BENCHMARK_CPU)
+		if ( (iUtlBenchmarkGetGovernor(BENCHMARK_CPU, pucGovernor, STRING_LENGTH) == 0) && (strcmp(pucGovernor, "performance") != 0) ) {
+#else
+		if ( (iUtlBenchmarkGetGovernor(0, pucGovernor, STRING_LENGTH) == 0) && (strcmp(pucGovernor, "performance") != 0) ) {
+#endif	/* defined(BENCHMARK_CPU) */
+			printf("Frequency scaling governor: %s, use performance for stable timings\n", pucGovernor);
+		}
+
+		printf("\n");
+
+	}
+#endif	/* defined(FREQUENCY_CHECK) */
+
+
+#if defined(ROOFLINE)
+	/* Measuring the read and memcpy() bandwidth from the L1 cache to well beyond the last level cache */
+	{
+
+		unsigned char		*pucData = NULL;
+
+		unsigned long long	pullLengths[4];
+		unsigned char		*ppucLengthNames[4] = {"L1", "L2", "LLC", "10x LLC"};
+		long				lCacheSize = 0;
+
+		unsigned int		uiRepetitions = 0;
+		unsigned int		uiL = 0;
+		double				dReadBytesPerSecond = 0;
+		double				dCopyBytesPerSecond = 0;
+
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		/* Size the buffers from the caches, half of each so they are not evicted by everything else */
+		pullLengths[0] = (((lCacheSize = sysconf(_SC_LEVEL1_DCACHE_SIZE)) > 0) ? lCacheSize : (32 * 1024)) / 2;
+		pullLengths[1] = (((lCacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE)) > 0) ? lCacheSize : (1024 * 1024)) / 2;
+		pullLengths[2] = (((lCacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE)) > 0) ? lCacheSize : (8 * 1024 * 1024)) / 2;
+		pullLengths[3] = pullLengths[2] * 20;
+
+		if ( (pucData = malloc(pullLengths[3])) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		/* Fault in the pages */
+		memset(pucData, 1, pullLengths[3]);
+
+		for ( uiL = 0; uiL < (sizeof(pullLengths) / sizeof(unsigned long long)); uiL++ ) {
+
+			uiRepetitions = (pullLengths[uiL] < ROOFLINE_BYTES) ? (ROOFLINE_BYTES / pullLengths[uiL]) : 1;
+
+			if ( (iUtlBenchmarkReadBandwidth(pucData, pullLengths[uiL], uiRepetitions, &dReadBytesPerSecond) != 0) ||
+					(iUtlBenchmarkCopyBandwidth(pucData, pullLengths[uiL], uiRepetitions, &dCopyBytesPerSecond) != 0) ) {
+				printf("Failed to measure the bandwidth\n");
+				exit (-1);
+			}
+
+			snprintf(pucNumberString, STRING_LENGTH, "%llu", pullLengths[uiL]);
+			printf("Bandwidth, buffer: %s (%s bytes)\n", ppucLengthNames[uiL], pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", dReadBytesPerSecond / 1000000);
+			printf("\tRead (MB/second) : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", dCopyBytesPerSecond / 1000000);
+			printf("\tmemcpy() (MB/second) : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			if ( dHertz > 0 ) {
+				printf("\tRead bytes/cycle : %.1f\n", dReadBytesPerSecond / dHertz);
+			}
+
+			printf("\n");
+		}
+
+		printf("\n");
+
+		free(pucData);
+
+	}
+#endif	/* defined(ROOFLINE) */
+
+
+#if defined(COMPRESSED_UINT_IN_PLACE)
+	/* Testing compressed uint in place */
+	{
+	
+		unsigned char		pucData[DATA_LENGTH];
+		unsigned char		*pucDataPtr = NULL;
+	
+		unsigned int		uiValueWritten1 = NUMBER_1;
+		unsigned int		uiValueWritten2 = NUMBER_2;
+		unsigned int		uiValueWritten3 = NUMBER_3;
+		unsigned int		uiValueWritten4 = NUMBER_4;
+		unsigned int		uiValueRead1 = 0;
+		unsigned int		uiValueRead2 = 0;
+		unsigned int		uiValueRead3 = 0;
+		unsigned int		uiValueRead4 = 0;
+	
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+	
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullChecksum = 0;
+		unsigned long long	ullExpectedChecksum = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+	
+		
+		memset(pucData, DATA_LENGTH, 0);
+	
+		pucDataPtr = pucData;
+		NUM_WRITE_COMPRESSED_UINT(uiValueWritten1, pucDataPtr);
+		NUM_WRITE_COMPRESSED_UINT(uiValueWritten2, pucDataPtr);
+		NUM_WRITE_COMPRESSED_UINT(uiValueWritten3, pucDataPtr);
+		NUM_WRITE_COMPRESSED_UINT(uiValueWritten4, pucDataPtr);
+	
+	
+		/* Warm up, checking the integers read */
+		for ( uiI = 0; uiI < WARM_UP_REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, ullExpectedChecksum = 0; uiJ < ITERATIONS; uiJ++ ) {
+
+				pucDataPtr = pucData;
+				UTL_BENCHMARK_LAUNDER(pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead1, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead2, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead3, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead4, pucDataPtr);
+
+#if defined(CHECK_READ)
+				if ( uiValueRead1 != uiValueWritten1 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+					exit (-1);
+				}
+
+				if ( uiValueRead2 != uiValueWritten2 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+					exit (-1);
+				}
+
+				if ( uiValueRead3 != uiValueWritten3 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+					exit (-1);
+				}
+
+				if ( uiValueRead4 != uiValueWritten4 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+					exit (-1);
+				}
+#endif	/* defined(CHECK_READ) */
+
+				ullExpectedChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		/* Sum the integers read into a checksum so the reads are not optimized away */
+		for ( uiI = 0, ullTotalIterations = 0, ullChecksum = 0; uiI < REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+
+				pucDataPtr = pucData;
+				UTL_BENCHMARK_LAUNDER(pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead1, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead2, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead3, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead4, pucDataPtr);
+				ullChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum);
+	
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+		printf("Reading compressed uint in place, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("compressed uint", "mixed widths", "read in place", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+	
+		printf("\n\n");
+	
+	}
+#endif	/* defined(COMPRESSED_UINT_IN_PLACE) */
+
+
+
+#if defined(VARINT_IN_PLACE)
+	/* Testing varint in place */
+	{
+	
+		unsigned char		pucData[DATA_LENGTH];
+		unsigned char		*pucDataPtr = NULL;
+	
+		unsigned int		uiValueWritten1 = NUMBER_1;
+		unsigned int		uiValueWritten2 = NUMBER_2;
+		unsigned int		uiValueWritten3 = NUMBER_3;
+		unsigned int		uiValueWritten4 = NUMBER_4;
+		unsigned int		uiValueRead1 = 0;
+		unsigned int		uiValueRead2 = 0;
+		unsigned int		uiValueRead3 = 0;
+		unsigned int		uiValueRead4 = 0;
+		
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+	
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullChecksum = 0;
+		unsigned long long	ullExpectedChecksum = 0;
+	
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+		
+		memset(pucData, DATA_LENGTH, 0);
+	
+		pucDataPtr = pucData;
+		NUM_WRITE_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+	
+		/* Warm up, checking the integers read */
+		for ( uiI = 0; uiI < WARM_UP_REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, ullExpectedChecksum = 0; uiJ < ITERATIONS; uiJ++ ) {
+
+				pucDataPtr = pucData;
+				UTL_BENCHMARK_LAUNDER(pucDataPtr);
+				NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+#if defined(CHECK_READ)
+				if ( uiValueRead1 != uiValueWritten1 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+					exit (-1);
+				}
+
+				if ( uiValueRead2 != uiValueWritten2 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+					exit (-1);
+				}
+
+				if ( uiValueRead3 != uiValueWritten3 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+					exit (-1);
+				}
+
+				if ( uiValueRead4 != uiValueWritten4 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+					exit (-1);
+				}
+#endif	/* defined(CHECK_READ) */
+
+				ullExpectedChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		/* Sum the integers read into a checksum so the reads are not optimized away */
+		for ( uiI = 0, ullTotalIterations = 0, ullChecksum = 0; uiI < REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+
+				pucDataPtr = pucData;
+				UTL_BENCHMARK_LAUNDER(pucDataPtr);
+				NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+				ullChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum);
+	
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+		printf("Reading varint quad in place, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("varint", "mixed widths", "read in place", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+	
+		printf("\n\n");
+
+	}
+#endif	/* defined(VARINT_IN_PLACE) */
+
+
+
+#if defined(COMPACT_VARINT_IN_PLACE)
+	/* Testing compact varint in place */
+	{
+	
+		unsigned char		pucData[DATA_LENGTH];
+		unsigned char		*pucDataPtr = NULL;
+	
+		unsigned int		uiValueWritten1 = NUMBER_1;
+		unsigned int		uiValueWritten2 = NUMBER_2;
+		unsigned int		uiValueWritten3 = NUMBER_3;
+		unsigned int		uiValueWritten4 = NUMBER_4;
+		unsigned int		uiValueRead1 = 0;
+		unsigned int		uiValueRead2 = 0;
+		unsigned int		uiValueRead3 = 0;
+		unsigned int		uiValueRead4 = 0;
+		
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+	
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullChecksum = 0;
+		unsigned long long	ullExpectedChecksum = 0;
+	
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+		
+		memset(pucData, DATA_LENGTH, 0);
+	
+		pucDataPtr = pucData;
+		NUM_WRITE_COMPACT_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+	
+		/* Warm up, checking the integers read */
+		for ( uiI = 0; uiI < WARM_UP_REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, ullExpectedChecksum = 0; uiJ < ITERATIONS; uiJ++ ) {
+
+				pucDataPtr = pucData;
+				UTL_BENCHMARK_LAUNDER(pucDataPtr);
+				NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+#if defined(CHECK_READ)
+				if ( uiValueRead1 != uiValueWritten1 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+					exit (-1);
+				}
+
+				if ( uiValueRead2 != uiValueWritten2 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+					exit (-1);
+				}
+
+				if ( uiValueRead3 != uiValueWritten3 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+					exit (-1);
+				}
+
+				if ( uiValueRead4 != uiValueWritten4 ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+					exit (-1);
+				}
+#endif	/* defined(CHECK_READ) */
+
+				ullExpectedChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		/* Sum the integers read into a checksum so the reads are not optimized away */
+		for ( uiI = 0, ullTotalIterations = 0, ullChecksum = 0; uiI < REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+
+				pucDataPtr = pucData;
+				UTL_BENCHMARK_LAUNDER(pucDataPtr);
+				NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+				ullChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum);
+	
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+		printf("Reading compact varint quad in place, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("compact varint", "mixed widths", "read in place", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+	
+		printf("\n\n");
+
+	}
+#endif	/* defined(COMPACT_VARINT_IN_PLACE) */
+
+
+
+#if defined(COMPRESSED_UINT_ACROSS_MEMORY)
+	/* Testing compressed uint across memory */
+	{
+	
+	
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+#if defined(ARENA_ALLOCATION)
+		void				*pvNumArena = NULL;
+#endif	/* defined(ARENA_ALLOCATION) */
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullChecksum = 0;
+		unsigned long long	ullExpectedChecksum = 0;
+	
+		unsigned int		uiValueWritten1 = NUMBER_1;
+		unsigned int		uiValueWritten2 = NUMBER_2;
+		unsigned int		uiValueWritten3 = NUMBER_3;
+		unsigned int		uiValueWritten4 = NUMBER_4;
+
+		unsigned int		uiValueRead1 = 0;
+		unsigned int		uiValueRead2 = 0;
+		unsigned int		uiValueRead3 = 0;
+		unsigned int		uiValueRead4 = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+#if defined(ARENA_ALLOCATION)
+		if ( (iNumArenaCreate(0, NUM_ARENA_FLAG_HUGE_PAGES | NUM_ARENA_FLAG_PREFAULT, &pvNumArena) != NUM_NoError) ||
+				(iNumArenaAllocate(pvNumArena, uiDataLength, (void **)&pucData) != NUM_NoError) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+#else
+		if ( (pucData = malloc(uiDataLength)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+		
+		memset(pucData, 0, uiDataLength);
+#endif	/* defined(ARENA_ALLOCATION) */
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
+	
+			uiValueWritten1 = uiI;
+			uiValueWritten2 = uiValueWritten1 + 1;
+			uiValueWritten3 = uiValueWritten2 + 1;
+			uiValueWritten4 = uiValueWritten3 + 1;
+
+			NUM_WRITE_COMPRESSED_UINT(uiValueWritten1, pucDataPtr);
+			NUM_WRITE_COMPRESSED_UINT(uiValueWritten2, pucDataPtr);
+			NUM_WRITE_COMPRESSED_UINT(uiValueWritten3, pucDataPtr);
+			NUM_WRITE_COMPRESSED_UINT(uiValueWritten4, pucDataPtr);
+		
+		}
+	
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ITERATIONS * 4));
+		printf("Writing compressed uint across memory, numbers written: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("compressed uint", "sequential", "write across memory", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%u", uiDataLength);
+		printf("\tBytes, allocated: %s", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		snprintf(pucNumberString, STRING_LENGTH, "%ld", pucDataPtr - pucData);
+		printf(", used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		printf("\n");
+		
+
+		/* Warm up, checking the integers read */
+		for ( uiI = 0; uiI < WARM_UP_REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, pucDataPtr = pucData, ullExpectedChecksum = 0; uiJ < ITERATIONS; uiJ++ ) {
+
+				NUM_READ_COMPRESSED_UINT(uiValueRead1, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead2, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead3, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead4, pucDataPtr);
+
+#if defined(CHECK_READ)
+				if ( uiValueRead1 != uiJ ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiJ);
+					exit (-1);
+				}
+
+				if ( uiValueRead2 != (uiJ + 1) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiJ + 1);
+					exit (-1);
+				}
+
+				if ( uiValueRead3 != (uiJ + 2) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiJ + 2);
+					exit (-1);
+				}
+
+				if ( uiValueRead4 != (uiJ + 3) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiJ + 3);
+					exit (-1);
+				}
+#endif	/* defined(CHECK_READ) */
+
+				ullExpectedChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		/* Sum the integers read into a checksum so the reads are not optimized away */
+		for ( uiI = 0, ullTotalIterations = 0, ullChecksum = 0; uiI < REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+
+				NUM_READ_COMPRESSED_UINT(uiValueRead1, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead2, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead3, pucDataPtr);
+				NUM_READ_COMPRESSED_UINT(uiValueRead4, pucDataPtr);
+				ullChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum);
+	
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+		printf("Reading compressed uint across memory, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("compressed uint", "sequential", "read across memory", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+	
+#if defined(ROOFLINE)
+		iUtlBenchmarkPrintRoofline(pucData, pucDataPtr - pucData, REPETITIONS, ullTotalIterations * 4, dMicroSeconds, dHertz);
+#endif	/* defined(ROOFLINE) */
+
+		printf("\n\n");
+
+	}
+#endif	/* defined(COMPRESSED_UINT_IN_PLACE) */
+
+
+
+#if defined(VARINT_ACROSS_MEMORY)
+	/* Testing varint across memory */
+	{
+	
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+#if defined(ARENA_ALLOCATION)
+		void				*pvNumArena = NULL;
+#endif	/* defined(ARENA_ALLOCATION) */
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullChecksum = 0;
+		unsigned long long	ullExpectedChecksum = 0;
+	
+		unsigned int		uiValueWritten1 = NUMBER_1;
+		unsigned int		uiValueWritten2 = NUMBER_2;
+		unsigned int		uiValueWritten3 = NUMBER_3;
+		unsigned int		uiValueWritten4 = NUMBER_4;
+
+		unsigned int		uiValueRead1 = 0;
+		unsigned int		uiValueRead2 = 0;
+		unsigned int		uiValueRead3 = 0;
+		unsigned int		uiValueRead4 = 0;
+
+		unsigned int		uiValueRead = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+#if defined(ARENA_ALLOCATION)
+		if ( (iNumArenaCreate(0, NUM_ARENA_FLAG_HUGE_PAGES | NUM_ARENA_FLAG_PREFAULT, &pvNumArena) != NUM_NoError) ||
+				(iNumArenaAllocate(pvNumArena, uiDataLength, (void **)&pucData) != NUM_NoError) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+#else
+		if ( (pucData = malloc(uiDataLength)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		memset(pucData, 0, uiDataLength);
+#endif	/* defined(ARENA_ALLOCATION) */
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
+	
+			uiValueWritten1 = uiI;
+			uiValueWritten2 = uiValueWritten1 + 1;
+			uiValueWritten3 = uiValueWritten2 + 1;
+			uiValueWritten4 = uiValueWritten3 + 1;
+
+			NUM_WRITE_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+
+		}
+	
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ITERATIONS * 4));
+		printf("Writing varint across memory, numbers written: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("varint", "sequential", "write across memory", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%u", uiDataLength);
+		printf("\tBytes, allocated: %s", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		snprintf(pucNumberString, STRING_LENGTH, "%ld", pucDataPtr - pucData);
+		printf(", used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		printf("\n");
+
+
+		/* Warm up, checking the integers read */
+		for ( uiI = 0; uiI < WARM_UP_REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, pucDataPtr = pucData, ullExpectedChecksum = 0; uiJ < ITERATIONS; uiJ++ ) {
+
+				NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+#if defined(CHECK_READ)
+				if ( uiValueRead1 != uiJ ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiJ);
+					exit (-1);
+				}
+
+				if ( uiValueRead2 != (uiJ + 1) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiJ + 1);
+					exit (-1);
+				}
+
+				if ( uiValueRead3 != (uiJ + 2) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiJ + 2);
+					exit (-1);
+				}
+
+				if ( uiValueRead4 != (uiJ + 3) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiJ + 3);
+					exit (-1);
+				}
+#endif	/* defined(CHECK_READ) */
+
+				ullExpectedChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		/* Sum the integers read into a checksum so the reads are not optimized away */
+		for ( uiI = 0, ullTotalIterations = 0, ullChecksum = 0; uiI < REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+
+				NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+				ullChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum);
+
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+		printf("Reading varint across memory, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("varint", "sequential", "read across memory", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+	
+#if defined(ROOFLINE)
+		iUtlBenchmarkPrintRoofline(pucData, pucDataPtr - pucData, REPETITIONS, ullTotalIterations * 4, dMicroSeconds, dHertz);
+#endif	/* defined(ROOFLINE) */
+
+		printf("\n\n");
+	
+	}
+#endif	/* defined(VARINT_ACROSS_MEMORY) */
+
+
+
+#if defined(COMPACT_VARINT_ACROSS_MEMORY)
+	/* Testing compact varint across memory */
+	{
+	
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+#if defined(ARENA_ALLOCATION)
+		void				*pvNumArena = NULL;
+#endif	/* defined(ARENA_ALLOCATION) */
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullChecksum = 0;
+		unsigned long long	ullExpectedChecksum = 0;
+	
+		unsigned int		uiValueWritten1 = NUMBER_1;
+		unsigned int		uiValueWritten2 = NUMBER_2;
+		unsigned int		uiValueWritten3 = NUMBER_3;
+		unsigned int		uiValueWritten4 = NUMBER_4;
+
+		unsigned int		uiValueRead1 = 0;
+		unsigned int		uiValueRead2 = 0;
+		unsigned int		uiValueRead3 = 0;
+		unsigned int		uiValueRead4 = 0;
+
+		unsigned int		uiValueRead = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+#if defined(ARENA_ALLOCATION)
+		if ( (iNumArenaCreate(0, NUM_ARENA_FLAG_HUGE_PAGES | NUM_ARENA_FLAG_PREFAULT, &pvNumArena) != NUM_NoError) ||
+				(iNumArenaAllocate(pvNumArena, uiDataLength, (void **)&pucData) != NUM_NoError) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+#else
+		if ( (pucData = malloc(uiDataLength)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		memset(pucData, 0, uiDataLength);
+#endif	/* defined(ARENA_ALLOCATION) */
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
+	
+			uiValueWritten1 = uiI;
+			uiValueWritten2 = uiValueWritten1 + 1;
+			uiValueWritten3 = uiValueWritten2 + 1;
+			uiValueWritten4 = uiValueWritten3 + 1;
+
+			NUM_WRITE_COMPACT_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+
+		}
+	
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ITERATIONS * 4));
+		printf("Writing compact varint across memory, numbers written: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("compact varint", "sequential", "write across memory", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
+
+		snprintf(pucNumberString, STRING_LENGTH, "%u", uiDataLength);
+		printf("\tBytes, allocated: %s", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		snprintf(pucNumberString, STRING_LENGTH, "%ld", pucDataPtr - pucData);
+		printf(", used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+		printf("\n");
+
+
+		/* Warm up, checking the integers read */
+		for ( uiI = 0; uiI < WARM_UP_REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, pucDataPtr = pucData, ullExpectedChecksum = 0; uiJ < ITERATIONS; uiJ++ ) {
+
+				NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+#if defined(CHECK_READ)
+				if ( uiValueRead1 != uiJ ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiJ);
+					exit (-1);
+				}
+
+				if ( uiValueRead2 != (uiJ + 1) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiJ + 1);
+					exit (-1);
+				}
+
+				if ( uiValueRead3 != (uiJ + 2) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiJ + 2);
+					exit (-1);
+				}
+
+				if ( uiValueRead4 != (uiJ + 3) ) {
+					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiJ + 3);
+					exit (-1);
+				}
+#endif	/* defined(CHECK_READ) */
+
+				ullExpectedChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+
+		gettimeofday(&tvStartTimeVal, NULL);
+
+		/* Sum the integers read into a checksum so the reads are not optimized away */
+		for ( uiI = 0, ullTotalIterations = 0, ullChecksum = 0; uiI < REPETITIONS; uiI++ ) {
+
+			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+
+				NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+				ullChecksum += uiValueRead1 + uiValueRead2 + uiValueRead3 + uiValueRead4;
+			}
+		}
+
+		gettimeofday(&tvEndTimeVal, NULL);
+
+		UTL_BENCHMARK_CHECK_CHECKSUM(ullChecksum, ullExpectedChecksum);
+
+		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+		printf("Reading compact varint across memory, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+	
+		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+		iUtlBenchmarkRecord("compact varint", "sequential", "read across memory", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+	
+#if defined(ROOFLINE)
+		iUtlBenchmarkPrintRoofline(pucData, pucDataPtr - pucData, REPETITIONS, ullTotalIterations * 4, dMicroSeconds, dHertz);
+#endif	/* defined(ROOFLINE) */
+
+		printf("\n\n");
+	
+	}
+#endif	/* defined(COMPACT_VARINT_ACROSS_MEMORY) */
+
+
+
+#if defined(PARALLEL_ACROSS_MEMORY)
+	/* Testing parallel encoding and decoding across memory */
+	{
+
+		void				*pvNumThreadPool = NULL;
+		void				*pvNumArena = NULL;
+
+		unsigned int		*puiValues = NULL;
+		unsigned long long	ullValuesLength = (unsigned long long)ITERATIONS * 4;
+
+		unsigned char		*pucData = NULL;
+		unsigned long long	ullDataLength = 0;
+		unsigned long long	*pullChunkOffsets = NULL;
+		unsigned int		uiChunkCount = 0;
+
+		unsigned int		uiFormat = 0;
+		unsigned char		*pucFormatName = NULL;
+		unsigned int		uiI = 0;
+		unsigned long long	ullJ = 0;
+		int					iError = NUM_NoError;
+
+		unsigned long long	ullTotalIterations = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		if ( (iError = iNumThreadPoolCreate(THREAD_COUNT, &pvNumThreadPool)) != NUM_NoError ) {
+			printf("Failed to create the thread pool, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		if ( (iError = iNumArenaCreate(0, NUM_ARENA_FLAG_HUGE_PAGES | NUM_ARENA_FLAG_PREFAULT, &pvNumArena)) != NUM_NoError ) {
+			printf("Failed to create the arena, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		if ( (puiValues = malloc(ullValuesLength * sizeof(unsigned int))) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+			puiValues[(uiI * 4)] = uiI;
+			puiValues[(uiI * 4) + 1] = uiI + 1;
+			puiValues[(uiI * 4) + 2] = uiI + 2;
+			puiValues[(uiI * 4) + 3] = uiI + 3;
+		}
+
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			pucFormatName = (uiFormat == NUM_FORMAT_COMPRESSED_UINT) ? "compressed uint" : (uiFormat == NUM_FORMAT_VARINT_QUAD) ? "varint" : "compact varint";
+
+			gettimeofday(&tvStartTimeVal, NULL);
+
+			if ( (iError = iNumParallelEncode(pvNumThreadPool, pvNumArena, uiFormat, 0, 0, puiValues, ullValuesLength, &pucData, &ullDataLength, &pullChunkOffsets, &uiChunkCount)) != NUM_NoError ) {
+				printf("Failed to encode, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			gettimeofday(&tvEndTimeVal, NULL);
+
+			UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+			UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+			snprintf(pucNumberString, STRING_LENGTH, "%llu", ullValuesLength);
+			printf("Writing %s in parallel across memory, numbers written: %s\n", pucFormatName, pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+			printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)ullValuesLength * ((double)1000000 / dMicroSeconds));
+			printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+			iUtlBenchmarkRecord(pucFormatName, "sequential", "write in parallel across memory", (double)ullValuesLength * ((double)1000000 / dMicroSeconds));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%llu", ullDataLength);
+			printf("\tBytes, used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			printf("\n");
+
+
+			gettimeofday(&tvStartTimeVal, NULL);
+
+			for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++, ullTotalIterations += ullValuesLength ) {
+				if ( (iError = iNumParallelDecode(pvNumThreadPool, uiFormat, NUM_BLOCK_INTEGER_COUNT_DEFAULT * NUM_PARALLEL_CHUNK_BLOCK_COUNT_DEFAULT,
+						pucData, pullChunkOffsets, uiChunkCount, puiValues, ullValuesLength)) != NUM_NoError ) {
+					printf("Failed to decode, error: %d.\n", iError);
+					exit (-1);
+				}
+			}
+
+			gettimeofday(&tvEndTimeVal, NULL);
+
+#if defined(CHECK_READ)
+			for ( ullJ = 0; ullJ < ullValuesLength; ullJ++ ) {
+				if ( puiValues[ullJ] != ((ullJ / 4) + (ullJ % 4)) ) {
+					printf("Failed, read: %u, expected: %llu.\n", puiValues[ullJ], (ullJ / 4) + (ullJ % 4));
+					exit (-1);
+				}
+			}
+#endif	/* defined(CHECK_READ) */
+
+			UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+			UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+			snprintf(pucNumberString, STRING_LENGTH, "%llu", ullTotalIterations);
+			printf("Reading %s in parallel across memory, numbers read: %s\n", pucFormatName, pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+			printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)ullTotalIterations * ((double)1000000 / dMicroSeconds));
+			printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+			iUtlBenchmarkRecord(pucFormatName, "sequential", "read in parallel across memory", (double)ullTotalIterations * ((double)1000000 / dMicroSeconds));
+
+			printf("\n\n");
+
+			/* Released into the arena to be reused by the next format */
+			iNumArenaRelease(pvNumArena, pucData);
+			iNumArenaRelease(pvNumArena, pullChunkOffsets);
+		}
+
+		free(puiValues);
+		iNumArenaFree(pvNumArena);
+		iNumThreadPoolFree(pvNumThreadPool);
+
+	}
+#endif	/* defined(PARALLEL_ACROSS_MEMORY) */
+
+
+
+#if defined(UNROLL_ACROSS_MEMORY)
+	/* Testing the bulk quad decoders across memory by unroll factor */
+	{
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned char		*pucDataEndPtr = NULL;
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		puiValues[DATA_LENGTH * 4];
+
+		unsigned int		uiFormat = 0;
+		unsigned char		*pucFormatName = NULL;
+		unsigned int		uiUnroll = 0;
+		unsigned int		uiQuadCount = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
+
+		unsigned long long	ullTotalIterations = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( uiFormat = NUM_FORMAT_VARINT_QUAD; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			pucFormatName = (uiFormat == NUM_FORMAT_VARINT_QUAD) ? "varint" : "compact varint";
+
+			for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
+				NUM_WRITE_QUAD(uiFormat, uiI, uiI + 1, uiI + 2, uiI + 3, pucDataPtr);
+			}
+			pucDataEndPtr = pucDataPtr;
+
+			for ( uiUnroll = 1; uiUnroll <= NUM_QUAD_DECODE_UNROLL_MAX; uiUnroll++ ) {
+
+				/* Decode DATA_LENGTH quads at a time so the decoded integers stay in the cache, the warm up repetitions are not timed */
+				for ( uiI = 0, ullTotalIterations = 0; uiI < (WARM_UP_REPETITIONS + REPETITIONS); uiI++ ) {
+
+					if ( uiI == WARM_UP_REPETITIONS ) {
+						ullTotalIterations = 0;
+						gettimeofday(&tvStartTimeVal, NULL);
+					}
+
+					for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ += uiQuadCount, ullTotalIterations += uiQuadCount ) {
+
+						uiQuadCount = ((ITERATIONS - uiJ) < DATA_LENGTH) ? (ITERATIONS - uiJ) : DATA_LENGTH;
+
+						if ( (iError = iNumDecodeQuads(uiFormat, uiUnroll, pucDataPtr, uiQuadCount, puiValues, &pucDataPtr)) != NUM_NoError ) {
+							printf("Failed to decode, error: %d.\n", iError);
+							exit (-1);
+						}
+
+#if defined(CHECK_READ)
+						for ( uiK = 0; (uiI < WARM_UP_REPETITIONS) && (uiK < (uiQuadCount * 4)); uiK++ ) {
+							if ( puiValues[uiK] != (uiJ + (uiK / 4) + (uiK % 4)) ) {
+								printf("Failed, read: %u, expected: %u.\n", puiValues[uiK], uiJ + (uiK / 4) + (uiK % 4));
+								exit (-1);
+							}
+						}
+#endif	/* defined(CHECK_READ) */
+					}
+
+					if ( pucDataPtr != pucDataEndPtr ) {
+						printf("Failed, data decoded: %ld, expected: %ld.\n", pucDataPtr - pucData, pucDataEndPtr - pucData);
+						exit (-1);
+					}
+				}
+
+				gettimeofday(&tvEndTimeVal, NULL);
+
+				UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+				UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+				snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+				printf("Reading %s across memory, %u quads per iteration, numbers read: %s\n", pucFormatName, uiUnroll,
+						pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+				snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+				printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+				snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+				printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				snprintf(pucNumberString, STRING_LENGTH, "read across memory, %u quads per iteration", uiUnroll);
+				iUtlBenchmarkRecord(pucFormatName, "sequential", pucNumberString, (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+
+#if defined(ROOFLINE)
+				iUtlBenchmarkPrintRoofline(pucData, pucDataEndPtr - pucData, REPETITIONS, ullTotalIterations * 4, dMicroSeconds, dHertz);
+#endif	/* defined(ROOFLINE) */
+
+				printf("\n");
+			}
+
+			printf("\n");
+		}
+
+		free(pucData);
+
+	}
+#endif	/* defined(UNROLL_ACROSS_MEMORY) */
+
+
+#if defined(OCTET_ACROSS_MEMORY)
+	/* Testing varint quads and varint octets across memory */
+	{
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned char		*pucDataEndPtr = NULL;
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		puiValues[DATA_LENGTH * 8];
+
+		unsigned int		uiOctets = 0;
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
+
+		unsigned long long	ullTotalIterations = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( uiOctets = 0; uiOctets < 2; uiOctets++ ) {
+
+			/* The same integers as quads and as octets, ITERATIONS * 4 of them */
+			for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI += 2 ) {
+				for ( uiJ = 0; uiJ < 8; uiJ++ ) {
+					puiValues[uiJ] = uiI + uiJ;
+				}
+				if ( uiOctets == 0 ) {
+					NUM_WRITE_VARINT_QUAD(puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucDataPtr);
+					NUM_WRITE_VARINT_QUAD(puiValues[4], puiValues[5], puiValues[6], puiValues[7], pucDataPtr);
+				}
+				else {
+					NUM_WRITE_VARINT_OCTET(puiValues, pucDataPtr);
+				}
+			}
+			pucDataEndPtr = pucDataPtr;
+
+			/* Decode DATA_LENGTH octets at a time so the decoded integers stay in the cache, the warm up repetitions are not timed */
+			for ( uiI = 0, ullTotalIterations = 0; uiI < (WARM_UP_REPETITIONS + REPETITIONS); uiI++ ) {
+
+				if ( uiI == WARM_UP_REPETITIONS ) {
+					ullTotalIterations = 0;
+					gettimeofday(&tvStartTimeVal, NULL);
+				}
+
+				for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ += uiValuesLength / 4, ullTotalIterations += uiValuesLength ) {
+
+					uiValuesLength = (((ITERATIONS - uiJ) < (DATA_LENGTH * 2)) ? (ITERATIONS - uiJ) : (DATA_LENGTH * 2)) * 4;
+
+					if ( uiOctets == 0 ) {
+						iError = iNumDecodeQuads(NUM_FORMAT_VARINT_QUAD, 0, pucDataPtr, uiValuesLength / 4, puiValues, &pucDataPtr);
+					}
+					else {
+						iError = iNumDecodeVarintOctets(pucDataPtr, uiValuesLength, puiValues, &pucDataPtr);
+					}
+
+					if ( iError != NUM_NoError ) {
+						printf("Failed to decode, error: %d.\n", iError);
+						exit (-1);
+					}
+
+#if defined(CHECK_READ)
+					for ( uiK = 0; (uiI < WARM_UP_REPETITIONS) && (uiK < uiValuesLength); uiK++ ) {
+						if ( puiValues[uiK] != ((uiJ + ((uiK / 8) * 2)) + (uiK % 8)) ) {
+							printf("Failed, read: %u, expected: %u.\n", puiValues[uiK], (uiJ + ((uiK / 8) * 2)) + (uiK % 8));
+							exit (-1);
+						}
+					}
+#endif	/* defined(CHECK_READ) */
+				}
+
+				if ( pucDataPtr != pucDataEndPtr ) {
+					printf("Failed, data decoded: %ld, expected: %ld.\n", pucDataPtr - pucData, pucDataEndPtr - pucData);
+					exit (-1);
+				}
+			}
+
+			gettimeofday(&tvEndTimeVal, NULL);
+
+			UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+			UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+			snprintf(pucNumberString, STRING_LENGTH, "%llu", ullTotalIterations);
+			printf("Reading varint %s across memory, numbers read: %s\n", (uiOctets == 0) ? "quads" : "octets",
+					pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+			printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+			snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)ullTotalIterations * ((double)1000000 / dMicroSeconds));
+			printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+			iUtlBenchmarkRecord((uiOctets == 0) ? "varint" : "varint octet", "sequential", "read across memory", (double)ullTotalIterations * ((double)1000000 / dMicroSeconds));
+
+#if defined(ROOFLINE)
+			iUtlBenchmarkPrintRoofline(pucData, pucDataEndPtr - pucData, REPETITIONS, ullTotalIterations, dMicroSeconds, dHertz);
+#endif	/* defined(ROOFLINE) */
+
+			printf("\n");
+		}
+
+		printf("\n");
+
+		free(pucData);
+
+	}
+#endif	/* defined(OCTET_ACROSS_MEMORY) */
+
+
+
+#if defined(RANDOM_ACCESS)
+	/* Testing random access across buffers from the L1 cache to well beyond the last level cache */
+	{
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned long long	*pullIndex = NULL;
+		unsigned long long	ullDataLength = 0;
+
+		unsigned long long	pullLengths[5];
+		unsigned char		*ppucLengthNames[5] = {"L1", "L2", "LLC", "2x LLC", "10x LLC"};
+		long				lCacheSize = 0;
+
+		unsigned int		uiIntegerCount = 0;
+		unsigned int		uiPosition = 0;
+		unsigned int		uiSkip = 0;
+		unsigned int		uiRandom = 1;
+		unsigned int		uiRandomSeed = 0;
+		unsigned int		puiValues[4];
+		unsigned int		uiValueRead = 0;
+		unsigned long long	ullValuesSum = 0;
+
+		unsigned int		uiFormat = 0;
+		unsigned char		*pucFormatName = NULL;
+		unsigned int		uiI = 0;
+		unsigned int		uiL = 0;
+
+		int					iPerfFileDescriptor = -1;
+		unsigned long long	ullCacheMisses = 0;
+		boolean				bCacheMisses = false;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		/* Size the buffers from the caches */
+		pullLengths[0] = ((lCacheSize = sysconf(_SC_LEVEL1_DCACHE_SIZE)) > 0) ? lCacheSize : (32 * 1024);
+		pullLengths[1] = ((lCacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE)) > 0) ? lCacheSize : (1024 * 1024);
+		pullLengths[2] = ((lCacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE)) > 0) ? lCacheSize : (8 * 1024 * 1024);
+		pullLengths[3] = pullLengths[2] * 2;
+		pullLengths[4] = pullLengths[2] * 10;
+
+		/* Half the L1 cache so the index and the decoded values fit alongside */
+		pullLengths[0] /= 2;
+
+		iPerfFileDescriptor = iUtlPerfCacheMissesOpen();
+
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			pucFormatName = (uiFormat == NUM_FORMAT_COMPRESSED_UINT) ? "compressed uint" : (uiFormat == NUM_FORMAT_VARINT_QUAD) ? "varint" : "compact varint";
+
+			for ( uiL = 0; uiL < (sizeof(pullLengths) / sizeof(unsigned long long)); uiL++ ) {
+
+				/* Integers take at least a byte each, and the last quad can overrun the buffer length */
+				if ( ((pucData = malloc(pullLengths[uiL] + (NUM_COMPRESSED_UINT_MAX_SIZE * 4) + NUM_READ_PADDING_SIZE)) == NULL) ||
+						((pullIndex = malloc(((pullLengths[uiL] / RANDOM_ACCESS_STRIDE) + 1) * sizeof(unsigned long long))) == NULL) ) {
+					printf("Failed to allocate memory\n");
+					exit (-1);
+				}
+
+
+				/* Encode sequential integers until the buffer is full, indexing every RANDOM_ACCESS_STRIDE integers */
+				for ( uiI = 0, pucDataPtr = pucData; (pucDataPtr - pucData) < pullLengths[uiL]; ) {
+
+					if ( (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && ((uiI + 3) > NUM_COMPACT_VARINT_MAX_VALUE) ) {
+						break;
+					}
+
+					if ( (uiI % RANDOM_ACCESS_STRIDE) == 0 ) {
+						pullIndex[uiI / RANDOM_ACCESS_STRIDE] = pucDataPtr - pucData;
+					}
+
+					if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+						NUM_WRITE_COMPRESSED_UINT(uiI, pucDataPtr);
+						uiI++;
+					}
+					else {
+						NUM_WRITE_QUAD(uiFormat, uiI, uiI + 1, uiI + 2, uiI + 3, pucDataPtr);
+						uiI += 4;
+					}
+				}
+
+				uiIntegerCount = uiI;
+				ullDataLength = pucDataPtr - pucData;
+				memset(pucDataPtr, 0, NUM_READ_PADDING_SIZE);
+
+
+				bCacheMisses = (iUtlPerfCacheMissesStart(iPerfFileDescriptor) == 0) ? true : false;
+
+				uiRandomSeed = uiRandom;
+
+				gettimeofday(&tvStartTimeVal, NULL);
+
+				/* Look up random positions, skipping forward from the nearest index entry */
+				for ( uiI = 0, ullValuesSum = 0; uiI < RANDOM_ACCESS_LOOKUPS; uiI++ ) {
+
+					uiRandom ^= uiRandom << 13;
+					uiRandom ^= uiRandom >> 17;
+					uiRandom ^= uiRandom << 5;
+
+					uiPosition = uiRandom % uiIntegerCount;
+					pucDataPtr = pucData + pullIndex[uiPosition / RANDOM_ACCESS_STRIDE];
+					uiSkip = uiPosition % RANDOM_ACCESS_STRIDE;
+
+					if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+						for ( ; uiSkip > 0; uiSkip-- ) {
+							NUM_SKIP_COMPRESSED_UINT(pucDataPtr);
+						}
+						NUM_READ_COMPRESSED_UINT(uiValueRead, pucDataPtr);
+					}
+					else {
+						for ( ; uiSkip >= 4; uiSkip -= 4 ) {
+							pucDataPtr += (uiFormat == NUM_FORMAT_VARINT_QUAD) ? pvsVarintSizesGlobal[pucDataPtr[0]].ucLength :
+									pvsCompactVarintSizesGlobal[pucDataPtr[0]].ucLength;
+						}
+						NUM_READ_QUAD(uiFormat, puiValues[0], puiValues[1], puiValues[2], puiValues[3], pucDataPtr);
+						uiValueRead = puiValues[uiSkip];
+					}
+
+					ullValuesSum += uiValueRead;
+				}
+
+				gettimeofday(&tvEndTimeVal, NULL);
+
+				if ( bCacheMisses == true ) {
+					bCacheMisses = (iUtlPerfCacheMissesStop(iPerfFileDescriptor, &ullCacheMisses) == 0) ? true : false;
+				}
+
+#if defined(CHECK_READ)
+				/* Replay the positions outside the timed loop, the integers are sequential so the sum read is the sum of the positions */
+				{
+					unsigned long long	ullPositionsSum = 0;
+
+					for ( uiI = 0, uiRandom = uiRandomSeed; uiI < RANDOM_ACCESS_LOOKUPS; uiI++ ) {
+						uiRandom ^= uiRandom << 13;
+						uiRandom ^= uiRandom >> 17;
+						uiRandom ^= uiRandom << 5;
+						ullPositionsSum += uiRandom % uiIntegerCount;
+					}
+
+					if ( ullValuesSum != ullPositionsSum ) {
+						printf("Failed, checksum: %llu, expected: %llu.\n", ullValuesSum, ullPositionsSum);
+						exit (-1);
+					}
+				}
+#endif	/* defined(CHECK_READ) */
+
+				UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+				UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+				snprintf(pucNumberString, STRING_LENGTH, "%llu", ullDataLength);
+				printf("Random access %s, buffer: %s (%s bytes), lookups: %u\n", pucFormatName, ppucLengthNames[uiL],
+						pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH), RANDOM_ACCESS_LOOKUPS);
+
+				printf("\tNanoseconds/lookup : %.1f\n", (dMicroSeconds * 1000) / RANDOM_ACCESS_LOOKUPS);
+				iUtlBenchmarkRecord(pucFormatName, ppucLengthNames[uiL], "random access lookup", (double)RANDOM_ACCESS_LOOKUPS * ((double)1000000 / dMicroSeconds));
+
+				if ( bCacheMisses == true ) {
+					printf("\tCache misses/lookup : %.2f\n", (double)ullCacheMisses / RANDOM_ACCESS_LOOKUPS);
+				}
+				else {
+					printf("\tCache misses/lookup : not available\n");
+				}
+
+				printf("\tChecksum : %llu\n", ullValuesSum);
+
+				printf("\n");
+
+				free(pullIndex);
+				free(pucData);
+			}
+
+			printf("\n");
+		}
+
+		if ( iPerfFileDescriptor != -1 ) {
+			close(iPerfFileDescriptor);
+		}
+
+	}
+#endif	/* defined(RANDOM_ACCESS) */
+
+
+
+#if defined(DECODE_LATENCY)
+	/* Testing the latency of block decodes by format and block size */
+	{
+
+		unsigned int		*puiValues = NULL;
+		unsigned int		uiValuesLength = ITERATIONS;
+		unsigned int		*puiValuesRead = NULL;
+		unsigned int		uiValuesReadLength = 0;
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned char		*pucDataEndPtr = NULL;
+		unsigned int		uiDataLength = 0;
+		unsigned int		uiBlockLength = 0;
+
+		unsigned int		puiBlockIntegerCounts[] = {16, 128, 1024, 8192, NUM_BLOCK_INTEGER_COUNT_MAX};
+		double				pdPercentiles[] = {50, 90, 99, 99.9, 99.99};
+
+		void				*pvNumHistogram = NULL;
+		unsigned long long	ullStartTicks = 0;
+		unsigned long long	ullCount = 0;
+		unsigned long long	ullMinValue = 0;
+		unsigned long long	ullMaxValue = 0;
+		unsigned long long	ullValue = 0;
+		double				dMeanValue = 0;
+		double				dTickNanoseconds = 0;
+
+		unsigned int		uiFormat = 0;
+		unsigned char		*pucFormatName = NULL;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiB = 0;
+		int					iError = NUM_NoError;
+
+
+		if ( ((puiValues = malloc(uiValuesLength * sizeof(unsigned int))) == NULL) ||
+				((puiValuesRead = malloc(NUM_BLOCK_INTEGER_COUNT_MAX * sizeof(unsigned int))) == NULL) ||
+				((pucData = malloc(((unsigned long long)uiValuesLength * NUM_COMPRESSED_UINT_MAX_SIZE) + NUM_READ_PADDING_SIZE)) == NULL) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( uiI = 0; uiI < uiValuesLength; uiI++ ) {
+			puiValues[uiI] = uiI % (NUM_COMPACT_VARINT_MAX_VALUE + 1);
+		}
+
+		if ( ((iError = iNumHistogramCreate(&pvNumHistogram)) != NUM_NoError) || ((iError = iNumGetTickNanoseconds(&dTickNanoseconds)) != NUM_NoError) ) {
+			printf("Failed to create the histogram, error: %d.\n", iError);
+			exit (-1);
+		}
+
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			pucFormatName = (uiFormat == NUM_FORMAT_COMPRESSED_UINT) ? "compressed uint" : (uiFormat == NUM_FORMAT_VARINT_QUAD) ? "varint" : "compact varint";
+
+			for ( uiB = 0; uiB < (sizeof(puiBlockIntegerCounts) / sizeof(unsigned int)); uiB++ ) {
+
+				/* Encode the integers into blocks */
+				for ( uiI = 0, pucDataPtr = pucData; uiI < uiValuesLength; uiI += uiJ, pucDataPtr += uiDataLength ) {
+					uiJ = ((uiValuesLength - uiI) < puiBlockIntegerCounts[uiB]) ? (uiValuesLength - uiI) : puiBlockIntegerCounts[uiB];
+					uiDataLength = (pucData + ((unsigned long long)uiValuesLength * NUM_COMPRESSED_UINT_MAX_SIZE)) - pucDataPtr;
+					if ( (iError = iNumBlockEncode(uiFormat, puiValues + uiI, uiJ, pucDataPtr, &uiDataLength)) != NUM_NoError ) {
+						printf("Failed to encode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+				}
+				pucDataEndPtr = pucDataPtr;
+
+
+				/* Decode the blocks, timing each one */
+				iNumHistogramReset(pvNumHistogram);
+
+				for ( uiI = 0; uiI < REPETITIONS; uiI++ ) {
+					for ( pucDataPtr = pucData; pucDataPtr < pucDataEndPtr; pucDataPtr += uiBlockLength ) {
+
+						ullStartTicks = ullNumGetTicks();
+
+						if ( (iError = iNumBlockDecode(uiFormat, pucDataPtr, pucDataEndPtr - pucDataPtr, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX,
+								&uiValuesReadLength, &uiBlockLength)) != NUM_NoError ) {
+							printf("Failed to decode a block, error: %d.\n", iError);
+							exit (-1);
+						}
+
+						iNumHistogramRecord(pvNumHistogram, ullNumGetTicks() - ullStartTicks);
+					}
+				}
+
+
+				/* Report the latency in nanoseconds */
+				iNumHistogramGetCounts(pvNumHistogram, &ullCount, &ullMinValue, &ullMaxValue, &dMeanValue);
+
+				printf("Decoding %s blocks of %u integers, blocks decoded: %llu\n", pucFormatName, puiBlockIntegerCounts[uiB], ullCount);
+				printf("\tNanoseconds, min: %.0f, mean: %.0f", ullMinValue * dTickNanoseconds, dMeanValue * dTickNanoseconds);
+
+				for ( uiJ = 0; uiJ < (sizeof(pdPercentiles) / sizeof(double)); uiJ++ ) {
+					iNumHistogramGetPercentile(pvNumHistogram, pdPercentiles[uiJ], &ullValue);
+					printf(", p%g: %.0f", pdPercentiles[uiJ], ullValue * dTickNanoseconds);
+				}
+
+				printf(", max: %.0f\n\n", ullMaxValue * dTickNanoseconds);
+			}
+
+			printf("\n");
+		}
+
+		iNumHistogramFree(pvNumHistogram);
+		free(pucData);
+		free(puiValuesRead);
+		free(puiValues);
+
+	}
+#endif	/* defined(DECODE_LATENCY) */
+
+
+
+#if defined(AGGREGATE_ACROSS_MEMORY)
+	/* Testing aggregation across memory, decoding then aggregating against the aggregate kernels */
+	{
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		puiValues[DATA_LENGTH * 4];
+
+		unsigned int		uiFormat = 0;
+		unsigned char		*pucFormatName = NULL;
+		unsigned int		uiFused = 0;
+		unsigned int		uiQuadCount = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
+		struct numAggregate	naNumAggregate;
+		struct numAggregate	naNumAggregateDecoded;
+
+		unsigned long long	ullTotalIterations = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( uiFormat = NUM_FORMAT_VARINT_QUAD; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			pucFormatName = (uiFormat == NUM_FORMAT_VARINT_QUAD) ? "varint" : "compact varint";
+
+			for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
+				NUM_WRITE_QUAD(uiFormat, uiI, uiI + 1, uiI + 2, uiI + 3, pucDataPtr);
+			}
+
+			for ( uiFused = 0; uiFused <= 1; uiFused++ ) {
+
+				gettimeofday(&tvStartTimeVal, NULL);
+
+				for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
+
+					/* Count the middle half of the integers */
+					iNumAggregateInit(&naNumAggregate, ITERATIONS / 4, ITERATIONS - (ITERATIONS / 4));
+
+					for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ += uiQuadCount, ullTotalIterations += uiQuadCount ) {
+
+						uiQuadCount = ((ITERATIONS - uiJ) < DATA_LENGTH) ? (ITERATIONS - uiJ) : DATA_LENGTH;
+
+						if ( uiFused == 1 ) {
+							iError = iNumAggregateQuads(uiFormat, pucDataPtr, uiQuadCount * 4, &naNumAggregate, &pucDataPtr);
+						}
+						else if ( (iError = iNumDecodeQuads(uiFormat, NUM_QUAD_DECODE_UNROLL_DEFAULT, pucDataPtr, uiQuadCount, puiValues, &pucDataPtr)) == NUM_NoError ) {
+							for ( uiK = 0; uiK < (uiQuadCount * 4); uiK++ ) {
+								naNumAggregate.ullSum += puiValues[uiK];
+								naNumAggregate.uiMinValue = (puiValues[uiK] < naNumAggregate.uiMinValue) ? puiValues[uiK] : naNumAggregate.uiMinValue;
+								naNumAggregate.uiMaxValue = (puiValues[uiK] > naNumAggregate.uiMaxValue) ? puiValues[uiK] : naNumAggregate.uiMaxValue;
+								naNumAggregate.ullRangeCount += ((puiValues[uiK] - naNumAggregate.uiRangeMinValue) <= (naNumAggregate.uiRangeMaxValue - naNumAggregate.uiRangeMinValue));
+							}
+							naNumAggregate.ullCount += uiQuadCount * 4;
+						}
+
+						if ( iError != NUM_NoError ) {
+							printf("Failed to aggregate, error: %d.\n", iError);
+							exit (-1);
+						}
+					}
+
+					/* Both passes must agree */
+					if ( uiFused == 0 ) {
+						naNumAggregateDecoded = naNumAggregate;
+					}
+					else if ( memcmp(&naNumAggregate, &naNumAggregateDecoded, sizeof(struct numAggregate)) != 0 ) {
+						printf("Failed, sum: %llu, expected: %llu.\n", naNumAggregate.ullSum, naNumAggregateDecoded.ullSum);
+						exit (-1);
+					}
+				}
+
+				gettimeofday(&tvEndTimeVal, NULL);
+
+				UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+				UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+				snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+				printf("Aggregating %s across memory, %s, numbers read: %s\n", pucFormatName, (uiFused == 1) ? "aggregate kernel" : "decode then aggregate",
+						pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+				snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+				printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+				snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+				printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				iUtlBenchmarkRecord(pucFormatName, "sequential", (uiFused == 1) ? "aggregate kernel" : "decode then aggregate", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+
+				printf("\n");
+			}
+
+			printf("\n");
+		}
+
+		free(pucData);
+
+	}
+#endif	/* defined(AGGREGATE_ACROSS_MEMORY) */
+
+
+
+#if defined(FILTER_ACROSS_MEMORY)
+	/* Testing filtering across memory, decoding then comparing against the filter kernels */
+	{
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+
+		unsigned int		uiDataLength = ITERATIONS * 16;
+
+		unsigned int		puiValues[DATA_LENGTH * 4];
+		unsigned char		pucBitmap[NUM_GET_FILTER_BITMAP_LENGTH(DATA_LENGTH * 4)];
+		unsigned char		pucBitmapDecoded[NUM_GET_FILTER_BITMAP_LENGTH(DATA_LENGTH * 4)];
+
+		unsigned int		uiFormat = 0;
+		unsigned char		*pucFormatName = NULL;
+		unsigned int		uiFused = 0;
+		unsigned int		uiQuadCount = 0;
+		unsigned int		uiMatchCount = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
+
+		unsigned long long	ullTotalIterations = 0;
+		unsigned long long	ullTotalMatches = 0;
+
+		struct timeval		tvStartTimeVal;
+		struct timeval		tvEndTimeVal;
+		struct timeval		tvDiffTimeVal;
+		double				dMicroSeconds = 0;
+		unsigned char		pucNumberString[STRING_LENGTH];
+		unsigned char		pucString[STRING_LENGTH];
+
+
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( uiFormat = NUM_FORMAT_VARINT_QUAD; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			pucFormatName = (uiFormat == NUM_FORMAT_VARINT_QUAD) ? "varint" : "compact varint";
+
+			for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
+				NUM_WRITE_QUAD(uiFormat, uiI, uiI + 1, uiI + 2, uiI + 3, pucDataPtr);
+			}
+
+			for ( uiFused = 0; uiFused <= 1; uiFused++ ) {
+
+				gettimeofday(&tvStartTimeVal, NULL);
+
+				/* Select the middle half of the integers into a bitmap */
+				for ( uiI = 0, ullTotalIterations = 0, ullTotalMatches = 0; uiI < REPETITIONS; uiI++ ) {
+
+					for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ += uiQuadCount, ullTotalIterations += uiQuadCount ) {
+
+						uiQuadCount = ((ITERATIONS - uiJ) < DATA_LENGTH) ? (ITERATIONS - uiJ) : DATA_LENGTH;
+
+						if ( uiFused == 1 ) {
+							iError = iNumFilterQuads(uiFormat, pucDataPtr, uiQuadCount * 4, ITERATIONS / 4, ITERATIONS - (ITERATIONS / 4),
+									pucBitmap, NULL, &uiMatchCount, &pucDataPtr);
+						}
+						else if ( (iError = iNumDecodeQuads(uiFormat, NUM_QUAD_DECODE_UNROLL_DEFAULT, pucDataPtr, uiQuadCount, puiValues, &pucDataPtr)) == NUM_NoError ) {
+							memset(pucBitmapDecoded, 0, NUM_GET_FILTER_BITMAP_LENGTH(uiQuadCount * 4));
+							for ( uiK = 0, uiMatchCount = 0; uiK < (uiQuadCount * 4); uiK++ ) {
+								if ( (puiValues[uiK] >= (ITERATIONS / 4)) && (puiValues[uiK] <= (ITERATIONS - (ITERATIONS / 4))) ) {
+									pucBitmapDecoded[uiK / 8] |= 1 << (uiK % 8);
+									uiMatchCount++;
+								}
+							}
+						}
+
+						if ( iError != NUM_NoError ) {
+							printf("Failed to filter, error: %d.\n", iError);
+							exit (-1);
+						}
+
+						ullTotalMatches += uiMatchCount;
+					}
+				}
+
+				gettimeofday(&tvEndTimeVal, NULL);
+
+				/* Both passes must select the same integers */
+				if ( ullTotalMatches != ((unsigned long long)REPETITIONS * ((ITERATIONS / 2) + 1) * 4) ) {
+					printf("Failed, matches: %llu, expected: %llu.\n", ullTotalMatches, (unsigned long long)REPETITIONS * ((ITERATIONS / 2) + 1) * 4);
+					exit (-1);
+				}
+
+				UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
+				UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+
+				snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
+				printf("Filtering %s across memory, %s, numbers read: %s\n", pucFormatName, (uiFused == 1) ? "filter kernel" : "decode then filter",
+						pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+				snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
+				printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+
+				snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+				printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				iUtlBenchmarkRecord(pucFormatName, "sequential", (uiFused == 1) ? "filter kernel" : "decode then filter", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
+
+				printf("\n");
+			}
+
+			printf("\n");
+		}
+
+		free(pucData);
+
+	}
+#endif	/* defined(FILTER_ACROSS_MEMORY) */
+
+
+
+#if defined(TEST_VARINT_1)
+	/* Sanity test 1 */
+	{
+
+		unsigned char	pucData[DATA_LENGTH];
+		unsigned char	*pucDataPtr = NULL;
+
+		unsigned int	uiI = 0;
+
+		unsigned int	uiValueWritten = 0;
+		unsigned int	uiValueRead = 0;
+
+		unsigned int	uiSize = 0;
+		
+
+		memset(pucData, DATA_LENGTH, 0);
+
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+
+			uiValueWritten = uiI;
+	
+			pucDataPtr = pucData;
+			NUM_GET_VARINT_SIZE(uiValueWritten, uiSize);
+			NUM_WRITE_VARINT(uiValueWritten, uiSize, pucDataPtr);
+
+			pucDataPtr = pucData;
+			NUM_READ_VARINT(uiValueRead, uiSize, pucDataPtr);
+
+			if ( uiValueRead != uiValueWritten ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead, uiValueWritten);
+				exit (-1);
+			}
+		}
+
+		printf("Sanity test 1 complete\n\n");
+
+	}
+#endif	/* defined(TEST_VARINT_1) */
+
+
+
+#if defined(TEST_VARINT_2)
+	/* Sanity test 2 */
+	{
+
+		unsigned char	pucData[DATA_LENGTH];
+		unsigned char	*pucDataPtr = NULL;
+
+		unsigned int	uiI = 0;
+
+		unsigned int	uiValueWritten1 = 0;
+		unsigned int	uiValueWritten2 = 0;
+		unsigned int	uiValueWritten3 = 0;
+		unsigned int	uiValueWritten4 = 0;
+
+		unsigned int	uiValueRead1 = 0;
+		unsigned int	uiValueRead2 = 0;
+		unsigned int	uiValueRead3 = 0;
+		unsigned int	uiValueRead4 = 0;
+
+		
+		memset(pucData, DATA_LENGTH, 0);
+
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+
+			uiValueWritten1 = uiI;
+			uiValueWritten2 = uiValueWritten1 + 1;
+			uiValueWritten3 = uiValueWritten2 + 1;
+			uiValueWritten4 = uiValueWritten3 + 1;
+
+			pucDataPtr = pucData;
+			NUM_WRITE_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+
+			pucDataPtr = pucData;
+			NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+			if ( uiValueRead1 != uiValueWritten1 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+				exit (-1);
+			}
+
+			if ( uiValueRead2 != uiValueWritten2 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+				exit (-1);
+			}
+
+			if ( uiValueRead3 != uiValueWritten3 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+				exit (-1);
+			}
+
+			if ( uiValueRead4 != uiValueWritten4 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+				exit (-1);
+			}
+		}
+
+		printf("Sanity test 2 complete\n\n");
+
+	}
+#endif	/* defined(TEST_VARINT_2) */
+
+
+
+#if defined(TEST_COMPACT_VARINT_1)
+	/* Sanity test 1 */
+	{
+
+		unsigned char	pucData[DATA_LENGTH];
+		unsigned char	*pucDataPtr = NULL;
+
+		unsigned int	uiI = 0;
+
+		unsigned int	uiValueWritten = 0;
+		unsigned int	uiValueRead = 0;
+
+		unsigned int	uiSize = 0;
+		
+
+		printf("Sanity test 1\n\n");
+
+		memset(pucData, DATA_LENGTH, 0);
+
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+
+			uiValueWritten = uiI;
+	
+			pucDataPtr = pucData;
+			NUM_GET_COMPACT_VARINT_SIZE(uiValueWritten, uiSize);
+			NUM_WRITE_COMPACT_VARINT(uiValueWritten, uiSize, pucDataPtr);
+
+			pucDataPtr = pucData;
+			NUM_READ_COMPACT_VARINT(uiValueRead, uiSize, pucDataPtr);
+
+			if ( uiValueRead != uiValueWritten ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead, uiValueWritten);
+				exit (-1);
+			}
+		}
+
+		printf("Sanity test 1 complete\n\n");
+
+	}
+#endif	/* defined(TEST_COMPACT_VARINT_1) */
+
+
+
+#if defined(TEST_COMPACT_VARINT_2)
+	/* Sanity test 2 */
+	{
+
+		unsigned char	pucData[DATA_LENGTH];
+		unsigned char	*pucDataPtr = NULL;
+
+		unsigned int	uiI = 0;
+
+		unsigned int	uiValueWritten1 = 0;
+		unsigned int	uiValueWritten2 = 0;
+		unsigned int	uiValueWritten3 = 0;
+		unsigned int	uiValueWritten4 = 0;
+
+		unsigned int	uiValueRead1 = 0;
+		unsigned int	uiValueRead2 = 0;
+		unsigned int	uiValueRead3 = 0;
+		unsigned int	uiValueRead4 = 0;
+
+		
+		printf("Sanity test 2\n\n");
+
+		memset(pucData, DATA_LENGTH, 0);
+
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+
+			uiValueWritten1 = uiI;
+			uiValueWritten2 = uiValueWritten1 + 1;
+			uiValueWritten3 = uiValueWritten2 + 1;
+			uiValueWritten4 = uiValueWritten3 + 1;
+
+			pucDataPtr = pucData;
+			NUM_WRITE_COMPACT_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+
+			pucDataPtr = pucData;
+			NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+			if ( uiValueRead1 != uiValueWritten1 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+				exit (-1);
+			}
+
+			if ( uiValueRead2 != uiValueWritten2 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+				exit (-1);
+			}
+
+			if ( uiValueRead3 != uiValueWritten3 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+				exit (-1);
+			}
+
+			if ( uiValueRead4 != uiValueWritten4 ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+				exit (-1);
+			}
+		}
+
+		printf("Sanity test 2 complete\n\n");
+
+	}
+#endif	/* defined(TEST_COMPACT_VARINT_2) */
+
+
+
+#if defined(TEST_STREAM_ENCODER)
+	/* Stream encoder test */
+	{
+
+		char			pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int				iFileDescriptor = -1;
+
+		void			*pvNumStreamEncoder = NULL;
+
+		unsigned char	*pucData = NULL;
+		unsigned char	*pucDataPtr = NULL;
+		unsigned char	*pucDataEndPtr = NULL;
+		struct stat		stStat;
+
+		unsigned int	puiValues[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int	uiValuesLength = 0;
+		unsigned int	uiBlockLength = 0;
+
+		unsigned int	uiFormat = 0;
+		unsigned int	uiI = 0;
+		unsigned int	uiJ = 0;
+		unsigned int	uiValueExpected = 0;
+		unsigned int	uiCorruptCount = 0;
+		unsigned int	uiCorruptLength = 0;
+		unsigned long long	ullIntegerCount = 0;
+		unsigned long long	ullByteCount = 0;
+		int				iError = NUM_NoError;
+
+
+		printf("Stream encoder test\n\n");
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+			if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+				printf("Failed to create a temporary file\n");
+				exit (-1);
+			}
+			unlink(pucFilePath);
+
+			if ( (iError = iNumStreamEncoderCreate(uiFormat, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to create a stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			/* Add the integers one at a time and in uneven batches */
+			for ( uiI = 0; uiI < (ITERATIONS + 3); ) {
+
+				if ( (uiI % 7) == 0 ) {
+					iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, uiI % (NUM_COMPACT_VARINT_MAX_VALUE + 1));
+					uiI++;
+				}
+				else {
+					for ( uiJ = 0; (uiJ < 1001) && (uiI < (ITERATIONS + 3)); uiJ++, uiI++ ) {
+						puiValues[uiJ] = uiI % (NUM_COMPACT_VARINT_MAX_VALUE + 1);
+					}
+					iError = iNumStreamEncoderAddIntegers(pvNumStreamEncoder, puiValues, uiJ);
+				}
+
+				if ( iError != NUM_NoError ) {
+					printf("Failed to add integers, error: %d.\n", iError);
+					exit (-1);
+				}
+			}
+
+			if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to close the stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			/* Read the file back and check the blocks */
+			fstat(iFileDescriptor, &stStat);
+
+			if ( (pucData = malloc(stStat.st_size + NUM_READ_PADDING_SIZE)) == NULL ) {
+				printf("Failed to allocate memory\n");
+				exit (-1);
+			}
+
+			if ( pread(iFileDescriptor, pucData, stStat.st_size, 0) != stStat.st_size ) {
+				printf("Failed to read the temporary file\n");
+				exit (-1);
+			}
+
+			close(iFileDescriptor);
+
+			for ( pucDataPtr = pucData, pucDataEndPtr = pucData + stStat.st_size, uiValueExpected = 0; pucDataPtr < pucDataEndPtr; pucDataPtr += uiBlockLength ) {
+
+				if ( (iError = iNumBlockDecode(uiFormat, pucDataPtr, pucDataEndPtr - pucDataPtr, puiValues, NUM_BLOCK_INTEGER_COUNT_MAX,
+						&uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+					printf("Failed to decode a block, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				for ( uiJ = 0; uiJ < uiValuesLength; uiJ++, uiValueExpected++ ) {
+					if ( puiValues[uiJ] != (uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1)) ) {
+						printf("Failed, read: %u, expected: %u.\n", puiValues[uiJ], uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1));
+						exit (-1);
+					}
+				}
+			}
+
+			if ( uiValueExpected != (ITERATIONS + 3) ) {
+				printf("Failed, integers read: %u, expected: %u.\n", uiValueExpected, ITERATIONS + 3);
+				exit (-1);
+			}
+
+			free(pucData);
+		}
+
+		/* A value too large for a compact varint must be rejected wherever it is in a quad, after
+		** the integers before it have been added
+		*/
+		for ( uiI = 0; uiI < 4; uiI++ ) {
+
+			strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+			if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+				printf("Failed to create a temporary file\n");
+				exit (-1);
+			}
+			unlink(pucFilePath);
+
+			if ( (iError = iNumStreamEncoderCreate(NUM_FORMAT_COMPACT_VARINT_QUAD, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to create a stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			for ( uiJ = 0; uiJ < 8; uiJ++ ) {
+				puiValues[uiJ] = (uiJ == uiI) ? (NUM_COMPACT_VARINT_MAX_VALUE + 1) : 1;
+			}
+
+			if ( (iError = iNumStreamEncoderAddIntegers(pvNumStreamEncoder, puiValues, 8)) != NUM_ValueOverflowError ) {
+				printf("Failed to reject a value too large for a compact varint, position: %u, error: %d.\n", uiI, iError);
+				exit (-1);
+			}
+
+			if ( ((iError = iNumStreamEncoderGetCounts(pvNumStreamEncoder, &ullIntegerCount, &ullByteCount)) != NUM_NoError) || (ullIntegerCount != uiI) ) {
+				printf("Failed, integers added: %llu, expected: %u, error: %d.\n", ullIntegerCount, uiI, iError);
+				exit (-1);
+			}
+
+			if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to close the stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			close(iFileDescriptor);
+		}
+
+		/* Corrupt headers must be rejected without reading past the data, a count too
+		** large for the data length, then quads that are longer than the data length
+		*/
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			for ( uiI = 0; uiI < 2; uiI++ ) {
+
+				uiCorruptCount = (uiI == 0) ? 4096 : 8;
+				uiCorruptLength = (uiI == 0) ? 1 : (uiFormat == NUM_FORMAT_COMPRESSED_UINT) ? 8 : (uiFormat == NUM_FORMAT_VARINT_QUAD) ? 10 : 2;
+
+				if ( (pucData = malloc(NUM_BLOCK_HEADER_MAX_SIZE + uiCorruptLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+					printf("Failed to allocate memory\n");
+					exit (-1);
+				}
+
+				memset(pucData, 0xFF, NUM_BLOCK_HEADER_MAX_SIZE + uiCorruptLength + NUM_READ_PADDING_SIZE);
+
+				pucDataPtr = pucData;
+				NUM_WRITE_COMPRESSED_UINT((uiCorruptCount << NUM_BLOCK_WIDTH_BITS) | NUM_BLOCK_WIDTH_VARIABLE, pucDataPtr);
+				NUM_WRITE_COMPRESSED_UINT(uiCorruptLength, pucDataPtr);
+
+				if ( (iError = iNumBlockDecode(uiFormat, pucData, (pucDataPtr - pucData) + uiCorruptLength, puiValues, NUM_BLOCK_INTEGER_COUNT_MAX,
+						&uiValuesLength, &uiBlockLength)) != NUM_CorruptDataError ) {
+					printf("Failed to reject a corrupt block, format: %u, integers: %u, error: %d.\n", uiFormat, uiCorruptCount, iError);
+					exit (-1);
+				}
+
+				free(pucData);
+			}
+		}
+
+		printf("Stream encoder test complete\n\n");
+
+	}
+#endif	/* defined(TEST_STREAM_ENCODER) */
+
+
+
+#if defined(TEST_STREAM_DECODER)
+	/* Stream decoder test */
+	{
+
+		char			pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int				iFileDescriptor = -1;
+
+		void			*pvNumStreamEncoder = NULL;
+		void			*pvNumStreamDecoder = NULL;
+		void			*pvNumMappedSource = NULL;
+
+		unsigned int	puiValues[1000];
+		unsigned int	uiValuesLength = 0;
+		unsigned int	uiValue = 0;
+
+		unsigned int	uiFormat = 0;
+		unsigned int	uiSource = 0;
+		unsigned int	uiI = 0;
+		unsigned int	uiJ = 0;
+		unsigned int	uiValueExpected = 0;
+		int				iError = NUM_NoError;
+
+
+		printf("Stream decoder test\n\n");
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+			if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+				printf("Failed to create a temporary file\n");
+				exit (-1);
+			}
+			unlink(pucFilePath);
+
+			if ( (iError = iNumStreamEncoderCreate(uiFormat, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to create a stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			for ( uiI = 0; uiI < (ITERATIONS + 3); uiI++ ) {
+				if ( (iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, uiI % (NUM_COMPACT_VARINT_MAX_VALUE + 1))) != NUM_NoError ) {
+					printf("Failed to add an integer, error: %d.\n", iError);
+					exit (-1);
+				}
+			}
+
+			if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to close the stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			/* Decode from the file descriptor and from a mapped source */
+			for ( uiSource = 0; uiSource < 2; uiSource++ ) {
+
+				lseek(iFileDescriptor, 0, SEEK_SET);
+
+				if ( uiSource == 0 ) {
+					iError = iNumStreamDecoderCreate(uiFormat, 0, 0, iNumStreamSourceFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamDecoder);
+				}
+				else {
+					if ( (iError = iNumMappedSourceCreate(iFileDescriptor, 0, &pvNumMappedSource)) == NUM_NoError ) {
+						iError = iNumStreamDecoderCreate(uiFormat, 0, 0, iNumStreamSourceMapped, pvNumMappedSource, &pvNumStreamDecoder);
+					}
+				}
+
+				if ( iError != NUM_NoError ) {
+					printf("Failed to create a stream decoder, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				/* Alternate between single integers and uneven batches */
+				for ( uiValueExpected = 0; ; ) {
+
+					if ( (uiValueExpected % 3) == 0 ) {
+						iError = iNumStreamDecoderNext(pvNumStreamDecoder, &uiValue);
+						puiValues[0] = uiValue;
+						uiValuesLength = 1;
+					}
+					else {
+						iError = iNumStreamDecoderNextBatch(pvNumStreamDecoder, puiValues, (uiValueExpected % 2) ? 1000 : 77, &uiValuesLength);
+					}
+
+					if ( iError == NUM_EndOfStream ) {
+						break;
+					}
+					else if ( iError != NUM_NoError ) {
+						printf("Failed to decode integers, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					for ( uiJ = 0; uiJ < uiValuesLength; uiJ++, uiValueExpected++ ) {
+						if ( puiValues[uiJ] != (uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1)) ) {
+							printf("Failed, read: %u, expected: %u.\n", puiValues[uiJ], uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1));
+							exit (-1);
+						}
+					}
+				}
+
+				if ( uiValueExpected != (ITERATIONS + 3) ) {
+					printf("Failed, integers read: %u, expected: %u.\n", uiValueExpected, ITERATIONS + 3);
+					exit (-1);
+				}
+
+				iNumStreamDecoderFree(pvNumStreamDecoder);
+
+				if ( pvNumMappedSource != NULL ) {
+					iNumMappedSourceFree(pvNumMappedSource);
+					pvNumMappedSource = NULL;
+				}
+			}
+
+			close(iFileDescriptor);
+		}
+
+		printf("Stream decoder test complete\n\n");
+
+	}
+#endif	/* defined(TEST_STREAM_DECODER) */
+
+
+
+#if defined(TEST_PARALLEL)
+	/* Parallel test */
+	{
+
+		void				*pvNumThreadPool = NULL;
+
+		unsigned int		*puiValues = NULL;
+		unsigned int		*puiValuesRead = NULL;
+		unsigned long long	ullValuesLength = ITERATIONS + 3;
+
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned long long	ullDataLength = 0;
+		unsigned long long	*pullChunkOffsets = NULL;
+		unsigned int		uiChunkCount = 0;
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiBlockLength = 0;
+
+		unsigned int		uiFormat = 0;
+		unsigned long long	ullI = 0;
+		int					iError = NUM_NoError;
+
+
+		printf("Parallel test\n\n");
+
+		if ( (iError = iNumThreadPoolCreate(4, &pvNumThreadPool)) != NUM_NoError ) {
+			printf("Failed to create the thread pool, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		if ( ((puiValues = malloc(ullValuesLength * sizeof(unsigned int))) == NULL) ||
+				((puiValuesRead = malloc((ullValuesLength + 3) * sizeof(unsigned int))) == NULL) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		for ( ullI = 0; ullI < ullValuesLength; ullI++ ) {
+			puiValues[ullI] = (ullI * 7919) % (NUM_COMPACT_VARINT_MAX_VALUE + 1);
+		}
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			if ( (iError = iNumParallelEncode(pvNumThreadPool, NULL, uiFormat, 64, 64 * 10, puiValues, ullValuesLength, &pucData, &ullDataLength, &pullChunkOffsets, &uiChunkCount)) != NUM_NoError ) {
+				printf("Failed to encode, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			/* Decode in parallel */
+			memset(puiValuesRead, 0, ullValuesLength * sizeof(unsigned int));
+			if ( (iError = iNumParallelDecode(pvNumThreadPool, uiFormat, 64 * 10, pucData, pullChunkOffsets, uiChunkCount, puiValuesRead, ullValuesLength)) != NUM_NoError ) {
+				printf("Failed to decode, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			for ( ullI = 0; ullI < ullValuesLength; ullI++ ) {
+				if ( puiValuesRead[ullI] != puiValues[ullI] ) {
+					printf("Failed, read: %u, expected: %u.\n", puiValuesRead[ullI], puiValues[ullI]);
+					exit (-1);
+				}
+			}
+
+			/* Decode a block at a time, the data must be the same as the stream encoder produces */
+			memset(puiValuesRead, 0, ullValuesLength * sizeof(unsigned int));
+			for ( pucDataPtr = pucData, ullI = 0; pucDataPtr < (pucData + ullDataLength); pucDataPtr += uiBlockLength, ullI += uiValuesLength ) {
+				if ( (iError = iNumBlockDecode(uiFormat, pucDataPtr, (pucData + ullDataLength) - pucDataPtr, puiValuesRead + ullI, 64, &uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+					printf("Failed to decode a block, error: %d.\n", iError);
+					exit (-1);
+				}
+			}
+
+			if ( (ullI != ullValuesLength) || (memcmp(puiValues, puiValuesRead, ullValuesLength * sizeof(unsigned int)) != 0) ) {
+				printf("Failed, blocks do not match.\n");
+				exit (-1);
+			}
+
+			free(pucData);
+			free(pullChunkOffsets);
+		}
+
+		free(puiValues);
+		free(puiValuesRead);
+		iNumThreadPoolFree(pvNumThreadPool);
+
+		printf("Parallel test complete\n\n");
+
+	}
+#endif	/* defined(TEST_PARALLEL) */
+
+
+#if defined(TEST_ASYNC_SOURCE)
+	/* Async source test */
+	{
+
+		char			pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int				iFileDescriptor = -1;
+
+		void			*pvNumStreamEncoder = NULL;
+		void			*pvNumStreamDecoder = NULL;
+		void			*pvNumAsyncSource = NULL;
+
+		unsigned int	puiValues[1000];
+		unsigned int	uiValuesLength = 0;
+
+		unsigned int	uiFormat = 0;
+		unsigned int	uiMode = 0;
+		unsigned int	uiJ = 0;
+		unsigned int	uiValueExpected = 0;
+		boolean			bIoUring = false;
+		int				iError = NUM_NoError;
+
+
+		printf("Async source test\n\n");
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+			if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+				printf("Failed to create a temporary file\n");
+				exit (-1);
+			}
+			unlink(pucFilePath);
+
+			if ( (iError = iNumStreamEncoderCreate(uiFormat, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to create a stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			for ( uiJ = 0; uiJ < (ITERATIONS + 3); uiJ++ ) {
+				if ( (iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, uiJ % (NUM_COMPACT_VARINT_MAX_VALUE + 1))) != NUM_NoError ) {
+					printf("Failed to add an integer, error: %d.\n", iError);
+					exit (-1);
+				}
+			}
+
+			if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to close the stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			/* Decode with io_uring and with the read thread, using small reads to cycle the slots */
+			for ( uiMode = 0; uiMode < 2; uiMode++ ) {
+
+				if ( (iError = iNumAsyncSourceCreate(iFileDescriptor, 4, 4096 + 13, (uiMode == 0) ? true : false, &pvNumAsyncSource)) != NUM_NoError ) {
+					printf("Failed to create an async source, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				iNumAsyncSourceIsIoUring(pvNumAsyncSource, &bIoUring);
+				printf("Format: %u, reading with %s\n", uiFormat, (bIoUring == true) ? "io_uring" : "a read thread");
+
+				if ( (iError = iNumStreamDecoderCreate(uiFormat, 0, 0, iNumStreamSourceAsync, pvNumAsyncSource, &pvNumStreamDecoder)) != NUM_NoError ) {
+					printf("Failed to create a stream decoder, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				for ( uiValueExpected = 0; ; ) {
+
+					if ( (iError = iNumStreamDecoderNextBatch(pvNumStreamDecoder, puiValues, 1000, &uiValuesLength)) == NUM_EndOfStream ) {
+						break;
+					}
+					else if ( iError != NUM_NoError ) {
+						printf("Failed to decode integers, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					for ( uiJ = 0; uiJ < uiValuesLength; uiJ++, uiValueExpected++ ) {
+						if ( puiValues[uiJ] != (uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1)) ) {
+							printf("Failed, read: %u, expected: %u.\n", puiValues[uiJ], uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1));
+							exit (-1);
+						}
+					}
+				}
+
+				if ( uiValueExpected != (ITERATIONS + 3) ) {
+					printf("Failed, integers read: %u, expected: %u.\n", uiValueExpected, ITERATIONS + 3);
+					exit (-1);
+				}
+
+				iNumStreamDecoderFree(pvNumStreamDecoder);
+				iNumAsyncSourceFree(pvNumAsyncSource);
+			}
+
+			close(iFileDescriptor);
+		}
+
+		printf("\nAsync source test complete\n\n");
+
+	}
+#endif	/* defined(TEST_ASYNC_SOURCE) */
+
+
+#if defined(TEST_ARENA)
+	/* Arena test */
+	{
+
+		void				*pvNumArena = NULL;
+		void				*pvNumThreadArena = NULL;
+		void				*pvNumThreadArenaAgain = NULL;
+		unsigned char		*ppucBuffers[64];
+		unsigned char		*pucBuffer = NULL;
+		unsigned long long	ullMappedLength = 0;
+		unsigned long long	ullAllocations = 0;
+		unsigned long long	ullReuses = 0;
+		unsigned int		uiFlags = 0;
+		unsigned int		uiI = 0;
+		int					iError = NUM_NoError;
+
+
+		printf("Arena test\n\n");
+
+		for ( uiFlags = 0; uiFlags <= (NUM_ARENA_FLAG_HUGE_PAGES | NUM_ARENA_FLAG_PREFAULT); uiFlags++ ) {
+
+			if ( (iError = iNumArenaCreate(1024 * 1024, uiFlags, &pvNumArena)) != NUM_NoError ) {
+				printf("Failed to create the arena, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			/* Sizes from a byte to beyond the region length, each is aligned and writable */
+			for ( uiI = 0; uiI < 64; uiI++ ) {
+				if ( (iError = iNumArenaAllocate(pvNumArena, (uiI * uiI * 613) + 1, (void **)&ppucBuffers[uiI])) != NUM_NoError ) {
+					printf("Failed to allocate from the arena, error: %d.\n", iError);
+					exit (-1);
+				}
+				if ( ((unsigned long)ppucBuffers[uiI] % NUM_CACHE_LINE_SIZE) != 0 ) {
+					printf("Failed, buffer not aligned.\n");
+					exit (-1);
+				}
+				memset(ppucBuffers[uiI], uiI, (uiI * uiI * 613) + 1);
+			}
+
+			for ( uiI = 0; uiI < 64; uiI++ ) {
+				if ( (ppucBuffers[uiI][0] != uiI) || (ppucBuffers[uiI][uiI * uiI * 613] != uiI) ) {
+					printf("Failed, buffers overlap.\n");
+					exit (-1);
+				}
+			}
+
+			/* Released buffers are reused by allocations of the same size class */
+			iNumArenaRelease(pvNumArena, ppucBuffers[10]);
+			if ( ((iError = iNumArenaAllocate(pvNumArena, 10 * 10 * 613, (void **)&pucBuffer)) != NUM_NoError) || (pucBuffer != ppucBuffers[10]) ) {
+				printf("Failed, buffer not reused.\n");
+				exit (-1);
+			}
+
+			iNumArenaGetCounts(pvNumArena, &ullMappedLength, &ullAllocations, &ullReuses);
+			if ( (ullAllocations != 65) || (ullReuses != 1) ) {
+				printf("Failed, allocations: %llu, reuses: %llu.\n", ullAllocations, ullReuses);
+				exit (-1);
+			}
+
+			iNumArenaFree(pvNumArena);
+		}
+
+		/* The thread arena stays the same for the thread */
+		if ( ((iError = iNumArenaGetThread(&pvNumThreadArena)) != NUM_NoError) || ((iError = iNumArenaGetThread(&pvNumThreadArenaAgain)) != NUM_NoError) ||
+				(pvNumThreadArena != pvNumThreadArenaAgain) ) {
+			printf("Failed, thread arena.\n");
+			exit (-1);
+		}
+
+		printf("Arena test complete\n\n");
+
+	}
+#endif	/* defined(TEST_ARENA) */
+
+
+#if defined(TEST_FIXED_WIDTH)
+	/* Fixed width block test */
+	{
+
+		unsigned int	puiValues[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int	puiValuesRead[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int	puiCounts[] = {0, 1, 3, 4, 15, 16, 17, 31, 33, 128, 1001, NUM_BLOCK_INTEGER_COUNT_MAX};
+		unsigned int	puiMaxValues[] = {0xFF, 0xFFFF, NUM_COMPACT_VARINT_MAX_VALUE};
+		unsigned char	*pucData = NULL;
+		unsigned int	uiDataLength = 0;
+		unsigned int	uiBlockLength = 0;
+		unsigned int	uiValuesLength = 0;
+		unsigned int	uiIntegerCount = 0;
+		unsigned int	uiWidth = 0;
+		unsigned int	uiBlockDataLength = 0;
+		unsigned int	uiHeaderLength = 0;
+		unsigned int	uiFormat = 0;
+		unsigned int	uiI = 0;
+		unsigned int	uiJ = 0;
+		unsigned int	uiK = 0;
+		int				iError = NUM_NoError;
+
+
+		printf("Fixed width block test\n\n");
+
+		NUM_GET_BLOCK_MAX_SIZE(NUM_BLOCK_INTEGER_COUNT_MAX, uiDataLength);
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		srand(1);
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+			for ( uiI = 0; uiI < (sizeof(puiMaxValues) / sizeof(unsigned int)); uiI++ ) {
+				for ( uiJ = 0; uiJ < (sizeof(puiCounts) / sizeof(unsigned int)); uiJ++ ) {
+
+					for ( uiK = 0; uiK < puiCounts[uiJ]; uiK++ ) {
+						puiValues[uiK] = (unsigned int)rand() & puiMaxValues[uiI];
+					}
+
+					uiBlockLength = uiDataLength;
+					if ( (iError = iNumBlockEncode(uiFormat, puiValues, puiCounts[uiJ], pucData, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to encode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					/* The length must match, and integers wider than 2 bytes can not be fixed width */
+					if ( ((iError = iNumBlockGetLength(uiFormat, puiValues, puiCounts[uiJ], &uiDataLength)) != NUM_NoError) || (uiDataLength != uiBlockLength) ) {
+						printf("Failed, block length: %u, expected: %u.\n", uiBlockLength, uiDataLength);
+						exit (-1);
+					}
+					NUM_GET_BLOCK_MAX_SIZE(NUM_BLOCK_INTEGER_COUNT_MAX, uiDataLength);
+
+					if ( (iError = iNumBlockReadHeader(pucData, uiBlockLength, &uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+						printf("Failed to read a block header, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( (puiMaxValues[uiI] > 0xFFFF) && (puiCounts[uiJ] > 32) && (uiWidth != NUM_BLOCK_WIDTH_VARIABLE) ) {
+						printf("Failed, width: %u, expected: %u.\n", uiWidth, NUM_BLOCK_WIDTH_VARIABLE);
+						exit (-1);
+					}
+
+					if ( (puiMaxValues[uiI] == 0xFF) && (uiFormat != NUM_FORMAT_COMPRESSED_UINT) && (puiCounts[uiJ] > 0) && (uiWidth != NUM_BLOCK_WIDTH_1) ) {
+						printf("Failed, width: %u, expected: %u.\n", uiWidth, NUM_BLOCK_WIDTH_1);
+						exit (-1);
+					}
+
+					if ( (iError = iNumBlockDecode(uiFormat, pucData, uiBlockLength, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX,
+							&uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to decode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( (uiValuesLength != puiCounts[uiJ]) || (memcmp(puiValues, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0) ) {
+						printf("Failed, format: %u, count: %u, max value: %u.\n", uiFormat, puiCounts[uiJ], puiMaxValues[uiI]);
+						exit (-1);
+					}
+				}
+			}
+		}
+
+		/* A width which does not match the data length is corrupt */
+		pucData[0] = (2 << NUM_BLOCK_WIDTH_BITS) | NUM_BLOCK_WIDTH_2;
+		pucData[1] = 3;
+		if ( iNumBlockDecode(NUM_FORMAT_VARINT_QUAD, pucData, 5, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX, &uiValuesLength, &uiBlockLength) != NUM_CorruptDataError ) {
+			printf("Failed, corrupt block decoded.\n");
+			exit (-1);
+		}
+
+		free(pucData);
+
+		printf("Fixed width block test complete\n\n");
+
+	}
+#endif	/* defined(TEST_FIXED_WIDTH) */
+
+
+#if defined(TEST_HISTOGRAM)
+	/* Histogram test */
+	{
+
+		void				*pvNumHistogram = NULL;
+		void				*pvNumHistogramMerged = NULL;
+		void				*pvNumThreadHistogram = NULL;
+		unsigned long long	ullCount = 0;
+		unsigned long long	ullMinValue = 0;
+		unsigned long long	ullMaxValue = 0;
+		unsigned long long	ullValue = 0;
+		unsigned long long	ullExpected = 0;
+		double				dMeanValue = 0;
+		double				dPercentile = 0;
+		unsigned int		uiI = 0;
+		int					iError = NUM_NoError;
+
+
+		printf("Histogram test\n\n");
+
+		if ( ((iError = iNumHistogramCreate(&pvNumHistogram)) != NUM_NoError) || ((iError = iNumHistogramCreate(&pvNumHistogramMerged)) != NUM_NoError) ) {
+			printf("Failed to create a histogram, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		/* Values 1 to 1,000,000, each percentile is within the bucket precision of the exact one */
+		for ( uiI = 1; uiI <= 1000000; uiI++ ) {
+			iNumHistogramRecord(pvNumHistogram, uiI);
+		}
+
+		iNumHistogramGetCounts(pvNumHistogram, &ullCount, &ullMinValue, &ullMaxValue, &dMeanValue);
+		if ( (ullCount != 1000000) || (ullMinValue != 1) || (ullMaxValue != 1000000) || (dMeanValue != 500000.5) ) {
+			printf("Failed, count: %llu, min: %llu, max: %llu, mean: %f.\n", ullCount, ullMinValue, ullMaxValue, dMeanValue);
+			exit (-1);
+		}
+
+		for ( dPercentile = 0; dPercentile <= 100; dPercentile += 0.5 ) {
+			iNumHistogramGetPercentile(pvNumHistogram, dPercentile, &ullValue);
+			ullExpected = (dPercentile == 0) ? 1 : (unsigned long long)ceil(dPercentile * 10000);
+			if ( (ullValue < ullExpected) || (ullValue > (ullExpected + (ullExpected >> NUM_HISTOGRAM_SUB_BUCKET_BITS))) ) {
+				printf("Failed, p%g: %llu, expected: %llu.\n", dPercentile, ullValue, ullExpected);
+				exit (-1);
+			}
+		}
+
+		/* Small values are exact, large ones do not overflow */
+		iNumHistogramReset(pvNumHistogram);
+		iNumHistogramRecord(pvNumHistogram, 7);
+		iNumHistogramRecord(pvNumHistogram, ~0ULL);
+		iNumHistogramGetPercentile(pvNumHistogram, 50, &ullValue);
+		if ( ullValue != 7 ) {
+			printf("Failed, p50: %llu, expected: 7.\n", ullValue);
+			exit (-1);
+		}
+		iNumHistogramGetPercentile(pvNumHistogram, 100, &ullValue);
+		if ( ullValue != ~0ULL ) {
+			printf("Failed, p100: %llu, expected: %llu.\n", ullValue, ~0ULL);
+			exit (-1);
+		}
+
+		/* Thread histograms are merged, including those of threads which have exited */
+		iNumHistogramResetThreads();
+
+		if ( (iError = iNumHistogramGetThread(&pvNumThreadHistogram)) != NUM_NoError ) {
+			printf("Failed to get the thread histogram, error: %d.\n", iError);
+			exit (-1);
+		}
+		iNumHistogramRecord(pvNumThreadHistogram, 100);
+
+		iNumHistogramMerge(pvNumHistogramMerged, pvNumHistogram);
+		iNumHistogramMergeThreads(pvNumHistogramMerged);
+
+		iNumHistogramGetCounts(pvNumHistogramMerged, &ullCount, &ullMinValue, &ullMaxValue, NULL);
+		if ( (ullCount != 3) || (ullMinValue != 7) || (ullMaxValue != ~0ULL) ) {
+			printf("Failed, merged count: %llu, min: %llu, max: %llu.\n", ullCount, ullMinValue, ullMaxValue);
+			exit (-1);
+		}
+
+		iNumHistogramFree(pvNumHistogramMerged);
+		iNumHistogramFree(pvNumHistogram);
+
+		printf("Histogram test complete\n\n");
+
+	}
+#endif	/* defined(TEST_HISTOGRAM) */
+
+
+
+#if defined(TEST_AGGREGATE)
+	/* Aggregate test */
+	{
+
+		unsigned int		puiValues[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int		puiCounts[] = {0, 1, 3, 4, 7, 8, 9, 31, 33, 128, 1001, NUM_BLOCK_INTEGER_COUNT_MAX};
+		unsigned int		puiMaxValues[] = {0xFF, 0xFFFF, NUM_COMPACT_VARINT_MAX_VALUE, 0xFFFFFFFF};
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned char		*pucDataEndPtr = NULL;
+		unsigned int		uiDataLength = 0;
+		unsigned int		uiBlockLength = 0;
+		unsigned int		uiFormat = 0;
+		unsigned int		uiMaxValue = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		unsigned int		uiCorruptCount = 0;
+		unsigned int		uiCorruptLength = 0;
+		unsigned int		uiHeaderLength = 0;
+		int					iError = NUM_NoError;
+		struct numAggregate	naNumAggregate;
+		struct numAggregate	naNumAggregateExpected;
+
+
+		printf("Aggregate test\n\n");
+
+		NUM_GET_BLOCK_MAX_SIZE(NUM_BLOCK_INTEGER_COUNT_MAX, uiDataLength);
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		srand(1);
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+			for ( uiI = 0; uiI < (sizeof(puiMaxValues) / sizeof(unsigned int)); uiI++ ) {
+
+				uiMaxValue = ((uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (puiMaxValues[uiI] > NUM_COMPACT_VARINT_MAX_VALUE)) ?
+						NUM_COMPACT_VARINT_MAX_VALUE : puiMaxValues[uiI];
+
+				for ( uiJ = 0; uiJ < (sizeof(puiCounts) / sizeof(unsigned int)); uiJ++ ) {
+
+					/* Count the middle half of the value range */
+					iNumAggregateInit(&naNumAggregateExpected, uiMaxValue / 4, uiMaxValue - (uiMaxValue / 4));
+					for ( uiK = 0; uiK < puiCounts[uiJ]; uiK++ ) {
+						puiValues[uiK] = (((unsigned int)rand() << 16) ^ (unsigned int)rand()) & uiMaxValue;
+						naNumAggregateExpected.ullCount++;
+						naNumAggregateExpected.ullSum += puiValues[uiK];
+						naNumAggregateExpected.uiMinValue = (puiValues[uiK] < naNumAggregateExpected.uiMinValue) ? puiValues[uiK] : naNumAggregateExpected.uiMinValue;
+						naNumAggregateExpected.uiMaxValue = (puiValues[uiK] > naNumAggregateExpected.uiMaxValue) ? puiValues[uiK] : naNumAggregateExpected.uiMaxValue;
+						naNumAggregateExpected.ullRangeCount += ((puiValues[uiK] >= naNumAggregateExpected.uiRangeMinValue) &&
+								(puiValues[uiK] <= naNumAggregateExpected.uiRangeMaxValue));
+					}
+
+					/* Aggregate the block */
+					uiBlockLength = uiDataLength;
+					if ( (iError = iNumBlockEncode(uiFormat, puiValues, puiCounts[uiJ], pucData, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to encode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					iNumAggregateInit(&naNumAggregate, naNumAggregateExpected.uiRangeMinValue, naNumAggregateExpected.uiRangeMaxValue);
+					if ( (iError = iNumBlockAggregate(uiFormat, pucData, uiBlockLength, &naNumAggregate, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to aggregate a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( memcmp(&naNumAggregate, &naNumAggregateExpected, sizeof(struct numAggregate)) != 0 ) {
+						printf("Failed, block, format: %u, count: %u, max value: %u, sum: %llu, expected: %llu.\n", uiFormat, puiCounts[uiJ], uiMaxValue,
+								naNumAggregate.ullSum, naNumAggregateExpected.ullSum);
+						exit (-1);
+					}
+
+					if ( uiFormat == NUM_FORMAT_COMPRESSED_UINT ) {
+						continue;
+					}
+
+					/* Aggregate the quads, the padding of the last quad must be skipped */
+					for ( uiK = 0, pucDataPtr = pucData; uiK < puiCounts[uiJ]; uiK += 4 ) {
+						NUM_WRITE_QUAD(uiFormat, puiValues[uiK], (uiK + 1 < puiCounts[uiJ]) ? puiValues[uiK + 1] : uiMaxValue,
+								(uiK + 2 < puiCounts[uiJ]) ? puiValues[uiK + 2] : uiMaxValue, (uiK + 3 < puiCounts[uiJ]) ? puiValues[uiK + 3] : uiMaxValue, pucDataPtr);
+					}
+					pucDataEndPtr = pucDataPtr;
+
+					iNumAggregateInit(&naNumAggregate, naNumAggregateExpected.uiRangeMinValue, naNumAggregateExpected.uiRangeMaxValue);
+					if ( (iError = iNumAggregateQuads(uiFormat, pucData, puiCounts[uiJ], &naNumAggregate, &pucDataPtr)) != NUM_NoError ) {
+						printf("Failed to aggregate quads, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( (pucDataPtr != pucDataEndPtr) || (memcmp(&naNumAggregate, &naNumAggregateExpected, sizeof(struct numAggregate)) != 0) ) {
+						printf("Failed, quads, format: %u, count: %u, max value: %u, sum: %llu, expected: %llu.\n", uiFormat, puiCounts[uiJ], uiMaxValue,
+								naNumAggregate.ullSum, naNumAggregateExpected.ullSum);
+						exit (-1);
+					}
+				}
+			}
+		}
+
+		/* Corrupt headers must be rejected without reading past the data, a count too large for the data
+		** length, then quads that are longer than the data length, the block is put at the end of the buffer
+		*/
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			for ( uiI = 0; uiI < 2; uiI++ ) {
+
+				uiCorruptCount = (uiI == 0) ? 4096 : 8;
+				uiCorruptLength = (uiI == 0) ? 1 : (uiFormat == NUM_FORMAT_COMPRESSED_UINT) ? 8 : (uiFormat == NUM_FORMAT_VARINT_QUAD) ? 10 : 2;
+
+				pucDataEndPtr = pucData;
+				NUM_WRITE_COMPRESSED_UINT((uiCorruptCount << NUM_BLOCK_WIDTH_BITS) | NUM_BLOCK_WIDTH_VARIABLE, pucDataEndPtr);
+				NUM_WRITE_COMPRESSED_UINT(uiCorruptLength, pucDataEndPtr);
+				uiHeaderLength = pucDataEndPtr - pucData;
+
+				pucDataPtr = pucData + uiDataLength - uiHeaderLength - uiCorruptLength;
+				memmove(pucDataPtr, pucData, uiHeaderLength);
+				memset(pucDataPtr + uiHeaderLength, 0xFF, uiCorruptLength + NUM_READ_PADDING_SIZE);
+
+				iNumAggregateInit(&naNumAggregate, 0, 0);
+				if ( (iError = iNumBlockAggregate(uiFormat, pucDataPtr, uiHeaderLength + uiCorruptLength, &naNumAggregate, &uiBlockLength)) != NUM_CorruptDataError ) {
+					printf("Failed to reject a corrupt block, format: %u, integers: %u, error: %d.\n", uiFormat, uiCorruptCount, iError);
 					exit (-1);
 				}
-#endif	/* defined(CHECK_READ) */
 			}
 		}
-	
-		gettimeofday(&tvEndTimeVal, NULL);
-	
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
-		printf("Reading compressed uint in place, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		printf("\n\n");
-	
+		/* An inverted range is rejected */
+		if ( iNumAggregateInit(&naNumAggregate, 2, 1) != NUM_InvalidParameter ) {
+			printf("Failed, inverted range accepted.\n");
+			exit (-1);
+		}
+
+		free(pucData);
+
+		printf("Aggregate test complete\n\n");
+
 	}
-#endif	/* defined(COMPRESSED_UINT_IN_PLACE) */
+#endif	/* defined(TEST_AGGREGATE) */
 
 
 
-#if defined(VARINT_IN_PLACE)
-	/* Testing varint in place */
+#if defined(TEST_FILTER)
+	/* Filter test */
 	{
-	
+
+		unsigned int		puiValues[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int		puiPositions[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned char		pucBitmap[NUM_GET_FILTER_BITMAP_LENGTH(NUM_BLOCK_INTEGER_COUNT_MAX)];
+		unsigned int		puiBlockPositions[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned char		pucBlockBitmap[NUM_GET_FILTER_BITMAP_LENGTH(NUM_BLOCK_INTEGER_COUNT_MAX)];
+		unsigned int		puiCounts[] = {0, 1, 3, 4, 5, 7, 8, 9, 12, 15, 31, 33, 128, 1001, NUM_BLOCK_INTEGER_COUNT_MAX};
+		unsigned int		puiMaxValues[] = {0xFF, 0xFFFF, NUM_COMPACT_VARINT_MAX_VALUE, 0xFFFFFFFF};
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned char		*pucDataEndPtr = NULL;
+		unsigned int		uiDataLength = 0;
+		unsigned char		*pucBlockData = NULL;
+		unsigned int		uiBlockDataLength = 0;
+		unsigned int		uiBlockLength = 0;
+		unsigned int		uiBlockFilterLength = 0;
+		unsigned int		uiBlockMatchCount = 0;
+		unsigned int		uiCorruptCount = 0;
+		unsigned int		uiCorruptLength = 0;
+		unsigned int		uiHeaderLength = 0;
+		unsigned int		uiFormat = 0;
+		unsigned int		uiMaxValue = 0;
+		unsigned int		uiRangeMinValue = 0;
+		unsigned int		uiRangeMaxValue = 0;
+		unsigned int		uiMatchCount = 0;
+		unsigned int		uiBitmapMatchCount = 0;
+		unsigned int		uiExpectedMatchCount = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		unsigned int		uiL = 0;
+		int					iError = NUM_NoError;
+		boolean				bMatch = false;
+
+
+		printf("Filter test\n\n");
+
+		NUM_GET_BLOCK_MAX_SIZE(NUM_BLOCK_INTEGER_COUNT_MAX, uiDataLength);
+		if ( ((pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL) || ((pucBlockData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+		uiBlockDataLength = uiDataLength;
+
+		srand(1);
+
+		for ( uiFormat = NUM_FORMAT_VARINT_QUAD; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+			for ( uiI = 0; uiI < (sizeof(puiMaxValues) / sizeof(unsigned int)); uiI++ ) {
+
+				uiMaxValue = ((uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (puiMaxValues[uiI] > NUM_COMPACT_VARINT_MAX_VALUE)) ?
+						NUM_COMPACT_VARINT_MAX_VALUE : puiMaxValues[uiI];
+
+				for ( uiJ = 0; uiJ < (sizeof(puiCounts) / sizeof(unsigned int)); uiJ++ ) {
+
+					/* The smallest integers have runs of zeros so the blocks cover every width */
+					for ( uiK = 0; uiK < puiCounts[uiJ]; uiK++ ) {
+						puiValues[uiK] = ((uiI == 0) && (((uiK / 64) % 2) == 0)) ? 0 : (((unsigned int)rand() << 16) ^ (unsigned int)rand()) & uiMaxValue;
+					}
+
+					uiBlockLength = uiBlockDataLength;
+					if ( (iError = iNumBlockEncode(uiFormat, puiValues, puiCounts[uiJ], pucBlockData, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to encode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					/* The padding is the largest integer so a 'greater than' filter would select it */
+					for ( uiK = 0, pucDataPtr = pucData; uiK < puiCounts[uiJ]; uiK += 4 ) {
+						NUM_WRITE_QUAD(uiFormat, puiValues[uiK], (uiK + 1 < puiCounts[uiJ]) ? puiValues[uiK + 1] : uiMaxValue,
+								(uiK + 2 < puiCounts[uiJ]) ? puiValues[uiK + 2] : uiMaxValue, (uiK + 3 < puiCounts[uiJ]) ? puiValues[uiK + 3] : uiMaxValue, pucDataPtr);
+					}
+					pucDataEndPtr = pucDataPtr;
+
+					/* A middle range, a 'greater than' range and the full range */
+					for ( uiL = 0; uiL < 3; uiL++ ) {
+
+						uiRangeMinValue = (uiL == 2) ? 0 : uiMaxValue / 4;
+						uiRangeMaxValue = (uiL == 0) ? uiMaxValue - (uiMaxValue / 4) : 0xFFFFFFFF;
+
+						memset(pucBitmap, 0xFF, sizeof(pucBitmap));
+						if ( (iError = iNumFilterQuads(uiFormat, pucData, puiCounts[uiJ], uiRangeMinValue, uiRangeMaxValue, pucBitmap, puiPositions,
+								&uiMatchCount, &pucDataPtr)) != NUM_NoError ) {
+							printf("Failed to filter quads, error: %d.\n", iError);
+							exit (-1);
+						}
+
+						if ( (iError = iNumFilterQuads(uiFormat, pucData, puiCounts[uiJ], uiRangeMinValue, uiRangeMaxValue, NULL, NULL,
+								&uiBitmapMatchCount, NULL)) != NUM_NoError ) {
+							printf("Failed to filter quads, error: %d.\n", iError);
+							exit (-1);
+						}
+
+						if ( (pucDataPtr != pucDataEndPtr) || (uiBitmapMatchCount != uiMatchCount) ) {
+							printf("Failed, format: %u, count: %u, matches: %u, expected: %u.\n", uiFormat, puiCounts[uiJ], uiBitmapMatchCount, uiMatchCount);
+							exit (-1);
+						}
+
+						for ( uiK = 0, uiExpectedMatchCount = 0; uiK < puiCounts[uiJ]; uiK++ ) {
+
+							bMatch = ((puiValues[uiK] >= uiRangeMinValue) && (puiValues[uiK] <= uiRangeMaxValue)) ? true : false;
+
+							if ( ((pucBitmap[uiK / 8] >> (uiK % 8)) & 1) != bMatch ) {
+								printf("Failed, format: %u, count: %u, bitmap bit: %u.\n", uiFormat, puiCounts[uiJ], uiK);
+								exit (-1);
+							}
+
+							if ( bMatch == true ) {
+								if ( (uiExpectedMatchCount >= uiMatchCount) || (puiPositions[uiExpectedMatchCount] != uiK) ) {
+									printf("Failed, format: %u, count: %u, position: %u.\n", uiFormat, puiCounts[uiJ], uiK);
+									exit (-1);
+								}
+								uiExpectedMatchCount++;
+							}
+						}
+
+						/* The bits past the last integer are clear */
+						if ( ((puiCounts[uiJ] % 8) != 0) && ((pucBitmap[puiCounts[uiJ] / 8] >> (puiCounts[uiJ] % 8)) != 0) ) {
+							printf("Failed, format: %u, count: %u, bitmap padding is set.\n", uiFormat, puiCounts[uiJ]);
+							exit (-1);
+						}
+
+						if ( uiExpectedMatchCount != uiMatchCount ) {
+							printf("Failed, format: %u, count: %u, matches: %u, expected: %u.\n", uiFormat, puiCounts[uiJ], uiMatchCount, uiExpectedMatchCount);
+							exit (-1);
+						}
+
+						/* The block gives the same matches as the quads */
+						if ( (iError = iNumBlockFilter(uiFormat, pucBlockData, uiBlockLength, uiRangeMinValue, uiRangeMaxValue, pucBlockBitmap, puiBlockPositions,
+								&uiBlockMatchCount, &uiBlockFilterLength)) != NUM_NoError ) {
+							printf("Failed to filter a block, error: %d.\n", iError);
+							exit (-1);
+						}
+
+						if ( (uiBlockFilterLength != uiBlockLength) || (uiBlockMatchCount != uiMatchCount) ||
+								(memcmp(pucBlockBitmap, pucBitmap, NUM_GET_FILTER_BITMAP_LENGTH(puiCounts[uiJ])) != 0) ||
+								(memcmp(puiBlockPositions, puiPositions, uiMatchCount * sizeof(unsigned int)) != 0) ) {
+							printf("Failed, block, format: %u, count: %u, matches: %u, expected: %u.\n", uiFormat, puiCounts[uiJ], uiBlockMatchCount, uiMatchCount);
+							exit (-1);
+						}
+					}
+				}
+			}
+		}
+
+		/* Corrupt headers must be rejected without reading past the data, a count too large for the data
+		** length, then quads that are longer than the data length, the block is put at the end of the buffer
+		*/
+		for ( uiFormat = NUM_FORMAT_VARINT_QUAD; uiFormat <= NUM_FORMAT_COMPACT_VARINT_QUAD; uiFormat++ ) {
+
+			for ( uiI = 0; uiI < 2; uiI++ ) {
+
+				uiCorruptCount = (uiI == 0) ? 4096 : 8;
+				uiCorruptLength = (uiI == 0) ? 1 : (uiFormat == NUM_FORMAT_VARINT_QUAD) ? 10 : 2;
+
+				pucDataEndPtr = pucBlockData;
+				NUM_WRITE_COMPRESSED_UINT((uiCorruptCount << NUM_BLOCK_WIDTH_BITS) | NUM_BLOCK_WIDTH_VARIABLE, pucDataEndPtr);
+				NUM_WRITE_COMPRESSED_UINT(uiCorruptLength, pucDataEndPtr);
+				uiHeaderLength = pucDataEndPtr - pucBlockData;
+
+				pucDataPtr = pucBlockData + uiBlockDataLength - uiHeaderLength - uiCorruptLength;
+				memmove(pucDataPtr, pucBlockData, uiHeaderLength);
+				memset(pucDataPtr + uiHeaderLength, 0xFF, uiCorruptLength + NUM_READ_PADDING_SIZE);
+
+				if ( (iError = iNumBlockFilter(uiFormat, pucDataPtr, uiHeaderLength + uiCorruptLength, 0, 0xFFFFFFFF, pucBlockBitmap, puiBlockPositions,
+						&uiBlockMatchCount, &uiBlockFilterLength)) != NUM_CorruptDataError ) {
+					printf("Failed to reject a corrupt block, format: %u, integers: %u, error: %d.\n", uiFormat, uiCorruptCount, iError);
+					exit (-1);
+				}
+			}
+		}
+
+		free(pucData);
+		free(pucBlockData);
+
+		printf("Filter test complete\n\n");
+
+	}
+#endif	/* defined(TEST_FILTER) */
+
+
+
+#if defined(TEST_ZERO_RUN)
+	/* Zero run test */
+	{
+
+		char				pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int					iFileDescriptor = -1;
+
+		void				*pvNumStreamEncoder = NULL;
+		void				*pvNumStreamDecoder = NULL;
+
+		unsigned int		puiValues[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int		puiValuesRead[NUM_BLOCK_INTEGER_COUNT_MAX];
+		unsigned int		puiCounts[] = {1, 3, 4, 5, 8, 9, 128, 1001, NUM_BLOCK_INTEGER_COUNT_MAX};
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucDataPtr = NULL;
+		unsigned int		uiDataLength = 0;
+		unsigned int		uiBlockLength = 0;
+		unsigned int		uiExpectedLength = 0;
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiIntegerCount = 0;
+		unsigned int		uiWidth = 0;
+		unsigned int		uiBlockDataLength = 0;
+		unsigned int		uiHeaderLength = 0;
+		unsigned int		uiFormat = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		unsigned int		uiValue = 0;
+		int					iError = NUM_NoError;
+		unsigned long long	ullByteCount = 0;
+		struct numAggregate	naNumAggregate;
+		struct numAggregate	naNumAggregateExpected;
+
+
+		printf("Zero run test\n\n");
+
+		NUM_GET_BLOCK_MAX_SIZE(NUM_BLOCK_INTEGER_COUNT_MAX, uiDataLength);
+		if ( (pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
+
+		/* Sparse integers, runs of zeros up to 200 long between a few integers */
+		srand(1);
+		for ( uiI = 0; uiI < NUM_BLOCK_INTEGER_COUNT_MAX; ) {
+			for ( uiJ = (unsigned int)rand() % 200; (uiJ > 0) && (uiI < NUM_BLOCK_INTEGER_COUNT_MAX); uiJ--, uiI++ ) {
+				puiValues[uiI] = 0;
+			}
+			for ( uiJ = 1 + ((unsigned int)rand() % 4); (uiJ > 0) && (uiI < NUM_BLOCK_INTEGER_COUNT_MAX); uiJ--, uiI++ ) {
+				puiValues[uiI] = (((unsigned int)rand() << 16) ^ (unsigned int)rand()) & NUM_COMPACT_VARINT_MAX_VALUE;
+			}
+		}
+
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+			for ( uiI = 0; uiI < 2; uiI++ ) {
+				for ( uiJ = 0; uiJ < (sizeof(puiCounts) / sizeof(unsigned int)); uiJ++ ) {
+
+					/* The sparse integers, then all zeros */
+					if ( uiI == 1 ) {
+						memset(puiValues, 0, puiCounts[uiJ] * sizeof(unsigned int));
+					}
+
+					uiBlockLength = uiDataLength;
+					if ( (iError = iNumBlockEncode(uiFormat, puiValues, puiCounts[uiJ], pucData, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to encode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( ((iError = iNumBlockGetLength(uiFormat, puiValues, puiCounts[uiJ], &uiExpectedLength)) != NUM_NoError) || (uiExpectedLength != uiBlockLength) ) {
+						printf("Failed, format: %u, count: %u, block length: %u, expected: %u.\n", uiFormat, puiCounts[uiJ], uiBlockLength, uiExpectedLength);
+						exit (-1);
+					}
+
+					if ( (iError = iNumBlockReadHeader(pucData, uiBlockLength, &uiIntegerCount, &uiWidth, &uiBlockDataLength, &uiHeaderLength)) != NUM_NoError ) {
+						printf("Failed to read a block header, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					/* Long compact varint blocks suppress the zero runs, and all zero blocks take a few bytes */
+					if ( (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (puiCounts[uiJ] >= 128) && (uiWidth != NUM_BLOCK_WIDTH_ZERO_RUN) ) {
+						printf("Failed, width: %u, expected: %u.\n", uiWidth, NUM_BLOCK_WIDTH_ZERO_RUN);
+						exit (-1);
+					}
+
+					if ( (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (uiI == 1) && (uiBlockDataLength > (NUM_COMPACT_VARINT_HEADER_SIZE + NUM_COMPRESSED_UINT_MAX_SIZE)) ) {
+						printf("Failed, count: %u, all zero block data length: %u.\n", puiCounts[uiJ], uiBlockDataLength);
+						exit (-1);
+					}
+
+					if ( (uiFormat != NUM_FORMAT_COMPACT_VARINT_QUAD) && (uiWidth == NUM_BLOCK_WIDTH_ZERO_RUN) ) {
+						printf("Failed, format: %u, zero runs suppressed.\n", uiFormat);
+						exit (-1);
+					}
+
+					if ( (iError = iNumBlockDecode(uiFormat, pucData, uiBlockLength, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX,
+							&uiValuesLength, &uiBlockLength)) != NUM_NoError ) {
+						printf("Failed to decode a block, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( (uiValuesLength != puiCounts[uiJ]) || (memcmp(puiValues, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0) ) {
+						printf("Failed, format: %u, count: %u.\n", uiFormat, puiCounts[uiJ]);
+						exit (-1);
+					}
+
+					/* Count the zeros */
+					iNumAggregateInit(&naNumAggregateExpected, 0, 0);
+					for ( uiK = 0; uiK < puiCounts[uiJ]; uiK++ ) {
+						naNumAggregateExpected.ullCount++;
+						naNumAggregateExpected.ullSum += puiValues[uiK];
+						naNumAggregateExpected.uiMinValue = (puiValues[uiK] < naNumAggregateExpected.uiMinValue) ? puiValues[uiK] : naNumAggregateExpected.uiMinValue;
+						naNumAggregateExpected.uiMaxValue = (puiValues[uiK] > naNumAggregateExpected.uiMaxValue) ? puiValues[uiK] : naNumAggregateExpected.uiMaxValue;
+						naNumAggregateExpected.ullRangeCount += (puiValues[uiK] == 0);
+					}
+
+					iNumAggregateInit(&naNumAggregate, 0, 0);
+					if ( ((iError = iNumBlockAggregate(uiFormat, pucData, uiBlockLength, &naNumAggregate, &uiBlockLength)) != NUM_NoError) ||
+							(memcmp(&naNumAggregate, &naNumAggregateExpected, sizeof(struct numAggregate)) != 0) ) {
+						printf("Failed to aggregate a block, format: %u, count: %u, error: %d.\n", uiFormat, puiCounts[uiJ], iError);
+						exit (-1);
+					}
+				}
+			}
+		}
+
+		/* A run past the end of the block is corrupt, as is a suppressed run in another format */
+		pucData[0] = (4 << NUM_BLOCK_WIDTH_BITS) | NUM_BLOCK_WIDTH_ZERO_RUN;
+		pucData[1] = 2;
+		pucData[2] = 0;
+		pucData[3] = 1;
+		if ( iNumBlockDecode(NUM_FORMAT_COMPACT_VARINT_QUAD, pucData, 4, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX, &uiValuesLength, &uiBlockLength) != NUM_CorruptDataError ) {
+			printf("Failed, corrupt block decoded.\n");
+			exit (-1);
+		}
+
+		pucData[3] = 0;
+		if ( iNumBlockDecode(NUM_FORMAT_VARINT_QUAD, pucData, 4, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX, &uiValuesLength, &uiBlockLength) != NUM_CorruptDataError ) {
+			printf("Failed, corrupt block decoded.\n");
+			exit (-1);
+		}
+
+		/* A quad longer than the rest of the block is corrupt, the block is put at the end of the buffer */
+		pucDataPtr = pucData + uiDataLength - 4;
+		pucDataPtr[0] = (8 << NUM_BLOCK_WIDTH_BITS) | NUM_BLOCK_WIDTH_ZERO_RUN;
+		pucDataPtr[1] = 2;
+		pucDataPtr[2] = 0xFF;
+		pucDataPtr[3] = 0;
+		if ( iNumBlockDecode(NUM_FORMAT_COMPACT_VARINT_QUAD, pucDataPtr, 4, puiValuesRead, NUM_BLOCK_INTEGER_COUNT_MAX, &uiValuesLength, &uiBlockLength) != NUM_CorruptDataError ) {
+			printf("Failed, corrupt block decoded.\n");
+			exit (-1);
+		}
+
+		iNumAggregateInit(&naNumAggregate, 0, 0);
+		if ( iNumBlockAggregate(NUM_FORMAT_COMPACT_VARINT_QUAD, pucDataPtr, 4, &naNumAggregate, &uiBlockLength) != NUM_CorruptDataError ) {
+			printf("Failed, corrupt block aggregated.\n");
+			exit (-1);
+		}
+
+
+		/* A sparse stream through the stream encoder and decoder */
+		strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+		if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+			printf("Failed to create a temporary file\n");
+			exit (-1);
+		}
+		unlink(pucFilePath);
+
+		if ( (iError = iNumStreamEncoderCreate(NUM_FORMAT_COMPACT_VARINT_QUAD, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+			printf("Failed to create a stream encoder, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+			if ( (iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, ((uiI % 1000) == 999) ? uiI & NUM_COMPACT_VARINT_MAX_VALUE : 0)) != NUM_NoError ) {
+				printf("Failed to add an integer, error: %d.\n", iError);
+				exit (-1);
+			}
+		}
+
+		if ( ((iError = iNumStreamEncoderFlush(pvNumStreamEncoder)) != NUM_NoError) ||
+				((iError = iNumStreamEncoderGetCounts(pvNumStreamEncoder, NULL, &ullByteCount)) != NUM_NoError) ||
+				((iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError) ) {
+			printf("Failed to close the stream encoder, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		printf("Sparse stream, integers: %u, bytes: %llu\n", ITERATIONS, ullByteCount);
+
+		lseek(iFileDescriptor, 0, SEEK_SET);
+		if ( (iError = iNumStreamDecoderCreate(NUM_FORMAT_COMPACT_VARINT_QUAD, 0, 0, iNumStreamSourceFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamDecoder)) != NUM_NoError ) {
+			printf("Failed to create a stream decoder, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		for ( uiI = 0; (iError = iNumStreamDecoderNext(pvNumStreamDecoder, &uiValue)) == NUM_NoError; uiI++ ) {
+			if ( uiValue != (((uiI % 1000) == 999) ? uiI & NUM_COMPACT_VARINT_MAX_VALUE : 0) ) {
+				printf("Failed, read: %u, expected: %u.\n", uiValue, ((uiI % 1000) == 999) ? uiI & NUM_COMPACT_VARINT_MAX_VALUE : 0);
+				exit (-1);
+			}
+		}
+
+		if ( (iError != NUM_EndOfStream) || (uiI != ITERATIONS) ) {
+			printf("Failed, integers read: %u, expected: %u, error: %d.\n", uiI, ITERATIONS, iError);
+			exit (-1);
+		}
+
+		iNumStreamDecoderFree(pvNumStreamDecoder);
+		close(iFileDescriptor);
+
+		free(pucData);
+
+		printf("Zero run test complete\n\n");
+
+	}
+#endif	/* defined(TEST_ZERO_RUN) */
+
+
+#if defined(TEST_COMPACT_VARINT_ESCAPE)
+	/* Compact varint escape test */
+	{
+
+		char				pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int					iFileDescriptor = -1;
+
+		void				*pvNumStreamEncoder = NULL;
+		void				*pvNumStreamDecoder = NULL;
+
 		unsigned char		pucData[DATA_LENGTH];
 		unsigned char		*pucDataPtr = NULL;
-	
-		unsigned int		uiValueWritten1 = NUMBER_1;
-		unsigned int		uiValueWritten2 = NUMBER_2;
-		unsigned int		uiValueWritten3 = NUMBER_3;
-		unsigned int		uiValueWritten4 = NUMBER_4;
+		unsigned char		*pucDataEnd = NULL;
+
+		unsigned int		puiValues[] = {0, 1, 0xFF, 0x100, 0xFFFF, 0x10000, 0xFFFFFE, 0xFFFFFF, 0x1000000, 0x7FFFFFFF, 0xFFFFFFFE, 0xFFFFFFFF};
+		unsigned int		puiQuadValues[16];
+		unsigned int		puiQuadValuesRead[16];
+		unsigned int		uiValuesLength = sizeof(puiValues) / sizeof(unsigned int);
 		unsigned int		uiValueRead1 = 0;
 		unsigned int		uiValueRead2 = 0;
 		unsigned int		uiValueRead3 = 0;
 		unsigned int		uiValueRead4 = 0;
-		
+		unsigned int		uiSize = 0;
+		unsigned int		uiFormat = 0;
 		unsigned int		uiI = 0;
 		unsigned int		uiJ = 0;
-	
-		unsigned long long	ullTotalIterations = 0;
-	
-		struct timeval		tvStartTimeVal;
-		struct timeval		tvEndTimeVal;
-		struct timeval		tvDiffTimeVal;
-		double				dMicroSeconds = 0;
-		unsigned char		pucNumberString[STRING_LENGTH];
-		unsigned char		pucString[STRING_LENGTH];
+		unsigned int		uiValue = 0;
+		int					iError = NUM_NoError;
+		unsigned long long	pullByteCounts[NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD + 1];
 
-		
-		memset(pucData, DATA_LENGTH, 0);
-	
+
+		printf("Compact varint escape test\n\n");
+
+		/* Every combination of four of the edge values */
+		for ( uiI = 0; uiI < (uiValuesLength * uiValuesLength * uiValuesLength * uiValuesLength); uiI++ ) {
+
+			puiQuadValues[0] = puiValues[uiI % uiValuesLength];
+			puiQuadValues[1] = puiValues[(uiI / uiValuesLength) % uiValuesLength];
+			puiQuadValues[2] = puiValues[(uiI / (uiValuesLength * uiValuesLength)) % uiValuesLength];
+			puiQuadValues[3] = puiValues[(uiI / (uiValuesLength * uiValuesLength * uiValuesLength)) % uiValuesLength];
+
+			pucDataPtr = pucData;
+			NUM_WRITE_COMPACT_VARINT_ESCAPE_QUAD(puiQuadValues[0], puiQuadValues[1], puiQuadValues[2], puiQuadValues[3], pucDataPtr);
+
+			NUM_GET_COMPACT_VARINT_ESCAPE_QUAD_SIZE(puiQuadValues[0], puiQuadValues[1], puiQuadValues[2], puiQuadValues[3], uiSize);
+			if ( (pucDataPtr - pucData) != uiSize ) {
+				printf("Failed, quad length: %u, expected: %u.\n", (unsigned int)(pucDataPtr - pucData), uiSize);
+				exit (-1);
+			}
+
+			pucDataPtr = pucData;
+			NUM_READ_COMPACT_VARINT_ESCAPE_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+
+			if ( (pucDataPtr - pucData) != uiSize ) {
+				printf("Failed, quad length read: %u, expected: %u.\n", (unsigned int)(pucDataPtr - pucData), uiSize);
+				exit (-1);
+			}
+
+			if ( (uiValueRead1 != puiQuadValues[0]) || (uiValueRead2 != puiQuadValues[1]) || (uiValueRead3 != puiQuadValues[2]) || (uiValueRead4 != puiQuadValues[3]) ) {
+				printf("Failed, read: %u %u %u %u, expected: %u %u %u %u.\n", uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4,
+						puiQuadValues[0], puiQuadValues[1], puiQuadValues[2], puiQuadValues[3]);
+				exit (-1);
+			}
+		}
+
+		/* Runs of quads through the quad decoder */
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+
+			pucDataPtr = pucData;
+			for ( uiJ = 0; uiJ < 16; uiJ += 4 ) {
+				puiQuadValues[uiJ] = puiValues[(uiI + uiJ) % uiValuesLength];
+				puiQuadValues[uiJ + 1] = uiI;
+				puiQuadValues[uiJ + 2] = puiValues[(uiI * 7 + uiJ) % uiValuesLength];
+				puiQuadValues[uiJ + 3] = uiI * 2654435761U;
+				NUM_WRITE_COMPACT_VARINT_ESCAPE_QUAD(puiQuadValues[uiJ], puiQuadValues[uiJ + 1], puiQuadValues[uiJ + 2], puiQuadValues[uiJ + 3], pucDataPtr);
+			}
+
+			if ( ((iError = iNumDecodeQuads(NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD, 0, pucData, 4, puiQuadValuesRead, &pucDataEnd)) != NUM_NoError) ||
+					(pucDataEnd != pucDataPtr) || (memcmp(puiQuadValues, puiQuadValuesRead, sizeof(puiQuadValues)) != 0) ) {
+				printf("Failed to decode quads, iteration: %u, error: %d.\n", uiI, iError);
+				exit (-1);
+			}
+		}
+
+		/* The checked writer rejects integers the compact varint cannot hold and writes nothing */
 		pucDataPtr = pucData;
-		NUM_WRITE_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
-	
-		gettimeofday(&tvStartTimeVal, NULL);
-	
-		for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
-	
-			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
-	
-				pucDataPtr = pucData;
-				NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
-		
-#if defined(CHECK_READ)
-				if ( uiValueRead1 != uiValueWritten1 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
-					exit (-1);
+		NUM_WRITE_COMPACT_VARINT_QUAD_CHECKED(1, 2, NUM_COMPACT_VARINT_MAX_VALUE + 1, 4, pucDataPtr, iError);
+		if ( (iError != NUM_ValueOverflowError) || (pucDataPtr != pucData) ) {
+			printf("Failed, overflow not reported, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		NUM_WRITE_COMPACT_VARINT_QUAD_CHECKED(1, 2, NUM_COMPACT_VARINT_MAX_VALUE, 4, pucDataPtr, iError);
+		NUM_GET_COMPACT_VARINT_QUAD_SIZE(1, 2, NUM_COMPACT_VARINT_MAX_VALUE, 4, uiSize);
+		if ( (iError != NUM_NoError) || ((pucDataPtr - pucData) != uiSize) ) {
+			printf("Failed, checked quad not written, error: %d.\n", iError);
+			exit (-1);
+		}
+
+
+		/* Small integers with rare large outliers through the stream encoder and decoder */
+		for ( uiFormat = NUM_FORMAT_VARINT_QUAD; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
+
+			strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+			if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+				printf("Failed to create a temporary file\n");
+				exit (-1);
+			}
+			unlink(pucFilePath);
+
+			if ( (iError = iNumStreamEncoderCreate(uiFormat, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+				printf("Failed to create a stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+				iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, ((uiI % 997) == 0) ? uiI * 2654435761U : uiI & 0xFFFF);
+
+				/* The compact varint refuses the outliers */
+				if ( (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) && (iError == NUM_ValueOverflowError) ) {
+					break;
 				}
-		
-				if ( uiValueRead2 != uiValueWritten2 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+
+				if ( iError != NUM_NoError ) {
+					printf("Failed to add an integer, error: %d.\n", iError);
 					exit (-1);
 				}
-		
-				if ( uiValueRead3 != uiValueWritten3 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+			}
+
+			if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
+				if ( uiI == ITERATIONS ) {
+					printf("Failed, compact varint overflow not reported.\n");
 					exit (-1);
 				}
-		
-				if ( uiValueRead4 != uiValueWritten4 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+
+				iNumStreamEncoderClose(pvNumStreamEncoder);
+				close(iFileDescriptor);
+				continue;
+			}
+
+			if ( ((iError = iNumStreamEncoderFlush(pvNumStreamEncoder)) != NUM_NoError) ||
+					((iError = iNumStreamEncoderGetCounts(pvNumStreamEncoder, NULL, &pullByteCounts[uiFormat])) != NUM_NoError) ||
+					((iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError) ) {
+				printf("Failed to close the stream encoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			lseek(iFileDescriptor, 0, SEEK_SET);
+			if ( (iError = iNumStreamDecoderCreate(uiFormat, 0, 0, iNumStreamSourceFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamDecoder)) != NUM_NoError ) {
+				printf("Failed to create a stream decoder, error: %d.\n", iError);
+				exit (-1);
+			}
+
+			for ( uiI = 0; (iError = iNumStreamDecoderNext(pvNumStreamDecoder, &uiValue)) == NUM_NoError; uiI++ ) {
+				if ( uiValue != (((uiI % 997) == 0) ? uiI * 2654435761U : uiI & 0xFFFF) ) {
+					printf("Failed, format: %u, read: %u, expected: %u.\n", uiFormat, uiValue, ((uiI % 997) == 0) ? uiI * 2654435761U : uiI & 0xFFFF);
 					exit (-1);
 				}
-#endif	/* defined(CHECK_READ) */
 			}
+
+			if ( (iError != NUM_EndOfStream) || (uiI != ITERATIONS) ) {
+				printf("Failed, integers read: %u, expected: %u, error: %d.\n", uiI, ITERATIONS, iError);
+				exit (-1);
+			}
+
+			iNumStreamDecoderFree(pvNumStreamDecoder);
+			close(iFileDescriptor);
 		}
 
+		printf("Outlier stream, integers: %u, varint bytes: %llu, compact varint escape bytes: %llu\n", ITERATIONS,
+				pullByteCounts[NUM_FORMAT_VARINT_QUAD], pullByteCounts[NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD]);
 
-		gettimeofday(&tvEndTimeVal, NULL);
-	
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
-		printf("Reading varint quad in place, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		printf("\n\n");
+		printf("Compact varint escape test complete\n\n");
 
 	}
-#endif	/* defined(VARINT_IN_PLACE) */
-
+#endif	/* defined(TEST_COMPACT_VARINT_ESCAPE) */
 
 
-#if defined(COMPACT_VARINT_IN_PLACE)
-	/* Testing compact varint in place */
+#if defined(TEST_VARINT_OCTET)
+	/* Varint octet test */
 	{
-	
-		unsigned char		pucData[DATA_LENGTH];
+
+		unsigned char		*pucData = NULL;
 		unsigned char		*pucDataPtr = NULL;
-	
-		unsigned int		uiValueWritten1 = NUMBER_1;
-		unsigned int		uiValueWritten2 = NUMBER_2;
-		unsigned int		uiValueWritten3 = NUMBER_3;
-		unsigned int		uiValueWritten4 = NUMBER_4;
+		unsigned char		*pucDataEnd = NULL;
+
+		unsigned int		*puiValues = NULL;
+		unsigned int		*puiValuesRead = NULL;
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiDataLength = 0;
+		unsigned int		uiSize = 0;
+		unsigned int		uiExpectedSize = 0;
 		unsigned int		uiValueRead1 = 0;
 		unsigned int		uiValueRead2 = 0;
 		unsigned int		uiValueRead3 = 0;
-		unsigned int		uiValueRead4 = 0;
-		
 		unsigned int		uiI = 0;
 		unsigned int		uiJ = 0;
-	
-		unsigned long long	ullTotalIterations = 0;
-	
-		struct timeval		tvStartTimeVal;
-		struct timeval		tvEndTimeVal;
-		struct timeval		tvDiffTimeVal;
-		double				dMicroSeconds = 0;
-		unsigned char		pucNumberString[STRING_LENGTH];
-		unsigned char		pucString[STRING_LENGTH];
+		int					iError = NUM_NoError;
 
-		
-		memset(pucData, DATA_LENGTH, 0);
-	
-		pucDataPtr = pucData;
-		NUM_WRITE_COMPACT_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
-	
-		gettimeofday(&tvStartTimeVal, NULL);
-	
-		for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
-	
-			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
-	
-				pucDataPtr = pucData;
-				NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
-		
-#if defined(CHECK_READ)
-				if ( uiValueRead1 != uiValueWritten1 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
-					exit (-1);
-				}
-		
-				if ( uiValueRead2 != uiValueWritten2 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
-					exit (-1);
-				}
-		
-				if ( uiValueRead3 != uiValueWritten3 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
-					exit (-1);
-				}
-		
-				if ( uiValueRead4 != uiValueWritten4 ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
-					exit (-1);
-				}
-#endif	/* defined(CHECK_READ) */
-			}
+
+		printf("Varint octet test\n\n");
+
+		NUM_GET_VARINT_OCTETS_MAX_SIZE(ITERATIONS, uiDataLength);
+		if ( ((pucData = malloc(uiDataLength + NUM_READ_PADDING_SIZE)) == NULL) ||
+				((puiValues = malloc(ITERATIONS * sizeof(unsigned int))) == NULL) ||
+				((puiValuesRead = malloc(ITERATIONS * sizeof(unsigned int))) == NULL) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
 		}
 
+		/* Integers of every size, mixed at random */
+		srand(1);
+		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+			puiValues[uiI] = (((unsigned int)rand() << 16) ^ (unsigned int)rand()) >> (8 * ((unsigned int)rand() % 4));
+		}
 
-		gettimeofday(&tvEndTimeVal, NULL);
-	
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
-		printf("Reading compact varint quad in place, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		printf("\n\n");
+		/* Pairs, trios and octets */
+		for ( uiI = 0; (uiI + 8) <= ITERATIONS; uiI += 8 ) {
 
-	}
-#endif	/* defined(COMPACT_VARINT_IN_PLACE) */
+			pucDataPtr = pucData;
+			NUM_WRITE_VARINT_PAIR(puiValues[uiI], puiValues[uiI + 1], pucDataPtr);
+			NUM_GET_VARINT_PAIR_SIZE(puiValues[uiI], puiValues[uiI + 1], uiSize);
+			if ( (pucDataPtr - pucData) != uiSize ) {
+				printf("Failed, pair length: %u, expected: %u.\n", (unsigned int)(pucDataPtr - pucData), uiSize);
+				exit (-1);
+			}
 
+			pucDataPtr = pucData;
+			NUM_READ_VARINT_PAIR(uiValueRead1, uiValueRead2, pucDataPtr);
+			if ( ((pucDataPtr - pucData) != uiSize) || (uiValueRead1 != puiValues[uiI]) || (uiValueRead2 != puiValues[uiI + 1]) ) {
+				printf("Failed, read: %u %u, expected: %u %u.\n", uiValueRead1, uiValueRead2, puiValues[uiI], puiValues[uiI + 1]);
+				exit (-1);
+			}
 
+			pucDataPtr = pucData;
+			NUM_WRITE_VARINT_TRIO(puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], pucDataPtr);
+			NUM_GET_VARINT_TRIO_SIZE(puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2], uiSize);
+			if ( (pucDataPtr - pucData) != uiSize ) {
+				printf("Failed, trio length: %u, expected: %u.\n", (unsigned int)(pucDataPtr - pucData), uiSize);
+				exit (-1);
+			}
 
-#if defined(COMPRESSED_UINT_ACROSS_MEMORY)
-	/* Testing compressed uint across memory */
-	{
-	
-	
-		unsigned char		*pucData = NULL;
-		unsigned char		*pucDataPtr = NULL;
+			pucDataPtr = pucData;
+			NUM_READ_VARINT_TRIO(uiValueRead1, uiValueRead2, uiValueRead3, pucDataPtr);
+			if ( ((pucDataPtr - pucData) != uiSize) || (uiValueRead1 != puiValues[uiI]) || (uiValueRead2 != puiValues[uiI + 1]) ||
+					(uiValueRead3 != puiValues[uiI + 2]) ) {
+				printf("Failed, read: %u %u %u, expected: %u %u %u.\n", uiValueRead1, uiValueRead2, uiValueRead3,
+						puiValues[uiI], puiValues[uiI + 1], puiValues[uiI + 2]);
+				exit (-1);
+			}
 
-		unsigned int		uiDataLength = ITERATIONS * 16;
+			pucDataPtr = pucData;
+			NUM_WRITE_VARINT_OCTET(puiValues + uiI, pucDataPtr);
+			NUM_GET_VARINT_OCTET_SIZE(puiValues + uiI, uiSize);
+			if ( (pucDataPtr - pucData) != uiSize ) {
+				printf("Failed, octet length: %u, expected: %u.\n", (unsigned int)(pucDataPtr - pucData), uiSize);
+				exit (-1);
+			}
 
-		unsigned int		uiI = 0;
-		unsigned int		uiJ = 0;
+			pucDataPtr = pucData;
+			NUM_READ_VARINT_OCTET(puiValuesRead, pucDataPtr);
+			if ( ((pucDataPtr - pucData) != uiSize) || (memcmp(puiValuesRead, puiValues + uiI, 8 * sizeof(unsigned int)) != 0) ) {
+				printf("Failed, octet read, iteration: %u.\n", uiI);
+				exit (-1);
+			}
+		}
 
-		unsigned long long	ullTotalIterations = 0;
-	
-		unsigned int		uiValueWritten1 = NUMBER_1;
-		unsigned int		uiValueWritten2 = NUMBER_2;
-		unsigned int		uiValueWritten3 = NUMBER_3;
-		unsigned int		uiValueWritten4 = NUMBER_4;
+		/* Runs of every length up to a few octets, then the whole lot */
+		for ( uiI = 0; uiI <= 80; uiI++ ) {
 
-		unsigned int		uiValueRead1 = 0;
-		unsigned int		uiValueRead2 = 0;
-		unsigned int		uiValueRead3 = 0;
-		unsigned int		uiValueRead4 = 0;
+			uiValuesLength = (uiI < 80) ? uiI : ITERATIONS;
 
-		struct timeval		tvStartTimeVal;
-		struct timeval		tvEndTimeVal;
-		struct timeval		tvDiffTimeVal;
-		double				dMicroSeconds = 0;
-		unsigned char		pucNumberString[STRING_LENGTH];
-		unsigned char		pucString[STRING_LENGTH];
+			for ( uiJ = 0, uiExpectedSize = 0; (uiJ + 4) <= uiValuesLength; uiJ += 4 ) {
+				uiExpectedSize += uiNumGetVarintQuadSize(puiValues[uiJ], puiValues[uiJ + 1], puiValues[uiJ + 2], puiValues[uiJ + 3]);
+			}
+			uiExpectedSize -= (uiValuesLength / 8) * ((2 * NUM_VARINT_HEADER_SIZE) - NUM_VARINT_OCTET_HEADER_SIZE);
+			if ( (uiValuesLength - uiJ) == 3 ) {
+				uiExpectedSize += uiNumGetVarintTrioSize(puiValues[uiJ], puiValues[uiJ + 1], puiValues[uiJ + 2]);
+			}
+			else if ( (uiValuesLength - uiJ) == 2 ) {
+				uiExpectedSize += uiNumGetVarintPairSize(puiValues[uiJ], puiValues[uiJ + 1]);
+			}
+			else if ( (uiValuesLength - uiJ) == 1 ) {
+				uiExpectedSize += uiNumGetVarintPairSize(puiValues[uiJ], 0);
+			}
 
+			if ( (iError = iNumEncodeVarintOctets(puiValues, uiValuesLength, pucData, &pucDataEnd)) != NUM_NoError ) {
+				printf("Failed to encode octets, error: %d.\n", iError);
+				exit (-1);
+			}
 
-		if ( (pucData = malloc(uiDataLength)) == NULL ) {
-			printf("Failed to allocate memory\n");
-			exit (-1);
+			NUM_GET_VARINT_OCTETS_MAX_SIZE(uiValuesLength, uiSize);
+			if ( ((pucDataEnd - pucData) != uiExpectedSize) || ((pucDataEnd - pucData) > uiSize) ) {
+				printf("Failed, count: %u, length: %u, expected: %u, maximum: %u.\n", uiValuesLength, (unsigned int)(pucDataEnd - pucData),
+						uiExpectedSize, uiSize);
+				exit (-1);
+			}
+
+			/* Guard the integer after the run */
+			memset(puiValuesRead, 0xFF, ((uiValuesLength < ITERATIONS) ? (uiValuesLength + 1) : uiValuesLength) * sizeof(unsigned int));
+
+			if ( ((iError = iNumDecodeVarintOctets(pucData, uiValuesLength, puiValuesRead, &pucDataPtr)) != NUM_NoError) || (pucDataPtr != pucDataEnd) ) {
+				printf("Failed to decode octets, count: %u, error: %d.\n", uiValuesLength, iError);
+				exit (-1);
+			}
+
+			if ( memcmp(puiValues, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0 ) {
+				printf("Failed, count: %u, integers read do not match.\n", uiValuesLength);
+				exit (-1);
+			}
+
+			if ( (uiValuesLength < ITERATIONS) && (puiValuesRead[uiValuesLength] != 0xFFFFFFFF) ) {
+				printf("Failed, count: %u, decoded past the end.\n", uiValuesLength);
+				exit (-1);
+			}
 		}
-		
-		memset(pucData, 0, uiDataLength);
 
+		free(pucData);
+		free(puiValues);
+		free(puiValuesRead);
 
-		gettimeofday(&tvStartTimeVal, NULL);
+		printf("Varint octet test complete\n\n");
 
-		for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
-	
-			uiValueWritten1 = uiI;
-			uiValueWritten2 = uiValueWritten1 + 1;
-			uiValueWritten3 = uiValueWritten2 + 1;
-			uiValueWritten4 = uiValueWritten3 + 1;
+	}
+#endif	/* defined(TEST_VARINT_OCTET) */
 
-			NUM_WRITE_COMPRESSED_UINT(uiValueWritten1, pucDataPtr);
-			NUM_WRITE_COMPRESSED_UINT(uiValueWritten2, pucDataPtr);
-			NUM_WRITE_COMPRESSED_UINT(uiValueWritten3, pucDataPtr);
-			NUM_WRITE_COMPRESSED_UINT(uiValueWritten4, pucDataPtr);
-		
+
+#if defined(TEST_MERGE)
+	/* Merge test */
+	{
+
+		char				pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int					piFileDescriptors[MERGE_STREAM_COUNT_MAX + 1];
+		int					iOutputFileDescriptor = -1;
+
+		void				*ppvNumStreamDecoders[MERGE_STREAM_COUNT_MAX];
+		void				*pvNumStreamEncoder = NULL;
+		void				*pvNumStreamDecoder = NULL;
+
+		unsigned char		*pucCounts = NULL;
+		unsigned int		uiCountsLength = 0;
+		unsigned int		puiValues[1000];
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiStreamLength = 0;
+		unsigned int		uiValueExpected = 0;
+		unsigned int		uiCount = 0;
+		unsigned long long	ullIntegerCount = 0;
+		unsigned long long	ullIntegerCountExpected = 0;
+
+		unsigned int		puiStreamCounts[] = {1, 2, 3, 8, MERGE_STREAM_COUNT_MAX};
+		unsigned int		uiStreamCount = 0;
+		unsigned int		uiFormat = 0;
+		unsigned int		uiUnique = 0;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiS = 0;
+		int					iError = NUM_NoError;
+
+
+		printf("Merge test\n\n");
+
+		/* Every stream is sorted and the integers are below ITERATIONS / 4 */
+		uiCountsLength = ITERATIONS / 4;
+		if ( (pucCounts = malloc(uiCountsLength)) == NULL ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
 		}
-	
-		gettimeofday(&tvEndTimeVal, NULL);
 
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
 
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ITERATIONS * 4));
-		printf("Writing compressed uint across memory, numbers written: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+			for ( uiI = 0; uiI < (sizeof(puiStreamCounts) / sizeof(unsigned int)); uiI++ ) {
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				uiStreamCount = puiStreamCounts[uiI];
+				memset(pucCounts, 0, uiCountsLength);
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				/* Stream s holds multiples of s + 1 so the streams overlap, with uneven lengths and an empty stream */
+				for ( uiS = 0; uiS <= uiStreamCount; uiS++ ) {
 
-		snprintf(pucNumberString, STRING_LENGTH, "%u", uiDataLength);
-		printf("\tBytes, allocated: %s", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-		snprintf(pucNumberString, STRING_LENGTH, "%ld", pucDataPtr - pucData);
-		printf(", used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+					strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+					if ( (piFileDescriptors[uiS] = mkstemp(pucFilePath)) == -1 ) {
+						printf("Failed to create a temporary file\n");
+						exit (-1);
+					}
+					unlink(pucFilePath);
 
-		printf("\n");
-		
+					if ( uiS == uiStreamCount ) {
+						break;
+					}
 
-		gettimeofday(&tvStartTimeVal, NULL);
-	
-		for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
+					if ( (iError = iNumStreamEncoderCreate(uiFormat, 0, 0, iNumStreamSinkFileDescriptor, (void *)&piFileDescriptors[uiS], &pvNumStreamEncoder)) != NUM_NoError ) {
+						printf("Failed to create a stream encoder, error: %d.\n", iError);
+						exit (-1);
+					}
 
-			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
+					uiStreamLength = ((uiStreamCount > 2) && (uiS == 1)) ? 0 : ((uiCountsLength - 1) / (uiS + 1));
+					uiStreamLength -= (uiStreamLength > (uiS * 13)) ? (uiS * 13) : 0;
 
-				NUM_READ_COMPRESSED_UINT(uiValueRead1, pucDataPtr);
-				NUM_READ_COMPRESSED_UINT(uiValueRead2, pucDataPtr);
-				NUM_READ_COMPRESSED_UINT(uiValueRead3, pucDataPtr);
-				NUM_READ_COMPRESSED_UINT(uiValueRead4, pucDataPtr);
+					for ( uiJ = 0; uiJ < uiStreamLength; uiJ++ ) {
+						if ( (iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, uiJ * (uiS + 1))) != NUM_NoError ) {
+							printf("Failed to add an integer, error: %d.\n", iError);
+							exit (-1);
+						}
+						pucCounts[uiJ * (uiS + 1)]++;
+					}
 
-#if defined(CHECK_READ)
-				if ( uiValueRead1 != uiJ ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiJ);
-					exit (-1);
-				}
-	
-				if ( uiValueRead2 != (uiJ + 1) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiJ + 1);
-					exit (-1);
+					if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+						printf("Failed to close the stream encoder, error: %d.\n", iError);
+						exit (-1);
+					}
 				}
-	
-				if ( uiValueRead3 != (uiJ + 2) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiJ + 2);
-					exit (-1);
+
+				iOutputFileDescriptor = piFileDescriptors[uiStreamCount];
+
+				for ( uiUnique = 0; uiUnique < 2; uiUnique++ ) {
+
+					/* Merge with a small batch length so the batches are refilled often */
+					for ( uiS = 0; uiS < uiStreamCount; uiS++ ) {
+						lseek(piFileDescriptors[uiS], 0, SEEK_SET);
+						if ( (iError = iNumStreamDecoderCreate(uiFormat, 0, 0, iNumStreamSourceFileDescriptor, (void *)&piFileDescriptors[uiS], &ppvNumStreamDecoders[uiS])) != NUM_NoError ) {
+							printf("Failed to create a stream decoder, error: %d.\n", iError);
+							exit (-1);
+						}
+					}
+
+					lseek(iOutputFileDescriptor, 0, SEEK_SET);
+					if ( ftruncate(iOutputFileDescriptor, 0) == -1 ) {
+						printf("Failed to truncate a temporary file\n");
+						exit (-1);
+					}
+
+					if ( (iError = iNumStreamEncoderCreate(uiFormat, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iOutputFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+						printf("Failed to create a stream encoder, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					if ( (iError = iNumMergeStreams(ppvNumStreamDecoders, uiStreamCount, 7 + uiUnique, (uiUnique == 1) ? true : false, pvNumStreamEncoder, &ullIntegerCount)) != NUM_NoError ) {
+						printf("Failed to merge, streams: %u, error: %d.\n", uiStreamCount, iError);
+						exit (-1);
+					}
+
+					if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+						printf("Failed to close the stream encoder, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					for ( uiS = 0; uiS < uiStreamCount; uiS++ ) {
+						iNumStreamDecoderFree(ppvNumStreamDecoders[uiS]);
+					}
+
+
+					/* Decode the merge and check it against the counts */
+					lseek(iOutputFileDescriptor, 0, SEEK_SET);
+					if ( (iError = iNumStreamDecoderCreate(uiFormat, 0, 0, iNumStreamSourceFileDescriptor, (void *)&iOutputFileDescriptor, &pvNumStreamDecoder)) != NUM_NoError ) {
+						printf("Failed to create a stream decoder, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					for ( uiValueExpected = 0, uiCount = 0, ullIntegerCountExpected = 0; ; ) {
+
+						if ( (iError = iNumStreamDecoderNextBatch(pvNumStreamDecoder, puiValues, 1000, &uiValuesLength)) == NUM_EndOfStream ) {
+							break;
+						}
+						else if ( iError != NUM_NoError ) {
+							printf("Failed to decode integers, error: %d.\n", iError);
+							exit (-1);
+						}
+
+						for ( uiJ = 0; uiJ < uiValuesLength; uiJ++, uiCount++, ullIntegerCountExpected++ ) {
+
+							/* Move on to the next integer once this one has been read as often as expected */
+							while ( (uiValueExpected < uiCountsLength) && (uiCount == ((uiUnique == 1) ? ((pucCounts[uiValueExpected] > 0) ? 1 : 0) : pucCounts[uiValueExpected])) ) {
+								uiValueExpected++;
+								uiCount = 0;
+							}
+
+							if ( puiValues[uiJ] != uiValueExpected ) {
+								printf("Failed, streams: %u, unique: %u, read: %u, expected: %u.\n", uiStreamCount, uiUnique, puiValues[uiJ], uiValueExpected);
+								exit (-1);
+							}
+						}
+					}
+
+					iNumStreamDecoderFree(pvNumStreamDecoder);
+
+					for ( uiJ = 0, uiCount = 0; uiJ < uiCountsLength; uiJ++ ) {
+						uiCount += (uiUnique == 1) ? ((pucCounts[uiJ] > 0) ? 1 : 0) : pucCounts[uiJ];
+					}
+
+					if ( (ullIntegerCount != uiCount) || (ullIntegerCountExpected != uiCount) ) {
+						printf("Failed, streams: %u, unique: %u, integers merged: %llu, read: %llu, expected: %u.\n", uiStreamCount, uiUnique,
+								ullIntegerCount, ullIntegerCountExpected, uiCount);
+						exit (-1);
+					}
 				}
-	
-				if ( uiValueRead4 != (uiJ + 3) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiJ + 3);
-					exit (-1);
+
+				for ( uiS = 0; uiS <= uiStreamCount; uiS++ ) {
+					close(piFileDescriptors[uiS]);
 				}
-#endif	/* defined(CHECK_READ) */
 			}
 		}
-	
-		gettimeofday(&tvEndTimeVal, NULL);
-	
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
-		printf("Reading compressed uint across memory, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		printf("\n\n");
 
-	}
-#endif	/* defined(COMPRESSED_UINT_IN_PLACE) */
 
+		/* A stream which is not sorted */
+		strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+		if ( (piFileDescriptors[0] = mkstemp(pucFilePath)) == -1 ) {
+			printf("Failed to create a temporary file\n");
+			exit (-1);
+		}
+		unlink(pucFilePath);
+
+		if ( (iError = iNumStreamEncoderCreate(NUM_FORMAT_VARINT_QUAD, 0, 0, iNumStreamSinkFileDescriptor, (void *)&piFileDescriptors[0], &pvNumStreamEncoder)) != NUM_NoError ) {
+			printf("Failed to create a stream encoder, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		for ( uiJ = 0; uiJ < 100; uiJ++ ) {
+			iNumStreamEncoderAddInteger(pvNumStreamEncoder, (uiJ == 50) ? 0 : uiJ);
+		}
+
+		iNumStreamEncoderClose(pvNumStreamEncoder);
 
+		lseek(piFileDescriptors[0], 0, SEEK_SET);
+		iNumStreamDecoderCreate(NUM_FORMAT_VARINT_QUAD, 0, 0, iNumStreamSourceFileDescriptor, (void *)&piFileDescriptors[0], &ppvNumStreamDecoders[0]);
 
-#if defined(VARINT_ACROSS_MEMORY)
-	/* Testing varint across memory */
+		if ( (iOutputFileDescriptor = open("/dev/null", O_WRONLY)) == -1 ) {
+			printf("Failed to open /dev/null\n");
+			exit (-1);
+		}
+		iNumStreamEncoderCreate(NUM_FORMAT_VARINT_QUAD, 0, 0, iNumStreamSinkFileDescriptor, (void *)&iOutputFileDescriptor, &pvNumStreamEncoder);
+
+		if ( (iError = iNumMergeStreams(ppvNumStreamDecoders, 1, 0, false, pvNumStreamEncoder, &ullIntegerCount)) != NUM_CorruptDataError ) {
+			printf("Failed, merging a stream which is not sorted, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		iNumStreamDecoderFree(ppvNumStreamDecoders[0]);
+		iNumStreamEncoderClose(pvNumStreamEncoder);
+		close(iOutputFileDescriptor);
+		close(piFileDescriptors[0]);
+
+		free(pucCounts);
+
+		printf("Merge test complete\n\n");
+
+	}
+#endif	/* defined(TEST_MERGE) */
+
+
+#if defined(TEST_TRANSCODE)
+	/* Transcode test */
 	{
-	
-		unsigned char		*pucData = NULL;
-		unsigned char		*pucDataPtr = NULL;
 
-		unsigned int		uiDataLength = ITERATIONS * 16;
+		char				pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int					iSourceFileDescriptor = -1;
+		int					iTargetFileDescriptor = -1;
+
+		void				*pvNumStreamEncoder = NULL;
+		void				*pvNumStreamDecoder = NULL;
 
+		unsigned int		puiBlockLengths[] = {1, 3, 4, 5, 128, 129, 1000};
+		unsigned int		uiBlockLength = 0;
+		unsigned char		*pucData = NULL;
+		unsigned char		*pucTargetData = NULL;
+		unsigned int		uiDataLength = 0;
+		unsigned int		uiTargetDataLength = 0;
+		unsigned int		uiBlockDataLength = 0;
+		unsigned int		uiMaxSize = 0;
+
+		unsigned int		puiValues[1000];
+		unsigned int		puiValuesRead[1000];
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiValueExpected = 0;
+		unsigned long long	ullIntegerCount = 0;
+
+		unsigned int		uiSourceFormat = 0;
+		unsigned int		uiTargetFormat = 0;
+		unsigned int		uiPattern = 0;
+		unsigned int		uiRandom = 1;
 		unsigned int		uiI = 0;
 		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
+		int					iErrorExpected = NUM_NoError;
 
-		unsigned long long	ullTotalIterations = 0;
-	
-		unsigned int		uiValueWritten1 = NUMBER_1;
-		unsigned int		uiValueWritten2 = NUMBER_2;
-		unsigned int		uiValueWritten3 = NUMBER_3;
-		unsigned int		uiValueWritten4 = NUMBER_4;
-
-		unsigned int		uiValueRead1 = 0;
-		unsigned int		uiValueRead2 = 0;
-		unsigned int		uiValueRead3 = 0;
-		unsigned int		uiValueRead4 = 0;
-
-		unsigned int		uiValueRead = 0;
 
-		struct timeval		tvStartTimeVal;
-		struct timeval		tvEndTimeVal;
-		struct timeval		tvDiffTimeVal;
-		double				dMicroSeconds = 0;
-		unsigned char		pucNumberString[STRING_LENGTH];
-		unsigned char		pucString[STRING_LENGTH];
+		printf("Transcode test\n\n");
 
+		NUM_GET_BLOCK_MAX_SIZE(1000, uiMaxSize);
 
-		if ( (pucData = malloc(uiDataLength)) == NULL ) {
+		if ( ((pucData = malloc(uiMaxSize + NUM_READ_PADDING_SIZE)) == NULL) || ((pucTargetData = malloc(uiMaxSize + NUM_READ_PADDING_SIZE)) == NULL) ) {
 			printf("Failed to allocate memory\n");
 			exit (-1);
 		}
 
-		memset(pucData, 0, uiDataLength);
+		for ( uiSourceFormat = NUM_FORMAT_COMPRESSED_UINT; uiSourceFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiSourceFormat++ ) {
 
+			for ( uiTargetFormat = NUM_FORMAT_COMPRESSED_UINT; uiTargetFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiTargetFormat++ ) {
 
-		gettimeofday(&tvStartTimeVal, NULL);
+				/* Blocks of every length with 1 and 2 byte integers, zero runs, compact varints and full integers */
+				for ( uiI = 0; uiI < (sizeof(puiBlockLengths) / sizeof(unsigned int)); uiI++ ) {
 
-		for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
-	
-			uiValueWritten1 = uiI;
-			uiValueWritten2 = uiValueWritten1 + 1;
-			uiValueWritten3 = uiValueWritten2 + 1;
-			uiValueWritten4 = uiValueWritten3 + 1;
+					uiBlockLength = puiBlockLengths[uiI];
 
-			NUM_WRITE_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+					for ( uiPattern = 0; uiPattern < 5; uiPattern++ ) {
 
-		}
-	
-		gettimeofday(&tvEndTimeVal, NULL);
+						/* Full integers can not be encoded as compact varints */
+						if ( (uiPattern == 4) && (uiSourceFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) ) {
+							continue;
+						}
 
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
+						for ( uiJ = 0; uiJ < uiBlockLength; uiJ++ ) {
+							uiRandom ^= uiRandom << 13;
+							uiRandom ^= uiRandom >> 17;
+							uiRandom ^= uiRandom << 5;
+							puiValues[uiJ] = (uiPattern == 0) ? (uiRandom & 0xFF) : (uiPattern == 1) ? (uiRandom & 0xFFFF) :
+									(uiPattern == 2) ? (((uiJ % 37) == 0) ? (uiRandom & NUM_COMPACT_VARINT_MAX_VALUE) : 0) :
+									(uiPattern == 3) ? (uiRandom & NUM_COMPACT_VARINT_MAX_VALUE) : (uiRandom | 0x80000000);
+						}
 
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ITERATIONS * 4));
-		printf("Writing varint across memory, numbers written: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+						if ( (iError = iNumBlockEncode(uiSourceFormat, puiValues, uiBlockLength, pucData, &uiDataLength)) != NUM_NoError ) {
+							printf("Failed to encode a block, error: %d.\n", iError);
+							exit (-1);
+						}
+						memset(pucData + uiDataLength, 0, NUM_READ_PADDING_SIZE);
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+						iErrorExpected = ((uiPattern == 4) && (uiTargetFormat == NUM_FORMAT_COMPACT_VARINT_QUAD)) ? NUM_ValueOverflowError : NUM_NoError;
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+						if ( (iError = iNumBlockTranscode(uiSourceFormat, pucData, uiDataLength, uiTargetFormat, pucTargetData, &uiTargetDataLength, &uiBlockDataLength)) != iErrorExpected ) {
+							printf("Failed to transcode a block from format %u to format %u, length: %u, pattern: %u, error: %d, expected: %d.\n",
+									uiSourceFormat, uiTargetFormat, uiBlockLength, uiPattern, iError, iErrorExpected);
+							exit (-1);
+						}
 
-		snprintf(pucNumberString, STRING_LENGTH, "%u", uiDataLength);
-		printf("\tBytes, allocated: %s", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-		snprintf(pucNumberString, STRING_LENGTH, "%ld", pucDataPtr - pucData);
-		printf(", used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+						if ( iError != NUM_NoError ) {
+							continue;
+						}
 
-		printf("\n");
+						if ( uiBlockDataLength != uiDataLength ) {
+							printf("Failed, block length: %u, expected: %u.\n", uiBlockDataLength, uiDataLength);
+							exit (-1);
+						}
 
+						memset(pucTargetData + uiTargetDataLength, 0, NUM_READ_PADDING_SIZE);
 
-		gettimeofday(&tvStartTimeVal, NULL);
-	
-		for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
-	
-			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
-	
-				NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
-	
-#if defined(CHECK_READ)
-				if ( uiValueRead1 != uiJ ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiJ);
+						if ( ((iError = iNumBlockDecode(uiTargetFormat, pucTargetData, uiTargetDataLength, puiValuesRead, 1000, &uiValuesLength, &uiBlockDataLength)) != NUM_NoError) ||
+								(uiValuesLength != uiBlockLength) || (uiBlockDataLength != uiTargetDataLength) ) {
+							printf("Failed to decode a transcoded block from format %u to format %u, length: %u, pattern: %u, error: %d.\n",
+									uiSourceFormat, uiTargetFormat, uiBlockLength, uiPattern, iError);
+							exit (-1);
+						}
+
+						if ( memcmp(puiValues, puiValuesRead, uiBlockLength * sizeof(unsigned int)) != 0 ) {
+							printf("Failed, format %u to format %u, length: %u, pattern: %u, integers read do not match.\n", uiSourceFormat, uiTargetFormat, uiBlockLength, uiPattern);
+							exit (-1);
+						}
+					}
+				}
+
+
+				/* Transcode a stream between files, re-blocking it */
+				strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+				if ( (iSourceFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+					printf("Failed to create a temporary file\n");
 					exit (-1);
 				}
-	
-				if ( uiValueRead2 != (uiJ + 1) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiJ + 1);
+				unlink(pucFilePath);
+
+				strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+				if ( (iTargetFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+					printf("Failed to create a temporary file\n");
 					exit (-1);
 				}
-	
-				if ( uiValueRead3 != (uiJ + 2) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiJ + 2);
+				unlink(pucFilePath);
+
+				if ( (iError = iNumStreamEncoderCreate(uiSourceFormat, 1000, 0, iNumStreamSinkFileDescriptor, (void *)&iSourceFileDescriptor, &pvNumStreamEncoder)) != NUM_NoError ) {
+					printf("Failed to create a stream encoder, error: %d.\n", iError);
 					exit (-1);
 				}
-	
-				if ( uiValueRead4 != (uiJ + 3) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiJ + 3);
+
+				for ( uiJ = 0; uiJ < (ITERATIONS + 3); uiJ++ ) {
+					if ( (iError = iNumStreamEncoderAddInteger(pvNumStreamEncoder, uiJ % (NUM_COMPACT_VARINT_MAX_VALUE + 1))) != NUM_NoError ) {
+						printf("Failed to add an integer, error: %d.\n", iError);
+						exit (-1);
+					}
+				}
+
+				if ( (iError = iNumStreamEncoderClose(pvNumStreamEncoder)) != NUM_NoError ) {
+					printf("Failed to close the stream encoder, error: %d.\n", iError);
 					exit (-1);
 				}
-#endif	/* defined(CHECK_READ) */
+
+				lseek(iSourceFileDescriptor, 0, SEEK_SET);
+
+				if ( (iError = iNumStreamTranscode(uiSourceFormat, 1000, iNumStreamSourceFileDescriptor, (void *)&iSourceFileDescriptor,
+						uiTargetFormat, 0, iNumStreamSinkFileDescriptor, (void *)&iTargetFileDescriptor, &ullIntegerCount)) != NUM_NoError ) {
+					printf("Failed to transcode a stream from format %u to format %u, error: %d.\n", uiSourceFormat, uiTargetFormat, iError);
+					exit (-1);
+				}
+
+				if ( ullIntegerCount != (ITERATIONS + 3) ) {
+					printf("Failed, integers transcoded: %llu, expected: %u.\n", ullIntegerCount, ITERATIONS + 3);
+					exit (-1);
+				}
+
+				lseek(iTargetFileDescriptor, 0, SEEK_SET);
+
+				if ( (iError = iNumStreamDecoderCreate(uiTargetFormat, 0, 0, iNumStreamSourceFileDescriptor, (void *)&iTargetFileDescriptor, &pvNumStreamDecoder)) != NUM_NoError ) {
+					printf("Failed to create a stream decoder, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				for ( uiValueExpected = 0; ; ) {
+
+					if ( (iError = iNumStreamDecoderNextBatch(pvNumStreamDecoder, puiValuesRead, 1000, &uiValuesLength)) == NUM_EndOfStream ) {
+						break;
+					}
+					else if ( iError != NUM_NoError ) {
+						printf("Failed to decode integers, error: %d.\n", iError);
+						exit (-1);
+					}
+
+					for ( uiK = 0; uiK < uiValuesLength; uiK++, uiValueExpected++ ) {
+						if ( puiValuesRead[uiK] != (uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1)) ) {
+							printf("Failed, read: %u, expected: %u.\n", puiValuesRead[uiK], uiValueExpected % (NUM_COMPACT_VARINT_MAX_VALUE + 1));
+							exit (-1);
+						}
+					}
+				}
+
+				if ( uiValueExpected != (ITERATIONS + 3) ) {
+					printf("Failed, integers read: %u, expected: %u.\n", uiValueExpected, ITERATIONS + 3);
+					exit (-1);
+				}
+
+				iNumStreamDecoderFree(pvNumStreamDecoder);
+				close(iSourceFileDescriptor);
+				close(iTargetFileDescriptor);
 			}
 		}
 
-	
-		gettimeofday(&tvEndTimeVal, NULL);
+		free(pucData);
+		free(pucTargetData);
 
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
-		printf("Reading varint across memory, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		printf("\n\n");
-	
-	}
-#endif	/* defined(VARINT_ACROSS_MEMORY) */
+		printf("Transcode test complete\n\n");
 
+	}
+#endif	/* defined(TEST_TRANSCODE) */
 
 
-#if defined(COMPACT_VARINT_ACROSS_MEMORY)
-	/* Testing compact varint across memory */
+#if defined(TEST_LIST)
+	/* List test */
 	{
-	
-		unsigned char		*pucData = NULL;
-		unsigned char		*pucDataPtr = NULL;
 
-		unsigned int		uiDataLength = ITERATIONS * 16;
+		char				pucFilePath[] = "/tmp/varintTest.XXXXXX";
+		int					iFileDescriptor = -1;
 
-		unsigned int		uiI = 0;
-		unsigned int		uiJ = 0;
+		void				*pvNumList = NULL;
+		void				*pvNumStreamDecoder = NULL;
 
-		unsigned long long	ullTotalIterations = 0;
-	
-		unsigned int		uiValueWritten1 = NUMBER_1;
-		unsigned int		uiValueWritten2 = NUMBER_2;
-		unsigned int		uiValueWritten3 = NUMBER_3;
-		unsigned int		uiValueWritten4 = NUMBER_4;
+		unsigned int		puiBlockIntegerCounts[] = {5, 0};
+		unsigned int		puiBlockSlacks[] = {1, 0};
+		unsigned int		uiBlockIntegerCount = 0;
 
-		unsigned int		uiValueRead1 = 0;
-		unsigned int		uiValueRead2 = 0;
-		unsigned int		uiValueRead3 = 0;
-		unsigned int		uiValueRead4 = 0;
+		unsigned int		*puiValues = NULL;
+		unsigned int		puiValuesRead[1000];
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiListLength = (ITERATIONS / 64) + 3;
+		unsigned int		uiValue = 0;
+		unsigned int		uiMaxValue = 0;
+		unsigned long long	ullIntegerCount = 0;
+		unsigned long long	ullDataLength = 0;
+		unsigned long long	ullBlockRewriteCount = 0;
 
-		unsigned int		uiValueRead = 0;
+		unsigned int		uiFormat = 0;
+		unsigned int		uiRandom = 1;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
 
-		struct timeval		tvStartTimeVal;
-		struct timeval		tvEndTimeVal;
-		struct timeval		tvDiffTimeVal;
-		double				dMicroSeconds = 0;
-		unsigned char		pucNumberString[STRING_LENGTH];
-		unsigned char		pucString[STRING_LENGTH];
 
+		printf("List test\n\n");
 
-		if ( (pucData = malloc(uiDataLength)) == NULL ) {
+		if ( (puiValues = malloc(uiListLength * sizeof(unsigned int))) == NULL ) {
 			printf("Failed to allocate memory\n");
 			exit (-1);
 		}
 
-		memset(pucData, 0, uiDataLength);
-
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
 
-		gettimeofday(&tvStartTimeVal, NULL);
+			uiMaxValue = (uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD) ? NUM_COMPACT_VARINT_MAX_VALUE : UINT_MAX;
 
-		for ( uiI = 0, pucDataPtr = pucData; uiI < ITERATIONS; uiI++ ) {
-	
-			uiValueWritten1 = uiI;
-			uiValueWritten2 = uiValueWritten1 + 1;
-			uiValueWritten3 = uiValueWritten2 + 1;
-			uiValueWritten4 = uiValueWritten3 + 1;
+			for ( uiI = 0; uiI < (sizeof(puiBlockIntegerCounts) / sizeof(unsigned int)); uiI++ ) {
 
-			NUM_WRITE_COMPACT_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+				uiBlockIntegerCount = (puiBlockIntegerCounts[uiI] > 0) ? puiBlockIntegerCounts[uiI] : NUM_BLOCK_INTEGER_COUNT_DEFAULT;
 
-		}
-	
-		gettimeofday(&tvEndTimeVal, NULL);
+				if ( (iError = iNumListCreate(uiFormat, puiBlockIntegerCounts[uiI], puiBlockSlacks[uiI], &pvNumList)) != NUM_NoError ) {
+					printf("Failed to create a list, error: %d.\n", iError);
+					exit (-1);
+				}
 
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
 
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ITERATIONS * 4));
-		printf("Writing compact varint across memory, numbers written: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				/* Append small integers in uneven batches */
+				for ( uiJ = 0; uiJ < uiListLength; uiJ++ ) {
+					uiRandom ^= uiRandom << 13;
+					uiRandom ^= uiRandom >> 17;
+					uiRandom ^= uiRandom << 5;
+					puiValues[uiJ] = uiRandom & 0x7F;
+				}
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				for ( uiJ = 0; uiJ < uiListLength; uiJ += uiValuesLength ) {
+					uiValuesLength = ((uiJ % 7) * 37) + 1;
+					uiValuesLength = (uiValuesLength < (uiListLength - uiJ)) ? uiValuesLength : (uiListLength - uiJ);
+					if ( (iError = iNumListAppend(pvNumList, puiValues + uiJ, uiValuesLength)) != NUM_NoError ) {
+						printf("Failed to append integers, error: %d.\n", iError);
+						exit (-1);
+					}
+				}
 
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ITERATIONS * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+				/* Compact varints can not hold full integers, the list is unchanged */
+				if ( uiFormat == NUM_FORMAT_COMPACT_VARINT_QUAD ) {
 
-		snprintf(pucNumberString, STRING_LENGTH, "%u", uiDataLength);
-		printf("\tBytes, allocated: %s", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-		snprintf(pucNumberString, STRING_LENGTH, "%ld", pucDataPtr - pucData);
-		printf(", used %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
+					uiValue = NUM_COMPACT_VARINT_MAX_VALUE + 1;
 
-		printf("\n");
+					if ( (iError = iNumListAppend(pvNumList, &uiValue, 1)) != NUM_ValueOverflowError ) {
+						printf("Failed to reject an integer on append, error: %d.\n", iError);
+						exit (-1);
+					}
 
+					if ( (iError = iNumListUpdate(pvNumList, 0, uiValue)) != NUM_ValueOverflowError ) {
+						printf("Failed to reject an integer on update, error: %d.\n", iError);
+						exit (-1);
+					}
+				}
 
-		gettimeofday(&tvStartTimeVal, NULL);
-	
-		for ( uiI = 0, ullTotalIterations = 0; uiI < REPETITIONS; uiI++ ) {
-	
-			for ( uiJ = 0, pucDataPtr = pucData; uiJ < ITERATIONS; uiJ++, ullTotalIterations++ ) {
-	
-				NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
-	
-#if defined(CHECK_READ)
-				if ( uiValueRead1 != uiJ ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiJ);
+				if ( (iError = iNumListUpdate(pvNumList, uiListLength, 0)) != NUM_InvalidParameter ) {
+					printf("Failed to reject an update past the end of the list, error: %d.\n", iError);
 					exit (-1);
 				}
-	
-				if ( uiValueRead2 != (uiJ + 1) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiJ + 1);
-					exit (-1);
+
+
+				/* Update integers at random, growing them beyond the slack so blocks are moved and the buffer compacted */
+				for ( uiJ = 0; uiJ < (uiListLength / 2); uiJ++ ) {
+					uiRandom ^= uiRandom << 13;
+					uiRandom ^= uiRandom >> 17;
+					uiRandom ^= uiRandom << 5;
+					uiK = uiRandom % uiListLength;
+					puiValues[uiK] = (uiJ & 1) ? (uiRandom & uiMaxValue) : (uiRandom & 0x3);
+					if ( (iError = iNumListUpdate(pvNumList, uiK, puiValues[uiK])) != NUM_NoError ) {
+						printf("Failed to update an integer, error: %d.\n", iError);
+						exit (-1);
+					}
 				}
-	
-				if ( uiValueRead3 != (uiJ + 2) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiJ + 2);
+
+				/* Update the tail */
+				for ( uiJ = uiListLength - (uiListLength % uiBlockIntegerCount); uiJ < uiListLength; uiJ++ ) {
+					puiValues[uiJ] = uiMaxValue - uiJ;
+					if ( (iError = iNumListUpdate(pvNumList, uiJ, puiValues[uiJ])) != NUM_NoError ) {
+						printf("Failed to update an integer, error: %d.\n", iError);
+						exit (-1);
+					}
+				}
+
+				if ( (iError = iNumListGetCounts(pvNumList, &ullIntegerCount, &ullDataLength, &ullBlockRewriteCount)) != NUM_NoError ) {
+					printf("Failed to get the list counts, error: %d.\n", iError);
 					exit (-1);
 				}
-	
-				if ( uiValueRead4 != (uiJ + 3) ) {
-					printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiJ + 3);
+
+				if ( (ullIntegerCount != uiListLength) || (ullBlockRewriteCount == 0) ) {
+					printf("Failed, integers: %llu, expected: %u, block rewrites: %llu.\n", ullIntegerCount, uiListLength, ullBlockRewriteCount);
 					exit (-1);
 				}
-#endif	/* defined(CHECK_READ) */
-			}
-		}
 
-	
-		gettimeofday(&tvEndTimeVal, NULL);
+				printf("Format: %u, block integer count: %u, data length: %llu, block rewrites: %llu.\n", uiFormat, uiBlockIntegerCount, ullDataLength, ullBlockRewriteCount);
 
-		UTL_DATE_DIFF_TIMEVAL(tvStartTimeVal, tvEndTimeVal, tvDiffTimeVal);
-		UTL_DATE_TIMEVAL_TO_MICROSECONDS(tvDiffTimeVal, dMicroSeconds);
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%llu", (ullTotalIterations * 4));
-		printf("Reading compact varint across memory, numbers read: %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", dMicroSeconds);
-		printf("\tMicroseconds : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		snprintf(pucNumberString, STRING_LENGTH, "%.0f", (double)(ullTotalIterations * 4) * ((double)1000000 / dMicroSeconds));
-		printf("\tIterations/second : %s\n", pucUtlStringsFormatIntegerString(pucNumberString, pucString, STRING_LENGTH));
-	
-		printf("\n\n");
-	
-	}
-#endif	/* defined(COMPACT_VARINT_ACROSS_MEMORY) */
 
+				/* Check the integers */
+				for ( uiJ = 0; uiJ < uiListLength; uiJ++ ) {
+					if ( (iError = iNumListGet(pvNumList, uiJ, &uiValue)) != NUM_NoError ) {
+						printf("Failed to get an integer, error: %d.\n", iError);
+						exit (-1);
+					}
+					if ( uiValue != puiValues[uiJ] ) {
+						printf("Failed, index: %u, read: %u, expected: %u.\n", uiJ, uiValue, puiValues[uiJ]);
+						exit (-1);
+					}
+				}
+
+				if ( (iError = iNumListGet(pvNumList, uiListLength, &uiValue)) != NUM_InvalidParameter ) {
+					printf("Failed to reject a get past the end of the list, error: %d.\n", iError);
+					exit (-1);
+				}
 
 
-#if defined(TEST_VARINT_1)
-	/* Sanity test 1 */
-	{
+				/* Write the list and read it back as a stream */
+				strcpy(pucFilePath, "/tmp/varintTest.XXXXXX");
+				if ( (iFileDescriptor = mkstemp(pucFilePath)) == -1 ) {
+					printf("Failed to create a temporary file\n");
+					exit (-1);
+				}
+				unlink(pucFilePath);
 
-		unsigned char	pucData[DATA_LENGTH];
-		unsigned char	*pucDataPtr = NULL;
+				if ( (iError = iNumListWrite(pvNumList, iNumStreamSinkFileDescriptor, (void *)&iFileDescriptor)) != NUM_NoError ) {
+					printf("Failed to write the list, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				lseek(iFileDescriptor, 0, SEEK_SET);
+
+				if ( (iError = iNumStreamDecoderCreate(uiFormat, puiBlockIntegerCounts[uiI], 0, iNumStreamSourceFileDescriptor, (void *)&iFileDescriptor, &pvNumStreamDecoder)) != NUM_NoError ) {
+					printf("Failed to create a stream decoder, error: %d.\n", iError);
+					exit (-1);
+				}
 
-		unsigned int	uiI = 0;
+				for ( uiJ = 0; ; ) {
 
-		unsigned int	uiValueWritten = 0;
-		unsigned int	uiValueRead = 0;
+					if ( (iError = iNumStreamDecoderNextBatch(pvNumStreamDecoder, puiValuesRead, 1000, &uiValuesLength)) == NUM_EndOfStream ) {
+						break;
+					}
+					else if ( iError != NUM_NoError ) {
+						printf("Failed to decode integers, error: %d.\n", iError);
+						exit (-1);
+					}
 
-		unsigned int	uiSize = 0;
-		
+					if ( (uiJ + uiValuesLength) > uiListLength ) {
+						printf("Failed, integers read exceed the list length: %u.\n", uiListLength);
+						exit (-1);
+					}
 
-		memset(pucData, DATA_LENGTH, 0);
+					if ( memcmp(puiValues + uiJ, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0 ) {
+						printf("Failed, integers read do not match.\n");
+						exit (-1);
+					}
 
-		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+					uiJ += uiValuesLength;
+				}
 
-			uiValueWritten = uiI;
-	
-			pucDataPtr = pucData;
-			NUM_GET_VARINT_SIZE(uiValueWritten, uiSize);
-			NUM_WRITE_VARINT(uiValueWritten, uiSize, pucDataPtr);
+				if ( uiJ != uiListLength ) {
+					printf("Failed, integers read: %u, expected: %u.\n", uiJ, uiListLength);
+					exit (-1);
+				}
 
-			pucDataPtr = pucData;
-			NUM_READ_VARINT(uiValueRead, uiSize, pucDataPtr);
+				iNumStreamDecoderFree(pvNumStreamDecoder);
+				close(iFileDescriptor);
 
-			if ( uiValueRead != uiValueWritten ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead, uiValueWritten);
-				exit (-1);
+				iNumListFree(pvNumList);
 			}
 		}
 
-		printf("Sanity test 1 complete\n\n");
+		free(puiValues);
 
-	}
-#endif	/* defined(TEST_VARINT_1) */
+		printf("List test complete\n\n");
 
+	}
+#endif	/* defined(TEST_LIST) */
 
 
-#if defined(TEST_VARINT_2)
-	/* Sanity test 2 */
+#if defined(TEST_SET)
+	/* Set test */
 	{
 
-		unsigned char	pucData[DATA_LENGTH];
-		unsigned char	*pucDataPtr = NULL;
+		void				*pvNumSet1 = NULL;
+		void				*pvNumSet2 = NULL;
+		void				*pvNumSet = NULL;
+
+		unsigned int		*puiValues1 = NULL;
+		unsigned int		*puiValues2 = NULL;
+		unsigned int		*puiValuesExpected = NULL;
+		unsigned int		*puiValuesRead = NULL;
+		unsigned int		uiValuesLength1 = 0;
+		unsigned int		uiValuesLength2 = 0;
+		unsigned int		uiValuesExpectedLength = 0;
+		unsigned int		uiValuesLength = 0;
+		unsigned int		uiChunkCount = 64;
+		unsigned int		uiValuesCapacity = uiChunkCount * NUM_SET_CHUNK_LENGTH;
+		unsigned int		puiValuesUnsorted[] = {1, 3, 3};
+		unsigned int		puiDensities[] = {0, 1, 8, 64, 256, 512, 1000, 1024};
+
+		unsigned long long	ullIntegerCount = 0;
+		unsigned long long	ullDataLength = 0;
+		unsigned int		uiListCount = 0;
+		unsigned int		uiBitmapCount = 0;
+
+		unsigned int		uiFormat = 0;
+		unsigned int		uiRandom = 1;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		unsigned int		uiK = 0;
+		int					iError = NUM_NoError;
 
-		unsigned int	uiI = 0;
 
-		unsigned int	uiValueWritten1 = 0;
-		unsigned int	uiValueWritten2 = 0;
-		unsigned int	uiValueWritten3 = 0;
-		unsigned int	uiValueWritten4 = 0;
+		printf("Set test\n\n");
 
-		unsigned int	uiValueRead1 = 0;
-		unsigned int	uiValueRead2 = 0;
-		unsigned int	uiValueRead3 = 0;
-		unsigned int	uiValueRead4 = 0;
+		if ( ((puiValues1 = malloc(uiValuesCapacity * sizeof(unsigned int))) == NULL) || ((puiValues2 = malloc(uiValuesCapacity * sizeof(unsigned int))) == NULL) ||
+				((puiValuesExpected = malloc(uiValuesCapacity * sizeof(unsigned int))) == NULL) || ((puiValuesRead = malloc(uiValuesCapacity * sizeof(unsigned int))) == NULL) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
 
-		
-		memset(pucData, DATA_LENGTH, 0);
+		for ( uiFormat = NUM_FORMAT_COMPRESSED_UINT; uiFormat <= NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD; uiFormat++ ) {
 
-		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+			if ( (iError = iNumSetCreate(uiFormat, puiValuesUnsorted, sizeof(puiValuesUnsorted) / sizeof(unsigned int), &pvNumSet)) != NUM_InvalidParameter ) {
+				printf("Failed to reject integers which are not sorted and unique, error: %d.\n", iError);
+				exit (-1);
+			}
 
-			uiValueWritten1 = uiI;
-			uiValueWritten2 = uiValueWritten1 + 1;
-			uiValueWritten3 = uiValueWritten2 + 1;
-			uiValueWritten4 = uiValueWritten3 + 1;
 
-			pucDataPtr = pucData;
-			NUM_WRITE_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+			/* Two sets with chunks of densities from empty to full spread over the 32 bit space, every density of one set meets every density of the other */
+			for ( uiI = 0, uiValuesLength1 = 0, uiValuesLength2 = 0; uiI < uiChunkCount; uiI++ ) {
+				for ( uiJ = 0; uiJ < NUM_SET_CHUNK_LENGTH; uiJ++ ) {
+					uiRandom ^= uiRandom << 13;
+					uiRandom ^= uiRandom >> 17;
+					uiRandom ^= uiRandom << 5;
+					uiK = ((uiI * 0x3FFFFFF) & 0xFFFF0000) | uiJ;
+					if ( (uiRandom & 0x3FF) < puiDensities[uiI % 8] ) {
+						puiValues1[uiValuesLength1++] = uiK;
+					}
+					if ( ((uiRandom >> 10) & 0x3FF) < puiDensities[(uiI / 8) % 8] ) {
+						puiValues2[uiValuesLength2++] = uiK;
+					}
+				}
+			}
 
-			pucDataPtr = pucData;
-			NUM_READ_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
+			if ( ((iError = iNumSetCreate(uiFormat, puiValues1, uiValuesLength1, &pvNumSet1)) != NUM_NoError) ||
+					((iError = iNumSetCreate((uiFormat % NUM_FORMAT_COMPACT_VARINT_ESCAPE_QUAD) + 1, puiValues2, uiValuesLength2, &pvNumSet2)) != NUM_NoError) ) {
+				printf("Failed to create a set, error: %d.\n", iError);
+				exit (-1);
+			}
 
-			if ( uiValueRead1 != uiValueWritten1 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+			if ( (iError = iNumSetGetCounts(pvNumSet1, &ullIntegerCount, &ullDataLength, &uiListCount, &uiBitmapCount)) != NUM_NoError ) {
+				printf("Failed to get the set counts, error: %d.\n", iError);
 				exit (-1);
 			}
 
-			if ( uiValueRead2 != uiValueWritten2 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+			if ( (ullIntegerCount != uiValuesLength1) || (uiListCount == 0) || (uiBitmapCount == 0) ) {
+				printf("Failed, integers: %llu, expected: %u, lists: %u, bitmaps: %u.\n", ullIntegerCount, uiValuesLength1, uiListCount, uiBitmapCount);
 				exit (-1);
 			}
 
-			if ( uiValueRead3 != uiValueWritten3 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+			printf("Format: %u, integers: %llu, data length: %llu, lists: %u, bitmaps: %u.\n", uiFormat, ullIntegerCount, ullDataLength, uiListCount, uiBitmapCount);
+
+
+			/* Decode the set */
+			if ( (iError = iNumSetDecode(pvNumSet1, puiValuesRead, uiValuesCapacity, &uiValuesLength)) != NUM_NoError ) {
+				printf("Failed to decode a set, error: %d.\n", iError);
 				exit (-1);
 			}
 
-			if ( uiValueRead4 != uiValueWritten4 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+			if ( (uiValuesLength != uiValuesLength1) || (memcmp(puiValues1, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0) ) {
+				printf("Failed, integers decoded: %u, expected: %u, or they do not match.\n", uiValuesLength, uiValuesLength1);
 				exit (-1);
 			}
+
+
+			/* Intersect the sets, both ways round */
+			for ( uiI = 0, uiJ = 0, uiValuesExpectedLength = 0; (uiI < uiValuesLength1) && (uiJ < uiValuesLength2); ) {
+				if ( puiValues1[uiI] < puiValues2[uiJ] ) {
+					uiI++;
+				}
+				else if ( puiValues1[uiI] > puiValues2[uiJ] ) {
+					uiJ++;
+				}
+				else {
+					puiValuesExpected[uiValuesExpectedLength++] = puiValues1[uiI];
+					uiI++;
+					uiJ++;
+				}
+			}
+
+			for ( uiK = 0; uiK < 2; uiK++ ) {
+
+				if ( (iError = iNumSetIntersect((uiK == 0) ? pvNumSet1 : pvNumSet2, (uiK == 0) ? pvNumSet2 : pvNumSet1, &pvNumSet)) != NUM_NoError ) {
+					printf("Failed to intersect the sets, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				if ( (iError = iNumSetDecode(pvNumSet, puiValuesRead, uiValuesCapacity, &uiValuesLength)) != NUM_NoError ) {
+					printf("Failed to decode a set, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				if ( (uiValuesLength != uiValuesExpectedLength) || (memcmp(puiValuesExpected, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0) ) {
+					printf("Failed, integers intersected: %u, expected: %u, or they do not match.\n", uiValuesLength, uiValuesExpectedLength);
+					exit (-1);
+				}
+
+				iNumSetFree(pvNumSet);
+			}
+
+
+			/* Unite the sets, both ways round */
+			for ( uiI = 0, uiJ = 0, uiValuesExpectedLength = 0; (uiI < uiValuesLength1) || (uiJ < uiValuesLength2); ) {
+				if ( (uiJ == uiValuesLength2) || ((uiI < uiValuesLength1) && (puiValues1[uiI] < puiValues2[uiJ])) ) {
+					puiValuesExpected[uiValuesExpectedLength++] = puiValues1[uiI++];
+				}
+				else if ( (uiI == uiValuesLength1) || (puiValues1[uiI] > puiValues2[uiJ]) ) {
+					puiValuesExpected[uiValuesExpectedLength++] = puiValues2[uiJ++];
+				}
+				else {
+					puiValuesExpected[uiValuesExpectedLength++] = puiValues1[uiI];
+					uiI++;
+					uiJ++;
+				}
+			}
+
+			for ( uiK = 0; uiK < 2; uiK++ ) {
+
+				if ( (iError = iNumSetUnion((uiK == 0) ? pvNumSet1 : pvNumSet2, (uiK == 0) ? pvNumSet2 : pvNumSet1, &pvNumSet)) != NUM_NoError ) {
+					printf("Failed to unite the sets, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				if ( (iError = iNumSetDecode(pvNumSet, puiValuesRead, uiValuesCapacity, &uiValuesLength)) != NUM_NoError ) {
+					printf("Failed to decode a set, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				if ( (uiValuesLength != uiValuesExpectedLength) || (memcmp(puiValuesExpected, puiValuesRead, uiValuesLength * sizeof(unsigned int)) != 0) ) {
+					printf("Failed, integers united: %u, expected: %u, or they do not match.\n", uiValuesLength, uiValuesExpectedLength);
+					exit (-1);
+				}
+
+				iNumSetFree(pvNumSet);
+			}
+
+			iNumSetFree(pvNumSet1);
+			iNumSetFree(pvNumSet2);
 		}
 
-		printf("Sanity test 2 complete\n\n");
+		free(puiValues1);
+		free(puiValues2);
+		free(puiValuesExpected);
+		free(puiValuesRead);
 
-	}
-#endif	/* defined(TEST_VARINT_2) */
+		printf("Set test complete\n\n");
 
+	}
+#endif	/* defined(TEST_SET) */
 
 
-#if defined(TEST_COMPACT_VARINT_1)
-	/* Sanity test 1 */
+#if defined(TEST_POSTING)
+	/* Posting test */
 	{
 
-		unsigned char	pucData[DATA_LENGTH];
-		unsigned char	*pucDataPtr = NULL;
+		void				*pvNumPostings = NULL;
+		void				*pvNumPostingCursor = NULL;
+
+		unsigned int		uiPostingCount = (ITERATIONS / 256) + 3;
+		unsigned int		*puiDocIDs = NULL;
+		unsigned int		*puiTfs = NULL;
+		unsigned long long	*pullPositionOffsets = NULL;
+		unsigned int		*puiPositions = NULL;
+		unsigned long long	ullPositionsLength = 0;
+		unsigned int		uiLongTf = 70000;
+		unsigned int		*puiPositionsRead = NULL;
+		unsigned int		uiPositionsLength = 0;
+
+		unsigned long long	ullPostingCount = 0;
+		unsigned long long	ullDocDataLength = 0;
+		unsigned long long	ullTfDataLength = 0;
+		unsigned long long	ullPositionDataLength = 0;
+		unsigned long long	ullDocBlockCount = 0;
+		unsigned long long	ullTfBlockCount = 0;
+		unsigned long long	ullPositionBlockCount = 0;
+		unsigned long long	ullBlockCount = 0;
+
+		unsigned int		uiDocID = 0;
+		unsigned int		uiTargetDocID = 0;
+		unsigned int		uiTf = 0;
+		unsigned int		uiRandom = 1;
+		unsigned int		uiI = 0;
+		unsigned int		uiJ = 0;
+		int					iError = NUM_NoError;
 
-		unsigned int	uiI = 0;
 
-		unsigned int	uiValueWritten = 0;
-		unsigned int	uiValueRead = 0;
+		printf("Posting test\n\n");
 
-		unsigned int	uiSize = 0;
-		
+		if ( ((puiDocIDs = malloc(uiPostingCount * sizeof(unsigned int))) == NULL) || ((puiTfs = malloc(uiPostingCount * sizeof(unsigned int))) == NULL) ||
+				((pullPositionOffsets = malloc(uiPostingCount * sizeof(unsigned long long))) == NULL) ||
+				((puiPositions = malloc(((unsigned long long)uiPostingCount * 8 + uiLongTf) * sizeof(unsigned int))) == NULL) ||
+				((puiPositionsRead = malloc(uiLongTf * sizeof(unsigned int))) == NULL) ) {
+			printf("Failed to allocate memory\n");
+			exit (-1);
+		}
 
-		printf("Sanity test 1\n\n");
 
-		memset(pucData, DATA_LENGTH, 0);
+		/* Postings with small doc ID gaps, mostly frequencies of one and one posting with more positions than a block holds */
+		for ( uiI = 0; uiI < uiPostingCount; uiI++ ) {
 
-		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+			uiRandom ^= uiRandom << 13;
+			uiRandom ^= uiRandom >> 17;
+			uiRandom ^= uiRandom << 5;
 
-			uiValueWritten = uiI;
-	
-			pucDataPtr = pucData;
-			NUM_GET_COMPACT_VARINT_SIZE(uiValueWritten, uiSize);
-			NUM_WRITE_COMPACT_VARINT(uiValueWritten, uiSize, pucDataPtr);
+			puiDocIDs[uiI] = uiDocID;
+			uiDocID += 1 + (uiRandom & 0x1F);
+			puiTfs[uiI] = (uiI == (uiPostingCount / 2)) ? uiLongTf : ((uiRandom >> 5) & 0x3) ? 1 : (1 + ((uiRandom >> 7) & 0x7));
+			pullPositionOffsets[uiI] = ullPositionsLength;
 
-			pucDataPtr = pucData;
-			NUM_READ_COMPACT_VARINT(uiValueRead, uiSize, pucDataPtr);
+			for ( uiJ = 0; uiJ < puiTfs[uiI]; uiJ++, ullPositionsLength++ ) {
+				uiRandom ^= uiRandom << 13;
+				uiRandom ^= uiRandom >> 17;
+				uiRandom ^= uiRandom << 5;
+				puiPositions[ullPositionsLength] = ((uiJ > 0) ? (puiPositions[ullPositionsLength - 1] + 1) : 0) + ((puiTfs[uiI] == uiLongTf) ? 0 : (uiRandom & 0xFF));
+			}
+		}
 
-			if ( uiValueRead != uiValueWritten ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead, uiValueWritten);
+		if ( (iError = iNumPostingsCreate(0, &pvNumPostings)) != NUM_NoError ) {
+			printf("Failed to create postings, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		for ( uiI = 0; uiI < uiPostingCount; uiI++ ) {
+
+			if ( (iError = iNumPostingsAdd(pvNumPostings, puiDocIDs[uiI], puiPositions + pullPositionOffsets[uiI], puiTfs[uiI])) != NUM_NoError ) {
+				printf("Failed to add a posting, error: %d.\n", iError);
 				exit (-1);
 			}
+
+			/* A short block in the middle */
+			if ( uiI == (uiPostingCount / 3) ) {
+				if ( (iError = iNumPostingsFlush(pvNumPostings)) != NUM_NoError ) {
+					printf("Failed to flush the postings, error: %d.\n", iError);
+					exit (-1);
+				}
+			}
 		}
 
-		printf("Sanity test 1 complete\n\n");
+		if ( (iError = iNumPostingsAdd(pvNumPostings, puiDocIDs[uiPostingCount - 1], puiPositions, 1)) != NUM_InvalidParameter ) {
+			printf("Failed to reject a doc ID which is not increasing, error: %d.\n", iError);
+			exit (-1);
+		}
 
-	}
-#endif	/* defined(TEST_COMPACT_VARINT_1) */
+		if ( (iError = iNumPostingsAdd(pvNumPostings, uiDocID, puiPositions, 0)) != NUM_InvalidParameter ) {
+			printf("Failed to reject a posting without positions, error: %d.\n", iError);
+			exit (-1);
+		}
 
+		if ( (iError = iNumPostingsFlush(pvNumPostings)) != NUM_NoError ) {
+			printf("Failed to flush the postings, error: %d.\n", iError);
+			exit (-1);
+		}
 
+		if ( (iError = iNumPostingsGetCounts(pvNumPostings, &ullPostingCount, &ullDocDataLength, &ullTfDataLength, &ullPositionDataLength)) != NUM_NoError ) {
+			printf("Failed to get the posting counts, error: %d.\n", iError);
+			exit (-1);
+		}
 
-#if defined(TEST_COMPACT_VARINT_2)
-	/* Sanity test 2 */
-	{
+		if ( ullPostingCount != uiPostingCount ) {
+			printf("Failed, postings: %llu, expected: %u.\n", ullPostingCount, uiPostingCount);
+			exit (-1);
+		}
 
-		unsigned char	pucData[DATA_LENGTH];
-		unsigned char	*pucDataPtr = NULL;
+		printf("Postings: %llu, doc ID bytes: %llu, frequency bytes: %llu, position bytes: %llu.\n", ullPostingCount, ullDocDataLength, ullTfDataLength, ullPositionDataLength);
 
-		unsigned int	uiI = 0;
 
-		unsigned int	uiValueWritten1 = 0;
-		unsigned int	uiValueWritten2 = 0;
-		unsigned int	uiValueWritten3 = 0;
-		unsigned int	uiValueWritten4 = 0;
+		/* Read the doc IDs, no frequencies or positions are decoded */
+		if ( (iError = iNumPostingCursorCreate(pvNumPostings, &pvNumPostingCursor)) != NUM_NoError ) {
+			printf("Failed to create a posting cursor, error: %d.\n", iError);
+			exit (-1);
+		}
 
-		unsigned int	uiValueRead1 = 0;
-		unsigned int	uiValueRead2 = 0;
-		unsigned int	uiValueRead3 = 0;
-		unsigned int	uiValueRead4 = 0;
+		if ( (iError = iNumPostingCursorGetTf(pvNumPostingCursor, &uiTf)) != NUM_InvalidParameter ) {
+			printf("Failed to reject getting a frequency before the first posting, error: %d.\n", iError);
+			exit (-1);
+		}
 
-		
-		printf("Sanity test 2\n\n");
+		for ( uiI = 0; (iError = iNumPostingCursorNext(pvNumPostingCursor, &uiDocID)) == NUM_NoError; uiI++ ) {
+			if ( (uiI >= uiPostingCount) || (uiDocID != puiDocIDs[uiI]) ) {
+				printf("Failed, posting: %u, doc ID: %u, expected: %u.\n", uiI, uiDocID, (uiI < uiPostingCount) ? puiDocIDs[uiI] : 0);
+				exit (-1);
+			}
+		}
 
-		memset(pucData, DATA_LENGTH, 0);
+		if ( (iError != NUM_EndOfStream) || (uiI != uiPostingCount) ) {
+			printf("Failed to read the postings, error: %d, postings read: %u, expected: %u.\n", iError, uiI, uiPostingCount);
+			exit (-1);
+		}
 
-		for ( uiI = 0; uiI < ITERATIONS; uiI++ ) {
+		iNumPostingCursorGetCounts(pvNumPostingCursor, &ullBlockCount, &ullTfBlockCount, &ullPositionBlockCount);
 
-			uiValueWritten1 = uiI;
-			uiValueWritten2 = uiValueWritten1 + 1;
-			uiValueWritten3 = uiValueWritten2 + 1;
-			uiValueWritten4 = uiValueWritten3 + 1;
+		if ( (ullTfBlockCount != 0) || (ullPositionBlockCount != 0) ) {
+			printf("Failed, frequency blocks decoded: %llu, position blocks decoded: %llu, expected none.\n", ullTfBlockCount, ullPositionBlockCount);
+			exit (-1);
+		}
 
-			pucDataPtr = pucData;
-			NUM_WRITE_COMPACT_VARINT_QUAD(uiValueWritten1, uiValueWritten2, uiValueWritten3, uiValueWritten4, pucDataPtr);
+		iNumPostingCursorFree(pvNumPostingCursor);
 
-			pucDataPtr = pucData;
-			NUM_READ_COMPACT_VARINT_QUAD(uiValueRead1, uiValueRead2, uiValueRead3, uiValueRead4, pucDataPtr);
 
-			if ( uiValueRead1 != uiValueWritten1 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead1, uiValueWritten1);
+		/* Read the frequencies of every posting and the positions of some */
+		if ( (iError = iNumPostingCursorCreate(pvNumPostings, &pvNumPostingCursor)) != NUM_NoError ) {
+			printf("Failed to create a posting cursor, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		for ( uiI = 0; (iError = iNumPostingCursorNext(pvNumPostingCursor, &uiDocID)) == NUM_NoError; uiI++ ) {
+
+			if ( (iError = iNumPostingCursorGetTf(pvNumPostingCursor, &uiTf)) != NUM_NoError ) {
+				printf("Failed to get a frequency, error: %d.\n", iError);
 				exit (-1);
 			}
 
-			if ( uiValueRead2 != uiValueWritten2 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead2, uiValueWritten2);
+			if ( uiTf != puiTfs[uiI] ) {
+				printf("Failed, posting: %u, frequency: %u, expected: %u.\n", uiI, uiTf, puiTfs[uiI]);
 				exit (-1);
 			}
 
-			if ( uiValueRead3 != uiValueWritten3 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead3, uiValueWritten3);
+			if ( ((uiI % 3) == 0) || (uiTf == uiLongTf) ) {
+
+				if ( (iError = iNumPostingCursorGetPositions(pvNumPostingCursor, puiPositionsRead, uiLongTf, &uiPositionsLength)) != NUM_NoError ) {
+					printf("Failed to get positions, error: %d.\n", iError);
+					exit (-1);
+				}
+
+				if ( (uiPositionsLength != uiTf) || (memcmp(puiPositionsRead, puiPositions + pullPositionOffsets[uiI], uiTf * sizeof(unsigned int)) != 0) ) {
+					printf("Failed, posting: %u, positions read: %u, expected: %u, or they do not match.\n", uiI, uiPositionsLength, uiTf);
+					exit (-1);
+				}
+			}
+		}
+
+		if ( (iError != NUM_EndOfStream) || (uiI != uiPostingCount) ) {
+			printf("Failed to read the postings, error: %d, postings read: %u, expected: %u.\n", iError, uiI, uiPostingCount);
+			exit (-1);
+		}
+
+		iNumPostingCursorFree(pvNumPostingCursor);
+
+
+		/* Advance to targets far apart, most blocks are skipped, and read the frequencies of the postings found */
+		if ( (iError = iNumPostingCursorCreate(pvNumPostings, &pvNumPostingCursor)) != NUM_NoError ) {
+			printf("Failed to create a posting cursor, error: %d.\n", iError);
+			exit (-1);
+		}
+
+		for ( uiI = 0, uiTargetDocID = 0; ; ) {
+
+			/* The first posting at or after the current one with a doc ID at least the target */
+			while ( (uiI < uiPostingCount) && (puiDocIDs[uiI] < uiTargetDocID) ) {
+				uiI++;
+			}
+
+			if ( (iError = iNumPostingCursorAdvance(pvNumPostingCursor, uiTargetDocID, &uiDocID)) == NUM_EndOfStream ) {
+				break;
+			}
+			else if ( iError != NUM_NoError ) {
+				printf("Failed to advance the posting cursor, error: %d.\n", iError);
 				exit (-1);
 			}
 
-			if ( uiValueRead4 != uiValueWritten4 ) {
-				printf("Failed, read: %u, expected: %u.\n", uiValueRead4, uiValueWritten4);
+			if ( (uiI >= uiPostingCount) || (uiDocID != puiDocIDs[uiI]) ) {
+				printf("Failed, target: %u, doc ID: %u, expected: %u.\n", uiTargetDocID, uiDocID, (uiI < uiPostingCount) ? puiDocIDs[uiI] : 0);
+				exit (-1);
+			}
+
+			if ( ((iError = iNumPostingCursorGetTf(pvNumPostingCursor, &uiTf)) != NUM_NoError) || (uiTf != puiTfs[uiI]) ) {
+				printf("Failed, target: %u, frequency: %u, expected: %u, error: %d.\n", uiTargetDocID, uiTf, puiTfs[uiI], iError);
 				exit (-1);
 			}
+
+			uiRandom ^= uiRandom << 13;
+			uiRandom ^= uiRandom >> 17;
+			uiRandom ^= uiRandom << 5;
+			uiTargetDocID = uiDocID + ((uiRandom & 0x7) ? (uiRandom & 0xFFFF) : 0);
 		}
 
-		printf("Sanity test 2 complete\n\n");
+		if ( uiI != uiPostingCount ) {
+			printf("Failed, advanced past the end at posting: %u, expected: %u.\n", uiI, uiPostingCount);
+			exit (-1);
+		}
+
+		iNumPostingCursorGetCounts(pvNumPostingCursor, &ullDocBlockCount, &ullTfBlockCount, &ullPositionBlockCount);
+
+		if ( (ullDocBlockCount >= ullBlockCount) || (ullTfBlockCount > ullDocBlockCount) || (ullPositionBlockCount != 0) ) {
+			printf("Failed, doc ID blocks decoded: %llu of %llu, frequency blocks decoded: %llu, position blocks decoded: %llu.\n",
+					ullDocBlockCount, ullBlockCount, ullTfBlockCount, ullPositionBlockCount);
+			exit (-1);
+		}
+
+		printf("Advance decoded doc ID blocks: %llu of %llu, frequency blocks: %llu.\n", ullDocBlockCount, ullBlockCount, ullTfBlockCount);
+
+		iNumPostingCursorFree(pvNumPostingCursor);
+		iNumPostingsFree(pvNumPostings);
+
+		free(puiDocIDs);
+		free(puiTfs);
+		free(pullPositionOffsets);
+		free(puiPositions);
+		free(puiPositionsRead);
+
+		printf("Posting test complete\n\n");
 
 	}
-#endif	/* defined(TEST_COMPACT_VARINT_2) */
+#endif	/* defined(TEST_POSTING) */
 
 
 	printf("\n\n");
+
+
+	/* Record the results, and check them against the baseline */
+	if ( pucResultsFilePath != NULL ) {
+		if ( iUtlBenchmarkWriteResults(pucResultsFilePath) != 0 ) {
+			printf("Failed to write the results to: %s\n", pucResultsFilePath);
+			exit (-1);
+		}
+	}
+
+	if ( pucBaselineFilePath != NULL ) {
+		if ( iUtlBenchmarkCheckResults(pucBaselineFilePath, REGRESSION_THRESHOLD, REGRESSION_NOISE_MULTIPLE, dNoise, &uiRegressions) != 0 ) {
+			printf("Failed to read the baseline from: %s\n", pucBaselineFilePath);
+			exit (-1);
+		}
+		if ( uiRegressions > 0 ) {
+			exit (1);
+		}
+	}
+
 	exit(0);
 
 }